@@ -376,6 +376,15 @@ set(PRIVATE_CODEC_HEADERS
     src/private/ZstdBlobCodecFactory.h
     src/private/ZstdCodecSettingsAction.h
     src/private/PassthroughCodecSettingsAction.h
+    src/private/ShuffleBlobCodec.h
+    src/private/ShuffleBlobCodecFactory.h
+    src/private/ShuffleCodecSettingsAction.h
+    src/private/Lz4BlobCodec.h
+    src/private/Lz4BlobCodecFactory.h
+    src/private/Lz4CodecSettingsAction.h
+    src/private/DeltaVarintBlobCodec.h
+    src/private/DeltaVarintBlobCodecFactory.h
+    src/private/DeltaVarintCodecSettingsAction.h
 )
 
 set(PRIVATE_CODEC_SOURCES
@@ -385,6 +394,15 @@ set(PRIVATE_CODEC_SOURCES
     src/private/ZstdBlobCodecFactory.cpp
     src/private/ZstdCodecSettingsAction.cpp
     src/private/PassthroughCodecSettingsAction.cpp
+    src/private/ShuffleBlobCodec.cpp
+    src/private/ShuffleBlobCodecFactory.cpp
+    src/private/ShuffleCodecSettingsAction.cpp
+    src/private/Lz4BlobCodec.cpp
+    src/private/Lz4BlobCodecFactory.cpp
+    src/private/Lz4CodecSettingsAction.cpp
+    src/private/DeltaVarintBlobCodec.cpp
+    src/private/DeltaVarintBlobCodecFactory.cpp
+    src/private/DeltaVarintCodecSettingsAction.cpp
 )
 
 set(PRIVATE_CODEC_FILES
@@ -477,10 +495,14 @@ set(PRIVATE_LEARNING_PAGE_FILES
 
 set(PRIVATE_MISCELLANEOUS_HEADERS
     src/private/Archiver.h
+    src/private/ArchiveStreamWriter.h
+    src/private/ArchiveEntryIndex.h
 )
 
 set(PRIVATE_MISCELLANEOUS_SOURCES
     src/private/Archiver.cpp
+    src/private/ArchiveStreamWriter.cpp
+    src/private/ArchiveEntryIndex.cpp
 )
 
 set(PRIVATE_MISCELLANEOUS_FILES
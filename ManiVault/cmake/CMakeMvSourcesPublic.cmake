@@ -32,8 +32,10 @@ set(PUBLIC_CORE_INTERFACE_FILES
 )
 
 set(PUBLIC_EVENT_HEADERS
+    src/event/DataChangedRegion.h
     src/event/Event.h
     src/event/EventListener.h
+    src/event/SelectionDelta.h
 )
 
 set(PUBLIC_EVENT_SOURCES
@@ -542,6 +544,9 @@ set(PUBLIC_UTIL_HEADERS
     src/util/Timer.h
     src/util/Icon.h
     src/util/Interpolation.h
+    src/util/IndexSet.h
+    src/util/EncodedBlockRegistry.h
+    src/util/SelectionUpdateScheduler.h
     src/util/ColorMap.h
     src/util/ColorMapFilterModel.h
     src/util/ColorMapModel.h
@@ -586,6 +591,7 @@ set(PUBLIC_UTIL_HEADERS
     src/util/BlobCodec.h
     src/util/BlobCodecFactory.h
     src/util/CodecRegistry.h
+    src/util/ArchiveEntryWriter.h
     src/util/CodecActionBinding.h
     src/util/SeverityLevel.h
     src/util/StackFrame.h
@@ -612,6 +618,9 @@ set(PUBLIC_UTIL_SOURCES
     src/util/Timer.cpp
     src/util/Icon.cpp
     src/util/Interpolation.cpp
+    src/util/IndexSet.cpp
+    src/util/EncodedBlockRegistry.cpp
+    src/util/SelectionUpdateScheduler.cpp
     src/util/ColorMap.cpp
     src/util/ColorMapFilterModel.cpp
     src/util/ColorMapModel.cpp
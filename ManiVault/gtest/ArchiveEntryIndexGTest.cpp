@@ -0,0 +1,265 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <private/ArchiveEntryIndex.h>
+
+#include <private/ArchiveStreamWriter.h>
+#include <private/Archiver.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+using mv::util::ArchiveEntryIndex;
+using mv::util::ArchiveStreamWriter;
+using mv::util::Archiver;
+
+namespace
+{
+    /** Random bytes, so that entries can not be confused */
+    QByteArray generateBytes(qsizetype numberOfBytes, std::mt19937& randomNumberEngine)
+    {
+        QByteArray bytes(numberOfBytes, 0);
+
+        for (auto& byte : bytes)
+            byte = static_cast<char>(randomNumberEngine());
+
+        return bytes;
+    }
+
+    /** Archive with stored entries (like encoded data blocks) and a deflated file (like the project json) */
+    class TestArchive
+    {
+    public:
+        TestArchive(std::int32_t numberOfEntries, std::mt19937& randomNumberEngine)
+        {
+            EXPECT_TRUE(_temporaryDir.isValid());
+
+            for (std::int32_t entryIndex = 0; entryIndex < numberOfEntries; ++entryIndex)
+                _entries.push_back(generateBytes(randomNumberEngine() % 100000, randomNumberEngine));
+
+            QDir().mkpath(getDirectoryPath());
+
+            QFile file(QDir(getDirectoryPath()).filePath("project.json"));
+
+            EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+
+            file.write(QByteArray(10000, '{'));
+            file.close();
+
+            ArchiveStreamWriter archiveStreamWriter(getFilePath());
+
+            archiveStreamWriter.open();
+
+            for (std::int32_t entryIndex = 0; entryIndex < numberOfEntries; ++entryIndex)
+                archiveStreamWriter.writeEntry(getEntryName(entryIndex), _entries[entryIndex]);
+
+            archiveStreamWriter.writeDirectory(getDirectoryPath(), 6);
+            archiveStreamWriter.close();
+        }
+
+        QString getFilePath() const
+        {
+            return _temporaryDir.filePath("Project.mv");
+        }
+
+        QString getDirectoryPath() const
+        {
+            return _temporaryDir.filePath("Save");
+        }
+
+        static QString getEntryName(std::int32_t entryIndex)
+        {
+            return QString("Block%1.bin").arg(entryIndex);
+        }
+
+        const std::vector<QByteArray>& getEntries() const
+        {
+            return _entries;
+        }
+
+    private:
+        QTemporaryDir               _temporaryDir;
+        std::vector<QByteArray>     _entries;
+    };
+}
+
+
+TEST(ArchiveEntryIndex, ReadsStoredEntries)
+{
+    std::mt19937 randomNumberEngine(1);
+
+    const TestArchive testArchive(20, randomNumberEngine);
+    const ArchiveEntryIndex archiveEntryIndex(testArchive.getFilePath());
+
+    for (std::int32_t entryIndex = 0; entryIndex < 20; ++entryIndex) {
+        const auto& entryData   = testArchive.getEntries()[entryIndex];
+        const auto entry        = archiveEntryIndex.findEntry(TestArchive::getEntryName(entryIndex));
+
+        ASSERT_NE(entry, nullptr);
+        EXPECT_TRUE(entry->isStored());
+        EXPECT_EQ(entry->_uncompressedSize, static_cast<std::uint64_t>(entryData.size()));
+
+        EXPECT_EQ(archiveEntryIndex.readStoredEntry(TestArchive::getEntryName(entryIndex)), entryData);
+
+        QByteArray destination(entryData.size(), 0);
+
+        archiveEntryIndex.readStoredEntryTo(TestArchive::getEntryName(entryIndex), destination.data(), static_cast<std::uint64_t>(destination.size()));
+
+        EXPECT_EQ(destination, entryData);
+    }
+
+    EXPECT_EQ(archiveEntryIndex.findEntry("Missing.bin"), nullptr);
+}
+
+
+TEST(ArchiveEntryIndex, ReadsEntriesConcurrently)
+{
+    std::mt19937 randomNumberEngine(2);
+
+    const TestArchive testArchive(32, randomNumberEngine);
+    const auto archiveEntryIndex = ArchiveEntryIndex::get(testArchive.getFilePath());
+
+    std::vector<std::thread> readers;
+    std::vector<std::int32_t> numberOfMismatches(4, 0);
+
+    for (std::int32_t readerIndex = 0; readerIndex < 4; ++readerIndex) {
+        readers.emplace_back([&, readerIndex]() -> void {
+            for (std::int32_t entryIndex = readerIndex; entryIndex < 32; entryIndex += 4)
+                if (archiveEntryIndex->readStoredEntry(TestArchive::getEntryName(entryIndex)) != testArchive.getEntries()[entryIndex])
+                    ++numberOfMismatches[readerIndex];
+        });
+    }
+
+    for (auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(numberOfMismatches, std::vector<std::int32_t>(4, 0));
+}
+
+
+TEST(ArchiveEntryIndex, StoredEntriesAreAligned)
+{
+    std::mt19937 randomNumberEngine(5);
+
+    const TestArchive testArchive(20, randomNumberEngine);
+    const ArchiveEntryIndex archiveEntryIndex(testArchive.getFilePath());
+
+    QFile file(testArchive.getFilePath());
+
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+
+    for (std::int32_t entryIndex = 0; entryIndex < 20; ++entryIndex) {
+        const auto entry = archiveEntryIndex.findEntry(TestArchive::getEntryName(entryIndex));
+
+        ASSERT_NE(entry, nullptr);
+        ASSERT_TRUE(file.seek(static_cast<qint64>(entry->_localHeaderOffset)));
+
+        // Name and extra field lengths in the local file header
+        const auto localHeader  = file.read(30);
+        const auto dataOffset   = entry->_localHeaderOffset + 30 + qFromLittleEndian<quint16>(localHeader.constData() + 26) + qFromLittleEndian<quint16>(localHeader.constData() + 28);
+
+        EXPECT_EQ(dataOffset % ArchiveEntryIndex::storedDataAlignment, 0u);
+    }
+}
+
+
+TEST(ArchiveEntryIndex, DoesNotKeepTheArchiveOpen)
+{
+    std::mt19937 randomNumberEngine(6);
+
+    const TestArchive testArchive(2, randomNumberEngine);
+    const auto archiveEntryIndex = ArchiveEntryIndex::get(testArchive.getFilePath());
+
+    EXPECT_EQ(archiveEntryIndex->readStoredEntry(TestArchive::getEntryName(0)), testArchive.getEntries()[0]);
+
+    // Removing (or replacing) an open file fails on Windows
+    EXPECT_TRUE(QFile::remove(testArchive.getFilePath()));
+    EXPECT_FALSE(archiveEntryIndex->isUpToDate());
+}
+
+
+TEST(ArchiveEntryIndex, RejectsInvalidReads)
+{
+    std::mt19937 randomNumberEngine(3);
+
+    const TestArchive testArchive(2, randomNumberEngine);
+    const ArchiveEntryIndex archiveEntryIndex(testArchive.getFilePath());
+
+    // Compressed entries can not be read at their offset, the archiver decompresses those
+    const auto projectEntry = archiveEntryIndex.findEntry("project.json");
+
+    ASSERT_NE(projectEntry, nullptr);
+    EXPECT_FALSE(projectEntry->isStored());
+    EXPECT_THROW((void)archiveEntryIndex.readStoredEntry("project.json"), std::runtime_error);
+    EXPECT_EQ(Archiver::readZipEntryToMemory(testArchive.getFilePath(), "project.json"), QByteArray(10000, '{'));
+
+    EXPECT_THROW((void)archiveEntryIndex.readStoredEntry("Missing.bin"), std::runtime_error);
+
+    QByteArray destination(testArchive.getEntries()[0].size() + 1, 0);
+
+    EXPECT_THROW(archiveEntryIndex.readStoredEntryTo(TestArchive::getEntryName(0), destination.data(), static_cast<std::uint64_t>(destination.size())), std::runtime_error);
+}
+
+
+TEST(ArchiveEntryIndex, RejectsFilesWhichAreNotArchives)
+{
+    const QTemporaryDir temporaryDir;
+
+    ASSERT_TRUE(temporaryDir.isValid());
+
+    const auto filePath = temporaryDir.filePath("Project.mv");
+
+    QFile file(filePath);
+
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+
+    file.write(QByteArray(1000, 'a'));
+    file.close();
+
+    EXPECT_THROW(ArchiveEntryIndex{ filePath }, std::runtime_error);
+    EXPECT_THROW(ArchiveEntryIndex{ temporaryDir.filePath("Missing.mv") }, std::runtime_error);
+}
+
+
+TEST(ArchiveEntryIndex, CachedIndexFollowsTheArchiveOnDisk)
+{
+    std::mt19937 randomNumberEngine(4);
+
+    const TestArchive testArchive(3, randomNumberEngine);
+
+    const auto archiveEntryIndex = ArchiveEntryIndex::get(testArchive.getFilePath());
+
+    EXPECT_TRUE(archiveEntryIndex->isUpToDate());
+    EXPECT_EQ(ArchiveEntryIndex::get(testArchive.getFilePath()), archiveEntryIndex);
+
+    // Rewrite the archive with other entries
+    const auto data = generateBytes(12345, randomNumberEngine);
+
+    {
+        ArchiveStreamWriter archiveStreamWriter(testArchive.getFilePath());
+
+        archiveStreamWriter.open();
+        archiveStreamWriter.writeEntry("Other.bin", data);
+        archiveStreamWriter.close();
+    }
+
+    EXPECT_FALSE(archiveEntryIndex->isUpToDate());
+
+    const auto rebuiltArchiveEntryIndex = ArchiveEntryIndex::get(testArchive.getFilePath());
+
+    EXPECT_NE(rebuiltArchiveEntryIndex, archiveEntryIndex);
+    EXPECT_EQ(rebuiltArchiveEntryIndex->findEntry(TestArchive::getEntryName(0)), nullptr);
+    EXPECT_EQ(rebuiltArchiveEntryIndex->readStoredEntry("Other.bin"), data);
+}
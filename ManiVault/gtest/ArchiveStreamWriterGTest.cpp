@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <private/ArchiveStreamWriter.h>
+
+#include <private/Archiver.h>
+
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+using mv::util::ArchiveStreamWriter;
+
+namespace
+{
+    /** Random bytes, so that entries can not be confused */
+    QByteArray generateBytes(qsizetype numberOfBytes, std::mt19937& randomNumberEngine)
+    {
+        QByteArray bytes(numberOfBytes, 0);
+
+        for (auto& byte : bytes)
+            byte = static_cast<char>(randomNumberEngine());
+
+        return bytes;
+    }
+
+    /** Write \p data as the single entry \p entryName of a complete archive at \p filePath */
+    void writeArchive(const QString& filePath, const QString& entryName, const QByteArray& data)
+    {
+        ArchiveStreamWriter archiveStreamWriter(filePath);
+
+        archiveStreamWriter.open();
+        archiveStreamWriter.writeEntry(entryName, data);
+        archiveStreamWriter.close();
+    }
+}
+
+
+TEST(ArchiveStreamWriter, ClosingMovesThePartialArchiveIntoPlace)
+{
+    const QTemporaryDir temporaryDir;
+
+    ASSERT_TRUE(temporaryDir.isValid());
+
+    std::mt19937 randomNumberEngine(1);
+
+    const auto filePath = temporaryDir.filePath("Project.mv");
+    const auto data     = generateBytes(100003, randomNumberEngine);
+
+    ArchiveStreamWriter archiveStreamWriter(filePath);
+
+    archiveStreamWriter.open();
+    archiveStreamWriter.writeEntry("Block.bin", data);
+
+    // Nothing is written to the destination while the archive is incomplete
+    EXPECT_FALSE(QFileInfo::exists(filePath));
+    EXPECT_TRUE(QFileInfo::exists(filePath + ".partial"));
+
+    archiveStreamWriter.close();
+
+    EXPECT_TRUE(QFileInfo::exists(filePath));
+    EXPECT_FALSE(QFileInfo::exists(filePath + ".partial"));
+    EXPECT_EQ(archiveStreamWriter.getEntryNames(), QStringList({ "Block.bin" }));
+    EXPECT_EQ(mv::util::Archiver::readZipEntryToMemory(filePath, "Block.bin"), data);
+}
+
+
+TEST(ArchiveStreamWriter, ClosingReplacesAnExistingArchive)
+{
+    const QTemporaryDir temporaryDir;
+
+    ASSERT_TRUE(temporaryDir.isValid());
+
+    std::mt19937 randomNumberEngine(2);
+
+    const auto filePath = temporaryDir.filePath("Project.mv");
+
+    writeArchive(filePath, "Block.bin", generateBytes(1000, randomNumberEngine));
+
+    // Read the existing archive, so that its entry index is cached
+    EXPECT_EQ(mv::util::Archiver::readZipEntryToMemory(filePath, "Block.bin").size(), 1000);
+
+    const auto data = generateBytes(2000, randomNumberEngine);
+
+    writeArchive(filePath, "Block.bin", data);
+
+    EXPECT_EQ(mv::util::Archiver::readZipEntryToMemory(filePath, "Block.bin"), data);
+}
+
+
+TEST(ArchiveStreamWriter, AbortingDiscardsThePartialArchive)
+{
+    const QTemporaryDir temporaryDir;
+
+    ASSERT_TRUE(temporaryDir.isValid());
+
+    std::mt19937 randomNumberEngine(3);
+
+    const auto filePath = temporaryDir.filePath("Project.mv");
+    const auto data     = generateBytes(1000, randomNumberEngine);
+
+    writeArchive(filePath, "Block.bin", data);
+
+    ArchiveStreamWriter archiveStreamWriter(filePath);
+
+    archiveStreamWriter.open();
+    archiveStreamWriter.writeEntry("Block.bin", generateBytes(1000, randomNumberEngine));
+    archiveStreamWriter.abort();
+
+    // The existing archive is left untouched
+    EXPECT_FALSE(QFileInfo::exists(filePath + ".partial"));
+    EXPECT_EQ(mv::util::Archiver::readZipEntryToMemory(filePath, "Block.bin"), data);
+
+    // As does a writer which is destroyed without being closed (when the save fails)
+    {
+        ArchiveStreamWriter failedArchiveStreamWriter(filePath);
+
+        failedArchiveStreamWriter.open();
+        failedArchiveStreamWriter.writeEntry("Other.bin", data);
+
+        EXPECT_TRUE(QFileInfo::exists(filePath + ".partial"));
+    }
+
+    EXPECT_FALSE(QFileInfo::exists(filePath + ".partial"));
+    EXPECT_EQ(mv::util::Archiver::readZipEntryToMemory(filePath, "Block.bin"), data);
+}
+
+
+TEST(ArchiveStreamWriter, WritesEntriesConcurrently)
+{
+    const QTemporaryDir temporaryDir;
+
+    ASSERT_TRUE(temporaryDir.isValid());
+
+    constexpr std::int32_t numberOfEntries = 64;
+
+    const auto filePath = temporaryDir.filePath("Project.mv");
+
+    std::vector<QByteArray> entries;
+
+    std::mt19937 randomNumberEngine(4);
+
+    for (std::int32_t entryIndex = 0; entryIndex < numberOfEntries; ++entryIndex)
+        entries.push_back(generateBytes(1 + randomNumberEngine() % 70000, randomNumberEngine));
+
+    ArchiveStreamWriter archiveStreamWriter(filePath);
+
+    archiveStreamWriter.open();
+
+    std::vector<std::thread> workers;
+
+    for (std::int32_t workerIndex = 0; workerIndex < 4; ++workerIndex) {
+        workers.emplace_back([&archiveStreamWriter, &entries, workerIndex]() -> void {
+            for (std::int32_t entryIndex = workerIndex; entryIndex < numberOfEntries; entryIndex += 4)
+                archiveStreamWriter.writeEntry(QString("Block%1.bin").arg(entryIndex), entries[entryIndex]);
+        });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    archiveStreamWriter.close();
+
+    EXPECT_EQ(archiveStreamWriter.getEntryNames().size(), numberOfEntries);
+
+    for (std::int32_t entryIndex = 0; entryIndex < numberOfEntries; ++entryIndex)
+        EXPECT_EQ(mv::util::Archiver::readZipEntryToMemory(filePath, QString("Block%1.bin").arg(entryIndex)), entries[entryIndex]);
+}
+
+
+TEST(ArchiveStreamWriter, RejectsWritesWhenNotOpen)
+{
+    const QTemporaryDir temporaryDir;
+
+    ASSERT_TRUE(temporaryDir.isValid());
+
+    ArchiveStreamWriter archiveStreamWriter(temporaryDir.filePath("Project.mv"));
+
+    EXPECT_THROW(archiveStreamWriter.writeEntry("Block.bin", QByteArray(10, 'a')), std::runtime_error);
+
+    archiveStreamWriter.open();
+
+    EXPECT_THROW(archiveStreamWriter.open(), std::runtime_error);
+
+    archiveStreamWriter.close();
+
+    EXPECT_THROW(archiveStreamWriter.writeEntry("Block.bin", QByteArray(10, 'a')), std::runtime_error);
+}
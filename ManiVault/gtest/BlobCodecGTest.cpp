@@ -0,0 +1,346 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The files to be tested:
+#include <private/DeltaVarintBlobCodec.h>
+#include <private/DeltaVarintCodecSettingsAction.h>
+#include <private/Lz4BlobCodec.h>
+#include <private/Lz4BlobCodecFactory.h>
+#include <private/Lz4CodecSettingsAction.h>
+#include <private/ShuffleBlobCodec.h>
+#include <private/ShuffleCodecSettingsAction.h>
+#include <private/ZstdBlobCodec.h>
+#include <private/ZstdBlobCodecFactory.h>
+#include <private/ZstdCodecSettingsAction.h>
+
+#include <Application.h>
+
+#include <QThread>
+
+#include <exception/ManiVaultException.h>
+
+#include <util/CodecRegistry.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace mv::util;
+
+namespace
+{
+    /** The shuffle codec creates its compressor through the codec registry of the application */
+    void ensureApplication()
+    {
+        static int argc = 1;
+        static char applicationName[] = "CodecGTest";
+        static char* argv[] = { applicationName, nullptr };
+
+        if (mv::Application::current())
+            return;
+
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+        static mv::Application application(argc, argv);
+
+        codecRegistry().registerFactory(std::make_unique<ZstdBlobCodecFactory>(&application));
+        codecRegistry().registerFactory(std::make_unique<Lz4BlobCodecFactory>(&application));
+    }
+
+    /** Sizes around the boundaries of the codec blocks (groups of four values, planes of eight elements) */
+    std::vector<qsizetype> getTestSizes(qsizetype granularity)
+    {
+        std::vector<qsizetype> sizes;
+
+        for (qsizetype size = granularity; size <= 40 * granularity; size += granularity)
+            sizes.push_back(size);
+
+        sizes.push_back(granularity * 100003);
+
+        return sizes;
+    }
+
+    /** Smooth floating point values (which shuffle well) with some noise */
+    QByteArray generateFloats(qsizetype numberOfBytes, std::mt19937& randomNumberEngine)
+    {
+        QByteArray bytes(numberOfBytes, 0);
+
+        std::uniform_real_distribution<float> noise(-0.01f, 0.01f);
+
+        const auto numberOfValues = static_cast<std::size_t>(numberOfBytes) / sizeof(float);
+
+        for (std::size_t valueIndex = 0; valueIndex < numberOfValues; ++valueIndex) {
+            const auto value = std::sin(static_cast<float>(valueIndex) * 0.01f) + noise(randomNumberEngine);
+
+            std::memcpy(bytes.data() + valueIndex * sizeof(float), &value, sizeof(float));
+        }
+
+        // Trailing bytes which do not form a whole element
+        for (auto byteIndex = static_cast<qsizetype>(numberOfValues * sizeof(float)); byteIndex < numberOfBytes; ++byteIndex)
+            bytes[byteIndex] = static_cast<char>(randomNumberEngine());
+
+        return bytes;
+    }
+
+    /** Encode \p input with \p codec and check that decoding (also directly to a buffer) restores it */
+    void expectRoundTrip(const BlobCodec& codec, const QByteArray& input)
+    {
+        const auto encoded = codec.encode(input);
+
+        EXPECT_EQ(codec.decode(encoded, input.size()), input);
+        EXPECT_EQ(codec.decode(encoded), input);
+
+        QByteArray decoded(input.size(), 0);
+
+        codec.decodeTo(encoded, decoded.data(), static_cast<std::uint64_t>(decoded.size()));
+
+        EXPECT_EQ(decoded, input);
+    }
+}
+
+
+TEST(ShuffleBlobCodec, RoundTripsAllModesAndElementSizes)
+{
+    ensureApplication();
+
+    std::mt19937 randomNumberEngine(1);
+
+    for (const auto mode : { 0, 1 }) {
+        for (const auto compressor : { 0, 1 }) {
+            ShuffleCodecSettingsAction settingsAction(nullptr, "Shuffle");
+
+            settingsAction.getModeAction().setCurrentIndex(mode);
+            settingsAction.getCompressorAction().setCurrentIndex(compressor);
+
+            for (const auto elementSize : { 1u, 2u, 4u, 8u }) {
+                ShuffleBlobCodec codec(nullptr, &settingsAction);
+
+                codec.setElementSize(elementSize);
+
+                // Sizes which are not a multiple of the element size leave a tail which is not shuffled
+                for (const auto size : getTestSizes(1))
+                    if (size < 64 || size % 7 == 0)
+                        expectRoundTrip(codec, generateFloats(size, randomNumberEngine));
+
+                // Around the groups of sixteen elements (and eight byte groups of the bit planes) which are transposed at once
+                for (qsizetype numberOfElements = 120; numberOfElements <= 136; ++numberOfElements)
+                    expectRoundTrip(codec, generateFloats(numberOfElements * elementSize + 1, randomNumberEngine));
+
+                expectRoundTrip(codec, generateFloats(4 * 100003 + 3, randomNumberEngine));
+            }
+        }
+    }
+}
+
+
+TEST(ShuffleBlobCodec, ShufflingHelpsSmoothFloats)
+{
+    ensureApplication();
+
+    std::mt19937 randomNumberEngine(2);
+
+    const auto input = generateFloats(4 * 100000, randomNumberEngine);
+
+    ShuffleCodecSettingsAction settingsAction(nullptr, "Shuffle");
+
+    ShuffleBlobCodec elementCodec(nullptr, &settingsAction);
+    ShuffleBlobCodec byteCodec(nullptr, &settingsAction);
+
+    elementCodec.setElementSize(4);
+    byteCodec.setElementSize(1);
+
+    // With single byte elements shuffling does nothing, so the compressor sees the raw floats
+    EXPECT_LT(elementCodec.encode(input).size(), byteCodec.encode(input).size());
+}
+
+
+TEST(ShuffleBlobCodec, ElementSizeIsTakenFromTheCodec)
+{
+    ensureApplication();
+
+    std::mt19937 randomNumberEngine(6);
+
+    const auto input = generateFloats(4 * 1000, randomNumberEngine);
+
+    ShuffleCodecSettingsAction settingsAction(nullptr, "Shuffle");
+
+    ShuffleBlobCodec encoder(nullptr, &settingsAction);
+    ShuffleBlobCodec decoder(nullptr, &settingsAction);
+
+    encoder.setElementSize(4);
+
+    const auto encoded = encoder.encode(input);
+
+    // The element size is stored in the blob map, not in the encoded data, so it has to be set on the decoder
+    decoder.setElementSize(4);
+
+    EXPECT_EQ(decoder.decode(encoded, input.size()), input);
+
+    decoder.setElementSize(2);
+
+    EXPECT_NE(decoder.decode(encoded, input.size()), input);
+}
+
+
+TEST(Lz4BlobCodec, RoundTripsFastAndHighCompression)
+{
+    ensureApplication();
+
+    std::mt19937 randomNumberEngine(3);
+
+    for (const auto highCompression : { false, true }) {
+        Lz4CodecSettingsAction settingsAction(nullptr, "LZ4");
+
+        settingsAction.getHighCompressionAction().setChecked(highCompression);
+
+        Lz4BlobCodec codec(nullptr, &settingsAction);
+
+        for (const auto size : getTestSizes(1))
+            if (size < 64 || size % 13 == 0)
+                expectRoundTrip(codec, generateFloats(size, randomNumberEngine));
+
+        // Incompressible data
+        QByteArray randomBytes(100003, 0);
+
+        for (auto& byte : randomBytes)
+            byte = static_cast<char>(randomNumberEngine());
+
+        expectRoundTrip(codec, randomBytes);
+    }
+}
+
+
+TEST(ZstdBlobCodec, WorkerThreadsDoNotExceedTheNumberOfCores)
+{
+    ensureApplication();
+
+    ZstdCodecSettingsAction settingsAction(nullptr, "Zstd");
+
+    settingsAction.getMultithreadedAction().setChecked(true);
+    settingsAction.getMaximumNumberOfWorkersAction().setValue(256);
+
+    ZstdBlobCodec codec(nullptr, &settingsAction);
+
+    // Encode blocks of several blobs at once, each blob claiming it is the only one being encoded
+    codec.setNumberOfConcurrentBlocks(1);
+
+    std::mt19937 randomNumberEngine(5);
+
+    const auto input            = generateFloats(4 * 1024 * 1024, randomNumberEngine);
+    const auto numberOfCores    = std::max(QThread::idealThreadCount(), 1);
+
+    std::atomic_bool isDone = false;
+    std::atomic_int32_t maximumNumberOfReservedWorkers = 0;
+
+    std::thread observer([&]() -> void {
+        while (!isDone)
+            maximumNumberOfReservedWorkers = std::max(maximumNumberOfReservedWorkers.load(), ZstdBlobCodec::getNumberOfReservedWorkers());
+    });
+
+    std::vector<std::thread> encoders;
+
+    for (std::int32_t encoderIndex = 0; encoderIndex < 2 * numberOfCores; ++encoderIndex)
+        encoders.emplace_back([&codec, &input]() -> void {
+            EXPECT_EQ(codec.decode(codec.encode(input), input.size()), input);
+        });
+
+    for (auto& encoder : encoders)
+        encoder.join();
+
+    isDone = true;
+
+    observer.join();
+
+    // Every block that is encoded occupies a core, the workers are handed out for the remaining ones
+    EXPECT_LE(maximumNumberOfReservedWorkers.load(), numberOfCores - 1);
+    EXPECT_EQ(ZstdBlobCodec::getNumberOfReservedWorkers(), 0);
+
+    // The cached context of this thread does not keep the workers of a previous block
+    settingsAction.getMultithreadedAction().setChecked(false);
+
+    expectRoundTrip(codec, input);
+
+    EXPECT_EQ(ZstdBlobCodec::getNumberOfReservedWorkers(), 0);
+}
+
+
+TEST(DeltaVarintBlobCodec, RoundTripsIndices)
+{
+    ensureApplication();
+
+    std::mt19937 randomNumberEngine(4);
+
+    DeltaVarintCodecSettingsAction settingsAction(nullptr, "Delta varint");
+
+    DeltaVarintBlobCodec codec(nullptr, &settingsAction);
+
+    const auto toBytes = [](const std::vector<std::uint32_t>& indices) -> QByteArray {
+        return QByteArray(reinterpret_cast<const char*>(indices.data()), static_cast<qsizetype>(indices.size() * sizeof(std::uint32_t)));
+    };
+
+    // Ascending indices with gaps of one to three bytes, including a partial last control byte
+    for (const auto numberOfIndices : { 1, 2, 3, 4, 5, 7, 8, 9, 1000, 100003 }) {
+        std::vector<std::uint32_t> indices(numberOfIndices);
+
+        std::uint32_t index = 0;
+
+        for (auto& sortedIndex : indices) {
+            index += randomNumberEngine() % (1u << (8 * (randomNumberEngine() % 3)));
+            sortedIndex = index;
+        }
+
+        expectRoundTrip(codec, toBytes(indices));
+    }
+
+    // Unsorted indices (negative deltas) and the extremes
+    expectRoundTrip(codec, toBytes({ 0xFFFFFFFFu, 0, 0x80000000u, 1, 0xFFFFFFFFu, 0xFFFFFFFEu }));
+
+    // Sorted indices take about a byte each
+    std::vector<std::uint32_t> consecutiveIndices(100000);
+
+    for (std::uint32_t index = 0; index < consecutiveIndices.size(); ++index)
+        consecutiveIndices[index] = 1000000 + 3 * index;
+
+    EXPECT_LT(codec.encode(toBytes(consecutiveIndices)).size(), static_cast<qsizetype>(consecutiveIndices.size() * 2));
+}
+
+
+TEST(BlobCodec, RejectsInvalidInput)
+{
+    ensureApplication();
+
+    ShuffleCodecSettingsAction shuffleSettingsAction(nullptr, "Shuffle");
+    Lz4CodecSettingsAction lz4SettingsAction(nullptr, "LZ4");
+    DeltaVarintCodecSettingsAction deltaVarintSettingsAction(nullptr, "Delta varint");
+
+    const ShuffleBlobCodec shuffleCodec(nullptr, &shuffleSettingsAction);
+    const Lz4BlobCodec lz4Codec(nullptr, &lz4SettingsAction);
+    const DeltaVarintBlobCodec deltaVarintCodec(nullptr, &deltaVarintSettingsAction);
+
+    // Empty blobs are not encoded (the serialization writes no blocks for them)
+    EXPECT_THROW((void)shuffleCodec.encode(QByteArray()), mv::ManiVaultException);
+    EXPECT_THROW((void)lz4Codec.encode(QByteArray()), mv::ManiVaultException);
+    EXPECT_THROW((void)deltaVarintCodec.encode(QByteArray()), mv::ManiVaultException);
+
+    // Indices are four bytes each
+    EXPECT_THROW((void)deltaVarintCodec.encode(QByteArray(6, 0)), mv::ManiVaultException);
+
+    // Truncated data and unexpected sizes
+    const QByteArray input(1000, 'a');
+
+    for (const BlobCodec* codec : std::initializer_list<const BlobCodec*>{ &shuffleCodec, &lz4Codec, &deltaVarintCodec }) {
+        const auto encoded = codec->encode(input);
+
+        EXPECT_THROW((void)codec->decode(encoded, input.size() + 1), mv::ManiVaultException);
+        EXPECT_THROW((void)codec->decode(encoded.left(4)), mv::ManiVaultException);
+    }
+}
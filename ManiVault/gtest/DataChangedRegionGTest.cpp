@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <event/DataChangedRegion.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using mv::DataChangedRegion;
+
+
+TEST(DataChangedRegion, CoversAllDataByDefault)
+{
+    const DataChangedRegion region;
+
+    EXPECT_TRUE(region.isComplete());
+    EXPECT_TRUE(region.coversAllPoints());
+    EXPECT_TRUE(region.coversAllDimensions());
+    EXPECT_FALSE(region.hasPointRange());
+    EXPECT_FALSE(region.hasPointIndices());
+    EXPECT_TRUE(region.getPointIndices().empty());
+    EXPECT_TRUE(region.containsDimension(0));
+    EXPECT_TRUE(region.containsDimension(1000));
+}
+
+
+TEST(DataChangedRegion, DescribesAPointRange)
+{
+    const DataChangedRegion region(10, 20, { 1, 3 });
+
+    EXPECT_FALSE(region.isComplete());
+    EXPECT_FALSE(region.coversAllPoints());
+    EXPECT_TRUE(region.hasPointRange());
+    EXPECT_FALSE(region.hasPointIndices());
+    EXPECT_EQ(region.getPointBegin(), 10u);
+    EXPECT_EQ(region.getPointEnd(), 20u);
+    EXPECT_TRUE(region.getPointIndices().empty());
+
+    EXPECT_FALSE(region.coversAllDimensions());
+    EXPECT_EQ(region.getDimensionIndices(), std::vector<std::uint32_t>({ 1, 3 }));
+    EXPECT_FALSE(region.containsDimension(0));
+    EXPECT_TRUE(region.containsDimension(1));
+    EXPECT_FALSE(region.containsDimension(2));
+    EXPECT_TRUE(region.containsDimension(3));
+
+    // All dimensions of the range
+    const DataChangedRegion allDimensionsRegion(0, 5);
+
+    EXPECT_TRUE(allDimensionsRegion.coversAllDimensions());
+    EXPECT_TRUE(allDimensionsRegion.containsDimension(7));
+    EXPECT_FALSE(allDimensionsRegion.isComplete());
+
+    // A reversed range is empty
+    const DataChangedRegion reversedRegion(8, 4);
+
+    EXPECT_EQ(reversedRegion.getPointBegin(), 8u);
+    EXPECT_EQ(reversedRegion.getPointEnd(), 8u);
+}
+
+
+TEST(DataChangedRegion, DescribesPointIndices)
+{
+    const DataChangedRegion region(std::vector<std::uint32_t>({ 7, 2, 9, 4 }), { 0 });
+
+    EXPECT_FALSE(region.isComplete());
+    EXPECT_FALSE(region.coversAllPoints());
+    EXPECT_FALSE(region.hasPointRange());
+    EXPECT_TRUE(region.hasPointIndices());
+    EXPECT_EQ(region.getPointIndices(), std::vector<std::uint32_t>({ 7, 2, 9, 4 }));
+
+    // The bounds of the indices
+    EXPECT_EQ(region.getPointBegin(), 2u);
+    EXPECT_EQ(region.getPointEnd(), 10u);
+
+    EXPECT_TRUE(region.containsDimension(0));
+    EXPECT_FALSE(region.containsDimension(1));
+
+    // No points changed
+    const DataChangedRegion emptyRegion(std::vector<std::uint32_t>{});
+
+    EXPECT_TRUE(emptyRegion.hasPointIndices());
+    EXPECT_EQ(emptyRegion.getPointBegin(), 0u);
+    EXPECT_EQ(emptyRegion.getPointEnd(), 0u);
+    EXPECT_TRUE(emptyRegion.coversAllDimensions());
+}
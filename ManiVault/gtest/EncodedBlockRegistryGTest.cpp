@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <util/EncodedBlockRegistry.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using mv::util::EncodedBlockRegistry;
+
+namespace
+{
+    using EncodedBlock = EncodedBlockRegistry::EncodedBlock;
+
+    /** Content key of block \p blockIndex encoded with \p codecSignature */
+    QString getKey(const QString& codecSignature, std::int32_t blockIndex)
+    {
+        return codecSignature + QString("%1").arg(blockIndex, 32, 16, QChar('0'));
+    }
+}
+
+
+TEST(EncodedBlockRegistry, FindsRegisteredBlocksByContent)
+{
+    EncodedBlockRegistry encodedBlockRegistry;
+
+    EXPECT_FALSE(encodedBlockRegistry.find(getKey("zstd:4:", 0)).has_value());
+
+    encodedBlockRegistry.add(getKey("zstd:4:", 0), { "Block0.bin.zst", 100, "A.mv" });
+
+    EXPECT_EQ(encodedBlockRegistry.find(getKey("zstd:4:", 0)), EncodedBlock({ "Block0.bin.zst", 100, "A.mv" }));
+
+    // The same content encoded with other codec settings is another block
+    EXPECT_FALSE(encodedBlockRegistry.find(getKey("zstd:1:", 0)).has_value());
+    EXPECT_FALSE(encodedBlockRegistry.find(getKey("lz4:4:", 0)).has_value());
+
+    // Copying a block into a new archive registers it there
+    encodedBlockRegistry.add(getKey("zstd:4:", 0), { "Block0.bin.zst", 100, "B.mv" });
+
+    EXPECT_EQ(encodedBlockRegistry.find(getKey("zstd:4:", 0))->_archiveFilePath, "B.mv");
+    EXPECT_EQ(encodedBlockRegistry.getNumberOfBlocks(), 1);
+}
+
+
+TEST(EncodedBlockRegistry, BlocksAreScopedToTheSavedArchive)
+{
+    EncodedBlockRegistry encodedBlockRegistry;
+
+    // Blocks loaded from project A
+    for (std::int32_t blockIndex = 0; blockIndex < 10; ++blockIndex)
+        encodedBlockRegistry.add(getKey("zstd:4:", blockIndex), { QString("Block%1.bin.zst").arg(blockIndex), 100, "A.mv" });
+
+    // Saving as project B copies the unmodified blocks and encodes the modified ones
+    for (std::int32_t blockIndex = 0; blockIndex < 5; ++blockIndex)
+        encodedBlockRegistry.add(getKey("zstd:4:", blockIndex), { QString("Block%1.bin.zst").arg(blockIndex), 100, "B.mv" });
+
+    encodedBlockRegistry.add(getKey("zstd:4:", 10), { "Block10.bin.zst", 100, "B.mv" });
+
+    // Once saved, only blocks in B can be copied into the next archive
+    encodedBlockRegistry.release("B.mv");
+
+    EXPECT_EQ(encodedBlockRegistry.getNumberOfBlocks(), 6);
+
+    for (std::int32_t blockIndex = 0; blockIndex <= 10; ++blockIndex) {
+        const auto encodedBlock = encodedBlockRegistry.find(getKey("zstd:4:", blockIndex));
+
+        if (blockIndex < 5 || blockIndex == 10) {
+            ASSERT_TRUE(encodedBlock.has_value());
+            EXPECT_EQ(encodedBlock->_archiveFilePath, "B.mv");
+        }
+        else {
+            EXPECT_FALSE(encodedBlock.has_value());
+        }
+    }
+
+    // Creating, opening or closing a project forgets all blocks
+    encodedBlockRegistry.release();
+
+    EXPECT_EQ(encodedBlockRegistry.getNumberOfBlocks(), 0);
+    EXPECT_FALSE(encodedBlockRegistry.find(getKey("zstd:4:", 0)).has_value());
+}
+
+
+TEST(EncodedBlockRegistry, RegistersBlocksConcurrently)
+{
+    EncodedBlockRegistry encodedBlockRegistry;
+
+    std::vector<std::thread> encoders;
+
+    for (std::int32_t encoderIndex = 0; encoderIndex < 4; ++encoderIndex) {
+        encoders.emplace_back([&encodedBlockRegistry, encoderIndex]() -> void {
+            for (std::int32_t blockIndex = encoderIndex; blockIndex < 4000; blockIndex += 4) {
+                encodedBlockRegistry.add(getKey("zstd:4:", blockIndex), { QString("Block%1.bin.zst").arg(blockIndex), static_cast<std::uint64_t>(blockIndex), "A.mv" });
+
+                EXPECT_TRUE(encodedBlockRegistry.find(getKey("zstd:4:", blockIndex)).has_value());
+            }
+        });
+    }
+
+    for (auto& encoder : encoders)
+        encoder.join();
+
+    EXPECT_EQ(encodedBlockRegistry.getNumberOfBlocks(), 4000);
+    EXPECT_EQ(encodedBlockRegistry.find(getKey("zstd:4:", 1234))->_compressedSize, 1234u);
+}
@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <util/IndexSet.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+using mv::util::IndexSet;
+
+namespace
+{
+    using Indices = std::vector<std::uint32_t>;
+
+    Indices toIndices(const std::set<std::uint32_t>& indices)
+    {
+        return { indices.begin(), indices.end() };
+    }
+
+    /** Random indices below \p range, optionally with a dense run which turns its chunk into a bitmap */
+    std::set<std::uint32_t> generateIndices(std::mt19937& randomNumberEngine, std::uint32_t count, std::uint32_t range, bool addDenseRun)
+    {
+        std::set<std::uint32_t> indices;
+
+        for (std::uint32_t i = 0; i < count; ++i)
+            indices.insert(randomNumberEngine() % range);
+
+        if (addDenseRun)
+            for (std::uint32_t index = 65536; index < 65536 + 30000; ++index)
+                indices.insert(index);
+
+        return indices;
+    }
+}
+
+
+TEST(IndexSet, DefaultIsEmpty)
+{
+    const IndexSet indexSet;
+
+    EXPECT_TRUE(indexSet.isEmpty());
+    EXPECT_EQ(indexSet.size(), 0u);
+    EXPECT_TRUE(indexSet.toIndices().empty());
+    EXPECT_FALSE(indexSet.contains(0));
+    EXPECT_EQ(indexSet, IndexSet(Indices()));
+}
+
+
+TEST(IndexSet, SortsAndDeduplicates)
+{
+    const IndexSet indexSet(Indices{ 7, 3, 70000, 3, 0, 7 });
+
+    EXPECT_EQ(indexSet.toIndices(), Indices({ 0, 3, 7, 70000 }));
+    EXPECT_EQ(indexSet.size(), 4u);
+}
+
+
+TEST(IndexSet, CrossesTheArrayToBitmapThreshold)
+{
+    // Every other index, so that the chunk holds one index more than an array container may hold
+    IndexSet indexSet;
+    Indices expected;
+
+    for (std::uint32_t index = 0; index < 2 * 4097; index += 2) {
+        indexSet.add(index);
+        expected.push_back(index);
+
+        ASSERT_EQ(indexSet.size(), expected.size());
+    }
+
+    EXPECT_EQ(indexSet.toIndices(), expected);
+    EXPECT_EQ(indexSet, IndexSet(expected));
+    EXPECT_TRUE(indexSet.contains(8192));
+    EXPECT_FALSE(indexSet.contains(8193));
+
+    // Dropping below the threshold again (through an operation) keeps the indices
+    const auto firstHalf = indexSet & IndexSet::fromRange(0, 4096);
+
+    EXPECT_EQ(firstHalf.size(), 2048u);
+    EXPECT_EQ(firstHalf.toIndices(), Indices(expected.begin(), expected.begin() + 2048));
+}
+
+
+TEST(IndexSet, HandlesChunkBoundaries)
+{
+    const Indices boundaryIndices = { 0, 65535, 65536, 131071, 131072, 0xFFFFFFFFu };
+
+    const IndexSet indexSet(boundaryIndices);
+
+    EXPECT_EQ(indexSet.toIndices(), boundaryIndices);
+
+    for (const auto index : boundaryIndices)
+        EXPECT_TRUE(indexSet.contains(index));
+
+    EXPECT_FALSE(indexSet.contains(1));
+    EXPECT_FALSE(indexSet.contains(65534));
+    EXPECT_FALSE(indexSet.contains(0xFFFFFFFEu));
+
+    const auto range = IndexSet::fromRange(65530, 131080);
+
+    EXPECT_EQ(range.size(), 131080u - 65530u);
+    EXPECT_EQ((indexSet & range).toIndices(), Indices({ 65535, 65536, 131071, 131072 }));
+}
+
+
+TEST(IndexSet, FromRange)
+{
+    EXPECT_TRUE(IndexSet::fromRange(5, 5).isEmpty());
+
+    const auto range = IndexSet::fromRange(5000000, 25000000);
+
+    EXPECT_EQ(range.size(), 20000000u);
+    EXPECT_TRUE(range.contains(5000000));
+    EXPECT_TRUE(range.contains(24999999));
+    EXPECT_FALSE(range.contains(4999999));
+    EXPECT_FALSE(range.contains(25000000));
+
+    // A dense selection takes a bit per index at most
+    EXPECT_LE(range.getMemoryUsage(), 20000000u / 8 + 458u * 8192u);
+    EXPECT_EQ(range.complement(30000000).size(), 10000000u);
+}
+
+
+TEST(IndexSet, AlgebraMatchesSortedSets)
+{
+    std::mt19937 randomNumberEngine(1);
+
+    const std::uint32_t ranges[] = { 300000, 70000, 4000000 };
+
+    for (std::uint32_t trial = 0; trial < 30; ++trial) {
+        const auto range = ranges[trial % 3];
+
+        const auto lhs = generateIndices(randomNumberEngine, randomNumberEngine() % 20000, range, trial % 5 == 0);
+        const auto rhs = generateIndices(randomNumberEngine, randomNumberEngine() % 20000, range, trial % 7 == 0);
+
+        const IndexSet lhsSet(toIndices(lhs));
+
+        // Built index by index instead of from a vector
+        IndexSet rhsSet;
+
+        for (const auto index : rhs)
+            rhsSet.add(index);
+
+        std::set<std::uint32_t> united, intersected, subtracted;
+
+        std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::inserter(united, united.end()));
+        std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::inserter(intersected, intersected.end()));
+        std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::inserter(subtracted, subtracted.end()));
+
+        const std::uint32_t universeSize = range / 2 + 7;
+
+        // The dense run may exceed the range
+        std::vector<bool> isInLhs(std::max(range, 65536u + 30000u), false);
+
+        for (const auto index : lhs)
+            isInLhs[index] = true;
+
+        Indices complemented;
+
+        for (std::uint32_t index = 0; index < universeSize; ++index)
+            if (!isInLhs[index])
+                complemented.push_back(index);
+
+        ASSERT_EQ(lhsSet.toIndices(), toIndices(lhs));
+        ASSERT_EQ(rhsSet.toIndices(), toIndices(rhs));
+        ASSERT_EQ(lhsSet.size(), lhs.size());
+
+        EXPECT_EQ((lhsSet | rhsSet).toIndices(), toIndices(united));
+        EXPECT_EQ((lhsSet & rhsSet).toIndices(), toIndices(intersected));
+        EXPECT_EQ((lhsSet - rhsSet).toIndices(), toIndices(subtracted));
+        EXPECT_EQ(lhsSet.complement(universeSize).toIndices(), complemented);
+
+        EXPECT_EQ(lhsSet | rhsSet, IndexSet(toIndices(united)));
+        EXPECT_EQ((lhsSet & rhsSet).size(), intersected.size());
+
+        for (std::uint32_t i = 0; i < 100; ++i) {
+            const auto index = randomNumberEngine() % range;
+
+            EXPECT_EQ(lhsSet.contains(index), isInLhs[index]);
+        }
+    }
+}
+
+
+TEST(IndexSet, CompoundAssignment)
+{
+    IndexSet indexSet(Indices{ 1, 2, 3 });
+
+    indexSet |= IndexSet(Indices{ 3, 4 });
+    EXPECT_EQ(indexSet.toIndices(), Indices({ 1, 2, 3, 4 }));
+
+    indexSet -= IndexSet(Indices{ 1, 4 });
+    EXPECT_EQ(indexSet.toIndices(), Indices({ 2, 3 }));
+
+    indexSet &= IndexSet(Indices{ 3, 5 });
+    EXPECT_EQ(indexSet.toIndices(), Indices({ 3 }));
+
+    indexSet.clear();
+    EXPECT_TRUE(indexSet.isEmpty());
+}
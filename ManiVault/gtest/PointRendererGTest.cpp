@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <renderers/PointRenderer.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using mv::Vector2f;
+using mv::gui::PointArrayObject;
+
+namespace
+{
+    /** Positions (i, -i) for the points i = 0, 1, 2, ... (the positions are not uploaded without a context) */
+    std::vector<Vector2f> createPositions(std::size_t numPoints)
+    {
+        std::vector<Vector2f> positions;
+
+        for (std::size_t pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+            positions.emplace_back(static_cast<float>(pointIndex), -static_cast<float>(pointIndex));
+
+        return positions;
+    }
+}
+
+
+TEST(PointArrayObject, UpdatesARangeOfPositions)
+{
+    PointArrayObject pointArrayObject;
+
+    pointArrayObject.setPositions(createPositions(10));
+    pointArrayObject.updatePositions(3, { Vector2f(100.f, 100.f), Vector2f(200.f, 200.f) });
+    pointArrayObject.updatePositions(9, { Vector2f(900.f, 900.f) });
+    pointArrayObject.updatePositions(10, {});
+
+    auto expectedPositions = createPositions(10);
+
+    expectedPositions[3] = Vector2f(100.f, 100.f);
+    expectedPositions[4] = Vector2f(200.f, 200.f);
+    expectedPositions[9] = Vector2f(900.f, 900.f);
+
+    EXPECT_EQ(pointArrayObject.getPositions(), expectedPositions);
+}
+
+
+TEST(PointArrayObject, ThrowsOnUpdatingPositionsOutOfRange)
+{
+    PointArrayObject pointArrayObject;
+
+    pointArrayObject.setPositions(createPositions(10));
+
+    EXPECT_THROW(pointArrayObject.updatePositions(9, { Vector2f(1.f, 1.f), Vector2f(2.f, 2.f) }), std::out_of_range);
+    EXPECT_THROW(pointArrayObject.updatePositions(11, { Vector2f(1.f, 1.f) }), std::out_of_range);
+    EXPECT_THROW(pointArrayObject.updatePositions(static_cast<std::size_t>(-1), { Vector2f(1.f, 1.f), Vector2f(2.f, 2.f) }), std::out_of_range);
+
+    // The positions are left unchanged
+    EXPECT_EQ(pointArrayObject.getPositions(), createPositions(10));
+}
@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <event/SelectionDelta.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using mv::SelectionDelta;
+using mv::util::IndexSet;
+
+namespace
+{
+    using Indices = std::vector<std::uint32_t>;
+
+    Indices generateIndices(std::mt19937& randomNumberEngine, std::uint32_t count, std::uint32_t range)
+    {
+        Indices indices(count);
+
+        for (auto& index : indices)
+            index = randomNumberEngine() % range;
+
+        return indices;
+    }
+}
+
+
+TEST(SelectionDelta, DefaultReplacesTheSelection)
+{
+    const SelectionDelta selectionDelta;
+
+    EXPECT_TRUE(selectionDelta.isReplaced());
+    EXPECT_FALSE(selectionDelta.isIncremental());
+    EXPECT_FALSE(selectionDelta.isEmpty());
+
+    // Replacing wins when combined with an incremental delta
+    EXPECT_TRUE(selectionDelta.then(SelectionDelta::fromAdded({ 1 })).isReplaced());
+    EXPECT_TRUE(SelectionDelta::fromAdded({ 1 }).then(selectionDelta).isReplaced());
+
+    // Nothing to apply, listeners read the whole selection
+    const IndexSet selection(Indices{ 1, 2 });
+
+    EXPECT_EQ(selectionDelta.apply(selection), selection);
+
+    Indices selectionIndices = { 2, 1 };
+
+    selectionDelta.applyTo(selectionIndices);
+
+    EXPECT_EQ(selectionIndices, Indices({ 2, 1 }));
+}
+
+
+TEST(SelectionDelta, AddedWinsOverRemoved)
+{
+    const SelectionDelta selectionDelta(IndexSet(Indices{ 1, 2 }), IndexSet(Indices{ 2, 3 }));
+
+    EXPECT_TRUE(selectionDelta.isIncremental());
+    EXPECT_EQ(selectionDelta.getAdded().toIndices(), Indices({ 1, 2 }));
+    EXPECT_EQ(selectionDelta.getRemoved().toIndices(), Indices({ 3 }));
+    EXPECT_EQ(selectionDelta.apply(IndexSet(Indices{ 2, 3, 4 })).toIndices(), Indices({ 1, 2, 4 }));
+}
+
+
+TEST(SelectionDelta, ThenEqualsApplyingBoth)
+{
+    std::mt19937 randomNumberEngine(1);
+
+    for (std::uint32_t trial = 0; trial < 100; ++trial) {
+        const IndexSet selection(generateIndices(randomNumberEngine, 5000, 200000));
+
+        const SelectionDelta first(IndexSet(generateIndices(randomNumberEngine, 300, 200000)), IndexSet(generateIndices(randomNumberEngine, 300, 200000)));
+        const SelectionDelta second(IndexSet(generateIndices(randomNumberEngine, 300, 200000)), IndexSet(generateIndices(randomNumberEngine, 300, 200000)));
+
+        EXPECT_EQ(first.then(second).apply(selection), second.apply(first.apply(selection)));
+        EXPECT_EQ(first.then(first).apply(selection), first.apply(selection));
+
+        const auto combined = first.then(second);
+
+        EXPECT_TRUE((combined.getAdded() & combined.getRemoved()).isEmpty());
+    }
+}
+
+
+TEST(SelectionDelta, ApplyToMatchesApply)
+{
+    std::mt19937 randomNumberEngine(3);
+
+    for (std::uint32_t trial = 0; trial < 300; ++trial) {
+        const std::uint32_t range = trial % 2 ? 200000 : 5000;
+
+        auto selectionIndices = generateIndices(randomNumberEngine, randomNumberEngine() % 8000, range);
+
+        // Mostly ascending selections (as produced by selection mapping), the others go through the index set
+        if (trial % 3)
+            selectionIndices = IndexSet(selectionIndices).toIndices();
+
+        const SelectionDelta selectionDelta(IndexSet(generateIndices(randomNumberEngine, randomNumberEngine() % 3000, range)), IndexSet(generateIndices(randomNumberEngine, randomNumberEngine() % 3000, range)));
+
+        const auto expected = selectionDelta.apply(IndexSet(selectionIndices)).toIndices();
+
+        selectionDelta.applyTo(selectionIndices);
+
+        EXPECT_EQ(selectionIndices, expected);
+    }
+}
+
+
+TEST(SelectionDelta, ApplyToLeavesUnsortedSelectionsAloneWhenEmpty)
+{
+    Indices selectionIndices = { 5, 1, 5 };
+
+    SelectionDelta(IndexSet(), IndexSet()).applyTo(selectionIndices);
+
+    EXPECT_EQ(selectionIndices, Indices({ 5, 1, 5 }));
+
+    SelectionDelta::fromRemoved({ 1 }).applyTo(selectionIndices);
+
+    EXPECT_EQ(selectionIndices, Indices({ 5 }));
+}
+
+
+TEST(SelectionDelta, ApplyToWorksInPlace)
+{
+    Indices selectionIndices = { 1, 3, 5, 7, 9 };
+
+    selectionIndices.reserve(16);
+
+    const auto selectionIndicesData = selectionIndices.data();
+
+    // Added indices are merged in between the selected ones, selected added indices do not grow the selection
+    SelectionDelta(IndexSet({ 0, 4, 5, 10 }), IndexSet({ 3, 9 })).applyTo(selectionIndices);
+
+    EXPECT_EQ(selectionIndices, Indices({ 0, 1, 4, 5, 7, 10 }));
+    EXPECT_EQ(selectionIndices.data(), selectionIndicesData);
+
+    // Unsorted selections are sorted in place as well
+    selectionIndices = { 8, 2, 6, 2 };
+    selectionIndices.reserve(16);
+
+    const auto unsortedSelectionIndicesData = selectionIndices.data();
+
+    SelectionDelta::fromAdded({ 4 }).applyTo(selectionIndices);
+
+    EXPECT_EQ(selectionIndices, Indices({ 2, 4, 6, 8 }));
+    EXPECT_EQ(selectionIndices.data(), unsortedSelectionIndicesData);
+}
+
+
+TEST(SelectionDelta, Equality)
+{
+    const auto selectionDelta = SelectionDelta::fromAdded({ 1, 2 });
+
+    EXPECT_EQ(selectionDelta, SelectionDelta(IndexSet(Indices{ 2, 1 }), IndexSet()));
+    EXPECT_NE(selectionDelta, SelectionDelta::fromRemoved({ 1, 2 }));
+    EXPECT_NE(selectionDelta, SelectionDelta());
+    EXPECT_EQ(SelectionDelta(), SelectionDelta());
+}
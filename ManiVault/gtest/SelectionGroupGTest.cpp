@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <SelectionGroup.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using mv::BiMap;
+using mv::Dataset;
+using mv::DatasetImpl;
+using mv::KeyBasedSelectionGroup;
+
+namespace
+{
+    using Indices = std::vector<std::uint32_t>;
+
+    /** Exposes the translation through the cross-maps, which works on the positions of the datasets in the group (so the datasets need not be valid) */
+    class TestSelectionGroup : public KeyBasedSelectionGroup
+    {
+    public:
+        using KeyBasedSelectionGroup::getBiMapByIndex;
+        using KeyBasedSelectionGroup::getNumberOfCrossMapBuilds;
+        using KeyBasedSelectionGroup::translateIndices;
+    };
+}
+
+
+TEST(SelectionGroup, TranslatesIndicesThroughTheKeys)
+{
+    TestSelectionGroup selectionGroup;
+
+    selectionGroup.addDataset(Dataset<DatasetImpl>(), { "a", "b", "c" });
+    selectionGroup.addDataset(Dataset<DatasetImpl>(), { "c", "a", "d" });
+
+    // Indices without a counterpart are skipped
+    EXPECT_EQ(selectionGroup.translateIndices(0, 1, { 0, 1, 2 }), Indices({ 1, 0 }));
+    EXPECT_EQ(selectionGroup.translateIndices(1, 0, { 2, 1, 0 }), Indices({ 0, 2 }));
+    EXPECT_TRUE(selectionGroup.translateIndices(0, 1, { 3 }).empty());
+}
+
+
+TEST(SelectionGroup, RebuildsCrossMapsOnlyWhenTheirBiMapChanges)
+{
+    TestSelectionGroup selectionGroup;
+
+    selectionGroup.addDataset(Dataset<DatasetImpl>(), { "a", "b", "c" });
+    selectionGroup.addDataset(Dataset<DatasetImpl>(), { "c", "a" });
+
+    EXPECT_EQ(selectionGroup.getNumberOfCrossMapBuilds(0), 1u);
+    EXPECT_EQ(selectionGroup.getNumberOfCrossMapBuilds(1), 1u);
+
+    // Accessing the bimaps does not change them
+    const auto biMapRevision = selectionGroup.getBiMapByIndex(1).getRevision();
+
+    (void)selectionGroup.translateIndices(0, 1, { 0, 1, 2 });
+
+    EXPECT_EQ(selectionGroup.getBiMapByIndex(1).getRevision(), biMapRevision);
+    EXPECT_EQ(selectionGroup.getNumberOfCrossMapBuilds(0), 1u);
+    EXPECT_EQ(selectionGroup.getNumberOfCrossMapBuilds(1), 1u);
+
+    // Changing a bimap only rebuilds its own cross-map, the key identifiers of the others are kept
+    selectionGroup.getBiMapByIndex(1).addKeyValuePairs({ "b", "d" }, { 0, 1 });
+
+    EXPECT_EQ(selectionGroup.translateIndices(0, 1, { 0, 1, 2 }), Indices({ 0 }));
+    EXPECT_EQ(selectionGroup.translateIndices(1, 0, { 0, 1 }), Indices({ 1 }));
+    EXPECT_EQ(selectionGroup.getNumberOfCrossMapBuilds(0), 1u);
+    EXPECT_EQ(selectionGroup.getNumberOfCrossMapBuilds(1), 2u);
+}
+
+
+TEST(SelectionGroup, BiMapRevisionChangesWithTheKeyValuePairs)
+{
+    BiMap biMap;
+
+    EXPECT_EQ(biMap.getRevision(), 0u);
+
+    biMap.addKeyValuePairs({ "a", "b" }, { 0, 1 });
+
+    EXPECT_EQ(biMap.getRevision(), 1u);
+    EXPECT_EQ(biMap.getValuesByKeys({ "b" }), Indices({ 1 }));
+
+    // Mismatching keys and values leave the bimap alone
+    biMap.addKeyValuePairs({ "a" }, { 0, 1 });
+
+    EXPECT_EQ(biMap.getRevision(), 1u);
+}
+
+
+TEST(SelectionGroup, GettingTheBiMapOfADatasetOutsideTheGroupThrows)
+{
+    const KeyBasedSelectionGroup selectionGroup;
+
+    EXPECT_THROW((void)selectionGroup.getBiMap(Dataset<DatasetImpl>()), std::runtime_error);
+}
@@ -0,0 +1,341 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <LinkedData.h>
+
+#include <QSize>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+using mv::SelectionDelta;
+using mv::SelectionMap;
+using mv::util::IndexSet;
+
+namespace
+{
+    using Indices = SelectionMap::Indices;
+
+    /** Maps \p pointIndices one at a time (the reference for the batch mapping) */
+    Indices mapPointByPoint(const SelectionMap& selectionMap, const Indices& pointIndices)
+    {
+        std::set<std::uint32_t> mappedIndices;
+        Indices indices;
+
+        for (const auto pointIndex : pointIndices) {
+            if (!selectionMap.hasMappingForPointIndex(pointIndex))
+                continue;
+
+            selectionMap.populateMappingIndices(pointIndex, indices);
+
+            mappedIndices.insert(indices.begin(), indices.end());
+        }
+
+        return { mappedIndices.begin(), mappedIndices.end() };
+    }
+
+    Indices mapIndices(const SelectionMap& selectionMap, const Indices& pointIndices)
+    {
+        Indices mappedIndices;
+
+        selectionMap.mapIndices(pointIndices, mappedIndices);
+
+        return mappedIndices;
+    }
+
+    /**
+     * Maps \p pointIndex of a source image of \p sourceSize to a target image of \p targetSize pixel by pixel (the
+     * reference for the image pyramid mapping, as it was computed per point before the mapping became analytical)
+     */
+    std::set<std::uint32_t> mapImagePyramidPixel(std::uint32_t pointIndex, const QSize& sourceSize, const QSize& targetSize)
+    {
+        const auto sourcePixelX = static_cast<int>(pointIndex) % sourceSize.width();
+        const auto sourcePixelY = static_cast<int>(pointIndex) / sourceSize.width();
+        const auto scaleFactor  = static_cast<float>(targetSize.width()) / static_cast<float>(sourceSize.width());
+
+        std::set<std::uint32_t> targetIndices;
+
+        if (scaleFactor == 1.0f)
+            targetIndices.insert(pointIndex);
+
+        if (scaleFactor < 1.0f) {
+            const auto levelFactor  = static_cast<int>(std::floor(1.0f / scaleFactor));
+            const auto targetPixelX = sourcePixelX / levelFactor;
+            const auto targetPixelY = sourcePixelY / levelFactor;
+
+            if (targetPixelX < targetSize.width() && targetPixelY < targetSize.height())
+                targetIndices.insert(static_cast<std::uint32_t>(targetPixelY * targetSize.width() + targetPixelX));
+        }
+
+        if (scaleFactor > 1.0f) {
+            const auto levelFactor = static_cast<int>(std::floor(scaleFactor));
+
+            for (int targetPixelY = sourcePixelY * levelFactor; targetPixelY < (sourcePixelY + 1) * levelFactor; ++targetPixelY)
+                for (int targetPixelX = sourcePixelX * levelFactor; targetPixelX < (sourcePixelX + 1) * levelFactor; ++targetPixelX)
+                    if (targetPixelX < targetSize.width() && targetPixelY < targetSize.height())
+                        targetIndices.insert(static_cast<std::uint32_t>(targetPixelY * targetSize.width() + targetPixelX));
+        }
+
+        return targetIndices;
+    }
+
+    /** All point indices in [0, end) */
+    Indices getPointIndices(std::uint32_t end)
+    {
+        Indices pointIndices(end);
+
+        for (std::uint32_t pointIndex = 0; pointIndex < end; ++pointIndex)
+            pointIndices[pointIndex] = pointIndex;
+
+        return pointIndices;
+    }
+}
+
+
+TEST(SelectionMap, CompressedMapMatchesIndexedMap)
+{
+    std::mt19937 randomNumberEngine(1);
+
+    for (std::uint32_t trial = 0; trial < 100; ++trial) {
+        SelectionMap selectionMap;
+
+        // Alternate between dense rows (few gaps) and sparse rows, which are compressed differently
+        const std::uint32_t span            = 1 + randomNumberEngine() % (trial % 2 ? 60 : 100000);
+        const std::uint32_t firstPointIndex = (trial % 3) * 7;
+        const std::uint32_t numberOfRows    = randomNumberEngine() % 50;
+
+        for (std::uint32_t row = 0; row < numberOfRows; ++row) {
+            Indices targets(randomNumberEngine() % 4);
+
+            for (auto& target : targets)
+                target = randomNumberEngine() % 1000;
+
+            selectionMap.getMap()[firstPointIndex + randomNumberEngine() % span] = targets;
+        }
+
+        const auto pointIndices = getPointIndices(firstPointIndex + span + 30);
+
+        EXPECT_EQ(mapIndices(selectionMap, pointIndices), mapPointByPoint(selectionMap, pointIndices));
+
+        // The appending variant keeps duplicates, but maps to the same indices
+        Indices appendedIndices = { 12345 };
+
+        selectionMap.populateMappingIndices(pointIndices, appendedIndices);
+
+        ASSERT_FALSE(appendedIndices.empty());
+        EXPECT_EQ(appendedIndices.front(), 12345u);
+        EXPECT_EQ(IndexSet(Indices(appendedIndices.begin() + 1, appendedIndices.end())).toIndices(), mapPointByPoint(selectionMap, pointIndices));
+
+        EXPECT_EQ(selectionMap.getMappedIndexSet().toIndices(), mapPointByPoint(selectionMap, pointIndices));
+    }
+}
+
+
+TEST(SelectionMap, MapsLargeInputsConcurrently)
+{
+    constexpr std::uint32_t numberOfPoints = 300000;
+
+    SelectionMap selectionMap;
+
+    for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; ++pointIndex)
+        if (pointIndex % 3 != 0)
+            selectionMap.getMap()[pointIndex] = { pointIndex / 2, pointIndex / 2 + 1 };
+
+    // More point indices than a single grain, in descending order
+    auto pointIndices = getPointIndices(numberOfPoints);
+
+    std::reverse(pointIndices.begin(), pointIndices.end());
+
+    EXPECT_EQ(mapIndices(selectionMap, pointIndices), mapPointByPoint(selectionMap, pointIndices));
+}
+
+
+TEST(SelectionMap, ChangingTheMapDiscardsTheCompressedMap)
+{
+    SelectionMap selectionMap;
+
+    selectionMap.getMap()[0] = { 10 };
+    selectionMap.getMap()[1] = { 11 };
+
+    EXPECT_EQ(mapIndices(selectionMap, { 0, 1 }), Indices({ 10, 11 }));
+    EXPECT_TRUE(selectionMap.isInjective());
+
+    // A copy shares the compressed map, but not the changes which are made to the copy
+    SelectionMap copy(selectionMap);
+
+    copy.getMap()[1] = { 10 };
+
+    EXPECT_EQ(mapIndices(copy, { 0, 1 }), Indices({ 10 }));
+    EXPECT_FALSE(copy.isInjective());
+
+    EXPECT_EQ(mapIndices(selectionMap, { 0, 1 }), Indices({ 10, 11 }));
+    EXPECT_TRUE(selectionMap.isInjective());
+}
+
+
+TEST(SelectionMap, MapsSelectionDeltas)
+{
+    SelectionMap selectionMap;
+
+    selectionMap.getMap()[0] = { 10, 11 };
+    selectionMap.getMap()[1] = { 12 };
+
+    const SelectionDelta selectionDelta(IndexSet(Indices{ 0 }), IndexSet(Indices{ 1 }));
+
+    const auto mappedDelta = selectionMap.mapSelectionDelta(selectionDelta);
+
+    ASSERT_TRUE(mappedDelta.isIncremental());
+    EXPECT_EQ(mappedDelta.getAdded().toIndices(), Indices({ 10, 11 }));
+    EXPECT_EQ(mappedDelta.getRemoved().toIndices(), Indices({ 12 }));
+
+    // Point 2 keeps index 12 selected when point 1 is deselected, so the removal cannot be mapped
+    selectionMap.getMap()[2] = { 12 };
+
+    EXPECT_TRUE(selectionMap.mapSelectionDelta(selectionDelta).isReplaced());
+    EXPECT_TRUE(selectionMap.mapSelectionDelta(SelectionDelta::fromAdded({ 2 })).isIncremental());
+}
+
+
+TEST(SelectionMap, OffsetRangesMatchTheirTargets)
+{
+    SelectionMap selectionMap(SelectionMap::Type::OffsetRange);
+
+    // Added out of order: [100, 110) by offset, [0, 4) through a table with an unmapped point and [50, 52) by offset
+    selectionMap.addOffsetRange({ 100, 110, 1000, {} });
+    selectionMap.addOffsetRange({ 0, 4, 0, { 7, SelectionMap::invalidIndex, 5, 6 } });
+    selectionMap.addOffsetRange({ 50, 52, 20, {} });
+
+    ASSERT_EQ(selectionMap.getOffsetRanges().size(), 3u);
+    EXPECT_EQ(selectionMap.getOffsetRanges()[0].sourceBegin, 0u);
+    EXPECT_EQ(selectionMap.getOffsetRanges()[1].sourceBegin, 50u);
+    EXPECT_EQ(selectionMap.getOffsetRanges()[2].sourceBegin, 100u);
+
+    EXPECT_FALSE(selectionMap.hasMappingForPointIndex(1));
+    EXPECT_FALSE(selectionMap.hasMappingForPointIndex(4));
+    EXPECT_FALSE(selectionMap.hasMappingForPointIndex(110));
+    EXPECT_TRUE(selectionMap.hasMappingForPointIndex(109));
+
+    const auto pointIndices = getPointIndices(120);
+
+    Indices expected = { 5, 6, 7, 20, 21 };
+
+    for (std::uint32_t targetIndex = 1000; targetIndex < 1010; ++targetIndex)
+        expected.push_back(targetIndex);
+
+    EXPECT_EQ(mapPointByPoint(selectionMap, pointIndices), expected);
+    EXPECT_EQ(mapIndices(selectionMap, pointIndices), expected);
+    EXPECT_EQ(mapIndices(selectionMap, { 109, 0, 51, 1, 200 }), Indices({ 7, 21, 1009 }));
+    EXPECT_EQ(selectionMap.getMappedIndexSet().toIndices(), expected);
+    EXPECT_TRUE(selectionMap.isInjective());
+}
+
+
+TEST(SelectionMap, OffsetRangesTrackInjectivity)
+{
+    // Ranges with disjoint targets stay injective
+    SelectionMap selectionMap(SelectionMap::Type::OffsetRange);
+
+    selectionMap.addOffsetRange({ 0, 10, 0, {} });
+    selectionMap.addOffsetRange({ 10, 12, 10, { 11, 10 } });
+    selectionMap.addOffsetRange({ 20, 30, 100, {} });
+
+    EXPECT_TRUE(selectionMap.isInjective());
+
+    // A range which maps to a target of an earlier range
+    auto overlapping = selectionMap;
+
+    overlapping.addOffsetRange({ 40, 42, 105, {} });
+
+    EXPECT_FALSE(overlapping.isInjective());
+    EXPECT_TRUE(overlapping.mapSelectionDelta(SelectionDelta::fromRemoved({ 40 })).isReplaced());
+
+    // A table which maps two points to the same target
+    auto duplicate = selectionMap;
+
+    duplicate.addOffsetRange({ 50, 53, 0, { 200, SelectionMap::invalidIndex, 200 } });
+
+    EXPECT_FALSE(duplicate.isInjective());
+
+    // Unmapped points in a table do not count as duplicates
+    auto unmapped = selectionMap;
+
+    unmapped.addOffsetRange({ 50, 53, 0, { SelectionMap::invalidIndex, 300, SelectionMap::invalidIndex } });
+
+    EXPECT_TRUE(unmapped.isInjective());
+    EXPECT_EQ(unmapped.mapSelectionDelta(SelectionDelta::fromRemoved({ 51 })).getRemoved().toIndices(), Indices({ 300 }));
+
+    // Injectivity matches a brute force check for many random ranges
+    std::mt19937 randomNumberEngine(2);
+
+    for (std::uint32_t trial = 0; trial < 50; ++trial) {
+        SelectionMap randomMap(SelectionMap::Type::OffsetRange);
+
+        std::set<std::uint32_t> targets;
+
+        bool isInjective = true;
+
+        for (std::uint32_t rangeIndex = 0; rangeIndex < 20; ++rangeIndex) {
+            const std::uint32_t sourceBegin = rangeIndex * 100;
+            const std::uint32_t size        = 1 + randomNumberEngine() % 20;
+            const std::uint32_t targetBegin = randomNumberEngine() % 4000;
+
+            for (std::uint32_t offset = 0; offset < size; ++offset)
+                isInjective &= targets.insert(targetBegin + offset).second;
+
+            randomMap.addOffsetRange({ sourceBegin, sourceBegin + size, targetBegin, {} });
+        }
+
+        EXPECT_EQ(randomMap.isInjective(), isInjective);
+        EXPECT_EQ(randomMap.getMappedIndexSet().toIndices(), Indices(targets.begin(), targets.end()));
+    }
+}
+
+
+TEST(SelectionMap, ImagePyramidMatchesPixelByPixelMapping)
+{
+    std::mt19937 randomNumberEngine(3);
+
+    for (std::uint32_t trial = 0; trial < 150; ++trial) {
+        // The scaling follows from the widths, so the source is wider than the level factor
+        const QSize sourceSize(6 + randomNumberEngine() % 64, 1 + randomNumberEngine() % 70);
+        const int levelFactor = 2 + randomNumberEngine() % 4;
+
+        // Same level, a coarser level (rounded up, so edge pixels may be partial) and a finer level
+        QSize targetSize = sourceSize;
+
+        if (trial % 3 == 1)
+            targetSize = QSize((sourceSize.width() + levelFactor - 1) / levelFactor, (sourceSize.height() + levelFactor - 1) / levelFactor);
+
+        if (trial % 3 == 2)
+            targetSize = sourceSize * levelFactor;
+
+        const SelectionMap selectionMap(sourceSize, targetSize);
+
+        Indices pointIndices;
+
+        for (std::uint32_t pointIndex = 0; pointIndex < static_cast<std::uint32_t>(sourceSize.width() * sourceSize.height()); ++pointIndex)
+            if (randomNumberEngine() % 3 == 0)
+                pointIndices.push_back(pointIndex);
+
+        std::set<std::uint32_t> expected;
+
+        for (const auto pointIndex : pointIndices) {
+            const auto targetIndices = mapImagePyramidPixel(pointIndex, sourceSize, targetSize);
+
+            expected.insert(targetIndices.begin(), targetIndices.end());
+        }
+
+        EXPECT_EQ(mapIndices(selectionMap, pointIndices), Indices(expected.begin(), expected.end()));
+        EXPECT_EQ(mapPointByPoint(selectionMap, pointIndices), Indices(expected.begin(), expected.end()));
+        EXPECT_EQ(selectionMap.isInjective(), trial % 3 != 1);
+    }
+}
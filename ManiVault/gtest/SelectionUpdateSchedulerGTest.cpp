@@ -0,0 +1,400 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <util/SelectionUpdateScheduler.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QThread>
+#include <QTimer>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using mv::SelectionDelta;
+using mv::util::IndexSet;
+using mv::util::SelectionUpdateScheduler;
+
+namespace
+{
+    /** The scheduler needs an event loop for its timers and future watchers */
+    void ensureApplication()
+    {
+        static int argc = 1;
+        static char applicationName[] = "CoreGTest";
+        static char* argv[] = { applicationName, nullptr };
+        static QCoreApplication application(argc, argv);
+    }
+
+    /** Process events for \p milliseconds */
+    void spinEventLoop(int milliseconds)
+    {
+        QEventLoop eventLoop;
+
+        QTimer::singleShot(milliseconds, &eventLoop, &QEventLoop::quit);
+
+        eventLoop.exec();
+    }
+
+    /** Records the selections which are applied by a scheduler */
+    struct AppliedSelections
+    {
+        SelectionUpdateScheduler::ApplySelectionFunction getApplySelectionFunction()
+        {
+            return [this](const SelectionUpdateScheduler::SelectionIndices& selectionIndices) -> void {
+                selections.push_back(selectionIndices);
+            };
+        }
+
+        std::vector<SelectionUpdateScheduler::SelectionIndices> selections;
+    };
+
+    /** Records the selections and their deltas which are applied by a scheduler which resolves them */
+    struct AppliedSelectionDeltas
+    {
+        SelectionUpdateScheduler::ApplySelectionDeltaFunction getApplySelectionDeltaFunction()
+        {
+            return [this](const SelectionUpdateScheduler::SelectionIndices& selectionIndices, const SelectionDelta& delta) -> void {
+                selections.push_back(selectionIndices);
+                deltas.push_back(delta);
+
+                if (QThread::currentThread() != QCoreApplication::instance()->thread())
+                    appliedOnGuiThread = false;
+            };
+        }
+
+        std::vector<SelectionUpdateScheduler::SelectionIndices> selections;
+        std::vector<SelectionDelta>                             deltas;
+        bool                                                    appliedOnGuiThread = true;
+    };
+
+    /** Selection of \p count indices in descending order, which takes a while to resolve */
+    SelectionUpdateScheduler::SelectionIndices createLargeSelection(std::uint32_t count)
+    {
+        SelectionUpdateScheduler::SelectionIndices selectionIndices(count);
+
+        std::iota(selectionIndices.rbegin(), selectionIndices.rend(), 0u);
+
+        return selectionIndices;
+    }
+
+    /** Process events until \p selectionUpdateScheduler applied all scheduled selections (or a timeout expired) */
+    void waitUntilApplied(const SelectionUpdateScheduler& selectionUpdateScheduler)
+    {
+        QElapsedTimer timeoutTimer;
+
+        timeoutTimer.start();
+
+        while (selectionUpdateScheduler.isPending() && timeoutTimer.elapsed() < 10000)
+            spinEventLoop(5);
+    }
+}
+
+
+TEST(SelectionUpdateScheduler, AppliesOnlyTheLatestOfSelectionsScheduledTogether)
+{
+    ensureApplication();
+
+    AppliedSelections appliedSelections;
+
+    SelectionUpdateScheduler selectionUpdateScheduler(appliedSelections.getApplySelectionFunction());
+
+    for (std::uint32_t index = 0; index < 1000; ++index)
+        selectionUpdateScheduler.schedule({ index, index + 1 });
+
+    EXPECT_TRUE(selectionUpdateScheduler.isPending());
+    EXPECT_TRUE(appliedSelections.selections.empty());
+
+    spinEventLoop(100);
+
+    ASSERT_EQ(appliedSelections.selections.size(), 1u);
+    EXPECT_EQ(appliedSelections.selections.back(), SelectionUpdateScheduler::SelectionIndices({ 999, 1000 }));
+    EXPECT_FALSE(selectionUpdateScheduler.isPending());
+}
+
+
+TEST(SelectionUpdateScheduler, CoalescesSelectionsToFrames)
+{
+    ensureApplication();
+
+    constexpr std::int32_t frameInterval = 20;
+    constexpr std::uint32_t numberOfSelections = 200;
+
+    AppliedSelections appliedSelections;
+
+    SelectionUpdateScheduler selectionUpdateScheduler(appliedSelections.getApplySelectionFunction());
+
+    selectionUpdateScheduler.setFrameInterval(frameInterval);
+
+    // Schedule a selection every millisecond, like the pixel selection tool does while brushing
+    QEventLoop eventLoop;
+    QTimer brushTimer;
+    QElapsedTimer elapsedTimer;
+    std::uint32_t numberOfScheduledSelections = 0;
+
+    QObject::connect(&brushTimer, &QTimer::timeout, [&]() -> void {
+        selectionUpdateScheduler.schedule({ numberOfScheduledSelections++ });
+
+        if (numberOfScheduledSelections == numberOfSelections) {
+            brushTimer.stop();
+            eventLoop.quit();
+        }
+    });
+
+    elapsedTimer.start();
+    brushTimer.start(1);
+    eventLoop.exec();
+
+    const auto elapsed = elapsedTimer.elapsed();
+
+    spinEventLoop(2 * frameInterval);
+
+    // At most one selection per frame, plus the first one which is applied right away
+    ASSERT_FALSE(appliedSelections.selections.empty());
+    EXPECT_LE(appliedSelections.selections.size(), static_cast<std::size_t>(elapsed / frameInterval) + 2);
+    EXPECT_LT(appliedSelections.selections.size(), static_cast<std::size_t>(numberOfSelections));
+
+    // The final selection is never dropped
+    EXPECT_EQ(appliedSelections.selections.back(), SelectionUpdateScheduler::SelectionIndices({ numberOfSelections - 1 }));
+}
+
+
+TEST(SelectionUpdateScheduler, FlushAppliesThePendingSelectionImmediately)
+{
+    ensureApplication();
+
+    AppliedSelections appliedSelections;
+
+    SelectionUpdateScheduler selectionUpdateScheduler(appliedSelections.getApplySelectionFunction());
+
+    std::size_t numberOfAppliedSignals = 0;
+
+    QObject::connect(&selectionUpdateScheduler, &SelectionUpdateScheduler::selectionApplied, [&numberOfAppliedSignals]() -> void {
+        ++numberOfAppliedSignals;
+    });
+
+    selectionUpdateScheduler.schedule({ 1, 2, 3 });
+    selectionUpdateScheduler.flush();
+
+    ASSERT_EQ(appliedSelections.selections.size(), 1u);
+    EXPECT_EQ(appliedSelections.selections.back(), SelectionUpdateScheduler::SelectionIndices({ 1, 2, 3 }));
+    EXPECT_EQ(numberOfAppliedSignals, 1u);
+    EXPECT_FALSE(selectionUpdateScheduler.isPending());
+
+    // Nothing is left to apply
+    selectionUpdateScheduler.flush();
+    spinEventLoop(50);
+
+    EXPECT_EQ(appliedSelections.selections.size(), 1u);
+    EXPECT_EQ(numberOfAppliedSignals, 1u);
+}
+
+
+TEST(SelectionUpdateScheduler, CancelDiscardsThePendingSelection)
+{
+    ensureApplication();
+
+    AppliedSelections appliedSelections;
+
+    SelectionUpdateScheduler selectionUpdateScheduler(appliedSelections.getApplySelectionFunction());
+
+    selectionUpdateScheduler.schedule({ 1 });
+    selectionUpdateScheduler.cancel();
+
+    EXPECT_FALSE(selectionUpdateScheduler.isPending());
+
+    spinEventLoop(50);
+
+    EXPECT_TRUE(appliedSelections.selections.empty());
+}
+
+
+TEST(SelectionUpdateScheduler, DiscardsSupersededComputations)
+{
+    ensureApplication();
+
+    AppliedSelections appliedSelections;
+
+    SelectionUpdateScheduler selectionUpdateScheduler(appliedSelections.getApplySelectionFunction());
+
+    QEventLoop eventLoop;
+
+    QObject::connect(&selectionUpdateScheduler, &SelectionUpdateScheduler::selectionApplied, &eventLoop, &QEventLoop::quit);
+
+    // The first computation runs until it is cancelled by the second one
+    selectionUpdateScheduler.schedule([](const SelectionUpdateScheduler::CancellationToken& cancellationToken) -> SelectionUpdateScheduler::SelectionIndices {
+        QElapsedTimer timeoutTimer;
+
+        timeoutTimer.start();
+
+        while (!cancellationToken.isCancelled() && timeoutTimer.elapsed() < 5000) {}
+
+        return { 1 };
+    });
+
+    selectionUpdateScheduler.schedule([](const SelectionUpdateScheduler::CancellationToken&) -> SelectionUpdateScheduler::SelectionIndices {
+        return { 2 };
+    });
+
+    QTimer::singleShot(5000, &eventLoop, &QEventLoop::quit);
+
+    eventLoop.exec();
+
+    spinEventLoop(50);
+
+    ASSERT_EQ(appliedSelections.selections.size(), 1u);
+    EXPECT_EQ(appliedSelections.selections.back(), SelectionUpdateScheduler::SelectionIndices({ 2 }));
+}
+
+
+TEST(SelectionUpdateScheduler, ResolvesSelectionsIntoDeltas)
+{
+    // The first selection replaces the selection, later ones are relative to the previous one
+    const auto first = SelectionUpdateScheduler::resolve({ 3, 1, 2 }, nullptr, {});
+
+    ASSERT_NE(first.indexSet, nullptr);
+    EXPECT_TRUE(first.delta.isReplaced());
+    EXPECT_EQ(first.indexSet->toIndices(), SelectionUpdateScheduler::SelectionIndices({ 1, 2, 3 }));
+    EXPECT_EQ(first.selectionIndices, SelectionUpdateScheduler::SelectionIndices({ 3, 1, 2 }));
+
+    const auto second = SelectionUpdateScheduler::resolve({ 2, 3, 4 }, first.indexSet, {});
+
+    ASSERT_NE(second.indexSet, nullptr);
+    ASSERT_TRUE(second.delta.isIncremental());
+    EXPECT_EQ(second.delta.getAdded().toIndices(), SelectionUpdateScheduler::SelectionIndices({ 4 }));
+    EXPECT_EQ(second.delta.getRemoved().toIndices(), SelectionUpdateScheduler::SelectionIndices({ 1 }));
+}
+
+
+TEST(SelectionUpdateScheduler, AppliesResolvedSelectionDeltasOnTheGuiThread)
+{
+    ensureApplication();
+
+    AppliedSelectionDeltas appliedSelectionDeltas;
+
+    SelectionUpdateScheduler selectionUpdateScheduler(appliedSelectionDeltas.getApplySelectionDeltaFunction());
+
+    selectionUpdateScheduler.schedule({ 1, 2, 3 });
+
+    // Resolved on a worker thread, so it is not applied synchronously
+    EXPECT_TRUE(selectionUpdateScheduler.isPending());
+    EXPECT_TRUE(appliedSelectionDeltas.selections.empty());
+
+    waitUntilApplied(selectionUpdateScheduler);
+
+    selectionUpdateScheduler.schedule({ 2, 3, 4 });
+
+    waitUntilApplied(selectionUpdateScheduler);
+
+    ASSERT_EQ(appliedSelectionDeltas.selections.size(), 2u);
+    EXPECT_TRUE(appliedSelectionDeltas.appliedOnGuiThread);
+    EXPECT_TRUE(appliedSelectionDeltas.deltas[0].isReplaced());
+    EXPECT_EQ(appliedSelectionDeltas.selections[1], SelectionUpdateScheduler::SelectionIndices({ 2, 3, 4 }));
+    ASSERT_TRUE(appliedSelectionDeltas.deltas[1].isIncremental());
+    EXPECT_EQ(appliedSelectionDeltas.deltas[1].getAdded().toIndices(), SelectionUpdateScheduler::SelectionIndices({ 4 }));
+    EXPECT_EQ(appliedSelectionDeltas.deltas[1].getRemoved().toIndices(), SelectionUpdateScheduler::SelectionIndices({ 1 }));
+}
+
+
+TEST(SelectionUpdateScheduler, CancelDiscardsTheSelectionBeingResolved)
+{
+    ensureApplication();
+
+    AppliedSelectionDeltas appliedSelectionDeltas;
+
+    SelectionUpdateScheduler selectionUpdateScheduler(appliedSelectionDeltas.getApplySelectionDeltaFunction());
+
+    selectionUpdateScheduler.schedule(createLargeSelection(4'000'000));
+
+    // Start resolving
+    spinEventLoop(1);
+
+    selectionUpdateScheduler.cancel();
+
+    EXPECT_FALSE(selectionUpdateScheduler.isPending());
+
+    spinEventLoop(500);
+
+    EXPECT_TRUE(appliedSelectionDeltas.selections.empty());
+}
+
+
+TEST(SelectionUpdateScheduler, AppliesSelectionsScheduledDuringAResolutionAfterIt)
+{
+    ensureApplication();
+
+    constexpr std::uint32_t numberOfIndices = 4'000'000;
+
+    AppliedSelectionDeltas appliedSelectionDeltas;
+
+    SelectionUpdateScheduler selectionUpdateScheduler(appliedSelectionDeltas.getApplySelectionDeltaFunction());
+
+    selectionUpdateScheduler.schedule(createLargeSelection(numberOfIndices));
+
+    // Start resolving, the selections which are scheduled in the meantime are coalesced
+    spinEventLoop(1);
+
+    selectionUpdateScheduler.schedule({ 1, 2 });
+    selectionUpdateScheduler.schedule({ 2, 3 });
+
+    waitUntilApplied(selectionUpdateScheduler);
+
+    ASSERT_EQ(appliedSelectionDeltas.selections.size(), 2u);
+    EXPECT_EQ(appliedSelectionDeltas.selections[0].size(), numberOfIndices);
+    EXPECT_EQ(appliedSelectionDeltas.selections[1], SelectionUpdateScheduler::SelectionIndices({ 2, 3 }));
+
+    // Relative to the selection which was resolved before it
+    ASSERT_TRUE(appliedSelectionDeltas.deltas[1].isIncremental());
+    EXPECT_TRUE(appliedSelectionDeltas.deltas[1].getAdded().isEmpty());
+    EXPECT_EQ(appliedSelectionDeltas.deltas[1].getRemoved().size(), numberOfIndices - 2u);
+}
+
+
+TEST(SelectionUpdateScheduler, FlushAppliesTheSelectionBeingResolved)
+{
+    ensureApplication();
+
+    constexpr std::uint32_t numberOfIndices = 4'000'000;
+
+    AppliedSelectionDeltas appliedSelectionDeltas;
+
+    SelectionUpdateScheduler selectionUpdateScheduler(appliedSelectionDeltas.getApplySelectionDeltaFunction());
+
+    // Resolve scheduled selections right away
+    selectionUpdateScheduler.setFrameInterval(0);
+
+    selectionUpdateScheduler.schedule(createLargeSelection(numberOfIndices));
+
+    spinEventLoop(1);
+
+    // Waits for the resolution, since it is the latest selection
+    selectionUpdateScheduler.flush();
+
+    ASSERT_EQ(appliedSelectionDeltas.selections.size(), 1u);
+    EXPECT_EQ(appliedSelectionDeltas.selections[0].size(), numberOfIndices);
+    EXPECT_FALSE(selectionUpdateScheduler.isPending());
+
+    // A newer selection supersedes the resolution in flight
+    selectionUpdateScheduler.schedule(createLargeSelection(numberOfIndices / 2));
+
+    spinEventLoop(1);
+
+    selectionUpdateScheduler.schedule({ 1 });
+    selectionUpdateScheduler.flush();
+
+    EXPECT_EQ(appliedSelectionDeltas.selections.back(), SelectionUpdateScheduler::SelectionIndices({ 1 }));
+    EXPECT_FALSE(selectionUpdateScheduler.isPending());
+
+    const auto numberOfAppliedSelections = appliedSelectionDeltas.selections.size();
+
+    spinEventLoop(500);
+
+    EXPECT_EQ(appliedSelectionDeltas.selections.size(), numberOfAppliedSelections);
+}
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <util/Serialization.h>
+
+#include <private/DeltaVarintBlobCodec.h>
+#include <private/DeltaVarintCodecSettingsAction.h>
+#include <private/Lz4BlobCodecFactory.h>
+#include <private/ZstdBlobCodecFactory.h>
+
+#include <Application.h>
+
+#include <exception/ManiVaultException.h>
+
+#include <util/CodecRegistry.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace mv::util;
+
+namespace
+{
+    /** Codec settings are actions, which need an application (with the codecs which the other codec tests use) */
+    void ensureApplication()
+    {
+        static int argc = 1;
+        static char applicationName[] = "CodecGTest";
+        static char* argv[] = { applicationName, nullptr };
+
+        if (mv::Application::current())
+            return;
+
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+        static mv::Application application(argc, argv);
+
+        codecRegistry().registerFactory(std::make_unique<ZstdBlobCodecFactory>(&application));
+        codecRegistry().registerFactory(std::make_unique<Lz4BlobCodecFactory>(&application));
+    }
+
+    /** Creates delta-varint codecs with \p settingsAction (the workflow is built without a project, so its codec is passed explicitly) */
+    std::function<SharedCodec()> getCreateCodecFunction(DeltaVarintCodecSettingsAction& settingsAction)
+    {
+        return [&settingsAction]() -> SharedCodec {
+            return std::make_shared<DeltaVarintBlobCodec>(nullptr, &settingsAction);
+        };
+    }
+}
+
+
+TEST(Serialization, BlobEncodingWorkflowEncodesTheBlocksInABatchedParallelStage)
+{
+    ensureApplication();
+
+    DeltaVarintCodecSettingsAction settingsAction(nullptr, "Delta varint");
+
+    const std::vector<char> bytes(100);
+
+    // Blocks of ten bytes are rounded down to two elements of four bytes, so there are thirteen of them
+    const auto plan = encodeBlobVariantMapWorkflow(bytes.data(), bytes.size(), getCreateCodecFunction(settingsAction), 10, QString(), 4);
+
+    const auto& stages = plan->getStages();
+
+    ASSERT_EQ(stages.size(), 2u);
+
+    EXPECT_TRUE(stages[0].isBatchedParallel());
+    EXPECT_EQ(stages[0].getJobs().size(), 13u);
+
+    // The blob map is published once all blocks are encoded
+    EXPECT_EQ(stages[1].getName(), QString("Publish blob map"));
+    EXPECT_EQ(stages[1].getJobs().size(), 1u);
+}
+
+
+TEST(Serialization, BlobEncodingWorkflowOfAnEmptyBufferOnlyPublishes)
+{
+    ensureApplication();
+
+    DeltaVarintCodecSettingsAction settingsAction(nullptr, "Delta varint");
+
+    const auto plan = encodeBlobVariantMapWorkflow(nullptr, 0, getCreateCodecFunction(settingsAction), 1 << 20, QString());
+
+    const auto& stages = plan->getStages();
+
+    ASSERT_EQ(stages.size(), 1u);
+    EXPECT_EQ(stages[0].getName(), QString("Publish blob map"));
+}
+
+
+TEST(Serialization, BlobEncodingWorkflowRejectsInvalidInput)
+{
+    ensureApplication();
+
+    DeltaVarintCodecSettingsAction settingsAction(nullptr, "Delta varint");
+
+    const std::vector<char> bytes(16);
+
+    EXPECT_THROW((void)encodeBlobVariantMapWorkflow(nullptr, bytes.size(), getCreateCodecFunction(settingsAction), 1 << 20, QString()), mv::ManiVaultException);
+    EXPECT_THROW((void)encodeBlobVariantMapWorkflow(bytes.data(), bytes.size(), getCreateCodecFunction(settingsAction), 0, QString()), mv::ManiVaultException);
+}
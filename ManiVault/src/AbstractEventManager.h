@@ -11,6 +11,8 @@ namespace mv
 {
 
 class DatasetImpl;
+class DataChangedRegion;
+class SelectionDelta;
 class KeyBasedSelectionGroup;
 
 /**
@@ -67,6 +69,13 @@ public:
      */
     virtual void notifyDatasetDataChanged(const Dataset<DatasetImpl>& dataset) = 0;
 
+    /**
+     * Notify listeners that a region of the data of a dataset has changed, so that they can update only that region
+     * @param dataset Smart pointer to the dataset of which the data changed
+     * @param region Region of the data that changed
+     */
+    virtual void notifyDatasetDataChanged(const Dataset<DatasetImpl>& dataset, const DataChangedRegion& region) = 0;
+
     /**
      * Notify listeners that a dataset has changed data dimensions
      * @param dataset Smart pointer to the dataset of which the data dimensions changed
@@ -80,6 +89,14 @@ public:
      */
     virtual void notifyDatasetDataSelectionChanged(const Dataset<DatasetImpl>& dataset, Datasets* ignoreDatasets = nullptr) = 0;
 
+    /**
+     * Notify listeners that dataset data selection has changed by \p delta, the delta is propagated (mapped) to linked datasets and selection groups
+     * @param dataset Smart pointer to the dataset of which the data selection changed
+     * @param delta How the data selection changed
+     * @param ignoreDatasets Pointer to datasets that should be ignored during notification
+     */
+    virtual void notifyDatasetDataSelectionChanged(const Dataset<DatasetImpl>& dataset, const SelectionDelta& delta, Datasets* ignoreDatasets = nullptr) = 0;
+
     /**
      * Notify all listeners that a dataset is locked
      * @param dataset Smart pointer to the dataset
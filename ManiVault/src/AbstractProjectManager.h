@@ -17,6 +17,7 @@
 #include "models/ProjectsModelProject.h"
 
 #include "util/SeverityLevel.h"
+#include "util/ArchiveEntryWriter.h"
 
 #include <QObject>
 #include <QMenu>
@@ -325,6 +326,26 @@ protected: // Temporary directories
         _temporaryDirPaths.remove(temporaryDirType);
     }
 
+public: // Archive streaming
+
+    /**
+     * Get the archive entry writer of the project that is currently being saved
+     * @return Shared pointer to the archive entry writer, nullptr if encoded blocks should be written to the temporary save directory instead
+     */
+    util::SharedArchiveEntryWriter getArchiveEntryWriter() const {
+        return _archiveEntryWriter;
+    }
+
+protected: // Archive streaming
+
+    /**
+     * Set the archive entry writer to \p archiveEntryWriter
+     * @param archiveEntryWriter Shared pointer to the archive entry writer (nullptr to disable archive streaming)
+     */
+    void setArchiveEntryWriter(const util::SharedArchiveEntryWriter& archiveEntryWriter) {
+        _archiveEntryWriter = archiveEntryWriter;
+    }
+
 public:
 
     /**
@@ -565,6 +586,7 @@ private:
     State                                   _state;                     /** Determines the state of the project manager */
     Task                                    _projectDownloadTask;       /** Progress reporting project downloading */
     QMap<TemporaryDirType, QString>         _temporaryDirPaths;         /** Temporary directories for file open/save etc. */
+    util::SharedArchiveEntryWriter          _archiveEntryWriter;        /** Writer for streaming encoded blocks into the project archive during save */
 };
 
 }
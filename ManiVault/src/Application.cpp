@@ -286,6 +286,11 @@ AbstractWorkflowPlanExecutor& Application::getWorkflowPlanExecutor()
     return *current()->_workflowPlanExecutor;
 }
 
+bool Application::hasWorkflowPlanExecutor()
+{
+    return current() && current()->_workflowPlanExecutor;
+}
+
 void Application::setWorkflowPlanExecutor(UniqueWorkflowPlanExecutor workflowPlanExecutor)
 {
     Q_ASSERT(workflowPlanExecutor);
@@ -313,6 +313,12 @@ public: // Workflow plan executor
      */
     static workflow::AbstractWorkflowPlanExecutor& getWorkflowPlanExecutor();
 
+    /**
+     * Establish whether a workflow plan executor is set (it is not until the application has started, e.g. in unit tests)
+     * @return Boolean determining whether getWorkflowPlanExecutor() may be called
+     */
+    static bool hasWorkflowPlanExecutor();
+
     /**
      * Set workflow plan executor to \p workflowPlanExecutor (the application takes ownership of the pointer)
      * @param workflowPlanExecutor Pointer to workflow plan executor
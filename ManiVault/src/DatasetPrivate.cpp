@@ -108,13 +108,13 @@ void DatasetPrivate::connectNotify(const QMetaMethod& signal)
             _pendingSupportedEventTypes.insert(t);
     };
 
-    if (signal == QMetaMethod::fromSignal(&DatasetPrivate::dataChanged))
+    if (signal == QMetaMethod::fromSignal(&DatasetPrivate::dataChanged) || signal == QMetaMethod::fromSignal(&DatasetPrivate::dataRegionChanged))
         scheduleAdd(static_cast<std::uint32_t>(EventType::DatasetDataChanged));
 
     if (signal == QMetaMethod::fromSignal(&DatasetPrivate::dataDimensionsChanged))
         scheduleAdd(static_cast<std::uint32_t>(EventType::DatasetDataDimensionsChanged));
 
-    if (signal == QMetaMethod::fromSignal(&DatasetPrivate::dataSelectionChanged))
+    if (signal == QMetaMethod::fromSignal(&DatasetPrivate::dataSelectionChanged) || signal == QMetaMethod::fromSignal(&DatasetPrivate::dataSelectionDeltaChanged))
         scheduleAdd(static_cast<std::uint32_t>(EventType::DatasetDataSelectionChanged));
 
     if (signal == QMetaMethod::fromSignal(&DatasetPrivate::childAdded))
@@ -133,14 +133,18 @@ void DatasetPrivate::disconnectNotify(const QMetaMethod& signal)
             _pendingSupportedEventTypes.remove(t);
     };
 
-    if (signal == QMetaMethod::fromSignal(&DatasetPrivate::dataChanged))
-        scheduleRemove(static_cast<std::uint32_t>(EventType::DatasetDataChanged));
+    // Both data changed signals are served by the same event type
+    if (signal == QMetaMethod::fromSignal(&DatasetPrivate::dataChanged) || signal == QMetaMethod::fromSignal(&DatasetPrivate::dataRegionChanged))
+        if (!isSignalConnected(QMetaMethod::fromSignal(&DatasetPrivate::dataChanged)) && !isSignalConnected(QMetaMethod::fromSignal(&DatasetPrivate::dataRegionChanged)))
+            scheduleRemove(static_cast<std::uint32_t>(EventType::DatasetDataChanged));
 
     if (signal == QMetaMethod::fromSignal(&DatasetPrivate::dataDimensionsChanged))
         scheduleRemove(static_cast<std::uint32_t>(EventType::DatasetDataDimensionsChanged));
 
-    if (signal == QMetaMethod::fromSignal(&DatasetPrivate::dataSelectionChanged))
-        scheduleRemove(static_cast<std::uint32_t>(EventType::DatasetDataSelectionChanged));
+    // Both data selection changed signals are served by the same event type
+    if (signal == QMetaMethod::fromSignal(&DatasetPrivate::dataSelectionChanged) || signal == QMetaMethod::fromSignal(&DatasetPrivate::dataSelectionDeltaChanged))
+        if (!isSignalConnected(QMetaMethod::fromSignal(&DatasetPrivate::dataSelectionChanged)) && !isSignalConnected(QMetaMethod::fromSignal(&DatasetPrivate::dataSelectionDeltaChanged)))
+            scheduleRemove(static_cast<std::uint32_t>(EventType::DatasetDataSelectionChanged));
 
     if (signal == QMetaMethod::fromSignal(&DatasetPrivate::childAdded))
         scheduleRemove(static_cast<std::uint32_t>(EventType::DatasetChildAdded));
@@ -200,6 +204,7 @@ void DatasetPrivate::registerDatasetEvents()
                         break;
 
                     emit dataChanged();
+                    emit dataRegionChanged(static_cast<DatasetDataChangedEvent*>(dataEvent)->getRegion());
 
                     break;
                 }
@@ -220,6 +225,7 @@ void DatasetPrivate::registerDatasetEvents()
                         break;
 
                     emit dataSelectionChanged();
+                    emit dataSelectionDeltaChanged(static_cast<DatasetDataSelectionChangedEvent*>(dataEvent)->getDelta());
 
                     break;
                 }
@@ -6,6 +6,8 @@
 
 #include "ManiVaultGlobals.h"
 
+#include "event/DataChangedRegion.h"
+#include "event/SelectionDelta.h"
 #include "event/EventListener.h"
 #include "util/Exception.h"
 
@@ -125,12 +127,24 @@ signals:
     /** Emitted when dataset data changes. */
     void dataChanged();
 
+    /**
+     * @brief Emitted when dataset data changes, along with dataChanged().
+     * @param region Region of the data that changed (complete if the change was not described).
+     */
+    void dataRegionChanged(const mv::DataChangedRegion& region);
+
     /** Emitted when dataset dimensions change. */
     void dataDimensionsChanged();
 
     /** Emitted when dataset selection changes. */
     void dataSelectionChanged();
 
+    /**
+     * @brief Emitted when dataset selection changes, along with dataSelectionChanged().
+     * @param delta How the selection changed (replaced if the change was not described).
+     */
+    void dataSelectionDeltaChanged(const mv::SelectionDelta& delta);
+
     /** Emitted when the dataset GUI name changes. */
     void guiNameChanged();
 
@@ -8,8 +8,95 @@
 
 #include "util/Serialization.h"
 
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <iterator>
+
 using namespace mv::util;
 
+namespace
+{
+
+/**
+ * Restore unsigned 32-bit integers from a blob variant map
+ * @param blobVariantMap Blob variant map
+ * @return Unsigned 32-bit integers
+ */
+std::vector<std::uint32_t> uint32sFromBlobVariantMap(const QVariantMap& blobVariantMap)
+{
+    QByteArray bytes = bytesFromBlobVariantMap(blobVariantMap);
+
+    if (bytes.size() % qsizetype(sizeof(std::uint32_t)) != 0)
+        throw std::runtime_error("Serialized map byte size is not uint32-aligned");
+
+    std::vector<std::uint32_t> values(bytes.size() / qsizetype(sizeof(std::uint32_t)));
+
+    std::memcpy(
+        values.data(),
+        bytes.constData(),
+        size_t(bytes.size())
+    );
+
+    return values;
+}
+
+/** Number of point indices per grain when mapping point indices concurrently */
+constexpr std::size_t mapIndicesGrainSize = 1 << 16;
+
+/**
+ * Mark \p index in \p bitmap (thread-safe)
+ * @param bitmap Bitmap
+ * @param index Index to mark
+ */
+void markInBitmap(std::vector<std::uint64_t>& bitmap, std::uint32_t index)
+{
+    std::atomic_ref<std::uint64_t>(bitmap[index >> 6]).fetch_or(std::uint64_t{ 1 } << (index & 63), std::memory_order_relaxed);
+}
+
+/**
+ * Mark the indices [\p begin, \p end) in \p bitmap, a word at a time
+ * @param bitmap Bitmap
+ * @param begin First index to mark
+ * @param end One past the last index to mark
+ */
+void setBitRange(std::vector<std::uint64_t>& bitmap, std::uint64_t begin, std::uint64_t end)
+{
+    while (begin < end) {
+        const auto firstBit         = begin & 63;
+        const auto numberOfBits     = std::min<std::uint64_t>(64 - firstBit, end - begin);
+        const auto mask             = numberOfBits == 64 ? ~std::uint64_t{ 0 } : ((std::uint64_t{ 1 } << numberOfBits) - 1) << firstBit;
+
+        bitmap[static_cast<std::size_t>(begin >> 6)] |= mask;
+
+        begin += numberOfBits;
+    }
+}
+
+/**
+ * Get the indices marked in \p bitmap
+ * @param bitmap Bitmap
+ * @param indices Sorted marked indices (replaced)
+ */
+void bitmapToIndices(const std::vector<std::uint64_t>& bitmap, std::vector<std::uint32_t>& indices)
+{
+    std::size_t numberOfIndices = 0;
+
+    for (const auto word : bitmap)
+        numberOfIndices += static_cast<std::size_t>(std::popcount(word));
+
+    indices.clear();
+    indices.reserve(numberOfIndices);
+
+    for (std::uint32_t wordIndex = 0; wordIndex < bitmap.size(); ++wordIndex)
+        for (auto word = bitmap[wordIndex]; word != 0; word &= word - 1)
+            indices.push_back((wordIndex << 6) | static_cast<std::uint32_t>(std::countr_zero(word)));
+}
+
+}
+
 namespace mv
 {
 
@@ -26,6 +113,89 @@ SelectionMap::SelectionMap(const QSize& sourceImageSize, const QSize& targetImag
     _targetImageSize = targetImageSize;
 }
 
+SelectionMap::SelectionMap(const SelectionMap& other) :
+    Serializable(other),
+    _type(other._type),
+    _map(other._map),
+    _sourceImageSize(other._sourceImageSize),
+    _targetImageSize(other._targetImageSize),
+    _offsetRanges(other._offsetRanges),
+    _offsetRangeTargets(other._offsetRangeTargets),
+    _hasInjectiveOffsetRanges(other._hasInjectiveOffsetRanges)
+{
+    const std::lock_guard compressedMapLock(other._compressedMapMutex);
+
+    _compressedMap = other._compressedMap;
+}
+
+SelectionMap::SelectionMap(SelectionMap&& other) noexcept :
+    Serializable(other),
+    _type(other._type),
+    _map(std::move(other._map)),
+    _sourceImageSize(other._sourceImageSize),
+    _targetImageSize(other._targetImageSize),
+    _offsetRanges(std::move(other._offsetRanges)),
+    _offsetRangeTargets(std::move(other._offsetRangeTargets)),
+    _hasInjectiveOffsetRanges(other._hasInjectiveOffsetRanges),
+    _compressedMap(std::move(other._compressedMap))
+{
+}
+
+SelectionMap& SelectionMap::operator=(const SelectionMap& other)
+{
+    if (this == &other)
+        return *this;
+
+    Serializable::operator=(other);
+
+    _type               = other._type;
+    _map                = other._map;
+    _sourceImageSize    = other._sourceImageSize;
+    _targetImageSize    = other._targetImageSize;
+    _offsetRanges       = other._offsetRanges;
+    _offsetRangeTargets = other._offsetRangeTargets;
+
+    _hasInjectiveOffsetRanges = other._hasInjectiveOffsetRanges;
+
+    const std::scoped_lock compressedMapLocks(_compressedMapMutex, other._compressedMapMutex);
+
+    _compressedMap = other._compressedMap;
+
+    return *this;
+}
+
+SelectionMap& SelectionMap::operator=(SelectionMap&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    Serializable::operator=(other);
+
+    _type               = other._type;
+    _map                = std::move(other._map);
+    _sourceImageSize    = other._sourceImageSize;
+    _targetImageSize    = other._targetImageSize;
+    _offsetRanges       = std::move(other._offsetRanges);
+    _offsetRangeTargets = std::move(other._offsetRangeTargets);
+
+    _hasInjectiveOffsetRanges = other._hasInjectiveOffsetRanges;
+
+    const std::lock_guard compressedMapLock(_compressedMapMutex);
+
+    _compressedMap = std::move(other._compressedMap);
+
+    return *this;
+}
+
+SelectionMap::Map& SelectionMap::getMap()
+{
+    const std::lock_guard compressedMapLock(_compressedMapMutex);
+
+    _compressedMap.reset();
+
+    return _map;
+}
+
 void SelectionMap::populateMappingIndices(std::uint32_t pointIndex, Indices& indices) const
 {
     switch (_type)
@@ -36,46 +206,460 @@ void SelectionMap::populateMappingIndices(std::uint32_t pointIndex, Indices& ind
 
         case Type::ImagePyramid:
         {
-            const QPoint sourcePixelPosition(pointIndex % _sourceImageSize.width(), static_cast<std::int32_t>(floorf(static_cast<float>(pointIndex) / static_cast<float>(_sourceImageSize.width()))));
+            indices.clear();
 
-            const auto scaleFactor = static_cast<float>(_targetImageSize.width()) / static_cast<float>(_sourceImageSize.width());
+            const auto sourceWidth  = static_cast<std::uint64_t>(_sourceImageSize.width());
+            const auto targetWidth  = static_cast<std::uint64_t>(_targetImageSize.width());
+            const auto targetHeight = static_cast<std::uint64_t>(_targetImageSize.height());
 
-            if (scaleFactor == 1.0f)
-                indices = Indices({ pointIndex });
+            if (sourceWidth == 0)
+                break;
 
-            if (scaleFactor < 1.0f) {
-                const auto levelFactor = static_cast<std::uint32_t>(floorf(1.0f / scaleFactor));
+            const auto sourcePixelX = pointIndex % sourceWidth;
+            const auto sourcePixelY = pointIndex / sourceWidth;
+            const auto levelFactor  = getImagePyramidLevelFactor();
 
-                const QPoint targetPixelPosition(
-                    static_cast<std::int32_t>(floorf(static_cast<float>(sourcePixelPosition.x()) / static_cast<float>(levelFactor))),
-                    static_cast<std::int32_t>(floorf(static_cast<float>(sourcePixelPosition.y()) / static_cast<float>(levelFactor)))
-                );
+            switch (getImagePyramidScaling())
+            {
+                case ImagePyramidScaling::None:
+                    indices.push_back(pointIndex);
+                    break;
 
-                indices = Indices({ static_cast<std::uint32_t>(targetPixelPosition.y() * _targetImageSize.width() + targetPixelPosition.x()) });
-            }
+                case ImagePyramidScaling::Down:
+                {
+                    const auto targetPixelX = sourcePixelX / levelFactor;
+                    const auto targetPixelY = sourcePixelY / levelFactor;
 
-            if (scaleFactor > 1.0f) {
-                const auto levelFactor = static_cast<std::uint32_t>(floorf(scaleFactor));
+                    if (targetPixelX < targetWidth && targetPixelY < targetHeight)
+                        indices.push_back(static_cast<std::uint32_t>(targetPixelY * targetWidth + targetPixelX));
+
+                    break;
+                }
 
-                const QPoint targetPixelPositionStart(sourcePixelPosition.x() * levelFactor, sourcePixelPosition.y() * levelFactor);
-                const QPoint targetPixelPositionEnd(targetPixelPositionStart + QPoint(levelFactor, levelFactor));
+                case ImagePyramidScaling::Up:
+                {
+                    const auto targetPixelXBegin    = sourcePixelX * levelFactor;
+                    const auto targetPixelXEnd      = std::min(targetPixelXBegin + levelFactor, targetWidth);
+                    const auto targetPixelYBegin    = sourcePixelY * levelFactor;
+                    const auto targetPixelYEnd      = std::min(targetPixelYBegin + levelFactor, targetHeight);
 
-                indices.clear();
-                indices.reserve(static_cast<size_t>(levelFactor) * static_cast<size_t>(levelFactor));
+                    indices.reserve(static_cast<size_t>(levelFactor) * static_cast<size_t>(levelFactor));
 
-                for (std::int32_t targetPixelX = targetPixelPositionStart.x(); targetPixelX < targetPixelPositionEnd.x(); ++targetPixelX) {
-                    for (std::int32_t targetPixelY = targetPixelPositionStart.y(); targetPixelY < targetPixelPositionEnd.y(); ++targetPixelY) {
-                        if (targetPixelX >= _targetImageSize.width() || targetPixelY >= _targetImageSize.height())
-                            break;
+                    for (auto targetPixelX = targetPixelXBegin; targetPixelX < targetPixelXEnd; ++targetPixelX)
+                        for (auto targetPixelY = targetPixelYBegin; targetPixelY < targetPixelYEnd; ++targetPixelY)
+                            indices.push_back(static_cast<std::uint32_t>(targetPixelY * targetWidth + targetPixelX));
 
-                        indices.push_back(targetPixelY * _targetImageSize.width() + targetPixelX);
-                    }
+                    break;
                 }
             }
 
             break;
         }
+
+        case Type::OffsetRange:
+        {
+            indices.clear();
+
+            if (const auto offsetRange = findOffsetRange(pointIndex))
+                if (const auto targetIndex = offsetRange->getTargetIndex(pointIndex); targetIndex != invalidIndex)
+                    indices.push_back(targetIndex);
+
+            break;
+        }
+    }
+}
+
+void SelectionMap::populateMappingIndices(std::span<const std::uint32_t> pointIndices, Indices& mappedIndices) const
+{
+    switch (_type)
+    {
+        case Type::Indexed:
+        {
+            const auto compressedMap = getCompressedMap();
+
+            for (const auto pointIndex : pointIndices)
+                if (const auto row = compressedMap->findRow(pointIndex); row != invalidIndex)
+                    mappedIndices.insert(mappedIndices.end(), compressedMap->targets.begin() + compressedMap->offsets[row], compressedMap->targets.begin() + compressedMap->offsets[row + 1]);
+
+            break;
+        }
+
+        case Type::ImagePyramid:
+        {
+            std::vector<std::uint64_t> bitmap;
+            Indices indices;
+
+            markImagePyramidTargets(pointIndices, bitmap);
+            bitmapToIndices(bitmap, indices);
+
+            mappedIndices.insert(mappedIndices.end(), indices.begin(), indices.end());
+
+            break;
+        }
+
+        case Type::OffsetRange:
+        {
+            const OffsetRange* offsetRange = nullptr;
+
+            for (const auto pointIndex : pointIndices) {
+                // Consecutive point indices usually fall in the same range, so only search when leaving it
+                if (offsetRange == nullptr || pointIndex < offsetRange->sourceBegin || pointIndex >= offsetRange->sourceEnd)
+                    offsetRange = findOffsetRange(pointIndex);
+
+                if (offsetRange == nullptr)
+                    continue;
+
+                if (const auto targetIndex = offsetRange->getTargetIndex(pointIndex); targetIndex != invalidIndex)
+                    mappedIndices.push_back(targetIndex);
+            }
+
+            break;
+        }
+    }
+}
+
+void SelectionMap::mapIndices(std::span<const std::uint32_t> pointIndices, Indices& mappedIndices) const
+{
+    if (_type == Type::ImagePyramid) {
+        std::vector<std::uint64_t> bitmap;
+
+        markImagePyramidTargets(pointIndices, bitmap);
+        bitmapToIndices(bitmap, mappedIndices);
+
+        return;
+    }
+
+    if (_type != Type::Indexed) {
+        Indices allMappedIndices;
+
+        allMappedIndices.reserve(pointIndices.size());
+
+        populateMappingIndices(pointIndices, allMappedIndices);
+
+        const auto maximumMappedIndex = std::max_element(allMappedIndices.begin(), allMappedIndices.end());
+
+        std::vector<std::uint64_t> bitmap(maximumMappedIndex == allMappedIndices.end() ? 0 : (static_cast<std::size_t>(*maximumMappedIndex) >> 6) + 1);
+
+        for (const auto mappedIndex : allMappedIndices)
+            bitmap[mappedIndex >> 6] |= std::uint64_t{ 1 } << (mappedIndex & 63);
+
+        bitmapToIndices(bitmap, mappedIndices);
+
+        return;
+    }
+
+    const auto compressedMap = getCompressedMap();
+
+    std::vector<std::uint64_t> bitmap(static_cast<std::size_t>((compressedMap->targetsEnd + 63) >> 6));
+
+    // Mark the targets of the point indices in [begin, end) in the (shared) bitmap
+    const auto markTargets = [&pointIndices, &compressedMap, &bitmap](std::size_t begin, std::size_t end) -> void {
+        const auto& offsets = compressedMap->offsets;
+        const auto& targets = compressedMap->targets;
+
+        for (std::size_t index = begin; index < end; ++index) {
+            const auto row = compressedMap->findRow(pointIndices[index]);
+
+            if (row == invalidIndex)
+                continue;
+
+            for (auto offset = offsets[row]; offset < offsets[row + 1]; ++offset)
+                markInBitmap(bitmap, targets[offset]);
+        }
+    };
+
+    if (pointIndices.size() <= mapIndicesGrainSize) {
+        markTargets(0, pointIndices.size());
+    }
+    else {
+        std::vector<std::pair<std::size_t, std::size_t>> grains;
+
+        for (std::size_t begin = 0; begin < pointIndices.size(); begin += mapIndicesGrainSize)
+            grains.emplace_back(begin, std::min(begin + mapIndicesGrainSize, pointIndices.size()));
+
+        QtConcurrent::blockingMap(grains, [&markTargets](const std::pair<std::size_t, std::size_t>& grain) -> void {
+            markTargets(grain.first, grain.second);
+        });
+    }
+
+    bitmapToIndices(bitmap, mappedIndices);
+}
+
+IndexSet SelectionMap::getMappedIndexSet() const
+{
+    switch (_type)
+    {
+        case Type::Indexed:
+            return IndexSet(getCompressedMap()->targets);
+
+        case Type::ImagePyramid:
+            return IndexSet::fromRange(0, static_cast<std::uint64_t>(_targetImageSize.width()) * static_cast<std::uint64_t>(_targetImageSize.height()));
+
+        case Type::OffsetRange:
+            return _offsetRangeTargets;
     }
+
+    return {};
+}
+
+bool SelectionMap::isInjective() const
+{
+    switch (_type)
+    {
+        case Type::Indexed:
+            return getCompressedMap()->isInjective;
+
+        case Type::ImagePyramid:
+            return getImagePyramidScaling() != ImagePyramidScaling::Down;
+
+        case Type::OffsetRange:
+            return _hasInjectiveOffsetRanges;
+    }
+
+    return false;
+}
+
+SelectionDelta SelectionMap::mapSelectionDelta(const SelectionDelta& delta) const
+{
+    if (delta.isReplaced())
+        return delta;
+
+    // Another point index may keep the mapping index of a removed point index selected
+    if (!delta.getRemoved().isEmpty() && !isInjective())
+        return {};
+
+    Indices mappedAddedIndices, mappedRemovedIndices;
+
+    mapIndices(delta.getAdded().toIndices(), mappedAddedIndices);
+    mapIndices(delta.getRemoved().toIndices(), mappedRemovedIndices);
+
+    return { IndexSet(mappedAddedIndices), IndexSet(mappedRemovedIndices) };
+}
+
+void SelectionMap::addOffsetRange(OffsetRange offsetRange)
+{
+    const auto position = std::upper_bound(_offsetRanges.begin(), _offsetRanges.end(), offsetRange.sourceBegin, [](std::uint32_t sourceBegin, const OffsetRange& other) -> bool {
+        return sourceBegin < other.sourceBegin;
+    });
+
+    // Only the target indices of the new range are visited, so adding n ranges is not quadratic in n
+    IndexSet        rangeTargets;
+    std::uint64_t   numberOfRangeTargets = 0;
+
+    if (offsetRange.targetIndices.empty()) {
+        numberOfRangeTargets    = offsetRange.sourceEnd - offsetRange.sourceBegin;
+        rangeTargets            = IndexSet::fromRange(offsetRange.targetBegin, static_cast<std::uint64_t>(offsetRange.targetBegin) + numberOfRangeTargets);
+    }
+    else {
+        Indices mappedIndices;
+
+        mappedIndices.reserve(offsetRange.targetIndices.size());
+
+        std::copy_if(offsetRange.targetIndices.begin(), offsetRange.targetIndices.end(), std::back_inserter(mappedIndices), [](std::uint32_t targetIndex) -> bool {
+            return targetIndex != invalidIndex;
+        });
+
+        numberOfRangeTargets    = mappedIndices.size();
+        rangeTargets            = IndexSet(mappedIndices);
+    }
+
+    // The mapping stays injective as long as the target indices of the range are unique and not yet mapped to
+    if (_hasInjectiveOffsetRanges)
+        _hasInjectiveOffsetRanges = rangeTargets.size() == numberOfRangeTargets && (_offsetRangeTargets & rangeTargets).isEmpty();
+
+    _offsetRangeTargets |= rangeTargets;
+
+    _offsetRanges.insert(position, std::move(offsetRange));
+}
+
+SelectionMap::ImagePyramidScaling SelectionMap::getImagePyramidScaling() const
+{
+    const auto scaleFactor = static_cast<float>(_targetImageSize.width()) / static_cast<float>(_sourceImageSize.width());
+
+    if (scaleFactor < 1.0f)
+        return ImagePyramidScaling::Down;
+
+    if (scaleFactor > 1.0f)
+        return ImagePyramidScaling::Up;
+
+    return ImagePyramidScaling::None;
+}
+
+std::uint64_t SelectionMap::getImagePyramidLevelFactor() const
+{
+    const auto scaleFactor = static_cast<float>(_targetImageSize.width()) / static_cast<float>(_sourceImageSize.width());
+
+    switch (getImagePyramidScaling())
+    {
+        case ImagePyramidScaling::None:
+            break;
+
+        case ImagePyramidScaling::Down:
+            return std::max<std::uint64_t>(1, static_cast<std::uint64_t>(floorf(1.0f / scaleFactor)));
+
+        case ImagePyramidScaling::Up:
+            return std::max<std::uint64_t>(1, static_cast<std::uint64_t>(floorf(scaleFactor)));
+    }
+
+    return 1;
+}
+
+void SelectionMap::markImagePyramidTargets(std::span<const std::uint32_t> pointIndices, std::vector<std::uint64_t>& bitmap) const
+{
+    const auto sourceWidth              = static_cast<std::uint64_t>(_sourceImageSize.width());
+    const auto targetWidth              = static_cast<std::uint64_t>(_targetImageSize.width());
+    const auto targetHeight             = static_cast<std::uint64_t>(_targetImageSize.height());
+    const auto numberOfSourcePixels     = sourceWidth * static_cast<std::uint64_t>(_sourceImageSize.height());
+    const auto numberOfTargetPixels     = targetWidth * targetHeight;
+
+    bitmap.assign(static_cast<std::size_t>((numberOfTargetPixels + 63) >> 6), 0);
+
+    if (sourceWidth == 0 || numberOfTargetPixels == 0)
+        return;
+
+    const auto levelFactor = getImagePyramidLevelFactor();
+
+    switch (getImagePyramidScaling())
+    {
+        case ImagePyramidScaling::None:
+        {
+            for (const std::uint64_t pointIndex : pointIndices)
+                if (pointIndex < numberOfSourcePixels && pointIndex < numberOfTargetPixels)
+                    setBitRange(bitmap, pointIndex, pointIndex + 1);
+
+            break;
+        }
+
+        case ImagePyramidScaling::Down:
+        {
+            // Each source pixel marks the target pixel which covers it
+            for (const std::uint64_t pointIndex : pointIndices) {
+                if (pointIndex >= numberOfSourcePixels)
+                    continue;
+
+                const auto targetPixelX = (pointIndex % sourceWidth) / levelFactor;
+                const auto targetPixelY = (pointIndex / sourceWidth) / levelFactor;
+
+                if (targetPixelX < targetWidth && targetPixelY < targetHeight)
+                    setBitRange(bitmap, targetPixelY * targetWidth + targetPixelX, targetPixelY * targetWidth + targetPixelX + 1);
+            }
+
+            break;
+        }
+
+        case ImagePyramidScaling::Up:
+        {
+            // Each source pixel marks a block of target pixels, row span by row span
+            for (const std::uint64_t pointIndex : pointIndices) {
+                if (pointIndex >= numberOfSourcePixels)
+                    continue;
+
+                const auto targetPixelXBegin = (pointIndex % sourceWidth) * levelFactor;
+                const auto targetPixelYBegin = (pointIndex / sourceWidth) * levelFactor;
+
+                if (targetPixelXBegin >= targetWidth)
+                    continue;
+
+                const auto targetPixelXEnd = std::min(targetPixelXBegin + levelFactor, targetWidth);
+                const auto targetPixelYEnd = std::min(targetPixelYBegin + levelFactor, targetHeight);
+
+                for (auto targetPixelY = targetPixelYBegin; targetPixelY < targetPixelYEnd; ++targetPixelY)
+                    setBitRange(bitmap, targetPixelY * targetWidth + targetPixelXBegin, targetPixelY * targetWidth + targetPixelXEnd);
+            }
+
+            break;
+        }
+    }
+}
+
+std::uint32_t SelectionMap::CompressedMap::findRow(std::uint32_t pointIndex) const
+{
+    if (pointIndices.empty()) {
+        if (pointIndex < firstPointIndex || pointIndex - firstPointIndex >= offsets.size() - 1)
+            return invalidIndex;
+
+        return pointIndex - firstPointIndex;
+    }
+
+    const auto it = std::lower_bound(pointIndices.begin(), pointIndices.end(), pointIndex);
+
+    if (it == pointIndices.end() || *it != pointIndex)
+        return invalidIndex;
+
+    return static_cast<std::uint32_t>(it - pointIndices.begin());
+}
+
+std::shared_ptr<const SelectionMap::CompressedMap> SelectionMap::getCompressedMap() const
+{
+    const std::lock_guard compressedMapLock(_compressedMapMutex);
+
+    if (_compressedMap)
+        return _compressedMap;
+
+    auto compressedMap = std::make_shared<CompressedMap>();
+
+    std::size_t numberOfTargets = 0;
+
+    for (const auto& [pointIndex, targets] : _map)
+        numberOfTargets += targets.size();
+
+    compressedMap->targets.reserve(numberOfTargets);
+
+    if (!_map.empty()) {
+        const auto firstPointIndex  = _map.begin()->first;
+        const auto numberOfRows     = static_cast<std::size_t>(_map.rbegin()->first - firstPointIndex) + 1;
+
+        // Use a dense row per point index if the point indices are (nearly) consecutive, otherwise store the point index of each row
+        const auto hasDenseRows = numberOfRows <= 2 * _map.size();
+
+        if (hasDenseRows) {
+            compressedMap->firstPointIndex = firstPointIndex;
+            compressedMap->offsets.reserve(numberOfRows + 1);
+        }
+        else {
+            compressedMap->pointIndices.reserve(_map.size());
+            compressedMap->offsets.reserve(_map.size() + 1);
+        }
+
+        for (const auto& [pointIndex, targets] : _map) {
+            if (hasDenseRows) {
+                // Empty rows for point indices without a mapping
+                compressedMap->offsets.resize(pointIndex - firstPointIndex, static_cast<std::uint32_t>(compressedMap->targets.size()));
+            }
+            else {
+                compressedMap->pointIndices.push_back(pointIndex);
+            }
+
+            compressedMap->offsets.push_back(static_cast<std::uint32_t>(compressedMap->targets.size()));
+            compressedMap->targets.insert(compressedMap->targets.end(), targets.begin(), targets.end());
+        }
+    }
+
+    compressedMap->offsets.push_back(static_cast<std::uint32_t>(compressedMap->targets.size()));
+
+    if (const auto maximumTarget = std::max_element(compressedMap->targets.begin(), compressedMap->targets.end()); maximumTarget != compressedMap->targets.end())
+        compressedMap->targetsEnd = static_cast<std::uint64_t>(*maximumTarget) + 1;
+
+    compressedMap->isInjective = IndexSet(compressedMap->targets).size() == compressedMap->targets.size();
+
+    _compressedMap = std::move(compressedMap);
+
+    return _compressedMap;
+}
+
+const SelectionMap::OffsetRange* SelectionMap::findOffsetRange(std::uint32_t pointIndex) const
+{
+    // Find the last range which starts at or before the point index
+    auto offsetRange = std::upper_bound(_offsetRanges.begin(), _offsetRanges.end(), pointIndex, [](std::uint32_t pointIndex, const OffsetRange& other) -> bool {
+        return pointIndex < other.sourceBegin;
+    });
+
+    if (offsetRange == _offsetRanges.begin())
+        return nullptr;
+
+    --offsetRange;
+
+    return pointIndex < offsetRange->sourceEnd ? &*offsetRange : nullptr;
 }
 
 bool SelectionMap::hasMappingForPointIndex(std::uint32_t pointIndex) const
@@ -86,7 +670,14 @@ bool SelectionMap::hasMappingForPointIndex(std::uint32_t pointIndex) const
             return _map.find(pointIndex) != _map.end();
 
         case Type::ImagePyramid:
-            return pointIndex < static_cast<std::uint32_t>(_sourceImageSize.width() * _sourceImageSize.height());
+            return pointIndex < static_cast<std::uint64_t>(_sourceImageSize.width()) * static_cast<std::uint64_t>(_sourceImageSize.height());
+
+        case Type::OffsetRange:
+        {
+            const auto offsetRange = findOffsetRange(pointIndex);
+
+            return offsetRange != nullptr && offsetRange->getTargetIndex(pointIndex) != invalidIndex;
+        }
     }
 
     return false;
@@ -108,25 +699,13 @@ void SelectionMap::fromVariantMap(const QVariantMap& variantMap)
     _sourceImageSize.setWidth(SourceImageSizeMap["Width"].toInt());
     _sourceImageSize.setHeight(SourceImageSizeMap["Height"].toInt());
 
-    auto TargetImageSizeMap = variantMap["SourceImageSize"].toMap();
+    auto TargetImageSizeMap = variantMap["TargetImageSize"].toMap();
     _targetImageSize.setWidth(TargetImageSizeMap["Width"].toInt());
     _targetImageSize.setHeight(TargetImageSizeMap["Height"].toInt());
 
-    std::vector<std::uint32_t> serializedMap;
-    serializedMap.resize(static_cast<size_t>(variantMap["SerializedMapSize"].toInt()));
-
-    QByteArray bytes = bytesFromBlobVariantMap(variantMap["SerializedMap"].toMap());
+    const auto serializedMap = uint32sFromBlobVariantMap(variantMap["SerializedMap"].toMap());
 
-    if (bytes.size() % qsizetype(sizeof(std::uint32_t)) != 0)
-        throw std::runtime_error("SerializedMap byte size is not uint32-aligned");
-
-    serializedMap.resize(bytes.size() / qsizetype(sizeof(std::uint32_t)));
-
-    std::memcpy(
-        serializedMap.data(),
-        bytes.constData(),
-        size_t(bytes.size())
-    );
+    auto& map = getMap();
 
     uint32_t key(0), size(0);
     for (auto it = serializedMap.begin(); it != serializedMap.end(); )
@@ -135,9 +714,41 @@ void SelectionMap::fromVariantMap(const QVariantMap& variantMap)
         it++;
         size = *it;
         it++;
-        _map[key] = std::vector<std::uint32_t>(it, it + size);
+        map[key] = std::vector<std::uint32_t>(it, it + size);
         it += size;
     }
+
+    _offsetRanges.clear();
+    _offsetRangeTargets.clear();
+
+    _hasInjectiveOffsetRanges = true;
+
+    if (variantMap.contains("OffsetRanges")) {
+        const auto serializedOffsetRanges = uint32sFromBlobVariantMap(variantMap["OffsetRanges"].toMap());
+
+        for (auto it = serializedOffsetRanges.begin(); it != serializedOffsetRanges.end(); )
+        {
+            if (serializedOffsetRanges.end() - it < 4)
+                throw std::runtime_error("Serialized offset range is truncated");
+
+            OffsetRange offsetRange;
+
+            offsetRange.sourceBegin = *it++;
+            offsetRange.sourceEnd   = *it++;
+            offsetRange.targetBegin = *it++;
+
+            const auto numberOfTargetIndices = *it++;
+
+            if (static_cast<std::uint32_t>(serializedOffsetRanges.end() - it) < numberOfTargetIndices)
+                throw std::runtime_error("Serialized offset range target indices are truncated");
+
+            offsetRange.targetIndices.assign(it, it + numberOfTargetIndices);
+
+            it += numberOfTargetIndices;
+
+            addOffsetRange(std::move(offsetRange));
+        }
+    }
 }
 
 QVariantMap SelectionMap::toVariantMap() const
@@ -165,11 +776,25 @@ QVariantMap SelectionMap::toVariantMap() const
     };
 
     variantMap["Type"]              = QVariant::fromValue(static_cast<std::int32_t>(_type));
-    variantMap["SerializedMap"]     = bytesToBlobVariantMap((char*)serializedMap.data(), serializedMap.size() * sizeof(std::uint32_t));
+    variantMap["SerializedMap"]     = indicesToBlobVariantMap(serializedMap.data(), serializedMap.size());
     variantMap["SerializedMapSize"] = QVariant::fromValue(serializedMap.size());
     variantMap["SourceImageSize"]   = QVariant::fromValue(sourceImageSize);
     variantMap["TargetImageSize"]   = QVariant::fromValue(targetImageSize);
 
+    if (_type == Type::OffsetRange) {
+        // serialize the offset ranges as: source begin, source end, target begin, number of target indices, target indices
+        std::vector<std::uint32_t> serializedOffsetRanges;
+
+        for (const auto& offsetRange : _offsetRanges)
+        {
+            serializedOffsetRanges.insert(serializedOffsetRanges.end(), { offsetRange.sourceBegin, offsetRange.sourceEnd, offsetRange.targetBegin, static_cast<std::uint32_t>(offsetRange.targetIndices.size()) });
+            serializedOffsetRanges.insert(serializedOffsetRanges.end(), offsetRange.targetIndices.begin(), offsetRange.targetIndices.end());
+        }
+
+        variantMap["OffsetRanges"]      = indicesToBlobVariantMap(serializedOffsetRanges.data(), serializedOffsetRanges.size());
+        variantMap["OffsetRangesSize"]  = QVariant::fromValue(serializedOffsetRanges.size());
+    }
+
     return variantMap;
 }
 
@@ -201,11 +826,32 @@ const SelectionMap& LinkedData::getMapping() const
 void LinkedData::setMapping(SelectionMap& mapping)
 {
     _mapping = mapping;
+
+    setMappedSelectionDelta({}, {});
 }
 
 void LinkedData::setMapping(SelectionMap&& mapping)
 {
     _mapping = std::move(mapping);
+
+    setMappedSelectionDelta({}, {});
+}
+
+SelectionDelta LinkedData::mapSelectionDelta(const SelectionDelta& delta) const
+{
+    if (delta.isReplaced())
+        return delta;
+
+    if (delta != _lastSelectionDelta)
+        setMappedSelectionDelta(delta, _mapping.mapSelectionDelta(delta));
+
+    return _lastMappedSelectionDelta;
+}
+
+void LinkedData::setMappedSelectionDelta(const SelectionDelta& delta, const SelectionDelta& mappedDelta) const
+{
+    _lastSelectionDelta         = delta;
+    _lastMappedSelectionDelta   = mappedDelta;
 }
 
 void LinkedData::fromVariantMap(const QVariantMap& variantMap)
@@ -219,6 +865,8 @@ void LinkedData::fromVariantMap(const QVariantMap& variantMap)
     _targetDataSet.setDatasetId(variantMap["TargetDataset"].toString());
 
     _mapping.fromParentVariantMap(variantMap);
+
+    setMappedSelectionDelta({}, {});
 }
 
 QVariantMap LinkedData::toVariantMap() const
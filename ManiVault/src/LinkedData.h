@@ -6,9 +6,15 @@
 
 #include "Dataset.h"
 
+#include "event/SelectionDelta.h"
+#include "util/IndexSet.h"
 #include "util/Serializable.h"
 
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <vector>
 
 namespace mv
@@ -24,12 +30,39 @@ public:
     enum class Type
     {
         Indexed,            /** Using mapped indices */
-        ImagePyramid        /** Using image pyramids */
+        ImagePyramid,       /** Using image pyramids */
+        OffsetRange         /** Using ranges of consecutive point indices (e.g. the members of a proxy dataset) */
     };
 
     using Indices   = std::vector<std::uint32_t>;
     using Map       = std::map<std::uint32_t, Indices>;
 
+    static constexpr std::uint32_t invalidIndex = std::numeric_limits<std::uint32_t>::max();    /** Marks unmapped point indices in an offset range lookup table */
+
+    /**
+     * Maps the consecutive point indices [sourceBegin, sourceEnd) to target indices, either by
+     * offset (the target index of point index i is targetBegin + i - sourceBegin) or through a
+     * lookup table with the target index of each point index in the range
+     */
+    struct OffsetRange
+    {
+        std::uint32_t   sourceBegin = 0;    /** First point index of the range */
+        std::uint32_t   sourceEnd   = 0;    /** One past the last point index of the range */
+        std::uint32_t   targetBegin = 0;    /** Target index of the first point index (when mapping by offset) */
+        Indices         targetIndices;      /** Target index of each point index in the range or invalidIndex if it is unmapped (empty when mapping by offset) */
+
+        /**
+         * Get the target index of \p pointIndex
+         * @param pointIndex Point index in [sourceBegin, sourceEnd)
+         * @return Target index, or invalidIndex if the point index is not mapped
+         */
+        std::uint32_t getTargetIndex(std::uint32_t pointIndex) const {
+            return targetIndices.empty() ? targetBegin + (pointIndex - sourceBegin) : targetIndices[pointIndex - sourceBegin];
+        }
+    };
+
+    using OffsetRanges = std::vector<OffsetRange>;
+
 public:
 
     /**
@@ -45,6 +78,18 @@ public:
      */
     SelectionMap(const QSize& sourceImageSize, const QSize& targetImageSize);
 
+    /** Copy construct from \p other (shares its compressed map) */
+    SelectionMap(const SelectionMap& other);
+
+    /** Move construct from \p other */
+    SelectionMap(SelectionMap&& other) noexcept;
+
+    /** Copy assign from \p other (shares its compressed map) */
+    SelectionMap& operator=(const SelectionMap& other);
+
+    /** Move assign from \p other */
+    SelectionMap& operator=(SelectionMap&& other) noexcept;
+
     /**
      * Populate mapping \p indices for \p pointIndex
      * @param pointIndex Point index for which to populate
@@ -53,10 +98,46 @@ public:
     void populateMappingIndices(std::uint32_t pointIndex, Indices& indices) const;
 
     /**
-     * Get map for indexed pixels
+     * Append the mapping indices of all \p pointIndices which have a mapping to \p mappedIndices
+     * @param pointIndices Point indices to map
+     * @param mappedIndices Mapping indices (appended to)
+     */
+    void populateMappingIndices(std::span<const std::uint32_t> pointIndices, Indices& mappedIndices) const;
+
+    /**
+     * Map all \p pointIndices at once. Indexed maps are looked up in their compressed form (see getMap()), large
+     * inputs are mapped concurrently and the result is deduplicated through a bitmap of the mapping indices.
+     * @param pointIndices Point indices to map
+     * @param mappedIndices Sorted unique mapping indices of the point indices which have a mapping (replaced)
+     */
+    void mapIndices(std::span<const std::uint32_t> pointIndices, Indices& mappedIndices) const;
+
+    /**
+     * Get the set of all indices which the mapping maps to
+     * @return Index set of the mapping indices
+     */
+    util::IndexSet getMappedIndexSet() const;
+
+    /**
+     * Get whether no two point indices map to the same index, in which case a selection delta can be mapped as a
+     * whole (the mapping indices of removed point indices are not kept selected by other point indices)
+     * @return Boolean determining whether the mapping is injective
+     */
+    bool isInjective() const;
+
+    /**
+     * Map selection \p delta of the source to the target. Added indices are always mapped, removed indices only if
+     * the mapping is injective, otherwise the mapped delta replaces the selection.
+     * @param delta Selection delta of the source
+     * @return Selection delta of the target
+     */
+    SelectionDelta mapSelectionDelta(const SelectionDelta& delta) const;
+
+    /**
+     * Get map for indexed pixels, discards the compressed form of the map (which is rebuilt on the next batch lookup)
      * @return Index map
      */
-    Map& getMap() { return _map; };
+    Map& getMap();
 
     /**
      * Get map for indexed pixels
@@ -64,6 +145,18 @@ public:
      */
     const Map& getMap() const { return _map; };
 
+    /**
+     * Add \p offsetRange (for offset range mappings), its point indices may not overlap with those of the other offset ranges
+     * @param offsetRange Offset range
+     */
+    void addOffsetRange(OffsetRange offsetRange);
+
+    /**
+     * Get offset ranges (for offset range mappings)
+     * @return Offset ranges, sorted by their first point index
+     */
+    const OffsetRanges& getOffsetRanges() const { return _offsetRanges; }
+
     /**
      * Establishes whether a mapping exists for \p pointIndex
      * @param pointIndex Point index to check for
@@ -84,10 +177,72 @@ public:
     QVariantMap toVariantMap() const override;
 
 private:
-    Type    _type;              /** The type of selection map */
-    Map     _map;               /** Map contents (when mapping type is indexed) */
-    QSize   _sourceImageSize;   /** Source image size (when mapping type is image pyramid) */
-    QSize   _targetImageSize;   /** Target image size (when mapping type is image pyramid) */
+
+    /** Direction of an image pyramid mapping */
+    enum class ImagePyramidScaling
+    {
+        None,       /** Source and target have the same resolution */
+        Down,       /** Each target pixel covers a block of source pixels */
+        Up          /** Each source pixel covers a block of target pixels */
+    };
+
+    /** Get the direction of the image pyramid mapping (determined by the image widths) */
+    ImagePyramidScaling getImagePyramidScaling() const;
+
+    /** Get the size (along each axis) of the pixel blocks of the image pyramid mapping */
+    std::uint64_t getImagePyramidLevelFactor() const;
+
+    /**
+     * Mark the target pixels of the source pixels \p pointIndices of the image pyramid mapping in \p bitmap (one bit per
+     * target pixel). Down-sampling marks the single target pixel of each source pixel, up-sampling marks the block of each
+     * source pixel as one span of bits per target row (a word operation per 64 target pixels).
+     * @param pointIndices Source pixel indices
+     * @param bitmap Bitmap of the target pixels (replaced)
+     */
+    void markImagePyramidTargets(std::span<const std::uint32_t> pointIndices, std::vector<std::uint64_t>& bitmap) const;
+
+    /** Immutable compressed sparse row (CSR) form of the indexed map, used for batch lookups */
+    struct CompressedMap
+    {
+        std::uint32_t   firstPointIndex = 0;    /** Point index of the first row (when the rows are dense) */
+        Indices         pointIndices;           /** Sorted point index of each row (empty when the rows are dense, i.e. one row per point index from firstPointIndex) */
+        Indices         offsets;                /** Offset of the first target of each row, followed by the total number of targets */
+        Indices         targets;                /** Targets of all rows */
+        std::uint64_t   targetsEnd = 0;         /** One past the largest target */
+        bool            isInjective = true;     /** Whether all targets are unique */
+
+        /**
+         * Find the row of \p pointIndex
+         * @param pointIndex Point index
+         * @return Row index, or invalidIndex if the point index has no row
+         */
+        std::uint32_t findRow(std::uint32_t pointIndex) const;
+    };
+
+    /**
+     * Get the compressed form of the indexed map, builds it if needed
+     * @return Shared pointer to the compressed map
+     */
+    std::shared_ptr<const CompressedMap> getCompressedMap() const;
+
+    /**
+     * Find the offset range which contains \p pointIndex
+     * @param pointIndex Point index
+     * @return Pointer to the offset range, nullptr if there is none
+     */
+    const OffsetRange* findOffsetRange(std::uint32_t pointIndex) const;
+
+private:
+    Type            _type;              /** The type of selection map */
+    Map             _map;               /** Map contents (when mapping type is indexed) */
+    QSize           _sourceImageSize;   /** Source image size (when mapping type is image pyramid) */
+    QSize           _targetImageSize;   /** Target image size (when mapping type is image pyramid) */
+    OffsetRanges    _offsetRanges;      /** Offset ranges sorted by their first point index (when mapping type is offset range) */
+    util::IndexSet  _offsetRangeTargets;                /** Target indices of all offset ranges (maintained by addOffsetRange()) */
+    bool            _hasInjectiveOffsetRanges = true;   /** Whether all target indices of the offset ranges are unique */
+
+    mutable std::mutex                              _compressedMapMutex;    /** Guards the compressed map */
+    mutable std::shared_ptr<const CompressedMap>    _compressedMap;         /** Compressed form of the indexed map (built on demand) */
 };
 
 class CORE_EXPORT LinkedData : public util::Serializable
@@ -105,6 +260,23 @@ public:
     void setMapping(SelectionMap& map);
     void setMapping(SelectionMap&& map);
 
+    /**
+     * Map selection \p delta of the source dataset to the target dataset (see SelectionMap::mapSelectionDelta()). The last
+     * mapped delta is remembered, so that updating the target selection and notifying listeners map a delta only once.
+     * Selection changes are propagated on the GUI thread, so the remembered delta is not guarded.
+     * @param delta Selection delta of the source dataset
+     * @return Selection delta of the target dataset
+     */
+    SelectionDelta mapSelectionDelta(const SelectionDelta& delta) const;
+
+    /**
+     * Remember \p mappedDelta as the mapping of \p delta, for instance a replaced delta when the target selection was
+     * replaced instead of changed incrementally (so that listeners are told to read the whole selection)
+     * @param delta Selection delta of the source dataset
+     * @param mappedDelta Selection delta of the target dataset
+     */
+    void setMappedSelectionDelta(const SelectionDelta& delta, const SelectionDelta& mappedDelta) const;
+
     /**
      * Load from variant map
      * @param variantMap Variant map
@@ -121,6 +293,8 @@ private:
     Dataset<DatasetImpl>    _sourceDataSet;
     Dataset<DatasetImpl>    _targetDataSet;
     SelectionMap            _mapping;
+    mutable SelectionDelta  _lastSelectionDelta;        /** Last selection delta of the source which was mapped */
+    mutable SelectionDelta  _lastMappedSelectionDelta;  /** Its mapping to the target */
 };
 
 }
@@ -10,6 +10,9 @@
 #include "private/PassthroughBlobCodecFactory.h"
 #include "private/ZstdBlobCodec.h"
 #include "private/ZstdBlobCodecFactory.h"
+#include "private/Lz4BlobCodecFactory.h"
+#include "private/DeltaVarintBlobCodecFactory.h"
+#include "private/ShuffleBlobCodecFactory.h"
 #include "private/TaskflowWorkflowPlanExecutor.h"
 
 #include <Application.h>
@@ -78,6 +81,9 @@ int main(int argc, char *argv[])
 
     codecRegistry().registerFactory(std::make_unique<PassthroughBlobCodecFactory>(&application));
     codecRegistry().registerFactory(std::make_unique<ZstdBlobCodecFactory>(&application));
+    codecRegistry().registerFactory(std::make_unique<Lz4BlobCodecFactory>(&application));
+    codecRegistry().registerFactory(std::make_unique<DeltaVarintBlobCodecFactory>(&application));
+    codecRegistry().registerFactory(std::make_unique<ShuffleBlobCodecFactory>(&application));
 
     Core core;
 
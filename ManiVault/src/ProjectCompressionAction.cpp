@@ -36,6 +36,8 @@ ProjectCompressionAction::ProjectCompressionAction(QObject* parent /*= nullptr*/
 
     addCodec(&codecRegistry().factory(BlobCodec::Type::None));
     addCodec(&codecRegistry().factory(BlobCodec::Type::Zstd));
+    addCodec(&codecRegistry().factory(BlobCodec::Type::Lz4));
+    addCodec(&codecRegistry().factory(BlobCodec::Type::Shuffle));
 
     _codecTypeAction.initialize(typeNameForDisplayName.keys(), codecRegistry().factory(BlobCodec::Type::Zstd).displayName());
 
@@ -135,7 +135,7 @@ namespace
         raw["__OptimizedVariantList"]   = true;
         raw["Type"]                     = typeName;
         raw["Count"]                    = static_cast<qulonglong>(values.size());
-        raw["Data"]                     = bytesToBlobVariantMap(reinterpret_cast<const char*>(values.constData()), static_cast<std::uint64_t>(values.size() * sizeof(T)));
+        raw["Data"]                     = bytesToBlobVariantMap(reinterpret_cast<const char*>(values.constData()), static_cast<std::uint64_t>(values.size() * sizeof(T)), sizeof(T));
 
         return raw;
     }
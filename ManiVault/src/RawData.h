@@ -8,7 +8,12 @@
 #include "DataType.h"
 #include "Application.h"
 
+#include <QMutex>
+#include <QMutexLocker>
 #include <QString>
+#include <QVariantMap>
+
+#include <cstdint>
 
 namespace mv {
     class DatasetImpl;
@@ -59,8 +64,97 @@ public:
         return {};
     }
 
+public: // Change tracking for incremental save
+
+    /**
+     * Get the version of the storage of the raw data, raw data which can be modified without a change notification
+     * (e.g. through a pointer to its storage) increments it on each (potential) modification
+     * @return Storage version (zero if the raw data does not track it)
+     */
+    virtual std::uint64_t getStorageVersion() const {
+        return 0;
+    }
+
+    /**
+     * Flag the raw data as modified, so that the next project save encodes it again
+     * Invoked by the dataset when its data or dimensions change (see DatasetImpl::setDataModified())
+     */
+    void setModified() {
+        QMutexLocker lock(&_encodedDataMutex);
+
+        ++_revision;
+    }
+
+    /**
+     * Flag the raw data as unmodified with respect to its encoded data (e.g. when the notifications that follow loading a project are done)
+     */
+    void clearModified() {
+        QMutexLocker lock(&_encodedDataMutex);
+
+        _encodedRevision = _revision;
+    }
+
+    /**
+     * Get whether the raw data was modified since it was last saved (or loaded)
+     * @return Boolean determining whether the raw data was modified
+     */
+    bool isModified() const {
+        QMutexLocker lock(&_encodedDataMutex);
+
+        return _encodedData.isEmpty() || _encodedRevision != _revision || _encodedStorageVersion != getStorageVersion();
+    }
+
+    /**
+     * Get the revision of the raw data, which is incremented each time the raw data is modified
+     * @return Revision number
+     */
+    std::uint64_t getRevision() const {
+        QMutexLocker lock(&_encodedDataMutex);
+
+        return _revision;
+    }
+
+    /**
+     * Remember \p encodedData (blob variant map) of revision \p revision of the raw data, of which the blocks are stored in the archive at \p archiveFilePath
+     * @param encodedData Blob variant map of the encoded raw data
+     * @param archiveFilePath File path of the archive that contains the encoded blocks
+     * @param revision Revision of the raw data at the time it was encoded (see getRevision())
+     * @param storageVersion Storage version of the raw data at the time it was encoded (see getStorageVersion())
+     */
+    void setEncodedData(const QVariantMap& encodedData, const QString& archiveFilePath, std::uint64_t revision, std::uint64_t storageVersion) const {
+        QMutexLocker lock(&_encodedDataMutex);
+
+        _encodedData                = encodedData;
+        _encodedArchiveFilePath     = archiveFilePath;
+        _encodedRevision            = revision;
+        _encodedStorageVersion      = storageVersion;
+    }
+
+    /**
+     * Get the encoded data of the raw data if it was not modified since it was encoded, both the revision (modifications
+     * which were notified) and the storage version (modifications which were not) have to match
+     * @param archiveFilePath File path of the archive that contains the encoded blocks (output)
+     * @return Blob variant map of the encoded raw data, empty if the raw data was modified
+     */
+    QVariantMap getEncodedData(QString& archiveFilePath) const {
+        QMutexLocker lock(&_encodedDataMutex);
+
+        if (_encodedData.isEmpty() || _encodedRevision != _revision || _encodedStorageVersion != getStorageVersion())
+            return {};
+
+        archiveFilePath = _encodedArchiveFilePath;
+
+        return _encodedData;
+    }
+
 private:
-    DataType    _dataType;  /** Type of data */
+    DataType                _dataType;                  /** Type of data */
+    mutable QMutex          _encodedDataMutex;          /** Guards the change tracking members (the raw data is saved on worker threads) */
+    std::uint64_t           _revision = 0;              /** Incremented each time the raw data is modified */
+    mutable QVariantMap     _encodedData;               /** Blob variant map of the last save (or load) */
+    mutable QString         _encodedArchiveFilePath;    /** File path of the archive with the encoded blocks of the last save (or load) */
+    mutable std::uint64_t   _encodedRevision = 0;       /** Revision of the raw data at the time of the last save (or load) */
+    mutable std::uint64_t   _encodedStorageVersion = 0; /** Storage version of the raw data at the time of the last save (or load) */
 };
 
 class CORE_EXPORT RawDataFactory : public PluginFactory
@@ -6,8 +6,17 @@
 
 #include <QStringList>
 #include <QVector>
+#include <QtConcurrent>
 
+#include <algorithm>
 #include <stdexcept>
+#include <utility>
+
+namespace
+{
+    /** Number of indices per grain when translating indices concurrently */
+    constexpr std::size_t translateIndicesGrainSize = 1 << 16;
+}
 
 namespace mv
 {
@@ -22,6 +31,8 @@ namespace mv
         _kvMap.clear();
         _vkMap.clear();
 
+        ++_revision;
+
         for (size_t i = 0; i < keys.size(); i++)
         {
             _kvMap[keys[i]] = values[i];
@@ -168,15 +179,18 @@ namespace mv
 
     BiMap& KeyBasedSelectionGroup::getBiMap(Dataset<DatasetImpl> dataset)
     {
-        for (size_t i = 0; i < _datasets.size(); i++)
-        {
-            Dataset<DatasetImpl> d = _datasets[i];
-            if (d == dataset && d.isValid())
-            {
-                return _biMaps[i];
-            }
-        }
-        throw std::runtime_error("Dataset not found in selection group");
+        // Changes through the returned reference increment the revision of the bimap, which outdates its cross-map
+        return const_cast<BiMap&>(std::as_const(*this).getBiMap(dataset));
+    }
+
+    const BiMap& KeyBasedSelectionGroup::getBiMap(Dataset<DatasetImpl> dataset) const
+    {
+        const auto datasetIndex = findDatasetIndex(dataset);
+
+        if (datasetIndex == invalidIndex)
+            throw std::runtime_error("Dataset not found in selection group");
+
+        return _biMaps[datasetIndex];
     }
 
     void KeyBasedSelectionGroup::addDataset(Dataset<DatasetImpl> dataset, const std::vector<QString>& keys)
@@ -187,40 +201,81 @@ namespace mv
         std::iota(indices.begin(), indices.end(), 0);
         bimap.addKeyValuePairs(keys, indices);
         _biMaps.push_back(std::move(bimap));
+        _crossMaps.emplace_back();
+
+        updateCrossMap(_crossMaps.size() - 1);
     }
 
     void KeyBasedSelectionGroup::addDataset(Dataset<DatasetImpl> dataset, BiMap& bimap)
     {
         _datasets.push_back(dataset);
         _biMaps.push_back(std::move(bimap)); // FIXME Make it clear to caller that this happens
+        _crossMaps.emplace_back();
+
+        updateCrossMap(_crossMaps.size() - 1);
     }
 
     void KeyBasedSelectionGroup::selectionChanged(Dataset<DatasetImpl> dataset, const std::vector<uint32_t>& indices) const
     {
         if (indices.empty()) return;
 
-        std::vector<QString> keys;
+        // Indices of a dataset outside the group have no keys, so the other datasets end up with an empty selection
+        const auto datasetIndex = findDatasetIndex(dataset);
 
-        // Find the keys associated with the given indices
+        // Translate the indices to the other datasets through the cross-maps
         for (size_t i = 0; i < _datasets.size(); i++)
         {
             Dataset<DatasetImpl> d = _datasets[i];
-            if (d == dataset && d.isValid())
+            if (d != dataset && d.isValid())
             {
-                keys = _biMaps[i].getKeysByValues(indices);
+                std::vector<uint32_t> translatedIndices = datasetIndex == invalidIndex ? std::vector<uint32_t>() : translateIndices(datasetIndex, i, indices);
+                
+                d->setSelectionIndices(translatedIndices);
+                d->markSelectionPropagated();
+
+                d->markSelectionDirty(true);
             }
         }
-        // Find values associated with the found keys in other datasets
+    }
+
+    void KeyBasedSelectionGroup::selectionChanged(Dataset<DatasetImpl> dataset, const SelectionDelta& delta) const
+    {
+        const auto datasetIndex = findDatasetIndex(dataset);
+
+        // Datasets outside the group (and replaced selections) go through the whole selection
+        if (delta.isReplaced() || datasetIndex == invalidIndex)
+        {
+            selectionChanged(dataset, dataset->getSelection()->getSelectionIndices());
+            return;
+        }
+
+        if (delta.isEmpty()) return;
+
+        const std::vector<uint32_t> addedIndices    = delta.getAdded().toIndices();
+        const std::vector<uint32_t> removedIndices  = delta.getRemoved().toIndices();
+
+        // Apply the translated delta to the other datasets, keys are unique so the delta maps one-to-one
         for (size_t i = 0; i < _datasets.size(); i++)
         {
             Dataset<DatasetImpl> d = _datasets[i];
             if (d != dataset && d.isValid())
             {
-                std::vector<uint32_t> indices = _biMaps[i].getValuesByKeys(keys);
-                
-                d->setSelectionIndices(indices);
+                // The delta only applies to the selection the group left behind, a selection which was changed elsewhere is replaced
+                if (!d->hasPropagatedSelection())
+                {
+                    d->setSelectionIndices(translateIndices(datasetIndex, i, dataset->getSelection()->getSelectionIndices()));
+                    d->markSelectionPropagated();
 
-                d->markSelectionDirty(true);
+                    d->markSelectionDirty(true);
+                    continue;
+                }
+
+                const SelectionDelta groupDelta(util::IndexSet(translateIndices(datasetIndex, i, addedIndices)), util::IndexSet(translateIndices(datasetIndex, i, removedIndices)));
+
+                d->applySelectionDelta(groupDelta);
+                d->markSelectionPropagated();
+
+                d->markSelectionDirty(true, groupDelta);
             }
         }
     }
@@ -245,6 +300,13 @@ namespace mv
         {
             _biMaps[i].fromVariantMap(bimapVariantList[i].toMap());
         }
+
+        _keyIds.clear();
+        _crossMaps.clear();
+        _crossMaps.resize(_biMaps.size());
+
+        for (size_t i = 0; i < _crossMaps.size(); i++)
+            updateCrossMap(i);
     }
 
     QVariantMap KeyBasedSelectionGroup::toVariantMap() const
@@ -274,6 +336,104 @@ namespace mv
         return variantMap;
     }
 
+    void KeyBasedSelectionGroup::updateCrossMap(std::size_t datasetIndex) const
+    {
+        CrossMap& crossMap = _crossMaps[datasetIndex];
+
+        const BiMap& biMap = _biMaps[datasetIndex];
+
+        if (crossMap.biMapRevision == biMap.getRevision())
+            return;
+
+        // Get the identifier of a key, keys which are new to the group are assigned the next free identifier
+        const auto getKeyId = [this](const QString& key) -> std::uint32_t {
+            return _keyIds.try_emplace(key, static_cast<std::uint32_t>(_keyIds.size())).first->second;
+        };
+
+        crossMap.keyIds.clear();
+        crossMap.indices.clear();
+
+        // Indices to keys (as looked up by BiMap::getKeysByValues())
+        for (const auto& [value, key] : biMap.getValueKeyMap())
+        {
+            if (value >= crossMap.keyIds.size())
+                crossMap.keyIds.resize(static_cast<std::size_t>(value) + 1, invalidIndex);
+
+            crossMap.keyIds[value] = getKeyId(key);
+        }
+
+        // Keys to indices (as looked up by BiMap::getValuesByKeys())
+        for (const auto& [key, value] : biMap.getKeyValueMap())
+        {
+            const auto keyId = getKeyId(key);
+
+            if (keyId >= crossMap.indices.size())
+                crossMap.indices.resize(static_cast<std::size_t>(keyId) + 1, invalidIndex);
+
+            crossMap.indices[keyId] = value;
+        }
+
+        crossMap.biMapRevision = biMap.getRevision();
+
+        ++crossMap.numberOfBuilds;
+    }
+
+    std::vector<std::uint32_t> KeyBasedSelectionGroup::translateIndices(std::size_t fromDatasetIndex, std::size_t toDatasetIndex, const std::vector<std::uint32_t>& indices) const
+    {
+        updateCrossMap(fromDatasetIndex);
+        updateCrossMap(toDatasetIndex);
+
+        const auto& keyIds          = _crossMaps[fromDatasetIndex].keyIds;
+        const auto& targetIndices   = _crossMaps[toDatasetIndex].indices;
+
+        std::vector<std::uint32_t> translatedIndices(indices.size());
+
+        // Gather the target index of each index in [begin, end), or invalidIndex if it has no counterpart
+        const auto gather = [&indices, &keyIds, &targetIndices, &translatedIndices](std::size_t begin, std::size_t end) -> void {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const auto index = indices[i];
+                const auto keyId = index < keyIds.size() ? keyIds[index] : invalidIndex;
+
+                translatedIndices[i] = keyId < targetIndices.size() ? targetIndices[keyId] : invalidIndex;
+            }
+        };
+
+        if (indices.size() <= translateIndicesGrainSize)
+        {
+            gather(0, indices.size());
+        }
+        else
+        {
+            std::vector<std::pair<std::size_t, std::size_t>> grains;
+
+            for (std::size_t begin = 0; begin < indices.size(); begin += translateIndicesGrainSize)
+                grains.emplace_back(begin, std::min(begin + translateIndicesGrainSize, indices.size()));
+
+            QtConcurrent::blockingMap(grains, [&gather](const std::pair<std::size_t, std::size_t>& grain) -> void {
+                gather(grain.first, grain.second);
+            });
+        }
+
+        translatedIndices.erase(std::remove(translatedIndices.begin(), translatedIndices.end(), invalidIndex), translatedIndices.end());
+
+        return translatedIndices;
+    }
+
+    std::uint32_t KeyBasedSelectionGroup::findDatasetIndex(const Dataset<DatasetImpl>& dataset) const
+    {
+        for (size_t i = 0; i < _datasets.size(); i++)
+        {
+            Dataset<DatasetImpl> d = _datasets[i];
+            if (d == dataset && d.isValid())
+            {
+                return static_cast<std::uint32_t>(i);
+            }
+        }
+
+        return invalidIndex;
+    }
+
     std::vector<QString> BiMap::getKeys() const
     {
         std::vector<uint32_t> values(_vkMap.size());
@@ -306,11 +466,11 @@ namespace mv
         return foundDataset1 && foundDataset2;
     }
 
-    std::vector<int> KeyBasedSelectionGroup::getMappingBetweenDatasets(Dataset<DatasetImpl> fromDataset, Dataset<DatasetImpl> toDataset)
+    std::vector<int> KeyBasedSelectionGroup::getMappingBetweenDatasets(Dataset<DatasetImpl> fromDataset, Dataset<DatasetImpl> toDataset) const
     {
-        BiMap& fromBimap = getBiMap(fromDataset);
+        const BiMap& fromBimap = getBiMap(fromDataset);
         std::vector<QString> keys = fromBimap.getKeys();
-        BiMap& toBimap = getBiMap(toDataset);
+        const BiMap& toBimap = getBiMap(toDataset);
         std::vector<int> values = toBimap.getValuesByKeysWithMissingValue(keys, -1);
         return values;
     }
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <Dataset.h>
+#include <event/SelectionDelta.h>
 #include <util/Serializable.h>
 
 #include <QString>
 
+#include <cstdint>
+#include <limits>
+#include <optional>
 #include <unordered_map>
 
 namespace mv
@@ -25,6 +29,15 @@ public:
     std::vector<uint32_t> getValuesByKeys(const std::vector<QString>& keys, bool verbose = false) const;
     std::vector<int> getValuesByKeysWithMissingValue(const std::vector<QString>& keys, int missingValue) const;
 
+    /** Get the key-value map */
+    const std::unordered_map<QString, uint32_t>& getKeyValueMap() const { return _kvMap; }
+
+    /** Get the value-key map */
+    const std::unordered_map<uint32_t, QString>& getValueKeyMap() const { return _vkMap; }
+
+    /** Get the revision of the key-value pairs, it is incremented whenever they change */
+    std::uint64_t getRevision() const { return _revision; }
+
 public: // Serialization
     /**
      * Load bimap from variant
@@ -41,20 +54,42 @@ public: // Serialization
 private:
     std::unordered_map<QString, uint32_t> _kvMap = {};
     std::unordered_map<uint32_t, QString> _vkMap = {};
+    std::uint64_t _revision = 0;    /** Incremented whenever the key-value pairs change */
 };
 
 class CORE_EXPORT KeyBasedSelectionGroup : public util::Serializable
 {
 public:
+    static constexpr std::uint32_t invalidIndex = std::numeric_limits<std::uint32_t>::max();   /** Marks indices and keys without a counterpart in the cross-maps */
+
+    /**
+     * Get the bimap of \p dataset, its cross-map is rebuilt before the next selection change if the bimap is changed through the reference
+     * @param dataset Dataset in the group
+     * @return Bimap of the dataset
+     */
     BiMap& getBiMap(Dataset<DatasetImpl> dataset);
 
+    /**
+     * Get the bimap of \p dataset
+     * @param dataset Dataset in the group
+     * @return Bimap of the dataset
+     */
+    const BiMap& getBiMap(Dataset<DatasetImpl> dataset) const;
+
     void addDataset(Dataset<DatasetImpl> dataset, const std::vector<QString>& keys);
     void addDataset(Dataset<DatasetImpl> dataset, BiMap& bimap);
 
     void selectionChanged(Dataset<DatasetImpl> dataset, const std::vector<uint32_t>& indices) const;
 
+    /**
+     * Apply selection \p delta of \p dataset to the other datasets in the group, only the keys of the changed indices are looked up
+     * @param dataset Dataset of which the selection changed
+     * @param delta How the selection changed (the whole selection is looked up if it was replaced)
+     */
+    void selectionChanged(Dataset<DatasetImpl> dataset, const SelectionDelta& delta) const;
+
     bool areDatasetsPartOfGroup(Dataset<DatasetImpl> d1, Dataset<DatasetImpl> d2);
-    std::vector<int> getMappingBetweenDatasets(Dataset<DatasetImpl> fromDataset, Dataset<DatasetImpl> toDataset);
+    std::vector<int> getMappingBetweenDatasets(Dataset<DatasetImpl> fromDataset, Dataset<DatasetImpl> toDataset) const;
 
 public: // Serialization
     /**
@@ -69,9 +104,65 @@ public: // Serialization
      */
     QVariantMap toVariantMap() const override;
 
+protected:
+
+    /**
+     * Get the bimap of the dataset at \p datasetIndex
+     * @param datasetIndex Index of the dataset in the group
+     * @return Bimap of the dataset
+     */
+    BiMap& getBiMapByIndex(std::size_t datasetIndex) { return _biMaps[datasetIndex]; }
+
+    /**
+     * Translate \p indices of the dataset at \p fromDatasetIndex to the dataset at \p toDatasetIndex through their cross-maps
+     * (concurrently for large selections), indices without a counterpart are skipped
+     * @param fromDatasetIndex Index of the dataset in the group to translate from
+     * @param toDatasetIndex Index of the dataset in the group to translate to
+     * @param indices Indices to translate
+     * @return Translated indices, in the order of \p indices
+     */
+    std::vector<std::uint32_t> translateIndices(std::size_t fromDatasetIndex, std::size_t toDatasetIndex, const std::vector<std::uint32_t>& indices) const;
+
+    /**
+     * Get the number of times the cross-map of the dataset at \p datasetIndex was (re)built from its bimap
+     * @param datasetIndex Index of the dataset in the group
+     * @return Number of cross-map builds
+     */
+    std::uint64_t getNumberOfCrossMapBuilds(std::size_t datasetIndex) const { return _crossMaps[datasetIndex].numberOfBuilds; }
+
+private:
+
+    /**
+     * Dense integer translation tables of a dataset in the group. Every key in the group has an integer identifier,
+     * so translating an index of one dataset to another is two table lookups instead of hashing its key.
+     */
+    struct CrossMap
+    {
+        std::vector<std::uint32_t>      keyIds;             /** Key identifier of each index (invalidIndex if the index has no key) */
+        std::vector<std::uint32_t>      indices;            /** Index of each key identifier (invalidIndex if the dataset does not have the key) */
+        std::optional<std::uint64_t>    biMapRevision;      /** Revision of the bimap the cross-map was built from (none if not built yet) */
+        std::uint64_t                   numberOfBuilds = 0; /** Number of times the cross-map was (re)built */
+    };
+
+    /**
+     * Build the cross-map of the dataset at \p datasetIndex if its bimap changed since it was built, new keys are assigned
+     * the next free identifier and the identifiers of known keys (and so the cross-maps of the other datasets) are kept
+     * @param datasetIndex Index of the dataset in the group
+     */
+    void updateCrossMap(std::size_t datasetIndex) const;
+
+    /**
+     * Get the index in the group of \p dataset
+     * @param dataset Dataset
+     * @return Index of the dataset in the group, invalidIndex if it is not part of the group
+     */
+    std::uint32_t findDatasetIndex(const Dataset<DatasetImpl>& dataset) const;
+
 private:
     std::vector<Dataset<DatasetImpl>> _datasets = {};
     std::vector<BiMap> _biMaps = {};
+    mutable std::unordered_map<QString, std::uint32_t> _keyIds = {};   /** Integer identifier of each key in the group */
+    mutable std::vector<CrossMap> _crossMaps = {};                      /** Cross-map of each dataset */
 };
 
 }
@@ -128,6 +128,74 @@ QVector<mv::Dataset<mv::DatasetImpl>> DatasetImpl::getChildren(const DataType& f
     return getChildren(QVector<DataType>({ filterDataType }));
 }
 
+void DatasetImpl::applySelectionDelta(const SelectionDelta& delta)
+{
+    if (delta.isReplaced() || delta.isEmpty())
+        return;
+
+    auto selectionIndices = getSelectionIndices();
+
+    delta.applyTo(selectionIndices);
+
+    setSelectionIndices(selectionIndices);
+}
+
+void DatasetImpl::addSelectionIndices(const std::vector<std::uint32_t>& indices)
+{
+    const auto delta = SelectionDelta::fromAdded(indices);
+
+    applySelectionDelta(delta);
+
+    events().notifyDatasetDataSelectionChanged(this, delta);
+}
+
+void DatasetImpl::removeSelectionIndices(const std::vector<std::uint32_t>& indices)
+{
+    const auto delta = SelectionDelta::fromRemoved(indices);
+
+    applySelectionDelta(delta);
+
+    events().notifyDatasetDataSelectionChanged(this, delta);
+}
+
+std::uint64_t DatasetImpl::getSelectionRevision() const
+{
+    const auto selection = getSelection();
+
+    return selection.isValid() ? selection->_selectionRevision : 0;
+}
+
+void DatasetImpl::markSelectionChanged()
+{
+    auto selection = getSelection();
+
+    if (selection.isValid())
+        ++selection->_selectionRevision;
+}
+
+void DatasetImpl::markSelectionPropagated()
+{
+    _propagatedSelectionRevision = getSelectionRevision();
+}
+
+bool DatasetImpl::hasPropagatedSelection() const
+{
+    return _propagatedSelectionRevision && *_propagatedSelectionRevision == getSelectionRevision();
+}
+
+void DatasetImpl::markSelectionDirty(bool isDirty, const SelectionDelta& delta /*= SelectionDelta()*/) const
+{
+    if (!isDirty) {
+        _dirtySelection         = false;
+        _pendingSelectionDelta  = SelectionDelta();
+
+        return;
+    }
+
+    _pendingSelectionDelta  = _dirtySelection ? _pendingSelectionDelta.then(delta) : delta;
+    _dirtySelection         = true;
+}
+
 std::int32_t DatasetImpl::getSelectionSize() const
 {
     return static_cast<std::int32_t>(const_cast<DatasetImpl*>(this)->getSelectionIndices().size());
@@ -456,7 +524,8 @@ DatasetImpl::DatasetImpl(const QString& rawDataName, bool mayUnderive /*= true*/
     _task(this, ""),
     _mayUnderive(mayUnderive),
     _aboutToBeRemoved(false),
-    _dirtySelection(false)
+    _dirtySelection(false),
+    _selectionRevision(0)
 {
     if (!id.isEmpty())
         Serializable::setId(id);
@@ -604,6 +673,15 @@ bool DatasetImpl::isAboutToBeRemoved() const
     return _aboutToBeRemoved;
 }
 
+void DatasetImpl::setDataModified()
+{
+    if (getStorageType() != StorageType::Owner || getRawDataName().isEmpty())
+        return;
+
+    if (auto rawData = getRawData<plugin::RawData>())
+        rawData->setModified();
+}
+
 QString DatasetImpl::getLocation(bool recompute /*= false*/) const
 {
     return getDataHierarchyItem().getLocation(recompute);
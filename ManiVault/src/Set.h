@@ -14,6 +14,7 @@
 #include "ModalTask.h"
 
 #include "actions/WidgetAction.h"
+#include "event/SelectionDelta.h"
 #include "util/Miscellaneous.h"
 
 #include <QString>
@@ -21,6 +22,7 @@
 #include <QVector>
 
 #include <memory>
+#include <optional>
 
 #define DATASET_IMPL_VERBOSE
 
@@ -298,6 +300,50 @@ public: // Selection
      */
     virtual void setSelectionIndices(const std::vector<std::uint32_t>& indices) = 0;
 
+    /**
+     * Change the selection incrementally by \p delta, without notifying listeners (does nothing if the delta replaces
+     * the selection, use setSelectionIndices() for that). The default implementation goes through the selection indices,
+     * datasets with linked data override it to update their linked datasets incrementally as well.
+     * @param delta Selection delta
+     */
+    virtual void applySelectionDelta(const SelectionDelta& delta);
+
+    /**
+     * Add \p indices to the selection and notify listeners of the delta
+     * @param indices Indices to add to the selection
+     */
+    void addSelectionIndices(const std::vector<std::uint32_t>& indices);
+
+    /**
+     * Remove \p indices from the selection and notify listeners of the delta
+     * @param indices Indices to remove from the selection
+     */
+    void removeSelectionIndices(const std::vector<std::uint32_t>& indices);
+
+    /**
+     * Get the revision of the selection indices, it changes whenever they change (the selection indices are shared by
+     * the datasets of the same raw data, and so is their revision)
+     * @return Selection revision (zero if there is no selection)
+     */
+    std::uint64_t getSelectionRevision() const;
+
+    /**
+     * Mark that the selection indices changed, so that selections which were propagated to them before are no longer
+     * built upon (see hasPropagatedSelection()). Selection setters, applySelectionDelta() and notifications of replaced
+     * selections do so, code which writes to the selection indices directly and notifies a delta has to call it.
+     */
+    void markSelectionChanged();
+
+    /** Remember the current selection revision as the result of the last selection change propagated to this dataset (see hasPropagatedSelection()) */
+    void markSelectionPropagated();
+
+    /**
+     * Get whether the selection indices are unchanged since markSelectionPropagated(). Only then may the next propagated
+     * selection delta be applied on top of them, otherwise the selection was changed elsewhere and has to be replaced.
+     * @return Boolean determining whether the selection is still the last propagated one
+     */
+    bool hasPropagatedSelection() const;
+
     /** Get size of the selection */
     std::int32_t getSelectionSize() const;
 
@@ -323,7 +369,16 @@ public: // Selection
     virtual void selectInvert() = 0;
 
 private:
-    void markSelectionDirty(bool isDirty) const { _dirtySelection = isDirty; }
+
+    /**
+     * Mark whether the dataset should be notified about a changed selection
+     * @param isDirty Whether the selection changed since the previous notification
+     * @param delta How the selection changed, combined with the pending delta of earlier changes (replaced by default)
+     */
+    void markSelectionDirty(bool isDirty, const SelectionDelta& delta = SelectionDelta()) const;
+
+    /** Get how the selection changed since the previous notification */
+    const SelectionDelta& getPendingSelectionDelta() const { return _pendingSelectionDelta; }
 
 public: // Lock
 
@@ -568,6 +623,11 @@ public: // Removal
      */
     bool isAboutToBeRemoved() const;
 
+public: // Change tracking for incremental save
+
+    /** Flag the raw data of the dataset as modified (its data or dimensions changed), so that the next project save encodes it again */
+    void setDataModified();
+
 protected:
 
     /**
@@ -633,6 +693,9 @@ private:
     DatasetTask                 _task;                  /** Task for display in the data hierarchy and foreground */
     bool                        _aboutToBeRemoved;      /** Boolean determining whether the set is in the process of being removed */
     mutable bool                _dirtySelection;        /** Whether the dataset should be notified about a changed selection */
+    mutable SelectionDelta      _pendingSelectionDelta; /** How the selection changed since the previous notification */
+    std::uint64_t               _selectionRevision;     /** Revision of the selection indices (of selection datasets) */
+    std::optional<std::uint64_t> _propagatedSelectionRevision;   /** Selection revision after the last propagated selection change */
 
     friend class CoreInterface;
     friend class Core;
@@ -6,6 +6,8 @@
 #include "Application.h"
 #include "CoreInterface.h"
 
+#include "util/SelectionUpdateScheduler.h"
+
 #include <QKeyEvent>
 #include <QMenu>
 
@@ -18,6 +20,7 @@ PixelSelectionAction::PixelSelectionAction(QObject* parent, const QString& title
     _initialized(false),
     _targetWidget(nullptr),
     _pixelSelectionTool(nullptr),
+    _selectionUpdateScheduler(nullptr),
     _overlayColorAction(this, "Overlay color", QColor(255, 0, 0)),
     _overlayOpacityAction(this, "Overlay opacity", 0.0f, 100.0f, 75.0f, 1),
     _typeModel(this),
@@ -234,6 +237,9 @@ void PixelSelectionAction::initialize(QWidget* targetWidget, util::PixelSelectio
 
     _targetWidget->installEventFilter(this);
     _initialized = true;
+
+    if (_selectionUpdateScheduler)
+        _pixelSelectionTool->setSelectionUpdateScheduler(_selectionUpdateScheduler);
 }
 
 QWidget* PixelSelectionAction::getTargetWidget()
@@ -246,6 +252,21 @@ PixelSelectionTool* PixelSelectionAction::getPixelSelectionTool()
     return _pixelSelectionTool;
 }
 
+void PixelSelectionAction::setSelectionDataset(const Dataset<DatasetImpl>& selectionDataset)
+{
+    delete _selectionUpdateScheduler;
+
+    _selectionUpdateScheduler = selectionDataset.isValid() ? new SelectionUpdateScheduler(selectionDataset, this) : nullptr;
+
+    if (_pixelSelectionTool)
+        _pixelSelectionTool->setSelectionUpdateScheduler(_selectionUpdateScheduler);
+}
+
+SelectionUpdateScheduler* PixelSelectionAction::getSelectionUpdateScheduler()
+{
+    return _selectionUpdateScheduler;
+}
+
 void PixelSelectionAction::setShortcutsEnabled(const bool& shortcutsEnabled)
 {
     if (!isInitialized())
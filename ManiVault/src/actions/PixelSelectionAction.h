@@ -14,10 +14,20 @@
 
 #include "util/PixelSelectionTool.h"
 
+#include "Dataset.h"
+
 #include <QActionGroup>
 
 class QWidget;
 
+namespace mv {
+    class DatasetImpl;
+}
+
+namespace mv::util {
+    class SelectionUpdateScheduler;
+}
+
 namespace mv::gui {
 
 /**
@@ -61,6 +71,16 @@ public:
     /** Get pointer to pixel selection tool */
     util::PixelSelectionTool* getPixelSelectionTool();
 
+    /**
+     * Set the dataset which is selected with the pixel selection tool to \p selectionDataset, the selections which are
+     * scheduled with getSelectionUpdateScheduler() while brushing are then coalesced to frames and resolved on a worker thread
+     * @param selectionDataset Dataset which is selected with the pixel selection tool (selection updates are no longer scheduled if invalid)
+     */
+    void setSelectionDataset(const Dataset<DatasetImpl>& selectionDataset);
+
+    /** Get the scheduler of the selection updates of the selection dataset (nullptr if no selection dataset is set) */
+    util::SelectionUpdateScheduler* getSelectionUpdateScheduler();
+
     /**
      * Enables/disables shortcuts
      * @param shortcutsEnabled Whether shortcuts are enabled or not
@@ -151,6 +171,7 @@ private:
     bool                            _initialized;                       /** Whether the pixel selection tool is initialized with a target widget and pixel selection tool */
     QWidget*                        _targetWidget;                      /** Pointer to target widget */
     util::PixelSelectionTool*       _pixelSelectionTool;                /** Pointer to pixel selection tool */
+    util::SelectionUpdateScheduler* _selectionUpdateScheduler;          /** Schedules the selection updates of the selection dataset (if any) */
     util::PixelSelectionTypes       _pixelSelectionTypes;               /** Pixel selection types */
     ColorAction                     _overlayColorAction;                /** Selection overlay color action */
     DecimalAction                   _overlayOpacityAction;              /** Selection overlay opacity action */
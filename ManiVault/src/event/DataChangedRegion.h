@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace mv
+{
+
+/**
+ * Data changed region class
+ * Describes which part of the data of a dataset changed: a set of points (a contiguous range or
+ * explicit indices) times a set of dimensions. By default, the region covers all data, which is
+ * what listeners have to assume when a dataset does not describe its changes.
+ */
+class DataChangedRegion
+{
+public:
+
+    /** Construct a region which covers all data */
+    DataChangedRegion() = default;
+
+    /**
+     * Construct a region which covers the contiguous range of points [\p pointBegin, \p pointEnd)
+     * @param pointBegin Index of the first changed point
+     * @param pointEnd Index one past the last changed point
+     * @param dimensionIndices Indices of the changed dimensions (all dimensions if empty)
+     */
+    DataChangedRegion(std::uint64_t pointBegin, std::uint64_t pointEnd, std::vector<std::uint32_t> dimensionIndices = {}) :
+        _pointSelection(PointSelection::Range),
+        _pointBegin(pointBegin),
+        _pointEnd(std::max(pointBegin, pointEnd)),
+        _dimensionIndices(std::move(dimensionIndices))
+    {
+    }
+
+    /**
+     * Construct a region which covers the points with \p pointIndices
+     * @param pointIndices Indices of the changed points
+     * @param dimensionIndices Indices of the changed dimensions (all dimensions if empty)
+     */
+    DataChangedRegion(std::vector<std::uint32_t> pointIndices, std::vector<std::uint32_t> dimensionIndices = {}) :
+        _pointSelection(PointSelection::Indices),
+        _pointIndices(std::move(pointIndices)),
+        _dimensionIndices(std::move(dimensionIndices))
+    {
+        if (!_pointIndices.empty()) {
+            const auto [minimum, maximum] = std::minmax_element(_pointIndices.begin(), _pointIndices.end());
+
+            _pointBegin = *minimum;
+            _pointEnd   = static_cast<std::uint64_t>(*maximum) + 1;
+        }
+    }
+
+    /** Get whether the region covers all data (all points and all dimensions) */
+    bool isComplete() const {
+        return coversAllPoints() && coversAllDimensions();
+    }
+
+    /** Get whether the region covers all points */
+    bool coversAllPoints() const {
+        return _pointSelection == PointSelection::All;
+    }
+
+    /** Get whether the changed points are a contiguous range (see getPointBegin() and getPointEnd()) */
+    bool hasPointRange() const {
+        return _pointSelection == PointSelection::Range;
+    }
+
+    /** Get whether the changed points are listed explicitly (see getPointIndices()) */
+    bool hasPointIndices() const {
+        return _pointSelection == PointSelection::Indices;
+    }
+
+    /** Get the index of the first changed point (also the lowest index if the points are listed explicitly) */
+    std::uint64_t getPointBegin() const {
+        return _pointBegin;
+    }
+
+    /** Get the index one past the last changed point (also one past the highest index if the points are listed explicitly) */
+    std::uint64_t getPointEnd() const {
+        return _pointEnd;
+    }
+
+    /** Get the indices of the changed points (empty unless hasPointIndices()) */
+    const std::vector<std::uint32_t>& getPointIndices() const {
+        return _pointIndices;
+    }
+
+    /** Get whether the region covers all dimensions */
+    bool coversAllDimensions() const {
+        return _dimensionIndices.empty();
+    }
+
+    /** Get the indices of the changed dimensions (empty if all dimensions changed) */
+    const std::vector<std::uint32_t>& getDimensionIndices() const {
+        return _dimensionIndices;
+    }
+
+    /**
+     * Get whether dimension \p dimensionIndex is (partially) covered by the region
+     * @param dimensionIndex Index of the dimension
+     * @return Boolean determining whether the dimension changed
+     */
+    bool containsDimension(std::uint32_t dimensionIndex) const {
+        return coversAllDimensions() || std::find(_dimensionIndices.begin(), _dimensionIndices.end(), dimensionIndex) != _dimensionIndices.end();
+    }
+
+private:
+
+    /** Ways in which the changed points are described */
+    enum class PointSelection {
+        All,        /** All points */
+        Range,      /** Contiguous range of points */
+        Indices     /** Explicit point indices */
+    };
+
+    PointSelection                  _pointSelection = PointSelection::All;  /** How the changed points are described */
+    std::uint64_t                   _pointBegin = 0;                        /** Index of the first changed point */
+    std::uint64_t                   _pointEnd = 0;                          /** Index one past the last changed point */
+    std::vector<std::uint32_t>      _pointIndices;                          /** Indices of the changed points */
+    std::vector<std::uint32_t>      _dimensionIndices;                      /** Indices of the changed dimensions (all if empty) */
+};
+
+}
@@ -9,6 +9,9 @@
 #include "DataType.h"
 #include "Dataset.h"
 
+#include "event/DataChangedRegion.h"
+#include "event/SelectionDelta.h"
+
 #include <QString>
 
 #include <stdexcept>
@@ -163,11 +166,21 @@ public:
     /**
      * Constructor
      * @param dataset Smart pointer to the dataset
+     * @param region Region of the data that changed (all data by default)
      */
-    DatasetDataChangedEvent(const Dataset<DatasetImpl>& dataset) :
-        DatasetEvent(EventType::DatasetDataChanged, dataset)
+    DatasetDataChangedEvent(const Dataset<DatasetImpl>& dataset, const DataChangedRegion& region = DataChangedRegion()) :
+        DatasetEvent(EventType::DatasetDataChanged, dataset),
+        _region(region)
     {
     }
+
+    /** Get the region of the data that changed, listeners that only update what changed can use it */
+    const DataChangedRegion& getRegion() const {
+        return _region;
+    }
+
+protected:
+    DataChangedRegion   _region;    /** Region of the data that changed */
 };
 
 /**
@@ -252,11 +265,21 @@ public:
     /**
      * Constructor
      * @param dataset Smart pointer to the dataset
+     * @param delta How the selection changed since the previous event (replaced by default)
      */
-    DatasetDataSelectionChangedEvent(const Dataset<DatasetImpl>& dataset) :
-        DatasetEvent(EventType::DatasetDataSelectionChanged, dataset)
+    DatasetDataSelectionChangedEvent(const Dataset<DatasetImpl>& dataset, const SelectionDelta& delta = SelectionDelta()) :
+        DatasetEvent(EventType::DatasetDataSelectionChanged, dataset),
+        _delta(delta)
     {
     }
+
+    /** Get how the selection changed, listeners that only update what changed can use it instead of reading the whole selection */
+    const SelectionDelta& getDelta() const {
+        return _delta;
+    }
+
+protected:
+    SelectionDelta  _delta;     /** How the selection changed */
 };
 
 /**
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#pragma once
+
+#include "util/IndexSet.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace mv
+{
+
+/**
+ * Selection delta class
+ * Describes how the selection of a dataset changed: either incrementally, by the indices which were added to
+ * and removed from the selection, or completely, in which case listeners have to read the whole selection.
+ * By default, the selection is replaced, which is what listeners have to assume when a change is not described.
+ *
+ * Applying an incremental delta to the previous selection yields the new selection: (previous - removed) | added.
+ * Deltas of consecutive changes are combined with then(), so a listener which is notified once for several
+ * changes receives the delta between the selection it saw last and the current one.
+ */
+class SelectionDelta
+{
+public:
+
+    /** Construct a delta which replaces the selection */
+    SelectionDelta() = default;
+
+    /**
+     * Construct an incremental delta which removes \p removed from the selection and adds \p added (an index in both is added)
+     * @param added Indices which are added to the selection
+     * @param removed Indices which are removed from the selection
+     */
+    SelectionDelta(util::IndexSet added, util::IndexSet removed) :
+        _isReplaced(false),
+        _added(std::move(added)),
+        _removed(std::move(removed))
+    {
+        _removed -= _added;
+    }
+
+    /**
+     * Create an incremental delta which adds \p indices to the selection
+     * @param indices Indices which are added to the selection
+     * @return Selection delta
+     */
+    static SelectionDelta fromAdded(const std::vector<std::uint32_t>& indices) {
+        return { util::IndexSet(indices), {} };
+    }
+
+    /**
+     * Create an incremental delta which removes \p indices from the selection
+     * @param indices Indices which are removed from the selection
+     * @return Selection delta
+     */
+    static SelectionDelta fromRemoved(const std::vector<std::uint32_t>& indices) {
+        return { {}, util::IndexSet(indices) };
+    }
+
+    /** Get whether the selection was replaced (listeners have to read the whole selection) */
+    bool isReplaced() const {
+        return _isReplaced;
+    }
+
+    /** Get whether the delta is incremental (see getAdded() and getRemoved()) */
+    bool isIncremental() const {
+        return !_isReplaced;
+    }
+
+    /** Get whether the delta is incremental and changes nothing */
+    bool isEmpty() const {
+        return !_isReplaced && _added.isEmpty() && _removed.isEmpty();
+    }
+
+    /** Get the indices which are added to the selection (empty if the selection was replaced) */
+    const util::IndexSet& getAdded() const {
+        return _added;
+    }
+
+    /** Get the indices which are removed from the selection (empty if the selection was replaced) */
+    const util::IndexSet& getRemoved() const {
+        return _removed;
+    }
+
+    /**
+     * Combine this delta with the delta of the change which followed it
+     * @param next Delta of the next change
+     * @return Delta of both changes (replaces the selection if either of them does)
+     */
+    SelectionDelta then(const SelectionDelta& next) const {
+        if (_isReplaced || next._isReplaced)
+            return {};
+
+        return { (_added - next._removed) | next._added, (_removed - next._added) | next._removed };
+    }
+
+    /**
+     * Apply the delta to \p selection
+     * @param selection Selection before the change
+     * @return Selection after the change (unchanged if the delta replaces the selection)
+     */
+    util::IndexSet apply(const util::IndexSet& selection) const {
+        if (_isReplaced)
+            return selection;
+
+        return (selection - _removed) | _added;
+    }
+
+    /**
+     * Apply the delta to the selection \p indices in place. Indices which are not strictly ascending are sorted (and
+     * deduplicated) first, after which the removed indices are compacted away and the added ones are merged in from
+     * the back, so that only the delta is materialized and the selection is not copied.
+     * @param indices Selection indices before the change, replaced by the (ascending) indices after the change
+     */
+    void applyTo(std::vector<std::uint32_t>& indices) const {
+        if (isEmpty() || _isReplaced)
+            return;
+
+        if (std::adjacent_find(indices.begin(), indices.end(), std::greater_equal<std::uint32_t>()) != indices.end()) {
+            std::sort(indices.begin(), indices.end());
+
+            indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        }
+
+        if (!_removed.isEmpty()) {
+            const auto removedIndices = _removed.toIndices();
+
+            auto removedIndex   = removedIndices.begin();
+            auto keptIndex      = indices.begin();
+
+            for (const auto index : indices) {
+                while (removedIndex != removedIndices.end() && *removedIndex < index)
+                    ++removedIndex;
+
+                if (removedIndex == removedIndices.end() || *removedIndex != index)
+                    *keptIndex++ = index;
+            }
+
+            indices.erase(keptIndex, indices.end());
+        }
+
+        if (!_added.isEmpty()) {
+            auto addedIndices = _added.toIndices();
+
+            // Only the added indices which are not selected already grow the selection
+            addedIndices.erase(std::remove_if(addedIndices.begin(), addedIndices.end(), [&indices](std::uint32_t index) -> bool {
+                return std::binary_search(indices.begin(), indices.end(), index);
+            }), addedIndices.end());
+
+            if (addedIndices.empty())
+                return;
+
+            const auto numberOfIndices = indices.size();
+
+            indices.resize(numberOfIndices + addedIndices.size());
+
+            // Merge from the back, so that no selected index is overwritten before it is moved
+            auto selectedIndex  = indices.rend() - static_cast<std::ptrdiff_t>(numberOfIndices);
+            auto addedIndex     = addedIndices.rbegin();
+
+            for (auto mergedIndex = indices.rbegin(); addedIndex != addedIndices.rend(); ++mergedIndex) {
+                if (selectedIndex != indices.rend() && *selectedIndex > *addedIndex)
+                    *mergedIndex = *selectedIndex++;
+                else
+                    *mergedIndex = *addedIndex++;
+            }
+        }
+    }
+
+    bool operator==(const SelectionDelta& other) const {
+        return _isReplaced == other._isReplaced && _added == other._added && _removed == other._removed;
+    }
+
+    bool operator!=(const SelectionDelta& other) const {
+        return !(*this == other);
+    }
+
+private:
+    bool                _isReplaced = true;     /** Whether the selection was replaced */
+    util::IndexSet      _added;                 /** Indices which are added to the selection */
+    util::IndexSet      _removed;               /** Indices which are removed from the selection (disjoint from the added indices) */
+};
+
+}
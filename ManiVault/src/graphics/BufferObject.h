@@ -27,6 +27,13 @@ public:
         glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(T), data.data(), GL_STATIC_DRAW);
     }
 
+    /** Replace \p count elements of the (bound) buffer, starting at element \p offset, without reallocating it */
+    template<typename T>
+    void setSubData(std::size_t offset, const T* data, std::size_t count)
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(T), count * sizeof(T), data);
+    }
+
     void destroy();
 private:
     GLuint _object;
@@ -306,6 +306,8 @@ void Clusters::setSelectionIndices(const std::vector<std::uint32_t>& indices)
 {
     getSelection<Clusters>()->indices = indices;
 
+    markSelectionChanged();
+
     events().notifyDatasetDataSelectionChanged(this);
 
     if (!getDataHierarchyItem().getParent())
@@ -24,7 +24,8 @@ ClustersActionWidget::ClustersActionWidget(QWidget* parent, ClustersAction* clus
     _selectClustersAction(this),
     _subsetAction(this),
     _refreshClustersAction(this),
-    _clustersTreeView()
+    _clustersTreeView(),
+    _selectionUpdateScheduler()
 {
     // Configure filter model
     _filterModel.setSourceModel(&clustersAction->getClustersModel());
@@ -169,6 +170,12 @@ void ClustersActionWidget::setupSelectionSynchronization()
     disconnect(_clustersTreeView.selectionModel(), &QItemSelectionModel::selectionChanged, this, nullptr);
     disconnect(&_clustersAction.getClustersDataset(), &Dataset<Clusters>::dataSelectionChanged, this, nullptr);
 
+    // Selecting clusters selects their points (and those of linked datasets), so only apply the latest cluster selection once per frame
+    _selectionUpdateScheduler = std::make_unique<mv::util::SelectionUpdateScheduler>([clustersDataset = _clustersAction.getClustersDataset()](const std::vector<std::uint32_t>& selectedClustersIndices) -> void {
+        if (clustersDataset.isValid())
+            clustersDataset->setSelectionIndices(selectedClustersIndices);
+    });
+
     // Select cluster points when the cluster selection changes
     connect(_clustersTreeView.selectionModel(), &QItemSelectionModel::selectionChanged, this, [this](const QItemSelection& selected, const QItemSelection& deselected) -> void {
 
@@ -186,7 +193,7 @@ void ClustersActionWidget::setupSelectionSynchronization()
             selectedClustersIndices.push_back(_filterModel.mapToSource(selectedIndex).row());
 
         // Select clusters
-        _clustersAction.getClustersDataset()->setSelectionIndices(selectedClustersIndices);
+        _selectionUpdateScheduler->schedule(std::move(selectedClustersIndices));
     });
 
     // Highlight selected clusters (selection made elsewhere)
@@ -8,6 +8,8 @@
 
 #include <actions/WidgetActionWidget.h>
 
+#include <util/SelectionUpdateScheduler.h>
+
 #include "ClustersModel.h"
 #include "ClustersFilterModel.h"
 #include "RemoveClustersAction.h"
@@ -20,6 +22,8 @@
 #include <QItemSelectionModel>
 #include <QTreeView>
 
+#include <memory>
+
 class ClustersAction;
 
 /**
@@ -74,4 +78,7 @@ protected:
     SubsetAction                _subsetAction;              /** Subset action */
     RefreshClustersAction       _refreshClustersAction;     /** Refresh clusters action */
     QTreeView                   _clustersTreeView;          /** Clusters tree view */
+
+    /** Coalesces the cluster selections made in rapid succession (e.g. by dragging over the rows) */
+    std::unique_ptr<mv::util::SelectionUpdateScheduler>     _selectionUpdateScheduler;
 };
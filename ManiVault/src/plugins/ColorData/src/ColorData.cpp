@@ -40,6 +40,8 @@ std::vector<std::uint32_t>& Colors::getSelectionIndices()
 void Colors::setSelectionIndices(const std::vector<std::uint32_t>& indices)
 {
     getSelectionIndices() = indices;
+
+    markSelectionChanged();
 }
 
 bool Colors::canSelect() const
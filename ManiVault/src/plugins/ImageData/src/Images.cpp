@@ -645,16 +645,13 @@ void Images::getScalarDataForImageStack(const std::uint32_t& dimensionIndex, QVe
                 // add data here that belongs to a different dataset
                 if (linkedData.getTargetDataset()->getFullDataset<Points>() == embedding->getSourceDataset<Points>()->getFullDataset<Points>())
                 {
-                    for (const auto globalPointIndex : cluster.getIndices())
-                    {
-                        SelectionMap::Indices linkedIndices;
-                            
-                        linkedData.getMapping().populateMappingIndices(globalPointIndex, linkedIndices);
+                    SelectionMap::Indices linkedIndices;
 
-                        // Fill in the data for all the linked data indices based on the location of the original id
-                        for (unsigned int linkedIndex : linkedIndices)
-                            scalarData[linkedIndex] = clusterIndex;
-                    }
+                    linkedData.getMapping().mapIndices(cluster.getIndices(), linkedIndices);
+
+                    // Fill in the cluster index for all the linked data indices of the cluster
+                    for (unsigned int linkedIndex : linkedIndices)
+                        scalarData[linkedIndex] = clusterIndex;
                 }
             }
 
@@ -713,17 +710,13 @@ void Images::computeMaskData()
                     continue;
                 }
 
-                for (std::int32_t localPointIndex = 0; localPointIndex < globalIndices.size(); localPointIndex++) {
-                    const auto targetPixelIndex = globalIndices[localPointIndex];
-                    SelectionMap::Indices linkedIndices;
+                SelectionMap::Indices linkedIndices;
 
-                    linkedData.getMapping().populateMappingIndices(targetPixelIndex,linkedIndices);
+                // Map all pixels at once and unmask the linked data indices
+                linkedData.getMapping().mapIndices(globalIndices, linkedIndices);
 
-                    // Fill in the data for all the linked data indices based on the
-                    // location of the original id
-                    for (unsigned int linkedIndex : linkedIndices)
-                      _maskData[linkedIndex] = 255;
-                }
+                for (unsigned int linkedIndex : linkedIndices)
+                  _maskData[linkedIndex] = 255;
 
             }
 
@@ -758,16 +751,13 @@ void Images::computeMaskData()
                     // add data here that belongs to a different dataset
                     if (linkedData.getTargetDataset()->getFullDataset<Points>() == embedding->getSourceDataset<Points>()->getFullDataset<Points>())
                     {
-                        for (const auto globalPointIndex : cluster.getIndices())
-                        {
-                            SelectionMap::Indices linkedIndices;
+                        SelectionMap::Indices linkedIndices;
 
-                            linkedData.getMapping().populateMappingIndices(globalPointIndex, linkedIndices);
+                        linkedData.getMapping().mapIndices(cluster.getIndices(), linkedIndices);
 
-                            // Fill in the data for all the linked data indices based on the location of the original id
-                            for (unsigned int linkedIndex : linkedIndices)
-                                _maskData[linkedIndex] = 255;
-                        }
+                        // Unmask all the linked data indices of the cluster
+                        for (unsigned int linkedIndex : linkedIndices)
+                            _maskData[linkedIndex] = 255;
                     }
                 }
             }
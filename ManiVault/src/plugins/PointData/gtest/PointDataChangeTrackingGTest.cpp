@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <PointData.h>
+
+#include <Application.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+    /** Produces point data without registering it with a core */
+    class TestPointDataFactory : public mv::plugin::RawDataFactory
+    {
+    public:
+        mv::plugin::RawData* produce() override
+        {
+            return new PointData(this);
+        }
+    };
+
+    /** Plugins and their factories are actions, which need an application */
+    TestPointDataFactory& getPointDataFactory()
+    {
+        static int argc = 1;
+        static char applicationName[] = "PointDataGTest";
+        static char* argv[] = { applicationName, nullptr };
+
+        if (!mv::Application::current()) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+
+            static mv::Application application(argc, argv);
+        }
+
+        static TestPointDataFactory pointDataFactory;
+
+        return pointDataFactory;
+    }
+
+    /** Point data with \p numPoints points of two dimensions, with values 0, 1, 2, ... */
+    std::unique_ptr<PointData> createPointData(std::size_t numPoints)
+    {
+        auto pointData = std::make_unique<PointData>(&getPointDataFactory());
+
+        std::vector<float> values(2 * numPoints);
+
+        std::iota(values.begin(), values.end(), 0.f);
+
+        pointData->setData(std::move(values), 2);
+
+        return pointData;
+    }
+
+    /** Blob variant map like the one the serialization produces for \p pointData */
+    QVariantMap getEncodedData()
+    {
+        return {
+            { "Codec", "zstd" },
+            { "Blocks", QVariantList({ QVariantMap({ { "URI", "Block0.bin.zst" } }) }) }
+        };
+    }
+
+    /** Remember encoded data of the current state of \p pointData, as a save (or load) does */
+    void setEncodedData(const PointData& pointData)
+    {
+        pointData.setEncodedData(getEncodedData(), "Project.mv", pointData.getRevision(), pointData.getStorageVersion());
+    }
+
+    /** Establish whether the encoded data of \p pointData can be reused by the next save */
+    bool canReuseEncodedData(const PointData& pointData)
+    {
+        QString archiveFilePath;
+
+        const auto encodedData = pointData.getEncodedData(archiveFilePath);
+
+        EXPECT_EQ(encodedData.isEmpty(), pointData.isModified());
+
+        if (encodedData.isEmpty())
+            return false;
+
+        EXPECT_EQ(encodedData, getEncodedData());
+        EXPECT_EQ(archiveFilePath, "Project.mv");
+
+        return true;
+    }
+}
+
+
+TEST(RawData, EncodedDataIsReusedUntilModified)
+{
+    const auto pointData = createPointData(100);
+
+    // Never saved
+    EXPECT_FALSE(canReuseEncodedData(*pointData));
+
+    setEncodedData(*pointData);
+
+    EXPECT_TRUE(canReuseEncodedData(*pointData));
+
+    // Notified modifications (of the data or dimensions) bump the revision
+    const auto revision = pointData->getRevision();
+
+    pointData->setModified();
+
+    EXPECT_GT(pointData->getRevision(), revision);
+    EXPECT_FALSE(canReuseEncodedData(*pointData));
+
+    // Loading a project marks the loaded data as unmodified after the notifications which follow it
+    setEncodedData(*pointData);
+
+    pointData->setModified();
+    pointData->clearModified();
+
+    EXPECT_TRUE(canReuseEncodedData(*pointData));
+}
+
+
+TEST(RawData, ModificationsWithoutNotificationPreventReuse)
+{
+    const auto pointData = createPointData(100);
+
+    setEncodedData(*pointData);
+
+    // Reading does not bump the storage version
+    const auto revision         = pointData->getRevision();
+    const auto storageVersion   = pointData->getStorageVersion();
+
+    (void)pointData->getSnapshot();
+    (void)pointData->getValueAt(3);
+
+    pointData->constVisitFromBeginToEnd([](auto begin, auto end) -> void {
+        (void)std::distance(begin, end);
+    });
+
+    EXPECT_EQ(pointData->getStorageVersion(), storageVersion);
+    EXPECT_TRUE(canReuseEncodedData(*pointData));
+
+    // Writing through a visitor is not notified, but bumps the storage version
+    pointData->visitFromBeginToEnd([](auto begin, auto end) -> void {
+        using value_type = typename std::iterator_traits<decltype(begin)>::value_type;
+
+        std::fill(begin, end, static_cast<value_type>(1.f));
+    });
+
+    EXPECT_GT(pointData->getStorageVersion(), storageVersion);
+    EXPECT_FALSE(canReuseEncodedData(*pointData));
+    EXPECT_EQ(pointData->getRevision(), revision);
+}
+
+
+TEST(RawData, ModificationsDuringASavePreventReuse)
+{
+    const auto pointData = createPointData(100);
+
+    // The save captures the revision and storage version before it encodes the data
+    const auto revision         = pointData->getRevision();
+    const auto storageVersion   = pointData->getStorageVersion();
+
+    pointData->visitFromBeginToEnd([](auto begin, auto end) -> void {
+        if (begin != end)
+            *begin = static_cast<typename std::iterator_traits<decltype(begin)>::value_type>(7.f);
+    });
+
+    pointData->setEncodedData(getEncodedData(), "Project.mv", revision, storageVersion);
+
+    EXPECT_FALSE(canReuseEncodedData(*pointData));
+
+    pointData->setModified();
+
+    pointData->setEncodedData(getEncodedData(), "Project.mv", revision, pointData->getStorageVersion());
+
+    EXPECT_FALSE(canReuseEncodedData(*pointData));
+}
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <PointData.h>
+
+#include <Application.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+    /** Produces point data without registering it with a core */
+    class TestPointDataFactory : public mv::plugin::RawDataFactory
+    {
+    public:
+        mv::plugin::RawData* produce() override
+        {
+            return new PointData(this);
+        }
+    };
+
+    /** Plugins and their factories are actions, which need an application */
+    TestPointDataFactory& getPointDataFactory()
+    {
+        static int argc = 1;
+        static char applicationName[] = "PointDataGTest";
+        static char* argv[] = { applicationName, nullptr };
+
+        if (!mv::Application::current()) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+
+            static mv::Application application(argc, argv);
+        }
+
+        static TestPointDataFactory pointDataFactory;
+
+        return pointDataFactory;
+    }
+
+    constexpr std::uint32_t numberOfDimensions = 16;
+
+    /** Point data with \p numPoints points of sixteen dimensions, with values 0, 1, 2, ... */
+    std::unique_ptr<PointData> createPointData(std::size_t numPoints)
+    {
+        auto pointData = std::make_unique<PointData>(&getPointDataFactory());
+
+        std::vector<float> values(numberOfDimensions * numPoints);
+
+        std::iota(values.begin(), values.end(), 0.f);
+
+        pointData->setData(std::move(values), numberOfDimensions);
+
+        return pointData;
+    }
+
+    /** Values of dimension \p dimensionIndex of \p pointData, as read from the row-major data */
+    std::vector<float> getDimension(const PointData& pointData, std::uint32_t dimensionIndex)
+    {
+        std::vector<float> values(pointData.getNumPoints());
+
+        for (std::uint64_t pointIndex = 0; pointIndex < values.size(); ++pointIndex)
+            values[pointIndex] = pointData.getValueAt(pointIndex * numberOfDimensions + dimensionIndex);
+
+        return values;
+    }
+
+    /** Extract dimension \p dimensionIndex of \p pointData \p numberOfExtractions times and check each result */
+    void extractDimension(const PointData& pointData, std::uint32_t dimensionIndex, std::uint32_t numberOfExtractions)
+    {
+        for (std::uint32_t extraction = 0; extraction < numberOfExtractions; ++extraction) {
+            std::vector<float> result;
+
+            pointData.extractFullDataForDimension(result, static_cast<int>(dimensionIndex));
+
+            EXPECT_EQ(result, getDimension(pointData, dimensionIndex));
+        }
+    }
+
+    /** Restores the default memory budget of the column-major copies when it goes out of scope */
+    class MemoryBudgetGuard
+    {
+    public:
+        MemoryBudgetGuard() :
+            _maximumTotalColumnMajorDataSize(PointData::getMaximumTotalColumnMajorDataSize())
+        {
+        }
+
+        ~MemoryBudgetGuard()
+        {
+            PointData::setMaximumTotalColumnMajorDataSize(_maximumTotalColumnMajorDataSize);
+        }
+
+    private:
+        std::uint64_t _maximumTotalColumnMajorDataSize;
+    };
+}
+
+
+TEST(PointData, ColumnMajorDataIsOptIn)
+{
+    const auto pointData = createPointData(1000);
+
+    EXPECT_FALSE(pointData->isColumnMajorDataEnabled());
+
+    extractDimension(*pointData, 3, 2 * PointData::columnMajorDataAccessThreshold);
+
+    EXPECT_EQ(pointData->getColumnMajorDataSize(), 0u);
+    EXPECT_FALSE(pointData->constVisitColumnMajorFromBeginToEnd([](auto, auto) -> void {}));
+}
+
+
+TEST(PointData, ColumnMajorDataIsBuiltOnRepeatedAccess)
+{
+    const auto pointData = createPointData(1000);
+
+    const auto totalColumnMajorDataSize = PointData::getTotalColumnMajorDataSize();
+
+    pointData->setColumnMajorDataEnabled(true);
+
+    // A single extraction does not pay for transposing the whole matrix
+    extractDimension(*pointData, 5, PointData::columnMajorDataAccessThreshold - 1);
+
+    EXPECT_EQ(pointData->getColumnMajorDataSize(), 0u);
+
+    extractDimension(*pointData, 7, 1);
+
+    EXPECT_EQ(pointData->getColumnMajorDataSize(), pointData->getRawDataSize());
+    EXPECT_EQ(PointData::getTotalColumnMajorDataSize(), totalColumnMajorDataSize + pointData->getRawDataSize());
+
+    // Dimensions are contiguous in the copy, and extractions from it match the row-major data
+    EXPECT_TRUE(pointData->constVisitColumnMajorFromBeginToEnd([&pointData](auto begin, auto) -> void {
+        for (std::uint32_t dimensionIndex = 0; dimensionIndex < numberOfDimensions; ++dimensionIndex)
+            EXPECT_TRUE(std::equal(begin + dimensionIndex * 1000, begin + (dimensionIndex + 1) * 1000, getDimension(*pointData, dimensionIndex).begin()));
+    }));
+
+    extractDimension(*pointData, 0, 1);
+    extractDimension(*pointData, numberOfDimensions - 1, 1);
+
+    // Disabling the copy releases it
+    pointData->setColumnMajorDataEnabled(false);
+
+    EXPECT_EQ(pointData->getColumnMajorDataSize(), 0u);
+    EXPECT_EQ(PointData::getTotalColumnMajorDataSize(), totalColumnMajorDataSize);
+}
+
+
+TEST(PointData, ModifyingTheDataReleasesTheColumnMajorData)
+{
+    auto pointData = createPointData(1000);
+
+    const auto totalColumnMajorDataSize = PointData::getTotalColumnMajorDataSize();
+
+    pointData->setColumnMajorDataEnabled(true);
+
+    extractDimension(*pointData, 2, PointData::columnMajorDataAccessThreshold);
+
+    EXPECT_GT(pointData->getColumnMajorDataSize(), 0u);
+
+    pointData->visitFromBeginToEnd([](auto begin, auto end) -> void {
+        using value_type = typename std::iterator_traits<decltype(begin)>::value_type;
+
+        std::fill(begin, end, static_cast<value_type>(2.f));
+    });
+
+    EXPECT_EQ(pointData->getColumnMajorDataSize(), 0u);
+    EXPECT_EQ(PointData::getTotalColumnMajorDataSize(), totalColumnMajorDataSize);
+
+    // The modified data has to be accessed repeatedly again before it is copied
+    extractDimension(*pointData, 2, PointData::columnMajorDataAccessThreshold - 1);
+
+    EXPECT_EQ(pointData->getColumnMajorDataSize(), 0u);
+
+    extractDimension(*pointData, 2, 1);
+
+    EXPECT_EQ(pointData->getColumnMajorDataSize(), pointData->getRawDataSize());
+
+    // Destroying the data returns its copy to the memory budget
+    pointData.reset();
+
+    EXPECT_EQ(PointData::getTotalColumnMajorDataSize(), totalColumnMajorDataSize);
+}
+
+
+TEST(PointData, ColumnMajorDataIsBoundedByAMemoryBudget)
+{
+    const MemoryBudgetGuard memoryBudgetGuard;
+
+    const auto first    = createPointData(1000);
+    const auto second   = createPointData(1000);
+
+    // Room for one copy only
+    PointData::setMaximumTotalColumnMajorDataSize(PointData::getTotalColumnMajorDataSize() + first->getRawDataSize());
+
+    first->setColumnMajorDataEnabled(true);
+    second->setColumnMajorDataEnabled(true);
+
+    extractDimension(*first, 1, PointData::columnMajorDataAccessThreshold);
+    extractDimension(*second, 1, PointData::columnMajorDataAccessThreshold);
+
+    EXPECT_EQ(first->getColumnMajorDataSize(), first->getRawDataSize());
+    EXPECT_EQ(second->getColumnMajorDataSize(), 0u);
+
+    // Extraction falls back to the row-major data
+    extractDimension(*second, 4, 1);
+
+    // Once the first copy is released, the second fits
+    first->setColumnMajorDataEnabled(false);
+
+    extractDimension(*second, 1, 1);
+
+    EXPECT_EQ(second->getColumnMajorDataSize(), second->getRawDataSize());
+}
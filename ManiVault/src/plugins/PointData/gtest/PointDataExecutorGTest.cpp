@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <PointData.h>
+
+#include <Application.h>
+
+#include <workflow/AbstractWorkflowPlanExecutor.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace mv::workflow;
+
+namespace
+{
+    /** Produces point data without registering it with a core */
+    class TestPointDataFactory : public mv::plugin::RawDataFactory
+    {
+    public:
+        mv::plugin::RawData* produce() override
+        {
+            return new PointData(this);
+        }
+    };
+
+    /** Runs data-parallel loops on threads of its own and records them, it does not execute workflow plans */
+    class TestWorkflowPlanExecutor : public AbstractWorkflowPlanExecutor
+    {
+    public:
+        static constexpr std::uint32_t numberOfThreads = 4;
+
+        WorkflowResultFuture execute(UniqueWorkflowPlan, SharedWorkflowExecutionContext, OptionalWorkflowOptions) override { throw std::logic_error("Not implemented"); }
+        SharedWorkflowResult executeBlocking(UniqueWorkflowPlan, mv::Task*, WorkflowOptions) override { throw std::logic_error("Not implemented"); }
+        SharedWorkflowResult executeBlocking(UniqueWorkflowPlan, SharedWorkflowExecutionContext) override { throw std::logic_error("Not implemented"); }
+
+        void parallelFor(std::uint64_t count, const std::function<void(std::uint64_t)>& function) override
+        {
+            {
+                const std::lock_guard lock(_mutex);
+
+                _loopCounts.push_back(count);
+            }
+
+            std::atomic<std::uint64_t> nextIndex = 0;
+            std::vector<std::thread> threads;
+
+            for (std::uint32_t threadIndex = 0; threadIndex < numberOfThreads; ++threadIndex) {
+                threads.emplace_back([&nextIndex, count, &function]() -> void {
+                    for (auto index = nextIndex++; index < count; index = nextIndex++)
+                        function(index);
+                });
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        /** Number of indices of each loop since the last call */
+        std::vector<std::uint64_t> takeLoopCounts()
+        {
+            const std::lock_guard lock(_mutex);
+
+            return std::exchange(_loopCounts, {});
+        }
+
+    protected:
+        WorkflowResultFuture executeAsyncImpl(UniqueWorkflowPlan, mv::Task::GuiScope, const WorkflowOptions&, SharedWorkflowExecutionContext) override { throw std::logic_error("Not implemented"); }
+        SharedWorkflowResult executeRoot(WorkflowPlan&, mv::Task*, const WorkflowOptions&) override { throw std::logic_error("Not implemented"); }
+        SharedWorkflowResult executeChild(WorkflowPlan&, SharedWorkflowExecutionContext) override { throw std::logic_error("Not implemented"); }
+
+    private:
+        void executeJobOnGuiThread(const WorkflowPlan::Job&, SharedWorkflowExecutionContext) override { throw std::logic_error("Not implemented"); }
+        void executeJobOnWorkerThread(const WorkflowPlan::Job&, SharedWorkflowExecutionContext) override { throw std::logic_error("Not implemented"); }
+        void executeJob(const WorkflowPlan::Job&, SharedWorkflowExecutionContext) override { throw std::logic_error("Not implemented"); }
+
+    private:
+        std::mutex                  _mutex;
+        std::vector<std::uint64_t>  _loopCounts;
+    };
+
+    /** Plugins and their factories are actions, which need an application (with the test executor) */
+    TestPointDataFactory& getPointDataFactory()
+    {
+        static int argc = 1;
+        static char applicationName[] = "PointDataGTest";
+        static char* argv[] = { applicationName, nullptr };
+
+        if (!mv::Application::current()) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+
+            static mv::Application application(argc, argv);
+        }
+
+        static TestPointDataFactory pointDataFactory;
+
+        return pointDataFactory;
+    }
+
+    TestWorkflowPlanExecutor& getWorkflowPlanExecutor()
+    {
+        getPointDataFactory();
+
+        static auto workflowPlanExecutor = []() -> TestWorkflowPlanExecutor* {
+            auto testWorkflowPlanExecutor = std::make_unique<TestWorkflowPlanExecutor>();
+            auto testWorkflowPlanExecutorPointer = testWorkflowPlanExecutor.get();
+
+            mv::Application::setWorkflowPlanExecutor(std::move(testWorkflowPlanExecutor));
+
+            return testWorkflowPlanExecutorPointer;
+        }();
+
+        return *workflowPlanExecutor;
+    }
+
+    /** Point data with \p numPoints points of \p numDimensions dimensions, with values 0, 1, 2, ... */
+    std::unique_ptr<PointData> createPointData(std::size_t numPoints, std::uint32_t numDimensions)
+    {
+        auto pointData = std::make_unique<PointData>(&getPointDataFactory());
+
+        std::vector<float> values(numDimensions * numPoints);
+
+        std::iota(values.begin(), values.end(), 0.f);
+
+        pointData->setData(std::move(values), numDimensions);
+
+        return pointData;
+    }
+}
+
+
+TEST(PointData, ExtractionRunsOnTheWorkflowPlanExecutor)
+{
+    auto& workflowPlanExecutor = getWorkflowPlanExecutor();
+
+    constexpr std::uint64_t numberOfPoints = 3 * PointData::extractionGrainSize + 5;
+
+    const auto pointData = createPointData(numberOfPoints, 2);
+
+    (void)workflowPlanExecutor.takeLoopCounts();
+
+    std::vector<float> result;
+
+    pointData->extractFullDataForDimension(result, 1);
+
+    // One loop with an index per grain
+    EXPECT_EQ(workflowPlanExecutor.takeLoopCounts(), std::vector<std::uint64_t>({ 4 }));
+
+    ASSERT_EQ(result.size(), numberOfPoints);
+
+    for (std::uint64_t pointIndex = 0; pointIndex < numberOfPoints; ++pointIndex)
+        ASSERT_EQ(result[pointIndex], static_cast<float>(2 * pointIndex + 1));
+
+    // A single grain is extracted on the calling thread
+    const auto smallPointData = createPointData(100, 2);
+
+    smallPointData->extractFullDataForDimension(result, 0);
+
+    EXPECT_TRUE(workflowPlanExecutor.takeLoopCounts().empty());
+    EXPECT_EQ(result[99], 198.f);
+}
+
+
+TEST(PointData, ColumnMajorDataIsTransposedOnTheWorkflowPlanExecutor)
+{
+    auto& workflowPlanExecutor = getWorkflowPlanExecutor();
+
+    // Three tiles of (at most) 64 dimensions
+    const auto pointData = createPointData(10, 130);
+
+    pointData->setColumnMajorDataEnabled(true);
+
+    (void)workflowPlanExecutor.takeLoopCounts();
+
+    std::vector<float> result;
+
+    for (std::uint32_t extraction = 0; extraction < PointData::columnMajorDataAccessThreshold; ++extraction)
+        pointData->extractFullDataForDimension(result, 129);
+
+    EXPECT_EQ(workflowPlanExecutor.takeLoopCounts(), std::vector<std::uint64_t>({ 3 }));
+    EXPECT_GT(pointData->getColumnMajorDataSize(), 0u);
+
+    for (std::uint64_t pointIndex = 0; pointIndex < 10; ++pointIndex)
+        EXPECT_EQ(result[pointIndex], static_cast<float>(130 * pointIndex + 129));
+}
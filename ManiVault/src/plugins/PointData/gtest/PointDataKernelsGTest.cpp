@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <PointDataKernels.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using mv::kernels::InstructionSet;
+
+namespace
+{
+    /** Vectorized instruction sets which the processor supports */
+    std::vector<InstructionSet> getSupportedInstructionSets()
+    {
+        std::vector<InstructionSet> instructionSets;
+
+        for (const auto instructionSet : { InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512, InstructionSet::NEON })
+            if (mv::kernels::isSupported(instructionSet))
+                instructionSets.push_back(instructionSet);
+
+        return instructionSets;
+    }
+
+    /** Random elements over the full range of \p T (bfloat16 over a range of floats) */
+    template <typename T>
+    std::vector<T> generateElements(std::size_t count, std::mt19937& randomNumberEngine)
+    {
+        std::vector<T> elements(count);
+
+        for (auto& element : elements) {
+            if constexpr (std::is_same_v<T, biovault::bfloat16_t> || std::is_floating_point_v<T>)
+                element = static_cast<T>(std::uniform_real_distribution<float>(-1.e6f, 1.e6f)(randomNumberEngine));
+            else
+                element = static_cast<T>(std::uniform_int_distribution<std::int64_t>(std::numeric_limits<T>::min(), std::numeric_limits<T>::max())(randomNumberEngine));
+        }
+
+        return elements;
+    }
+
+    /** Compare the kernels of all supported instruction sets with the scalar ones, for element type \p T */
+    template <typename T>
+    void compareWithScalarKernels(std::mt19937& randomNumberEngine)
+    {
+        constexpr std::uint64_t numberOfDimensions = 3;
+
+        // Counts around the vector widths (4, 8 and 16) and the gather tile size, so that all tails are covered
+        for (const std::size_t count : { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 255, 256, 257, 1000 }) {
+            const auto elements = generateElements<T>(count * numberOfDimensions, randomNumberEngine);
+
+            std::vector<std::uint32_t> indices(count);
+
+            for (auto& index : indices)
+                index = static_cast<std::uint32_t>(randomNumberEngine() % count);
+
+            std::vector<float> expectedConverted(count * numberOfDimensions), expectedGathered(count), expectedPairs(2 * count);
+
+            mv::kernels::convertToFloat(InstructionSet::Scalar, elements.data(), expectedConverted.data(), elements.size());
+            mv::kernels::gatherToFloat(InstructionSet::Scalar, elements.data(), numberOfDimensions, 1, indices.data(), expectedGathered.data(), count);
+            mv::kernels::gatherPairsToFloat(InstructionSet::Scalar, elements.data(), numberOfDimensions, 2, 0, nullptr, expectedPairs.data(), count);
+
+            for (std::size_t index = 0; index < elements.size(); ++index)
+                ASSERT_EQ(expectedConverted[index], static_cast<float>(elements[index]));
+
+            for (const auto instructionSet : getSupportedInstructionSets()) {
+                SCOPED_TRACE(testing::Message() << "Instruction set " << static_cast<int>(instructionSet) << ", count " << count);
+
+                // Offset destinations and sources, so that unaligned loads and stores are covered as well
+                std::vector<float> converted(count * numberOfDimensions + 1), gathered(count), pairs(2 * count);
+
+                mv::kernels::convertToFloat(instructionSet, elements.data(), converted.data() + 1, elements.size());
+                mv::kernels::gatherToFloat(instructionSet, elements.data(), numberOfDimensions, 1, indices.data(), gathered.data(), count);
+                mv::kernels::gatherPairsToFloat(instructionSet, elements.data(), numberOfDimensions, 2, 0, nullptr, pairs.data(), count);
+
+                EXPECT_EQ(std::vector<float>(converted.begin() + 1, converted.end()), expectedConverted);
+                EXPECT_EQ(gathered, expectedGathered);
+                EXPECT_EQ(pairs, expectedPairs);
+
+                if (count > 1) {
+                    std::vector<float> unalignedConverted(count - 1);
+
+                    mv::kernels::convertToFloat(instructionSet, elements.data() + 1, unalignedConverted.data(), count - 1);
+
+                    EXPECT_EQ(unalignedConverted, std::vector<float>(expectedConverted.begin() + 1, expectedConverted.begin() + count));
+                }
+            }
+        }
+    }
+}
+
+
+TEST(PointDataKernels, DefaultInstructionSetIsSupported)
+{
+    EXPECT_TRUE(mv::kernels::isSupported(InstructionSet::Scalar));
+    EXPECT_TRUE(mv::kernels::isSupported(mv::kernels::getInstructionSet()));
+
+    // The widest supported instruction set is the default
+    for (const auto instructionSet : getSupportedInstructionSets())
+        EXPECT_LE(static_cast<int>(instructionSet), static_cast<int>(mv::kernels::getInstructionSet()));
+}
+
+
+TEST(PointDataKernels, KernelsMatchTheScalarKernels)
+{
+    std::mt19937 randomNumberEngine(1);
+
+    compareWithScalarKernels<float>(randomNumberEngine);
+    compareWithScalarKernels<biovault::bfloat16_t>(randomNumberEngine);
+    compareWithScalarKernels<std::int32_t>(randomNumberEngine);
+    compareWithScalarKernels<std::uint32_t>(randomNumberEngine);
+    compareWithScalarKernels<std::int16_t>(randomNumberEngine);
+    compareWithScalarKernels<std::uint16_t>(randomNumberEngine);
+    compareWithScalarKernels<std::int8_t>(randomNumberEngine);
+    compareWithScalarKernels<std::uint8_t>(randomNumberEngine);
+}
+
+
+TEST(PointDataKernels, InterleavingMatchesTheScalarKernel)
+{
+    std::mt19937 randomNumberEngine(2);
+
+    for (const std::size_t count : { 0, 1, 3, 4, 5, 8, 13, 256, 1001 }) {
+        const auto x = generateElements<float>(count, randomNumberEngine);
+        const auto y = generateElements<float>(count, randomNumberEngine);
+
+        std::vector<float> expected(2 * count);
+
+        mv::kernels::interleave(InstructionSet::Scalar, x.data(), y.data(), expected.data(), count);
+
+        for (std::size_t index = 0; index < count; ++index)
+            ASSERT_EQ(std::make_tuple(expected[2 * index], expected[2 * index + 1]), std::make_tuple(x[index], y[index]));
+
+        for (const auto instructionSet : getSupportedInstructionSets()) {
+            std::vector<float> interleaved(2 * count);
+
+            mv::kernels::interleave(instructionSet, x.data(), y.data(), interleaved.data(), count);
+
+            EXPECT_EQ(interleaved, expected) << "Instruction set " << static_cast<int>(instructionSet) << ", count " << count;
+        }
+    }
+}
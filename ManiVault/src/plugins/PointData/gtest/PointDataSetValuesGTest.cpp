@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <PointData.h>
+
+#include <Application.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    /** Produces point data without registering it with a core */
+    class TestPointDataFactory : public mv::plugin::RawDataFactory
+    {
+    public:
+        mv::plugin::RawData* produce() override
+        {
+            return new PointData(this);
+        }
+    };
+
+    /** Plugins and their factories are actions, which need an application */
+    TestPointDataFactory& getPointDataFactory()
+    {
+        static int argc = 1;
+        static char applicationName[] = "PointDataGTest";
+        static char* argv[] = { applicationName, nullptr };
+
+        if (!mv::Application::current()) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+
+            static mv::Application application(argc, argv);
+        }
+
+        static TestPointDataFactory pointDataFactory;
+
+        return pointDataFactory;
+    }
+
+    constexpr std::uint32_t numberOfDimensions = 3;
+
+    /** Values 0, 1, 2, ... of \p numPoints points of three dimensions */
+    std::vector<float> createValues(std::size_t numPoints)
+    {
+        std::vector<float> values(numberOfDimensions * numPoints);
+
+        std::iota(values.begin(), values.end(), 0.f);
+
+        return values;
+    }
+
+    /** Point data with the values of createValues() */
+    std::unique_ptr<PointData> createPointData(std::size_t numPoints)
+    {
+        auto pointData = std::make_unique<PointData>(&getPointDataFactory());
+
+        pointData->setData(createValues(numPoints), numberOfDimensions);
+
+        return pointData;
+    }
+
+    /** All values of \p pointData */
+    std::vector<float> getValues(const PointData& pointData)
+    {
+        std::vector<float> values(pointData.getNumPoints() * numberOfDimensions);
+
+        for (std::size_t valueIndex = 0; valueIndex < values.size(); ++valueIndex)
+            values[valueIndex] = pointData.getValueAt(valueIndex);
+
+        return values;
+    }
+}
+
+
+TEST(PointData, SetsTheValuesOfAPointRange)
+{
+    const auto pointData = createPointData(10);
+
+    // All dimensions, converted from integers
+    const std::vector<std::int32_t> rows = { -1, -2, -3, -4, -5, -6 };
+
+    pointData->setValues(4, 2, {}, rows.data());
+
+    auto expectedValues = createValues(10);
+
+    for (std::size_t valueIndex = 0; valueIndex < rows.size(); ++valueIndex)
+        expectedValues[12 + valueIndex] = static_cast<float>(rows[valueIndex]);
+
+    EXPECT_EQ(getValues(*pointData), expectedValues);
+
+    // Some dimensions, in the order of their indices
+    const std::vector<float> columns = { 100.f, 200.f, 101.f, 201.f, 102.f, 202.f };
+
+    pointData->setValues(7, 3, { 2, 0 }, columns.data());
+
+    for (std::size_t pointIndex = 7; pointIndex < 10; ++pointIndex) {
+        expectedValues[pointIndex * numberOfDimensions + 2] = 100.f + static_cast<float>(pointIndex - 7);
+        expectedValues[pointIndex * numberOfDimensions + 0] = 200.f + static_cast<float>(pointIndex - 7);
+    }
+
+    EXPECT_EQ(getValues(*pointData), expectedValues);
+
+    // An empty range
+    pointData->setValues<float>(10, 0, {}, nullptr);
+
+    EXPECT_EQ(getValues(*pointData), expectedValues);
+}
+
+
+TEST(PointData, SetsTheValuesOfPointIndices)
+{
+    const auto pointData = createPointData(10);
+
+    const std::vector<float> values = { -9.f, -2.f, -5.f };
+
+    pointData->setValues({ 9, 2, 5 }, { 1 }, values.data());
+
+    auto expectedValues = createValues(10);
+
+    expectedValues[9 * numberOfDimensions + 1] = -9.f;
+    expectedValues[2 * numberOfDimensions + 1] = -2.f;
+    expectedValues[5 * numberOfDimensions + 1] = -5.f;
+
+    EXPECT_EQ(getValues(*pointData), expectedValues);
+}
+
+
+TEST(PointData, SettingValuesIsIsolatedFromSnapshots)
+{
+    const auto pointData = createPointData(10);
+
+    const auto snapshot         = pointData->getSnapshot();
+    const auto storageVersion   = pointData->getStorageVersion();
+
+    const std::vector<float> values(numberOfDimensions, -1.f);
+
+    pointData->setValues(0, 1, {}, values.data());
+
+    EXPECT_GT(pointData->getStorageVersion(), storageVersion);
+    EXPECT_NE(pointData->getDataConstVoidPtr(), snapshot.getDataConstVoidPtr());
+    EXPECT_EQ(pointData->getValueAt(0), -1.f);
+
+    EXPECT_EQ(snapshot.constVisitFromBeginToEnd<float>([](auto begin, auto) -> float { return static_cast<float>(*begin); }), 0.f);
+}
+
+
+TEST(PointData, ThrowsOnSettingValuesOutOfRange)
+{
+    const auto pointData = createPointData(10);
+
+    const std::vector<float> values(2 * numberOfDimensions, -1.f);
+
+    EXPECT_THROW(pointData->setValues(9, 2, {}, values.data()), std::out_of_range);
+    EXPECT_THROW(pointData->setValues(std::numeric_limits<std::uint64_t>::max(), 2, {}, values.data()), std::out_of_range);
+    EXPECT_THROW(pointData->setValues({ 0, 10 }, {}, values.data()), std::out_of_range);
+    EXPECT_THROW(pointData->setValues(0, 2, { 0, numberOfDimensions }, values.data()), std::out_of_range);
+    EXPECT_THROW(pointData->setValues({ 0, 1 }, { 3 }, values.data()), std::out_of_range);
+
+    // The data is left unchanged
+    EXPECT_EQ(getValues(*pointData), createValues(10));
+}
@@ -0,0 +1,396 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The files to be tested:
+#include <PointData.h>
+#include <RecursiveSharedMutex.h>
+
+#include <Application.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /** Produces point data without registering it with a core */
+    class TestPointDataFactory : public mv::plugin::RawDataFactory
+    {
+    public:
+        mv::plugin::RawData* produce() override
+        {
+            return new PointData(this);
+        }
+    };
+
+    /** Plugins and their factories are actions, which need an application */
+    TestPointDataFactory& getPointDataFactory()
+    {
+        static int argc = 1;
+        static char applicationName[] = "PointDataGTest";
+        static char* argv[] = { applicationName, nullptr };
+
+        if (!mv::Application::current()) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+
+            static mv::Application application(argc, argv);
+        }
+
+        static TestPointDataFactory pointDataFactory;
+
+        return pointDataFactory;
+    }
+
+    /** Point data with \p numPoints points of two dimensions, with values 0, 1, 2, ... */
+    std::unique_ptr<PointData> createPointData(std::size_t numPoints)
+    {
+        auto pointData = std::make_unique<PointData>(&getPointDataFactory());
+
+        std::vector<float> values(2 * numPoints);
+
+        std::iota(values.begin(), values.end(), 0.f);
+
+        pointData->setData(std::move(values), 2);
+
+        return pointData;
+    }
+
+    /** Sum of the values in \p snapshot */
+    double getSum(const PointData::Snapshot& snapshot)
+    {
+        return snapshot.constVisitFromBeginToEnd<double>([](auto begin, auto end) -> double {
+            double sum = 0.0;
+
+            for (auto it = begin; it != end; ++it)
+                sum += static_cast<double>(static_cast<float>(*it));
+
+            return sum;
+        });
+    }
+
+    /** Modify all values of \p pointData in place */
+    void fill(PointData& pointData, float value)
+    {
+        pointData.visitFromBeginToEnd([value](auto begin, auto end) -> void {
+            using value_type = typename std::iterator_traits<decltype(begin)>::value_type;
+
+            std::fill(begin, end, static_cast<value_type>(value));
+        });
+    }
+}
+
+
+TEST(RecursiveSharedMutex, NestsLocksOfTheOwningThread)
+{
+    RecursiveSharedMutex mutex;
+
+    {
+        const std::unique_lock exclusiveLock(mutex);
+        const std::unique_lock nestedExclusiveLock(mutex);
+        const std::shared_lock sharedLockInsideExclusiveLock(mutex);
+    }
+
+    {
+        const std::shared_lock sharedLock(mutex);
+        const std::shared_lock nestedSharedLock(mutex);
+    }
+
+    // Fully released, so another thread may lock exclusively
+    std::thread([&mutex]() -> void {
+        const std::unique_lock exclusiveLock(mutex);
+    }).join();
+}
+
+
+TEST(RecursiveSharedMutex, UpgradesASharedLock)
+{
+    RecursiveSharedMutex mutex;
+
+    {
+        const std::shared_lock sharedLock(mutex);
+
+        std::atomic_bool isRead = false;
+        std::thread reader;
+
+        {
+            const std::unique_lock exclusiveLock(mutex);
+
+            // Other threads can not read while the lock is upgraded
+            reader = std::thread([&mutex, &isRead]() -> void {
+                const std::shared_lock otherSharedLock(mutex);
+
+                isRead = true;
+            });
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+            EXPECT_FALSE(isRead);
+        }
+
+        reader.join();
+
+        EXPECT_TRUE(isRead);
+
+        // The shared lock is restored, and may be nested
+        const std::shared_lock nestedSharedLock(mutex);
+    }
+
+    // Fully released, so another thread may lock exclusively
+    std::thread([&mutex]() -> void {
+        const std::unique_lock exclusiveLock(mutex);
+    }).join();
+}
+
+
+TEST(RecursiveSharedMutex, ReadersUpgradeConcurrently)
+{
+    RecursiveSharedMutex mutex;
+
+    std::atomic_uint32_t numberOfReaders = 0;
+    std::uint32_t numberOfWrites = 0;
+
+    std::vector<std::thread> readers;
+
+    // All readers hold the shared lock before any of them upgrades, which deadlocks if the upgrade keeps the shared lock
+    for (std::uint32_t readerIndex = 0; readerIndex < 4; ++readerIndex) {
+        readers.emplace_back([&]() -> void {
+            const std::shared_lock sharedLock(mutex);
+
+            ++numberOfReaders;
+
+            while (numberOfReaders < 4)
+                std::this_thread::yield();
+
+            const std::unique_lock exclusiveLock(mutex);
+
+            ++numberOfWrites;
+        });
+    }
+
+    for (auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(numberOfWrites, 4u);
+}
+
+
+TEST(PointData, ExclusiveAccessWhileReadingUpgradesTheLock)
+{
+    const auto pointData = createPointData(10);
+
+    {
+        const auto sharedDataLock = pointData->lockDataShared();
+
+        {
+            const auto dataLock = pointData->lockData();
+        }
+
+        // Also when a member locks the data exclusively
+        pointData->setElementType(PointData::ElementTypeSpecifier::float32);
+
+        // Reading is fine
+        EXPECT_EQ(pointData->getNumPoints(), 10u);
+    }
+
+    // Modify the data from inside a (read-only) visitor
+    const auto sum = pointData->constVisitFromBeginToEnd<double>([&pointData](auto begin, auto end) -> double {
+        double sum = 0.0;
+
+        for (auto it = begin; it != end; ++it)
+            sum += static_cast<double>(static_cast<float>(*it));
+
+        pointData->prepareForWrite();
+        pointData->setValueAt(0, 100.f);
+
+        return sum;
+    });
+
+    EXPECT_EQ(sum, 190.0);
+    EXPECT_EQ(pointData->getValueAt(0), 100.f);
+
+    const auto dataLock = pointData->lockData();
+
+    EXPECT_EQ(pointData->getNumDimensions(), 2u);
+}
+
+
+TEST(PointData, TakingASnapshotDoesNotCopy)
+{
+    const auto pointData = createPointData(1000);
+
+    const auto snapshot = pointData->getSnapshot();
+
+    ASSERT_TRUE(snapshot.isValid());
+    EXPECT_EQ(snapshot.getNumPoints(), 1000u);
+    EXPECT_EQ(snapshot.getNumDimensions(), 2u);
+    EXPECT_EQ(snapshot.getElementSize(), sizeof(float));
+    EXPECT_EQ(snapshot.getVersion(), pointData->getStorageVersion());
+    EXPECT_EQ(snapshot.getDataConstVoidPtr(), pointData->getDataConstVoidPtr());
+    EXPECT_EQ(pointData->getSnapshot().getDataConstVoidPtr(), snapshot.getDataConstVoidPtr());
+}
+
+
+TEST(PointData, SnapshotIsIsolatedFromModifications)
+{
+    const auto pointData = createPointData(1000);
+
+    const auto snapshot = pointData->getSnapshot();
+    const auto sum      = getSum(snapshot);
+
+    fill(*pointData, 0.f);
+
+    EXPECT_EQ(getSum(snapshot), sum);
+    EXPECT_GT(pointData->getStorageVersion(), snapshot.getVersion());
+    EXPECT_NE(pointData->getDataConstVoidPtr(), snapshot.getDataConstVoidPtr());
+    EXPECT_EQ(getSum(pointData->getSnapshot()), 0.0);
+
+    // Replace the data (with a different number of points and dimensions)
+    const auto zeroSnapshot = pointData->getSnapshot();
+
+    pointData->setData(std::vector<float>(30, 1.f), 3);
+
+    EXPECT_EQ(getSum(snapshot), sum);
+    EXPECT_EQ(snapshot.getNumPoints(), 1000u);
+    EXPECT_EQ(zeroSnapshot.getNumPoints(), 1000u);
+    EXPECT_EQ(getSum(zeroSnapshot), 0.0);
+    EXPECT_EQ(pointData->getSnapshot().getNumPoints(), 10u);
+}
+
+
+TEST(PointData, SnapshotCanBeReadWhileTheDataIsModified)
+{
+    const auto pointData = createPointData(100000);
+
+    const auto snapshot = pointData->getSnapshot();
+    const auto sum      = getSum(snapshot);
+
+    std::atomic_bool isDone = false;
+    std::atomic_bool isUnchanged = true;
+
+    // Reads without a data lock
+    std::thread reader([&]() -> void {
+        while (!isDone)
+            if (getSum(snapshot) != sum)
+                isUnchanged = false;
+    });
+
+    for (std::uint32_t modification = 0; modification < 100; ++modification)
+        fill(*pointData, static_cast<float>(modification));
+
+    isDone = true;
+
+    reader.join();
+
+    EXPECT_TRUE(isUnchanged);
+    EXPECT_EQ(getSum(pointData->getSnapshot()), 99.0 * 200000.0);
+}
+
+
+TEST(PointData, SettingAValueCopiesOnWrite)
+{
+    const auto pointData = createPointData(1000);
+
+    const auto snapshot         = pointData->getSnapshot();
+    const auto sum              = getSum(snapshot);
+    const auto storageVersion   = pointData->getStorageVersion();
+
+    pointData->setValueAt(0, 1000.f);
+
+    // The snapshot keeps the unmodified data, and the modification is visible in the storage version
+    EXPECT_EQ(getSum(snapshot), sum);
+    EXPECT_NE(pointData->getDataConstVoidPtr(), snapshot.getDataConstVoidPtr());
+    EXPECT_GT(pointData->getStorageVersion(), storageVersion);
+    EXPECT_EQ(getSum(pointData->getSnapshot()), sum + 1000.0);
+
+    // Each write after the storage version was read is a modification
+    const auto modifiedStorageVersion = pointData->getStorageVersion();
+
+    pointData->setValueAt(1, 1000.f);
+
+    EXPECT_GT(pointData->getStorageVersion(), modifiedStorageVersion);
+
+    // Writes after prepareForWrite() do not lock
+    pointData->prepareForWrite();
+
+    const auto preparedStorageVersion = pointData->getStorageVersion();
+
+    pointData->prepareForWrite();
+
+    {
+        const auto sharedDataLock = pointData->lockDataShared();
+
+        std::thread([&pointData]() -> void {
+            pointData->setValueAt(2, 1000.f);
+        }).join();
+    }
+
+    EXPECT_GT(pointData->getStorageVersion(), preparedStorageVersion);
+    EXPECT_EQ(pointData->getValueAt(2), 1000.f);
+}
+
+
+TEST(PointData, PublishingTheBackBufferRecyclesBuffers)
+{
+    const auto pointData = createPointData(1000);
+
+    EXPECT_FALSE(pointData->publishBackBuffer());
+
+    const auto initialData = pointData->getDataConstVoidPtr();
+
+    // The first back buffer is allocated, since nothing was published yet
+    auto& firstBackBuffer = pointData->getBackBuffer<float>(1000, 2);
+
+    std::fill(firstBackBuffer.begin(), firstBackBuffer.end(), 1.f);
+
+    const auto firstData = static_cast<const void*>(firstBackBuffer.data());
+
+    ASSERT_TRUE(pointData->publishBackBuffer());
+    EXPECT_EQ(pointData->getDataConstVoidPtr(), firstData);
+    EXPECT_EQ(pointData->getNumberOfRecycledBuffers(), 1u);
+    EXPECT_EQ(getSum(pointData->getSnapshot()), 2000.0);
+
+    // The replaced storage is reused as the next back buffer, so that the producer ping-pongs between two buffers
+    EXPECT_EQ(static_cast<const void*>(pointData->getBackBuffer<float>(1000, 2).data()), initialData);
+    EXPECT_EQ(pointData->getNumberOfRecycledBuffers(), 0u);
+    ASSERT_TRUE(pointData->publishBackBuffer());
+    EXPECT_EQ(static_cast<const void*>(pointData->getBackBuffer<float>(1000, 2).data()), firstData);
+    ASSERT_TRUE(pointData->publishBackBuffer());
+    EXPECT_EQ(pointData->getDataConstVoidPtr(), firstData);
+
+    // A buffer which is still read through a snapshot is not reused
+    const auto snapshot = pointData->getSnapshot();
+
+    auto& backBuffer = pointData->getBackBuffer<float>(1000, 2);
+
+    EXPECT_EQ(static_cast<const void*>(backBuffer.data()), initialData);
+    ASSERT_TRUE(pointData->publishBackBuffer());
+    EXPECT_EQ(pointData->getNumberOfRecycledBuffers(), 1u);
+    EXPECT_NE(static_cast<const void*>(pointData->getBackBuffer<float>(1000, 2).data()), snapshot.getDataConstVoidPtr());
+    EXPECT_EQ(getSum(snapshot), 2000.0);
+
+    // The number of recycled buffers is bounded, even if none of them can be reused
+    std::vector<PointData::Snapshot> snapshots;
+
+    for (std::size_t publication = 0; publication < 2 * PointData::maximumNumberOfRecycledBuffers; ++publication) {
+        snapshots.push_back(pointData->getSnapshot());
+
+        pointData->getBackBuffer<float>(1000, 2);
+
+        ASSERT_TRUE(pointData->publishBackBuffer());
+        EXPECT_LE(pointData->getNumberOfRecycledBuffers(), PointData::maximumNumberOfRecycledBuffers);
+    }
+
+    EXPECT_EQ(pointData->getNumberOfRecycledBuffers(), PointData::maximumNumberOfRecycledBuffers);
+}
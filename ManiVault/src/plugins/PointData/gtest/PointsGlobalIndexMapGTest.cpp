@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <PointData.h>
+
+#include <Application.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+    using Indices = std::vector<std::uint32_t>;
+
+    /** Datasets are actions, which need an application (the datasets are not registered with a core) */
+    void ensureApplication()
+    {
+        static int argc = 1;
+        static char applicationName[] = "PointDataGTest";
+        static char* argv[] = { applicationName, nullptr };
+
+        if (mv::Application::current())
+            return;
+
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+        static mv::Application application(argc, argv);
+    }
+
+    /** Exposes the global index map of an explicit chain of subsets, which does not need a core */
+    class TestPoints : public Points
+    {
+    public:
+        using Points::Points;
+        using Points::getGlobalIndexMap;
+    };
+}
+
+
+TEST(Points, GlobalIndexMapIsCachedUntilTheIndicesChange)
+{
+    ensureApplication();
+
+    TestPoints subset("Subset");
+
+    subset.indices = { 5, 3, 8, 1 };
+    subset.indicesChanged();
+
+    const auto globalIndexMap = subset.getGlobalIndexMap({ &subset }, 4, 10);
+
+    EXPECT_EQ(globalIndexMap->getGlobalIndices(), Indices({ 5, 3, 8, 1 }));
+    EXPECT_FALSE(globalIndexMap->isContiguous());
+    EXPECT_TRUE(globalIndexMap->isInjective());
+    EXPECT_EQ(globalIndexMap->getLocalIndex(8), 2u);
+    EXPECT_EQ(globalIndexMap->getLocalIndex(2), Points::GlobalIndexMap::invalidIndex);
+
+    // Cached as long as the indices do not change
+    EXPECT_EQ(subset.getGlobalIndexMap({ &subset }, 4, 10), globalIndexMap);
+
+    // Invalidated by a change notification
+    subset.indicesChanged();
+
+    const auto notifiedGlobalIndexMap = subset.getGlobalIndexMap({ &subset }, 4, 10);
+
+    EXPECT_NE(notifiedGlobalIndexMap, globalIndexMap);
+    EXPECT_EQ(notifiedGlobalIndexMap->getGlobalIndices(), globalIndexMap->getGlobalIndices());
+
+    // Invalidated by a direct write to the indices, without a change notification
+    subset.indices[1] = 7;
+
+    const auto rewrittenGlobalIndexMap = subset.getGlobalIndexMap({ &subset }, 4, 10);
+
+    EXPECT_NE(rewrittenGlobalIndexMap, notifiedGlobalIndexMap);
+    EXPECT_EQ(rewrittenGlobalIndexMap->getGlobalIndices(), Indices({ 5, 7, 8, 1 }));
+    EXPECT_EQ(rewrittenGlobalIndexMap->getLocalIndex(7), 1u);
+    EXPECT_EQ(rewrittenGlobalIndexMap->getLocalIndex(3), Points::GlobalIndexMap::invalidIndex);
+
+    // The map which was handed out before is not modified
+    EXPECT_EQ(notifiedGlobalIndexMap->getGlobalIndices(), Indices({ 5, 3, 8, 1 }));
+
+    // Invalidated by replaced indices (of a different size)
+    subset.indices = { 9, 0 };
+
+    EXPECT_EQ(subset.getGlobalIndexMap({ &subset }, 2, 10)->getGlobalIndices(), Indices({ 9, 0 }));
+}
+
+
+TEST(Points, GlobalIndexMapFollowsTheSubsetsItDerivesFrom)
+{
+    ensureApplication();
+
+    TestPoints parent("Parent"), child("Child");
+
+    parent.indices = { 10, 20, 30, 40, 50 };
+    parent.indicesChanged();
+
+    child.indices = { 4, 0, 2 };
+    child.indicesChanged();
+
+    const auto globalIndexMap = child.getGlobalIndexMap({ &child, &parent }, 3, 100);
+
+    EXPECT_EQ(globalIndexMap->getGlobalIndices(), Indices({ 50, 10, 30 }));
+    EXPECT_EQ(globalIndexMap->getLocalIndex(30), 2u);
+    EXPECT_EQ(child.getGlobalIndexMap({ &child, &parent }, 3, 100), globalIndexMap);
+
+    // A change of the indices of the parent invalidates the map of the child
+    parent.indices[4] = 60;
+
+    const auto updatedGlobalIndexMap = child.getGlobalIndexMap({ &child, &parent }, 3, 100);
+
+    EXPECT_NE(updatedGlobalIndexMap, globalIndexMap);
+    EXPECT_EQ(updatedGlobalIndexMap->getGlobalIndices(), Indices({ 60, 10, 30 }));
+    EXPECT_EQ(updatedGlobalIndexMap->getLocalIndex(60), 0u);
+    EXPECT_EQ(updatedGlobalIndexMap->getLocalIndex(50), Points::GlobalIndexMap::invalidIndex);
+
+    // As does a different chain
+    EXPECT_EQ(child.getGlobalIndexMap({ &child }, 3, 100)->getGlobalIndices(), Indices({ 4, 0, 2 }));
+}
+
+
+TEST(Points, GlobalIndexMapOfConsecutiveIndices)
+{
+    ensureApplication();
+
+    TestPoints parent("Parent"), child("Child");
+
+    parent.indices.resize(1000);
+
+    std::iota(parent.indices.begin(), parent.indices.end(), 100u);
+
+    parent.indicesChanged();
+
+    child.indices.resize(10);
+
+    std::iota(child.indices.begin(), child.indices.end(), 20u);
+
+    child.indicesChanged();
+
+    const auto globalIndexMap = child.getGlobalIndexMap({ &child, &parent }, 10, 2000);
+
+    EXPECT_TRUE(globalIndexMap->isContiguous());
+    EXPECT_EQ(globalIndexMap->getFirstGlobalIndex(), 120u);
+    EXPECT_EQ(globalIndexMap->getLocalIndex(125), 5u);
+    EXPECT_EQ(globalIndexMap->getLocalIndex(130), Points::GlobalIndexMap::invalidIndex);
+
+    // Breaking the run of the child yields a map with an inverse
+    child.indices[0] = 999;
+
+    const auto updatedGlobalIndexMap = child.getGlobalIndexMap({ &child, &parent }, 10, 2000);
+
+    EXPECT_FALSE(updatedGlobalIndexMap->isContiguous());
+    EXPECT_EQ(updatedGlobalIndexMap->getGlobalIndices().front(), 1099u);
+    EXPECT_EQ(updatedGlobalIndexMap->getLocalIndex(1099), 0u);
+    EXPECT_EQ(updatedGlobalIndexMap->getLocalIndex(120), Points::GlobalIndexMap::invalidIndex);
+
+    // Duplicate global indices
+    child.indices[1] = 999;
+
+    EXPECT_FALSE(child.getGlobalIndexMap({ &child, &parent }, 10, 2000)->isInjective());
+}
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+// The file to be tested:
+#include <PointData.h>
+
+#include <Application.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using Indices   = std::vector<std::uint32_t>;
+    using IndexRuns = Points::IndexRuns;
+
+    /** Datasets are actions, which need an application (the datasets are not registered with a core) */
+    void ensureApplication()
+    {
+        static int argc = 1;
+        static char applicationName[] = "PointDataGTest";
+        static char* argv[] = { applicationName, nullptr };
+
+        if (mv::Application::current())
+            return;
+
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+        static mv::Application application(argc, argv);
+    }
+
+    /** Index runs of \p indices, computed without a cache */
+    IndexRuns getExpectedIndexRuns(const Indices& indices)
+    {
+        IndexRuns indexRuns;
+
+        for (const auto index : indices) {
+            if (!indexRuns.empty() && indexRuns.back().end == index)
+                ++indexRuns.back().end;
+            else
+                indexRuns.push_back({ index, index + 1 });
+        }
+
+        return indexRuns;
+    }
+}
+
+
+TEST(Points, IndexRunsOfConsecutiveIndices)
+{
+    ensureApplication();
+
+    Points points("Points");
+
+    EXPECT_TRUE(points.getIndexRuns()->empty());
+
+    points.indices = { 0, 1, 2, 5, 6, 9, 3, 4 };
+    points.indicesChanged();
+
+    EXPECT_EQ(*points.getIndexRuns(), IndexRuns({ { 0, 3 }, { 5, 7 }, { 9, 10 }, { 3, 5 } }));
+
+    // Compact runs are cached until the indices change
+    points.indices.resize(100);
+
+    std::iota(points.indices.begin(), points.indices.end(), 0u);
+    std::iota(points.indices.begin() + 50, points.indices.end(), 1000u);
+
+    points.indicesChanged();
+
+    const auto compactIndexRuns = points.getCompactIndexRuns();
+
+    ASSERT_NE(compactIndexRuns, nullptr);
+    EXPECT_EQ(*compactIndexRuns, IndexRuns({ { 0, 50 }, { 1000, 1050 } }));
+    EXPECT_EQ(points.getIndexRuns(), compactIndexRuns);
+    EXPECT_EQ(points.getCompactIndexRuns(), compactIndexRuns);
+}
+
+
+TEST(Points, IndexRunsOfFragmentedIndicesAreNotCached)
+{
+    ensureApplication();
+
+    Points points("Points");
+
+    // Ten runs of nine indices, at most one run per eight indices is compact
+    for (std::uint32_t run = 0; run < 10; ++run)
+        for (std::uint32_t index = 0; index < 9; ++index)
+            points.indices.push_back(100 * run + index);
+
+    points.indicesChanged();
+
+    ASSERT_NE(points.getCompactIndexRuns(), nullptr);
+    EXPECT_EQ(points.getCompactIndexRuns()->size(), 10u);
+
+    // Split one of the runs
+    points.indices[4] = 50;
+
+    EXPECT_EQ(points.getCompactIndexRuns(), nullptr);
+
+    const auto indexRuns = points.getIndexRuns();
+
+    EXPECT_EQ(*indexRuns, getExpectedIndexRuns(points.indices));
+    EXPECT_NE(points.getIndexRuns(), indexRuns);
+
+    // A single run is always compact
+    points.indices = { 7 };
+
+    ASSERT_NE(points.getCompactIndexRuns(), nullptr);
+    EXPECT_EQ(*points.getCompactIndexRuns(), IndexRuns({ { 7, 8 } }));
+}
+
+
+TEST(Points, IndexRunsFollowDirectWritesToTheIndices)
+{
+    ensureApplication();
+
+    std::mt19937 randomNumberEngine(1);
+
+    Points points("Points");
+
+    points.indices.resize(10000);
+
+    std::iota(points.indices.begin(), points.indices.end(), 100u);
+
+    points.indicesChanged();
+
+    ASSERT_EQ(*points.getIndexRuns(), IndexRuns({ { 100, 10100 } }));
+
+    // Rewrites in place, without a change notification (same size and buffer)
+    for (std::uint32_t trial = 0; trial < 100; ++trial) {
+        const auto indexRuns = points.getIndexRuns();
+
+        auto& index = points.indices[randomNumberEngine() % points.indices.size()];
+
+        index = (index + 1 + randomNumberEngine() % 19999) % 20000;
+
+        const auto expectedIndexRuns = getExpectedIndexRuns(points.indices);
+
+        EXPECT_EQ(*points.getIndexRuns(), expectedIndexRuns);
+
+        // The runs which were handed out before are not modified
+        EXPECT_NE(points.getIndexRuns(), indexRuns);
+    }
+
+    // Assigned indices of the same size
+    points.indices = Indices(points.indices.size(), 7u);
+
+    EXPECT_EQ(points.getIndexRuns()->size(), points.indices.size());
+}
+
+
+TEST(Points, SetIndexRunsNormalizesTheRuns)
+{
+    ensureApplication();
+
+    Points points("Points");
+
+    points.setIndexRuns({ { 0, 20 }, { 20, 40 }, { 45, 45 }, { 70, 80 }, { 90, 30 } });
+
+    Indices expectedIndices(50);
+
+    std::iota(expectedIndices.begin(), expectedIndices.begin() + 40, 0u);
+    std::iota(expectedIndices.begin() + 40, expectedIndices.end(), 70u);
+
+    EXPECT_EQ(points.indices, expectedIndices);
+
+    const auto indexRuns = points.getIndexRuns();
+
+    EXPECT_EQ(*indexRuns, IndexRuns({ { 0, 40 }, { 70, 80 } }));
+
+    // The normalized runs are cached as they are
+    EXPECT_EQ(points.getIndexRuns(), indexRuns);
+
+    // Unless they are fragmented
+    points.setIndexRuns({ { 0, 2 }, { 2, 4 }, { 7, 8 } });
+
+    EXPECT_EQ(points.indices, Indices({ 0, 1, 2, 3, 7 }));
+    EXPECT_EQ(points.getCompactIndexRuns(), nullptr);
+    EXPECT_EQ(*points.getIndexRuns(), IndexRuns({ { 0, 4 }, { 7, 8 } }));
+
+    points.setIndexRuns({});
+
+    EXPECT_TRUE(points.indices.empty());
+    EXPECT_TRUE(points.getIndexRuns()->empty());
+}
+
@@ -386,10 +386,13 @@ void DimensionsPickerAction::computeStatistics()
             
             const auto& pointData = *_points;
 
-            pointData.visitFromBeginToEnd([&statistics, &pointData](auto beginOfData, auto endOfData)
+            // Computes the statistics from either the row-major data or its column-major copy (in which each dimension is contiguous)
+            const auto computeStatisticsFromData = [&statistics, &pointData](auto beginOfData, const bool columnMajor)
             {
                 const auto numberOfDimensions = pointData.getNumDimensions();
                 const auto numberOfPoints = pointData.getNumPoints();
+                const std::uint64_t pointStride = columnMajor ? 1 : numberOfDimensions;
+                const std::uint64_t dimensionStride = columnMajor ? numberOfPoints : 1;
 
                 constexpr static auto quiet_NaN = std::numeric_limits<double>::quiet_NaN();
 
@@ -424,15 +427,15 @@ void DimensionsPickerAction::computeStatistics()
 #else
                         (void)std::for_each_n(statistics.begin(), numberOfDimensions,
 #endif
-                            [statisticsData, numberOfDimensions, numberOfPoints, beginOfData](auto& statisticsPerDimension)
+                            [statisticsData, numberOfPoints, pointStride, dimensionStride, beginOfData](auto& statisticsPerDimension)
                         {
                             const std::unique_ptr<double[]> data(new double[numberOfPoints]);
                             {
-                                const auto i = &statisticsPerDimension - statisticsData;
+                                const std::uint64_t i = &statisticsPerDimension - statisticsData;
 
                                 for (std::uint64_t j{}; j < numberOfPoints; ++j)
                                 {
-                                    data[j] = beginOfData[j * numberOfDimensions + i];
+                                    data[j] = beginOfData[j * pointStride + i * dimensionStride];
                                 }
                             }
 
@@ -475,7 +478,11 @@ void DimensionsPickerAction::computeStatistics()
                         });
                     }
                 }
-            });
+            };
+
+            if (!pointData.constVisitColumnMajorFromBeginToEnd([&computeStatisticsFromData](auto beginOfData, auto) { computeStatisticsFromData(beginOfData, true); }))
+                pointData.visitFromBeginToEnd([&computeStatisticsFromData](auto beginOfData, auto) { computeStatisticsFromData(beginOfData, false); });
+
             qDebug()
                 << " Duration: " << QTime::currentTime().msecsTo(time) << " microsecond(s)";
 
@@ -23,8 +23,9 @@
 #include <QDebug>
 #include <QtCore>
 
+#include <algorithm>
 #include <cstring>
-#include <set>
+#include <limits>
 #include <type_traits>
 
 Q_PLUGIN_METADATA(IID "studio.manivault.PointData")
@@ -38,6 +39,8 @@ using namespace mv::plugin;
 using namespace mv::util;
 using namespace mv::workflow;
 
+static_assert(sizeof(mv::Vector2f) == 2 * sizeof(float) && std::is_standard_layout_v<mv::Vector2f>, "Pairs of dimensions are gathered into vectors of mv::Vector2f as interleaved floats");
+
 namespace
 {
     namespace local
@@ -52,6 +55,21 @@ namespace
         }
     }
 
+    /** Invokes \p function for each index in [0, \p count) on the workers of the shared workflow plan executor (on the calling thread when there is none) */
+    void parallelFor(std::uint64_t count, const std::function<void(std::uint64_t)>& function)
+    {
+        if (count > 1 && Application::hasWorkflowPlanExecutor()) {
+            Application::getWorkflowPlanExecutor().parallelFor(count, function);
+            return;
+        }
+
+        for (std::uint64_t index = 0; index < count; ++index)
+            function(index);
+    }
+
+    /** Size (in bytes) of the column-major copies of all point data, and its budget */
+    std::atomic<std::uint64_t> totalColumnMajorDataSize{ 0 };
+    std::atomic<std::uint64_t> maximumTotalColumnMajorDataSizeInBytes{ std::uint64_t{ 4 } << 30 };
 }
 
 PointData::ElementTypeSpecifier PointData::elementTypeSpecifier(const QString& typeName)
@@ -103,6 +121,13 @@ QString PointData::elementTypeName(const ElementTypeSpecifier elementTypeSpecifi
     return "unknown";
 }
 
+PointData::~PointData()
+{
+    const std::lock_guard columnMajorDataLock(_columnMajorDataMutex);
+
+    releaseColumnMajorData();
+}
+
 void PointData::init()
 {
 }
@@ -114,7 +139,7 @@ mv::Dataset<DatasetImpl> PointData::createDataSet(const QString& guid /*= ""*/)
 
 std::uint64_t PointData::getNumPoints() const
 {
-    const auto dataLock = lockData();
+    const auto dataLock = lockDataShared();
 
     if (_numDimensions == 0)
     {
@@ -130,24 +155,24 @@ std::uint64_t PointData::getNumPoints() const
 
 std::uint64_t PointData::getNumDimensions() const
 {
-    const auto dataLock = lockData();
+    const auto dataLock = lockDataShared();
     return _numDimensions;
 }
 
 std::uint64_t PointData::getNumberOfElements() const
 {
-    const auto dataLock = lockData();
+    const auto dataLock = lockDataShared();
     return getSizeOfVector();
 }
 
 
 std::uint64_t PointData::getRawDataSize() const
 {
-    const auto dataLock = lockData();
+    const auto dataLock = lockDataShared();
 
     if (_isDense)
     {
-        std::uint64_t elementSize = std::visit([](auto& vec) { return vec.empty() ? 0u : sizeof(vec[0]); }, _variantOfVectors);
+        std::uint64_t elementSize = std::visit([](auto& vec) { return vec.empty() ? 0u : sizeof(vec[0]); }, *_variantOfVectors);
         return elementSize * getNumberOfElements();
     }
     else
@@ -159,18 +184,211 @@ std::uint64_t PointData::getRawDataSize() const
 void* PointData::getDataVoidPtr()
 {
     const auto dataLock = lockData();
-    return std::visit([](auto& vec) { return (void*)vec.data(); }, _variantOfVectors);
+    detachStorage();
+    return std::visit([](auto& vec) { return (void*)vec.data(); }, *_variantOfVectors);
 }
 
 const void* PointData::getDataConstVoidPtr() const
+{
+    const auto dataLock = lockDataShared();
+    return std::visit([](const auto& vec) { return (const void*)vec.data(); }, *_variantOfVectors);
+}
+
+void PointData::setColumnMajorDataEnabled(bool enabled)
 {
     const auto dataLock = lockData();
-    return std::visit([](const auto& vec) { return (const void*)vec.data(); }, _variantOfVectors);
+
+    _columnMajorDataEnabled = enabled;
+
+    if (!enabled) {
+        const std::lock_guard columnMajorDataLock(_columnMajorDataMutex);
+
+        releaseColumnMajorData();
+    }
+}
+
+bool PointData::isColumnMajorDataEnabled() const
+{
+    const auto dataLock = lockDataShared();
+    return _columnMajorDataEnabled;
+}
+
+std::uint64_t PointData::getColumnMajorDataSize() const
+{
+    const std::lock_guard columnMajorDataLock(_columnMajorDataMutex);
+
+    return _columnMajorDataSize;
+}
+
+void PointData::setMaximumTotalColumnMajorDataSize(std::uint64_t maximumTotalColumnMajorDataSize)
+{
+    maximumTotalColumnMajorDataSizeInBytes = maximumTotalColumnMajorDataSize;
+}
+
+std::uint64_t PointData::getMaximumTotalColumnMajorDataSize()
+{
+    return maximumTotalColumnMajorDataSizeInBytes;
+}
+
+std::uint64_t PointData::getTotalColumnMajorDataSize()
+{
+    return totalColumnMajorDataSize;
+}
+
+void PointData::releaseColumnMajorData() const
+{
+    totalColumnMajorDataSize -= _columnMajorDataSize;
+
+    _columnMajorData.reset();
+
+    _columnMajorDataSize = 0;
+}
+
+std::shared_ptr<const PointData::VariantOfVectors> PointData::updateColumnMajorData() const
+{
+    if (!_columnMajorDataEnabled || !_isDense || _numDimensions == 0)
+        return {};
+
+    const auto revision         = getRevision();
+    const auto storageVersion   = getStorageVersion();
+
+    // Readers hold the data lock shared, so concurrent readers wait here for the copy to be built only once
+    const std::lock_guard columnMajorDataLock(_columnMajorDataMutex);
+
+    if (_columnMajorDataRevision != revision || _columnMajorDataStorageVersion != storageVersion) {
+        releaseColumnMajorData();
+
+        _columnMajorDataRevision            = revision;
+        _columnMajorDataStorageVersion      = storageVersion;
+        _columnMajorDataNumberOfAccesses    = 0;
+    }
+
+    if (_columnMajorData)
+        return _columnMajorData;
+
+    if (++_columnMajorDataNumberOfAccesses < columnMajorDataAccessThreshold)
+        return {};
+
+    // Reserve the size of the copy from the memory budget of all point data
+    const auto size = getRawDataSize();
+
+    auto reservedSize = totalColumnMajorDataSize.load();
+
+    do {
+        if (reservedSize + size > maximumTotalColumnMajorDataSizeInBytes)
+            return {};
+    } while (!totalColumnMajorDataSize.compare_exchange_weak(reservedSize, reservedSize + size));
+
+    // Return the reservation if the copy can not be built
+    auto reservationGuard = qScopeGuard([size]() -> void {
+        totalColumnMajorDataSize -= size;
+    });
+
+    const auto numberOfPoints       = getNumPoints();
+    const auto numberOfDimensions   = _numDimensions;
+
+    std::visit([this, numberOfPoints, numberOfDimensions](const auto& vec)
+        {
+            using VectorType = std::remove_cv_t<std::remove_reference_t<decltype(vec)>>;
+
+            VectorType columnMajor(vec.size());
+
+            // Transpose in tiles, so that both the rows that are read and the columns
+            // that are written stay in cache; tiles of dimensions are transposed in parallel
+            constexpr std::uint64_t tileSize = 64;
+
+            const auto transposeTile = [&vec, &columnMajor, numberOfPoints, numberOfDimensions](const std::uint64_t dimensionTile)
+            {
+                const auto dimensionBegin   = dimensionTile * tileSize;
+                const auto dimensionEnd     = std::min(dimensionBegin + tileSize, numberOfDimensions);
+
+                for (std::uint64_t pointBegin{}; pointBegin < numberOfPoints; pointBegin += tileSize)
+                {
+                    const auto pointEnd = std::min(pointBegin + tileSize, numberOfPoints);
+
+                    for (std::uint64_t dimensionIndex = dimensionBegin; dimensionIndex < dimensionEnd; ++dimensionIndex)
+                        for (std::uint64_t pointIndex = pointBegin; pointIndex < pointEnd; ++pointIndex)
+                            columnMajor[dimensionIndex * numberOfPoints + pointIndex] = vec[pointIndex * numberOfDimensions + dimensionIndex];
+                }
+            };
+
+            parallelFor((numberOfDimensions + tileSize - 1) / tileSize, transposeTile);
+
+            _columnMajorData = std::make_shared<const VariantOfVectors>(std::move(columnMajor));
+        },
+        *_variantOfVectors);
+
+    reservationGuard.dismiss();
+
+    _columnMajorDataSize = size;
+
+    return _columnMajorData;
+}
+
+bool PointData::publishBackBuffer()
+{
+    const std::lock_guard backBufferLock(_backBufferMutex);
+
+    if (!_backBuffer)
+        return false;
+
+    {
+        const auto dataLock = lockData();
+
+        std::swap(_variantOfVectors, _backBuffer);
+
+        _numDimensions = _backBufferNumDimensions;
+
+        ++_storageVersion;
+    }
+
+    // The change notification may be deferred (see Points::publishBackBuffer()), so flag the data as modified right away
+    setModified();
+
+    _recycledBuffers.push_back(std::move(_backBuffer));
+
+    if (_recycledBuffers.size() > maximumNumberOfRecycledBuffers)
+        _recycledBuffers.erase(_recycledBuffers.begin());
+
+    return true;
+}
+
+std::size_t PointData::getNumberOfRecycledBuffers() const
+{
+    const std::lock_guard backBufferLock(_backBufferMutex);
+
+    return _recycledBuffers.size();
+}
+
+std::shared_ptr<PointData::VariantOfVectors> PointData::takeRecycledBuffer()
+{
+    const auto recycledBuffer = std::find_if(_recycledBuffers.begin(), _recycledBuffers.end(), [](const auto& buffer) {
+        return buffer.use_count() == 1;
+    });
+
+    if (recycledBuffer == _recycledBuffers.end())
+        return std::make_shared<VariantOfVectors>();
+
+    auto buffer = std::move(*recycledBuffer);
+
+    _recycledBuffers.erase(recycledBuffer);
+
+    return buffer;
+}
+
+PointData::Snapshot PointData::getSnapshot() const
+{
+    const auto dataLock = lockDataShared();
+
+    if (!_isDense)
+        return {};
+
+    return Snapshot(_variantOfVectors, _numDimensions, getStorageVersion());
 }
 
 const std::vector<QString>& PointData::getDimensionNames() const
 {
-    const auto dataLock = lockData();
+    const auto dataLock = lockDataShared();
     return _dimNames;
 }
 
@@ -210,7 +428,7 @@ float PointData::getValueAt(const std::size_t index) const
         {
             return static_cast<float>(vec[index]);
         },
-        _variantOfVectors);
+        *_variantOfVectors);
 }
 
 void PointData::setValueAt(const std::size_t index, const float newValue)
@@ -222,14 +440,29 @@ void PointData::setValueAt(const std::size_t index, const float newValue)
    // storage is not modified concurrently.
    //
    // Use lockData() / the bulk-access APIs when synchronized access is
-   // required.
+   // required. Only the first write after the storage version was read
+   // (e.g. by a snapshot) locks, to copy the storage on write.
+
+    if (!_storageWritable) {
+        const auto dataLock = lockData();
+
+        if (!_storageWritable)
+            detachStorage();
+    }
 
     std::visit([index, newValue](auto& vec)
         {
             using value_type = typename std::remove_reference_t<decltype(vec)>::value_type;
             vec[index] = static_cast<value_type>(newValue);
         },
-        _variantOfVectors);
+        *_variantOfVectors);
+}
+
+void PointData::prepareForWrite()
+{
+    const auto dataLock = lockData();
+
+    detachStorage();
 }
 
 UniqueWorkflowPlan PointData::fromVariantMapWorkflow(QVariantMap variantMap)
@@ -249,7 +482,18 @@ UniqueWorkflowPlan PointData::fromVariantMapWorkflow(QVariantMap variantMap)
         return plan;
     }
 
-    plan->addSequentialStage("Allocate and populate storage", [this, variantMap](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext&) {
+    // Context struct to hand the allocated storage to the (parallel) block decoders
+    struct Context : WorkflowContextBase {
+        QVariantMap     rawMap;
+        char*           destination     = nullptr;
+        std::uint64_t   destinationSize = 0;
+        std::uint64_t   revision        = 0;
+        std::uint64_t   storageVersion  = 0;
+    };
+
+    auto context = std::make_shared<Context>();
+
+    plan->addSequentialStage("Allocate storage", [this, variantMap, context](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext&) {
         const auto dataLock = lockData();
 
         variantMapMustContain(variantMap, "Data");
@@ -272,18 +516,35 @@ UniqueWorkflowPlan PointData::fromVariantMapWorkflow(QVariantMap variantMap)
 
             setElementTypeSpecifier(elementTypeIndex);
             resizeVector(numberOfElements);
-          
-            // Keep allocation and all writes to the exposed buffer mutually
-            // exclusive. The synchronous decoder is intentional here: a
-            // std::mutex lock may not be handed from this workflow worker to
-            // the parallel workers used by populateBytesFromBlobMapWorkflow().
-            const auto rawDataSize = getRawDataSize();
-
-            if (rawDataSize > 0)
-                populateBytesFromBlobMap(dataMap["Raw"].toMap(), static_cast<char*>(getDataVoidPtr()), rawDataSize);
+
+            context->rawMap             = dataMap["Raw"].toMap();
+            context->destination        = static_cast<char*>(getDataVoidPtr());
+            context->destinationSize    = getRawDataSize();
+            context->revision           = getRevision();
+            context->storageVersion     = getStorageVersion();
         }
     });
 
+    plan->addNestedWorkflowStage("Populate storage", [context](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext& executionContext) -> UniqueWorkflowPlan {
+        if (context->destinationSize == 0)
+            return std::make_unique<WorkflowPlan>("Populate storage (empty)");
+
+        // The blocks are decoded by parallel workers, each of which reads its
+        // block straight from the project archive and writes it to its own
+        // range of the storage allocated above. A recursive mutex lock can
+        // not be handed to those workers, so the storage is populated without
+        // holding the data lock; it is not resized until loading finished.
+        return populateBytesFromBlobMapWorkflow(context->rawMap, context->destination, context->destinationSize, executionContext->getOptions());
+    });
+
+    // The encoded blocks remain in the project archive, so they can be copied on the next save if the data is not modified
+    plan->addSequentialStage("Remember encoded data", [this, context](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext&) {
+        if (context->destinationSize == 0 || !_isDense)
+            return;
+
+        setEncodedData(context->rawMap, mv::projects().getCurrentProject()->getFilePath(), context->revision, context->storageVersion);
+    });
+
     return plan;
 }
 
@@ -293,7 +554,7 @@ UniqueWorkflowPlan PointData::toVariantMapWorkflow() const
     bool isDense;
 
     {
-        const auto dataLock = lockData();
+        const auto dataLock = lockDataShared();
         isDense = _isDense;
     }
 
@@ -305,20 +566,48 @@ UniqueWorkflowPlan PointData::toVariantMapWorkflow() const
     //;
 
     if (isDense) {
-        const auto storeRawStage = plan->addNestedWorkflowStage("Save raw", [this](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext&) {
-            const auto dataLock = lockData();
-            const auto rawMap   = bytesToBlobVariantMap(static_cast<const char*>(getDataConstVoidPtr()), getRawDataSize());
-            auto storePlan      = std::make_unique<WorkflowPlan>("Publish point data blob");
 
-            storePlan->addSequentialStage("Publish point data blob", [rawMap](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext& storeExecutionContext) {
-                storeExecutionContext->setOutput(rawMap);
-            });
+        // Context struct to remember which revision of the raw data is saved, and to keep it alive while its blocks are encoded
+        struct Context : WorkflowContextBase {
+            std::uint64_t   revision = 0;
+            std::uint64_t   storageVersion = 0;
+            Snapshot        snapshot;
+        };
+
+        auto context = std::make_shared<Context>();
+
+        const auto storeRawStage = plan->addNestedWorkflowStage("Save raw", [this, context](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext&) -> UniqueWorkflowPlan {
+
+            // The revision and storage version are obtained first, so that a modification in between makes the encoded data unavailable
+            context->revision       = getRevision();
+            context->storageVersion = getStorageVersion();
+
+            // Unmodified raw data is not encoded again, its blocks are copied from the archive it was last saved to (or loaded from)
+            QString encodedArchiveFilePath;
+
+            if (const auto encodedData = getEncodedData(encodedArchiveFilePath); copyBlobVariantMapBlocks(encodedData, encodedArchiveFilePath)) {
+                auto copyPlan = std::make_unique<WorkflowPlan>("Copy encoded raw");
+
+                copyPlan->addSequentialStage("Publish blob map", [encodedData](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext& executionContext) {
+                    executionContext->setOutput(encodedData);
+                }, WorkflowPlan::JobThreadAffinity::CurrentWorkerThread, 1.0);
 
-            return storePlan;
+                return copyPlan;
+            }
+
+            // The blocks are encoded by parallel workers, so the data lock
+            // can not be held for the duration of the encoding. The snapshot
+            // keeps the data unchanged instead, modifications while saving
+            // are made to a copy.
+            context->snapshot = getSnapshot();
+
+            const auto& snapshot = context->snapshot;
+
+            return bytesToBlobVariantMapWorkflow(static_cast<const char*>(snapshot.getDataConstVoidPtr()), snapshot.getRawDataSize(), snapshot.getElementSize());
         });
 
-        plan->addSequentialStage("Build map", [this, storeRawStage](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext& executionContext) {
-            const auto dataLock = lockData();
+        plan->addSequentialStage("Build map", [this, context, storeRawStage](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext& executionContext) {
+            const auto dataLock = lockDataShared();
             QVariantMap outputMap;
 
             const auto typeSpecifier        = getElementTypeSpecifier();
@@ -331,7 +620,7 @@ UniqueWorkflowPlan PointData::toVariantMapWorkflow() const
             outputMap.insert("Raw", rawMap);
             outputMap.insert("NumberOfElements", QVariant::fromValue(getNumberOfElements()));
 
-            const auto expectedBytes = getRawDataSize();
+            const auto expectedBytes = context->snapshot.isValid() ? context->snapshot.getRawDataSize() : getRawDataSize();
             const auto blobTotalSize = rawMap["Size"].toULongLong();
 
             if (blobTotalSize != expectedBytes) {
@@ -348,14 +637,24 @@ UniqueWorkflowPlan PointData::toVariantMapWorkflow() const
                 );
             }
 
+            if (const auto archiveEntryWriter = mv::projects().getArchiveEntryWriter())
+                setEncodedData(rawMap, archiveEntryWriter->getFilePath(), context->revision, context->storageVersion);
+
             executionContext->setOutput(outputMap);
+
+            context->snapshot = {};
         });
     } else {
-        plan->addSequentialStage("Build map", [this](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext& executionContext) {
-            const auto dataLock = lockData();
-            QVariantMap outputMap;
 
-            std::vector<char> bytes;
+        // Context struct to keep the packed sparse data alive while its blocks are encoded
+        struct Context : WorkflowContextBase {
+            std::vector<char>   bytes;
+        };
+
+        auto context = std::make_shared<Context>();
+
+        plan->addSequentialStage("Pack sparse data", [this, context](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext&) {
+            const auto dataLock = lockDataShared();
 
             const auto& indexPointers   = _sparseData.getIndexPointers();
             const auto& colIndices      = _sparseData.getColIndices();
@@ -365,43 +664,121 @@ UniqueWorkflowPlan PointData::toVariantMapWorkflow() const
             const auto* colIndicesBytes     = reinterpret_cast<const char*>(colIndices.data());
             const auto* valuesBytes         = reinterpret_cast<const char*>(values.data());
 
+            auto& bytes = context->bytes;
+
+            bytes.reserve(indexPointers.size() * sizeof(size_t) + colIndices.size() * sizeof(size_t) + values.size() * sizeof(float));
             bytes.insert(bytes.end(), indexPointersBytes, indexPointersBytes + indexPointers.size() * sizeof(size_t));
             bytes.insert(bytes.end(), colIndicesBytes, colIndicesBytes + colIndices.size() * sizeof(size_t));
             bytes.insert(bytes.end(), valuesBytes, valuesBytes + values.size() * sizeof(float));
+        });
 
-            outputMap.insert("Raw", bytesToBlobVariantMap(bytes.data(), bytes.size()));
+        const auto storeRawStage = plan->addNestedWorkflowStage("Save raw", [context](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext&) -> UniqueWorkflowPlan {
+            return bytesToBlobVariantMapWorkflow(context->bytes.data(), context->bytes.size());
+        });
+
+        plan->addSequentialStage("Build map", [context, storeRawStage](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext& executionContext) {
+            QVariantMap outputMap;
+
+            outputMap.insert("Raw", executionContext->takeOutput(storeRawStage).toMap());
 
             executionContext->setOutput(outputMap);
+
+            context->bytes = {};
         });
     }
 
     return plan;
 }
 
-void PointData::extractFullDataForDimension(std::vector<float>& result, const int dimensionIndex) const
+void PointData::gatherDimensionsToFloat(float* destination, const std::uint64_t numberOfValues, const std::uint32_t* indices, const int dimensionIndex1, const int dimensionIndex2 /*= -1*/) const
 {
-    const auto dataLock = lockData();
+    const auto dataLock = lockDataShared();
 
-    CheckDimensionIndex(dimensionIndex);
+    const auto gather = [destination, numberOfValues, indices, dimensionIndex2](const auto* data, const std::uint64_t stride, const std::uint64_t offset1, const std::uint64_t offset2)
+    {
+        const std::uint64_t numberOfValuesPerPoint = dimensionIndex2 < 0 ? 1 : 2;
+
+        forEachGrain(numberOfValues, [destination, indices, dimensionIndex2, data, stride, offset1, offset2, numberOfValuesPerPoint](const std::uint64_t begin, const std::uint64_t end) {
+            // Without indices, the points of the grain start at point begin of the data
+            const auto grainData        = indices ? data : data + begin * stride;
+            const auto grainIndices     = indices ? indices + begin : nullptr;
+            const auto grainDestination = destination + begin * numberOfValuesPerPoint;
+
+            if (dimensionIndex2 < 0)
+                kernels::gatherToFloat(grainData, stride, offset1, grainIndices, grainDestination, end - begin);
+            else
+                kernels::gatherPairsToFloat(grainData, stride, offset1, offset2, grainIndices, grainDestination, end - begin);
+        });
+    };
 
-    result.resize(getNumPoints());
+    // Sparse data is gathered from dense copies of the columns
+    if (!_isDense) {
+        const auto column1 = _sparseData.getDenseCol(dimensionIndex1);
 
-    std::visit(
-        [&result, this, dimensionIndex](const auto& vec)
-        {
-            const auto resultSize = result.size();
+        if (dimensionIndex2 < 0) {
+            gather(column1.data(), 1, 0, 0);
+        }
+        else {
+            const auto column2 = _sparseData.getDenseCol(dimensionIndex2);
+
+            std::vector<float> values1(numberOfValues), values2(numberOfValues);
+
+            kernels::gatherToFloat(column1.data(), 1, 0, indices, values1.data(), numberOfValues);
+            kernels::gatherToFloat(column2.data(), 1, 0, indices, values2.data(), numberOfValues);
+            kernels::interleave(values1.data(), values2.data(), destination, numberOfValues);
+        }
+
+        return;
+    }
 
-            for (std::size_t i{}; i < resultSize; ++i)
-                result[i] = vec[i * _numDimensions + dimensionIndex];
+    const auto numberOfPoints = getNumPoints();
+
+    // In the column-major copy a dimension is a contiguous column, so full extraction is a bulk conversion
+    if (shouldUseColumnMajorData(dimensionIndex2 < 0 ? 1 : 2) && constVisitColumnMajorFromBeginToEnd([&gather, numberOfPoints, dimensionIndex1, dimensionIndex2](const auto begin, const auto) {
+            gather(&*begin, 1, dimensionIndex1 * numberOfPoints, dimensionIndex2 < 0 ? 0 : dimensionIndex2 * numberOfPoints);
+        }))
+        return;
 
+    std::visit([&gather, this, dimensionIndex1, dimensionIndex2](const auto& vec)
+        {
+            gather(vec.data(), _numDimensions, dimensionIndex1, dimensionIndex2 < 0 ? 0 : dimensionIndex2);
         },
-        _variantOfVectors);
+        *_variantOfVectors);
+}
+
+void PointData::forEachGrain(const std::uint64_t count, const std::function<void(std::uint64_t, std::uint64_t)>& function)
+{
+    const auto numberOfGrains = (count + extractionGrainSize - 1) / extractionGrainSize;
+
+    if (numberOfGrains < 2) {
+        if (count > 0)
+            function(0, count);
+
+        return;
+    }
+
+    parallelFor(numberOfGrains, [count, &function](const std::uint64_t grain) -> void {
+        const auto begin = grain * extractionGrainSize;
+
+        function(begin, std::min(begin + extractionGrainSize, count));
+    });
+}
+
+void PointData::extractFullDataForDimension(std::vector<float>& result, const int dimensionIndex) const
+{
+    const auto dataLock = lockDataShared();
+
+    CheckDimensionIndex(dimensionIndex);
+
+    result.resize(getNumPoints());
+
+    gatherDimensionsToFloat(result.data(), result.size(), nullptr, dimensionIndex);
 }
 
 
 void PointData::extractFullDataForDimensions(std::vector<mv::Vector2f>& result, const int dimensionIndex1, const int dimensionIndex2) const
 {
-    const auto dataLock = lockData();
+    const auto dataLock = lockDataShared();
 
     if (_isDense)
     {
@@ -410,18 +787,7 @@ void PointData::extractFullDataForDimensions(std::vector<mv::Vector2f>& result,
 
         result.resize(getNumPoints());
 
-        std::visit(
-            [&result, this, dimensionIndex1, dimensionIndex2](const auto& vec)
-            {
-                const auto resultSize = result.size();
-
-                for (std::size_t i{}; i < resultSize; ++i)
-                {
-                    const auto n = i * _numDimensions;
-                    result[i].set(vec[n + dimensionIndex1], vec[n + dimensionIndex2]);
-                }
-            },
-            _variantOfVectors);
+        gatherDimensionsToFloat(reinterpret_cast<float*>(result.data()), result.size(), nullptr, dimensionIndex1, dimensionIndex2);
     }
     else
     {
@@ -438,44 +804,25 @@ void PointData::extractFullDataForDimensions(std::vector<mv::Vector2f>& result,
 
 void PointData::extractDataForDimension(std::vector<float> &result, const int dimensionIndex, const std::vector<std::uint32_t> &indices) const
 {
+    const auto dataLock = lockDataShared();
+
     CheckDimensionIndex(dimensionIndex);
 
     result.resize(indices.size());
 
-    std::visit(
-        [&result, this, dimensionIndex,
-         indices](const auto &vec) {
-          const auto resultSize = result.size();
-
-          for (std::size_t i{}; i < resultSize; ++i) {
-            const auto n = std::size_t{indices[i]} * _numDimensions;
-            result[i] = vec[n + dimensionIndex];
-          }
-        },
-        _variantOfVectors);
+    gatherDimensionsToFloat(result.data(), result.size(), indices.data(), dimensionIndex);
 }
 
 void PointData::extractDataForDimensions(std::vector<mv::Vector2f>& result, const int dimensionIndex1, const int dimensionIndex2, const std::vector<std::uint32_t>& indices) const
 {
-    const auto dataLock = lockData();
+    const auto dataLock = lockDataShared();
 
     CheckDimensionIndex(dimensionIndex1);
     CheckDimensionIndex(dimensionIndex2);
 
     result.resize(indices.size());
 
-    std::visit(
-        [&result, this, dimensionIndex1, dimensionIndex2, indices](const auto& vec)
-        {
-            const auto resultSize = result.size();
-
-            for (std::size_t i{}; i < resultSize; ++i)
-            {
-                const auto n = std::size_t{ indices[i] } *_numDimensions;
-                result[i].set(vec[n + dimensionIndex1], vec[n + dimensionIndex2]);
-            }
-        },
-        _variantOfVectors);
+    gatherDimensionsToFloat(reinterpret_cast<float*>(result.data()), result.size(), indices.data(), dimensionIndex1, dimensionIndex2);
 }
 
 Points::Points(QString dataName, bool mayUnderive /*= true*/, const QString& guid /*= ""*/) :
@@ -585,26 +932,105 @@ void Points::setData(std::nullptr_t, const std::size_t numPoints, const std::siz
         handleNumberDimensionsChanged(numDimensions);
 }
 
-void Points::extractDataForDimension(std::vector<float>& result, const int dimensionIndex) const
+void Points::publishBackBuffer()
 {
-    if (isProxy()) {
-        result.resize(getNumPoints());
+    auto pointData = getRawData<PointData>();
 
-        auto pointIndexOffset = 0u;
+    const auto previousNumDimensions = pointData->getNumDimensions();
 
-        for (auto proxyMember : getProxyMembers()) {
-            auto points = mv::Dataset<Points>(proxyMember);
+    if (!pointData->publishBackBuffer())
+        return;
 
-            std::vector<float> proxyPoints;
+    if (const auto numDimensions = pointData->getNumDimensions(); numDimensions != previousNumDimensions)
+        QMetaObject::invokeMethod(this, [this, numDimensions]() -> void {
+            handleNumberDimensionsChanged(numDimensions);
+        });
 
-            proxyPoints.resize(points->getNumPoints());
+    // A pending notification also covers this data
+    if (_publishNotificationPending.exchange(true))
+        return;
+
+    QMetaObject::invokeMethod(this, [this]() -> void {
+        const auto elapsed = _publishNotificationTimer.isValid() ? _publishNotificationTimer.elapsed() : std::numeric_limits<qint64>::max();
+        const auto delay   = elapsed < _publishFrameBudget ? static_cast<std::int32_t>(_publishFrameBudget - elapsed) : 0;
+
+        if (delay == 0)
+            notifyPublishedData();
+        else
+            QTimer::singleShot(delay, this, &Points::notifyPublishedData);
+    });
+}
+
+void Points::setPublishFrameBudget(std::int32_t publishFrameBudget)
+{
+    _publishFrameBudget = std::max(publishFrameBudget, 0);
+}
+
+std::int32_t Points::getPublishFrameBudget() const
+{
+    return _publishFrameBudget;
+}
+
+void Points::notifyPublishedData()
+{
+    _publishNotificationPending = false;
+
+    _publishNotificationTimer.start();
 
-            points->extractDataForDimension(proxyPoints, dimensionIndex);
+    events().notifyDatasetDataChanged(this);
+}
+
+void Points::notifyDataRegionChanged(const DataChangedRegion& region)
+{
+    events().notifyDatasetDataChanged(this, region);
+}
 
-            std::copy(proxyPoints.begin(), proxyPoints.end(), result.begin() + pointIndexOffset);
+void Points::forEachProxyMember(const std::function<void(const ProxyMemberRange&)>& function) const
+{
+    std::vector<ProxyMemberRange> proxyMemberRanges;
+    std::uint64_t offset = 0;
+
+    // Datasets are resolved on the calling thread, the (concurrent) function only touches the raw data
+    const std::function<void(const Points&)> collectProxyMemberRanges = [&proxyMemberRanges, &offset, &collectProxyMemberRanges](const Points& points) -> void {
+        for (const auto& proxyMember : points.getProxyMembers()) {
+            const auto proxyMemberPoints = Dataset<Points>(proxyMember);
+
+            if (proxyMemberPoints->isProxy()) {
+                collectProxyMemberRanges(*proxyMemberPoints);
+                continue;
+            }
 
-            pointIndexOffset += points->getNumPoints();
+            const auto numberOfPoints = static_cast<std::uint64_t>(proxyMemberPoints->getNumPoints());
+
+            proxyMemberRanges.push_back({
+                proxyMemberPoints->getRawData<PointData>(),
+                proxyMemberPoints->isFull() ? nullptr : &proxyMemberPoints->indices,
+                numberOfPoints,
+                offset
+            });
+
+            offset += numberOfPoints;
         }
+    };
+
+    collectProxyMemberRanges(*this);
+
+    parallelFor(proxyMemberRanges.size(), [&proxyMemberRanges, &function](const std::uint64_t proxyMemberIndex) -> void {
+        function(proxyMemberRanges[proxyMemberIndex]);
+    });
+}
+
+void Points::extractDataForDimension(std::vector<float>& result, const int dimensionIndex) const
+{
+    if (isProxy()) {
+        result.resize(getNumPoints());
+
+        // Each member writes directly into its part of the result
+        forEachProxyMember([&result, dimensionIndex](const ProxyMemberRange& proxyMember) {
+            const auto indices = proxyMember.indices ? proxyMember.indices->data() : nullptr;
+
+            proxyMember.rawPointData->gatherDimensionsToFloat(result.data() + proxyMember.offset, proxyMember.numPoints, indices, dimensionIndex);
+        });
     }
     else {
         const auto rawPointData = getRawData<PointData>();
@@ -622,21 +1048,12 @@ void Points::extractDataForDimensions(std::vector<mv::Vector2f>& result, const i
     if (isProxy()) {
         result.resize(getNumPoints());
 
-        auto pointIndexOffset = 0u;
-
-        for (auto proxyMember : getProxyMembers()) {
-            auto points = mv::Dataset<Points>(proxyMember);
-
-            std::vector<mv::Vector2f> proxyPoints;
-
-            proxyPoints.resize(points->getNumPoints());
+        // Each member writes directly into its part of the result
+        forEachProxyMember([&result, dimensionIndex1, dimensionIndex2](const ProxyMemberRange& proxyMember) {
+            const auto indices = proxyMember.indices ? proxyMember.indices->data() : nullptr;
 
-            points->extractDataForDimensions(proxyPoints, dimensionIndex1, dimensionIndex2);
-
-            std::copy(proxyPoints.begin(), proxyPoints.end(), result.begin() + pointIndexOffset);
-
-            pointIndexOffset += points->getNumPoints();
-        }
+            proxyMember.rawPointData->gatherDimensionsToFloat(reinterpret_cast<float*>(result.data() + proxyMember.offset), proxyMember.numPoints, indices, dimensionIndex1, dimensionIndex2);
+        });
     }
     else {
         const auto rawPointData = getRawData<PointData>();
@@ -670,6 +1087,7 @@ Dataset<DatasetImpl> Points::copy() const
 
     set->setText(text());
     set->indices = indices;
+    set->indicesChanged();
 
     return set;
 }
@@ -715,6 +1133,7 @@ Dataset<DatasetImpl> Points::createSubsetFromVisibleSelection(const QString& gui
     // If the data is full, then the locally selected points are the new subset
 
     subsetSelection->indices = localSelectionIndices;
+    subsetSelection->indicesChanged();
 
     return mv::data().createSubsetFromSelection(subsetSelection, toSmartPointer(), guiName, parentDataSet, visible);
 }
@@ -734,26 +1153,79 @@ void Points::setProxyMembers(const Datasets& proxyMembers)
     for (auto proxyMember : getProxyMembers()) {
         auto targetPoints = Dataset<Points>(proxyMember);
 
-        std::vector<std::uint32_t> targetGlobalIndices;
+        const auto numberOfPoints       = ::local::safe_numeric_cast<std::uint32_t>(targetPoints->getNumPoints());
+        const auto proxyIndexBegin      = ::local::safe_numeric_cast<std::uint32_t>(pointIndexOffset);
+        const auto globalIndexMap       = targetPoints->getGlobalIndexMap();
+        const auto& targetGlobalIndices = globalIndexMap->getGlobalIndices();
 
-        targetPoints->getGlobalIndices(targetGlobalIndices);
+        // The member covers the consecutive proxy indices [proxyIndexBegin, proxyIndexBegin + numberOfPoints), so the
+        // mapping to the member is a single offset range (with a lookup table if the global indices of the member are
+        // not consecutive), and the mapping back consists of one offset range per cluster of global indices
 
         // Selection map from proxy to member
         {
-            SelectionMap selectionMapToTarget;
+            SelectionMap::OffsetRange offsetRange{ proxyIndexBegin, proxyIndexBegin + numberOfPoints, globalIndexMap->getFirstGlobalIndex() };
 
-            for (std::uint64_t pointIndex = 0; pointIndex < targetPoints->getNumPoints(); ++pointIndex)
-                selectionMapToTarget.getMap()[pointIndexOffset + pointIndex] = std::vector<std::uint32_t>({ targetGlobalIndices[pointIndex] });
+            if (!globalIndexMap->isContiguous())
+                offsetRange.targetIndices = targetGlobalIndices;
 
-            addLinkedData(targetPoints, selectionMapToTarget);
+            SelectionMap selectionMapToTarget(SelectionMap::Type::OffsetRange);
+
+            selectionMapToTarget.addOffsetRange(std::move(offsetRange));
+
+            addLinkedData(targetPoints, std::move(selectionMapToTarget));
         }
 
         // Selection map from member to proxy
         {
-            SelectionMap selectionMapToSource;
+            SelectionMap selectionMapToSource(SelectionMap::Type::OffsetRange);
+
+            if (globalIndexMap->isContiguous()) {
+                selectionMapToSource.addOffsetRange({ globalIndexMap->getFirstGlobalIndex(), globalIndexMap->getFirstGlobalIndex() + numberOfPoints, proxyIndexBegin });
+            }
+            else if (!targetGlobalIndices.empty()) {
+                // A single lookup table would span all global indices between the smallest and the largest one, which is
+                // mostly unused for a sparse member. The (global index, proxy index) pairs are therefore split wherever
+                // the global indices leave a gap of more than maxGap, and each segment gets a lookup table of its own
+                // (or none if it maps consecutive global indices to consecutive proxy indices).
+                constexpr std::uint32_t maxGap = 16;
+
+                std::vector<std::pair<std::uint32_t, std::uint32_t>> globalToProxyIndices(numberOfPoints);
+
+                for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; ++pointIndex)
+                    globalToProxyIndices[pointIndex] = { targetGlobalIndices[pointIndex], proxyIndexBegin + pointIndex };
+
+                if (!std::is_sorted(globalToProxyIndices.begin(), globalToProxyIndices.end()))
+                    std::sort(globalToProxyIndices.begin(), globalToProxyIndices.end());
+
+                for (std::size_t segmentBegin = 0; segmentBegin < globalToProxyIndices.size();) {
+                    auto segmentEnd     = segmentBegin + 1;
+                    auto isConsecutive  = true;
 
-            for (std::uint64_t pointIndex = 0; pointIndex < targetPoints->getNumPoints(); ++pointIndex)
-                selectionMapToSource.getMap()[targetGlobalIndices[pointIndex]] = std::vector<std::uint32_t>({ ::local::safe_numeric_cast<std::uint32_t>(pointIndexOffset + pointIndex) });
+                    for (; segmentEnd < globalToProxyIndices.size(); ++segmentEnd) {
+                        const auto& [previousGlobalIndex, previousProxyIndex]   = globalToProxyIndices[segmentEnd - 1];
+                        const auto& [globalIndex, proxyIndex]                   = globalToProxyIndices[segmentEnd];
+
+                        if (globalIndex - previousGlobalIndex > maxGap)
+                            break;
+
+                        isConsecutive = isConsecutive && globalIndex == previousGlobalIndex + 1 && proxyIndex == previousProxyIndex + 1;
+                    }
+
+                    SelectionMap::OffsetRange offsetRange{ globalToProxyIndices[segmentBegin].first, globalToProxyIndices[segmentEnd - 1].first + 1, globalToProxyIndices[segmentBegin].second };
+
+                    if (!isConsecutive) {
+                        offsetRange.targetIndices.assign(offsetRange.sourceEnd - offsetRange.sourceBegin, SelectionMap::invalidIndex);
+
+                        for (auto pairIndex = segmentBegin; pairIndex < segmentEnd; ++pairIndex)
+                            offsetRange.targetIndices[globalToProxyIndices[pairIndex].first - offsetRange.sourceBegin] = globalToProxyIndices[pairIndex].second;
+                    }
+
+                    selectionMapToSource.addOffsetRange(std::move(offsetRange));
+
+                    segmentBegin = segmentEnd;
+                }
+            }
 
             targetPoints->addLinkedData(toSmartPointer(), selectionMapToSource);
 
@@ -781,18 +1253,14 @@ void Points::setProxyMembers(const Datasets& proxyMembers)
 /*                            Index transformation                            */
 /* -------------------------------------------------------------------------- */
 
-void Points::getGlobalIndices(std::vector<std::uint32_t>& globalIndices) const
+std::shared_ptr<const Points::GlobalIndexMap> Points::getGlobalIndexMap() const
 {
-    if (isProxy())
-    {
-        globalIndices.resize(getNumPoints(), 0);
-        std::iota(globalIndices.begin(), globalIndices.end(), 0);
-        return;
-    }
-
     // Traverse the chain of datasets back to the original source data
     // Any subsets traversed along the way are stored in the a subset chain
-    std::vector<Dataset<Points>> subsetChain;
+    // (proxies index the data directly)
+    std::vector<const Points*> subsetChain;
+
+    if (!isProxy())
     {
         auto currentDataset = toSmartPointer<Points>();
 
@@ -801,59 +1269,274 @@ void Points::getGlobalIndices(std::vector<std::uint32_t>& globalIndices) const
         {
             // If the current set is a subset then store it on the stack to traverse later
             if (!currentDataset->isFull())
-                subsetChain.push_back(currentDataset);
+                subsetChain.push_back(currentDataset.get());
 
             currentDataset = currentDataset->getNextSourceDataset<Points>();
         }
 
         // We now have a non-derived dataset bound, push it if its also a subset
         if (!currentDataset->isFull())
-            subsetChain.push_back(currentDataset);
+            subsetChain.push_back(currentDataset.get());
     }
 
+    return getGlobalIndexMap(subsetChain, static_cast<std::size_t>(getNumPoints()), static_cast<std::size_t>(getSourceDataset<Points>()->getNumRawPoints()));
+}
+
+std::shared_ptr<const Points::GlobalIndexMap> Points::getGlobalIndexMap(const std::vector<const Points*>& subsets, std::size_t numberOfPoints, std::size_t numberOfRawPoints) const
+{
+    // The state of the indices of each subset in the chain
+    std::vector<IndicesState> subsetChain;
+
+    subsetChain.reserve(subsets.size());
+
+    for (const auto subset : subsets)
+        subsetChain.push_back(subset->getIndicesState());
+
+    const std::lock_guard globalIndexMapLock(_globalIndexMapMutex);
+
+    // The cached map remains valid as long as none of the subsets in the chain changed its indices
+    if (_globalIndexMap && _globalIndexMapChain == subsetChain && _globalIndexMap->_globalIndices.size() == numberOfPoints)
+        return _globalIndexMap;
+
+    auto globalIndexMap = std::make_shared<GlobalIndexMap>();
+
     // Find the original global indices of this dataset by transforming them
     // step by step traversing through the chain of subsets
+    auto& globalIndices = globalIndexMap->_globalIndices;
+
+    globalIndices.resize(numberOfPoints);
+
+    // As long as each subset in the chain is a single run of consecutive indices, the
+    // global indices remain consecutive and only the first global index is transformed
+    bool            isContiguous        = true;
+    std::uint32_t   firstGlobalIndex    = 0;
+
+    for (const auto& indicesState : subsetChain)
+    {
+        if (isContiguous)
+        {
+            if (const auto indexRuns = indicesState.points->getCompactIndexRuns(); indexRuns && indexRuns->size() == 1)
+            {
+                firstGlobalIndex += indexRuns->front().begin;
+                continue;
+            }
+
+            std::iota(globalIndices.begin(), globalIndices.end(), firstGlobalIndex);
+
+            isContiguous = false;
+        }
+
+        const auto& subsetIndices = indicesState.points->indices;
+
+        for (std::uint64_t i = 0; i < globalIndices.size(); i++)
+            globalIndices[i] = subsetIndices[globalIndices[i]];
+    }
+
+    if (isContiguous)
+        std::iota(globalIndices.begin(), globalIndices.end(), firstGlobalIndex);
+    else if (!globalIndices.empty() && std::adjacent_find(globalIndices.begin(), globalIndices.end(), [](std::uint32_t lhs, std::uint32_t rhs) { return rhs != lhs + 1; }) == globalIndices.end())
     {
-        globalIndices.resize(getNumPoints(), 0);
-        std::iota(globalIndices.begin(), globalIndices.end(), 0);
+        isContiguous        = true;
+        firstGlobalIndex    = globalIndices.front();
+    }
 
-        for (const Dataset<Points>& subset : subsetChain)
+    // Build the inverse: none if the global indices are consecutive, a dense array if the
+    // dataset covers at least an eighth of the raw data, otherwise a hash map
+    if (isContiguous)
+    {
+        globalIndexMap->_isContiguous       = true;
+        globalIndexMap->_firstGlobalIndex   = firstGlobalIndex;
+    }
+    else
+    {
+        if (globalIndices.size() * 8 >= numberOfRawPoints)
         {
-            for (std::uint64_t i = 0; i < globalIndices.size(); i++)
-                globalIndices[i] = subset->indices[globalIndices[i]];
+            auto& denseLocalIndices = globalIndexMap->_denseLocalIndices;
+
+            denseLocalIndices.assign(numberOfRawPoints, GlobalIndexMap::invalidIndex);
+
+            for (std::uint32_t localIndex = 0; localIndex < globalIndices.size(); localIndex++)
+            {
+                const auto globalIndex = globalIndices[localIndex];
+
+                if (globalIndex >= denseLocalIndices.size())
+                    continue;
+
+                if (denseLocalIndices[globalIndex] != GlobalIndexMap::invalidIndex)
+                    globalIndexMap->_isInjective = false;
+                else
+                    denseLocalIndices[globalIndex] = localIndex;
+            }
+        }
+        else
+        {
+            auto& sparseLocalIndices = globalIndexMap->_sparseLocalIndices;
+
+            sparseLocalIndices.reserve(globalIndices.size());
+
+            for (std::uint32_t localIndex = 0; localIndex < globalIndices.size(); localIndex++)
+                if (!sparseLocalIndices.emplace(globalIndices[localIndex], localIndex).second)
+                    globalIndexMap->_isInjective = false;
         }
     }
+
+    _globalIndexMap         = std::move(globalIndexMap);
+    _globalIndexMapChain    = std::move(subsetChain);
+
+    return _globalIndexMap;
+}
+
+void Points::indicesChanged()
+{
+    ++_indicesRevision;
+}
+
+Points::IndicesState Points::getIndicesState() const
+{
+    return { this, _indicesRevision, indices.data(), indices.size(), mv::util::hashBytes(indices.data(), indices.size() * sizeof(std::uint32_t)) };
+}
+
+std::shared_ptr<const Points::IndexRuns> Points::getIndexRuns() const
+{
+    if (auto compactIndexRuns = getCompactIndexRuns())
+        return compactIndexRuns;
+
+    // The runs of fragmented indices are not cached
+    auto indexRuns = std::make_shared<IndexRuns>();
+
+    for (const auto index : indices)
+    {
+        if (!indexRuns->empty() && indexRuns->back().end == index)
+            ++indexRuns->back().end;
+        else
+            indexRuns->push_back({ index, index + 1 });
+    }
+
+    return indexRuns;
+}
+
+std::shared_ptr<const Points::IndexRuns> Points::getCompactIndexRuns() const
+{
+    const auto indicesState = getIndicesState();
+
+    const std::lock_guard indexRunsLock(_indexRunsMutex);
+
+    if (_indexRunsState == indicesState)
+        return _indexRuns;
+
+    const auto maximumNumberOfIndexRuns = getMaximumNumberOfCompactIndexRuns(indices.size());
+
+    auto indexRuns = std::make_shared<IndexRuns>();
+
+    for (const auto index : indices)
+    {
+        if (!indexRuns->empty() && indexRuns->back().end == index)
+            ++indexRuns->back().end;
+        else if (indexRuns->size() < maximumNumberOfIndexRuns)
+            indexRuns->push_back({ index, index + 1 });
+        else {
+            indexRuns.reset();
+            break;
+        }
+    }
+
+    if (indexRuns)
+        indexRuns->shrink_to_fit();
+
+    _indexRuns      = std::move(indexRuns);
+    _indexRunsState = indicesState;
+
+    return _indexRuns;
+}
+
+void Points::setIndexRuns(const IndexRuns& indexRuns)
+{
+    // Merge adjacent runs and skip empty ones, so that the runs can be cached as they are
+    auto normalizedIndexRuns = std::make_shared<IndexRuns>();
+
+    std::size_t numberOfIndices = 0;
+
+    for (const auto& indexRun : indexRuns)
+    {
+        if (indexRun.end <= indexRun.begin)
+            continue;
+
+        if (!normalizedIndexRuns->empty() && normalizedIndexRuns->back().end == indexRun.begin)
+            normalizedIndexRuns->back().end = indexRun.end;
+        else
+            normalizedIndexRuns->push_back(indexRun);
+
+        numberOfIndices += indexRun.size();
+    }
+
+    indices.resize(numberOfIndices);
+
+    auto destination = indices.begin();
+
+    for (const auto& indexRun : *normalizedIndexRuns)
+    {
+        std::iota(destination, destination + indexRun.size(), indexRun.begin);
+
+        destination += indexRun.size();
+    }
+
+    indicesChanged();
+
+    const std::lock_guard indexRunsLock(_indexRunsMutex);
+
+    if (normalizedIndexRuns->size() <= getMaximumNumberOfCompactIndexRuns(numberOfIndices))
+        _indexRuns = std::move(normalizedIndexRuns);
+    else
+        _indexRuns.reset();
+
+    _indexRunsState = getIndicesState();
+}
+
+void Points::getGlobalIndices(std::vector<std::uint32_t>& globalIndices) const
+{
+    globalIndices = getGlobalIndexMap()->getGlobalIndices();
 }
 
 void Points::selectedLocalIndices(const std::vector<std::uint32_t>& selectionIndices, std::vector<bool>& selected) const
 {
     //Timer timer(__FUNCTION__);
 
-    // Find the global indices of this dataset
-    std::vector<std::uint32_t> localGlobalIndices;
-    getGlobalIndices(localGlobalIndices);
-
     if (isProxy()) {
         selected.resize(getNumPoints(), false);
 
         for (const auto& selectionIndex : selectionIndices) {
-            selected[localGlobalIndices[selectionIndex]] = true;
+            selected[selectionIndex] = true;
         }
+
+        return;
     }
-    else {
-        // In an array the size of the full raw data, mark selected points as true
-        std::vector<bool> globalSelection(getSourceDataset<Points>()->getNumRawPoints(), false);
 
+    // Find the global indices of this dataset
+    const auto globalIndexMap       = getGlobalIndexMap();
+    const auto& localGlobalIndices  = globalIndexMap->getGlobalIndices();
+
+    selected.resize(localGlobalIndices.size(), false);
+
+    // Look up the local index of each selected point, which is proportional to the size of the selection
+    if (globalIndexMap->isInjective()) {
         for (const std::uint32_t& selectionIndex : selectionIndices)
-            globalSelection[selectionIndex] = true;
+            if (const auto localIndex = globalIndexMap->getLocalIndex(selectionIndex); localIndex != GlobalIndexMap::invalidIndex)
+                selected[localIndex] = true;
 
-        // For all local points find out which are selected
-        selected.resize(localGlobalIndices.size(), false);
-        for (std::uint64_t i = 0; i < localGlobalIndices.size(); i++)
-        {
-            if (globalSelection[localGlobalIndices[i]])
-                selected[i] = true;
-        }
+        return;
+    }
+
+    // In an array the size of the full raw data, mark selected points as true
+    std::vector<bool> globalSelection(getSourceDataset<Points>()->getNumRawPoints(), false);
+
+    for (const std::uint32_t& selectionIndex : selectionIndices)
+        globalSelection[selectionIndex] = true;
+
+    // For all local points find out which are selected
+    for (std::uint64_t i = 0; i < localGlobalIndices.size(); i++)
+    {
+        if (globalSelection[localGlobalIndices[i]])
+            selected[i] = true;
     }
 }
 
@@ -865,12 +1548,29 @@ void Points::getLocalSelectionIndices(std::vector<std::uint32_t>& localSelection
         return;
     }
 
-
     auto selection = getSelection<Points>();
 
     // Find the global indices of this dataset
-    std::vector<std::uint32_t> localGlobalIndices;
-    getGlobalIndices(localGlobalIndices);
+    const auto globalIndexMap = getGlobalIndexMap();
+
+    // Look up the local index of each selected point, which is proportional to the size of the selection
+    if (globalIndexMap->isInjective())
+    {
+        localSelectionIndices.clear();
+        localSelectionIndices.reserve(selection->indices.size());
+
+        for (const std::uint32_t& selectionIndex : selection->indices)
+            if (const auto localIndex = globalIndexMap->getLocalIndex(selectionIndex); localIndex != GlobalIndexMap::invalidIndex)
+                localSelectionIndices.push_back(localIndex);
+
+        std::sort(localSelectionIndices.begin(), localSelectionIndices.end());
+
+        localSelectionIndices.erase(std::unique(localSelectionIndices.begin(), localSelectionIndices.end()), localSelectionIndices.end());
+
+        return;
+    }
+
+    const auto& localGlobalIndices = globalIndexMap->getGlobalIndices();
 
     // In an array the size of the full raw data, mark selected points as true
     std::vector<bool> globalSelection(getSourceDataset<Points>()->getNumRawPoints(), false);
@@ -878,23 +1578,12 @@ void Points::getLocalSelectionIndices(std::vector<std::uint32_t>& localSelection
         globalSelection[selectionIndex] = true;
 
     // For all local points find out which are selected
-    std::vector<bool> selected(localGlobalIndices.size(), false);
-    int indexCount = 0;
+    localSelectionIndices.clear();
+
     for (std::uint64_t i = 0; i < localGlobalIndices.size(); i++)
     {
         if (globalSelection[localGlobalIndices[i]])
-        {
-            selected[i] = true;
-            indexCount++;
-        }
-    }
-
-    localSelectionIndices.resize(indexCount);
-    std::uint64_t c = 0;
-    for (std::uint64_t i = 0; i < selected.size(); i++)
-    {
-        if (selected[i])
-            localSelectionIndices[c++] = i;
+            localSelectionIndices.push_back(static_cast<std::uint32_t>(i));
     }
 }
 
@@ -961,7 +1650,12 @@ void Points::setValueAt(const std::size_t index, const float newValue)
     getRawData<PointData>()->setValueAt(index, newValue);
 }
 
-static void resolveLinkedPointData(const LinkedData& linkedData, const std::vector<std::uint32_t>& indices, Datasets* ignoreDatasets = nullptr)
+void Points::prepareForWrite()
+{
+    getRawData<PointData>()->prepareForWrite();
+}
+
+static void resolveLinkedPointData(const LinkedData& linkedData, const std::vector<std::uint32_t>& indices, Datasets* ignoreDatasets = nullptr, const SelectionDelta& delta = SelectionDelta())
 {
     Dataset<Points> sourceDataset   = linkedData.getSourceDataSet();
     Dataset<Points> targetDataset   = linkedData.getTargetDataset();
@@ -981,42 +1675,44 @@ static void resolveLinkedPointData(const LinkedData& linkedData, const std::vect
 
     //qDebug() << QString("%1, %2, %3").arg(__FUNCTION__, sourceDataset->getGuiName(), targetDataset->getGuiName());
 
+    SelectionDelta targetDelta;
+
     {
         //Timer timer("Creating maps");
 
         const SelectionMap& mapping = linkedData.getMapping();
 
-        // Create separate vector of additional linked selected points
-        std::vector<std::uint32_t> linkedIndices;
-
-        // Reserve at least as much space as required for a 1-1 mapping
-        linkedIndices.reserve(indices.size());
+        // Only the changed indices need to be mapped if the mapping preserves the selection delta, and only if the target
+        // selection is still the one of the previous propagation (otherwise it was changed elsewhere and is replaced)
+        if (delta.isIncremental() && targetDataset->hasPropagatedSelection())
+            targetDelta = linkedData.mapSelectionDelta(delta);
 
-        for (const auto& selectionIndex : indices)
-        {
-            if (mapping.hasMappingForPointIndex(selectionIndex))
-            {
-                std::vector<std::uint32_t> mappedSelection;
-                mapping.populateMappingIndices(selectionIndex, mappedSelection);
-                linkedIndices.insert(linkedIndices.end(), mappedSelection.begin(), mappedSelection.end());
-            }
+        if (targetDelta.isIncremental()) {
+            targetDelta.applyTo(targetSelection->indices);
         }
+        else {
+            // Listeners of the target have to read its whole selection as well
+            if (delta.isIncremental())
+                linkedData.setMappedSelectionDelta(delta, targetDelta);
 
-        if (targetDataset->isProxy()) {
-            std::set<std::uint32_t> targetIndicesSet(targetSelection->indices.begin(), targetSelection->indices.end());
+            // Map the whole selection at once (sorted and without duplicates)
+            std::vector<std::uint32_t> linkedIndices;
 
-            for (auto& [key, value] : const_cast<SelectionMap&>(mapping).getMap())
-                for (const auto& v : value)
-                    targetIndicesSet.erase(v);
+            mapping.mapIndices(indices, linkedIndices);
 
-            for (const auto& linkedIndex : linkedIndices)
-                targetIndicesSet.insert(linkedIndex);
+            if (targetDataset->isProxy()) {
+                // Replace the part of the target selection covered by the mapping with the linked indices
+                const auto targetIndexSet = (IndexSet(targetSelection->indices) - mapping.getMappedIndexSet()) | IndexSet(linkedIndices);
 
-            targetSelection->indices = std::vector<std::uint32_t>(targetIndicesSet.begin(), targetIndicesSet.end());
-        }
-        else {
-            targetSelection->indices = linkedIndices;
+                targetSelection->indices = targetIndexSet.toIndices();
+            }
+            else {
+                targetSelection->indices = linkedIndices;
+            }
         }
+
+        targetDataset->markSelectionChanged();
+        targetDataset->markSelectionPropagated();
     }
     
     // Add the target of the linked data (of which we updated the selection indices) to the ignore list
@@ -1025,21 +1721,25 @@ static void resolveLinkedPointData(const LinkedData& linkedData, const std::vect
 
     // Recursively resolve linked point data
     for (const mv::LinkedData& targetLd : targetDataset->getLinkedData())
-        resolveLinkedPointData(targetLd, targetSelection->indices, ignoreDatasets);
+        resolveLinkedPointData(targetLd, targetSelection->indices, ignoreDatasets, targetDelta);
 }
 
-void Points::resolveLinkedData(bool force /*= false*/)
+/**
+ * Resolve the linked data of \p points and of its source datasets (which share its selection)
+ * @param points Points of which the selection changed
+ * @param delta How the selection changed (replaced by default)
+ */
+static void resolveLinkedPointDataOfSelection(const Dataset<Points>& points, const SelectionDelta& delta = SelectionDelta())
 {
-    if (isLocked())
-        return;
+    const auto& selectionIndices = points->getSelection<Points>()->indices;
 
     // Check for linked data in this dataset and resolve them
-    for (const mv::LinkedData& linkedData : getLinkedData())
-        resolveLinkedPointData(linkedData, getSelection<Points>()->indices, nullptr);
+    for (const mv::LinkedData& linkedData : points->getLinkedData())
+        resolveLinkedPointData(linkedData, selectionIndices, nullptr, delta);
 
     // Check for linked data in all source datasets and resolve them
     // This and all source data share the same selection indices
-    mv::Dataset<Points> dataset = Dataset<Points>(this);
+    mv::Dataset<Points> dataset = points;
     while (dataset->isDerivedData())
     {
         dataset = dataset->getSourceDataset<Points>();
@@ -1047,13 +1747,20 @@ void Points::resolveLinkedData(bool force /*= false*/)
         if (dataset.isValid())
         {
             for (const mv::LinkedData& linkedData : dataset->getLinkedData())
-                resolveLinkedPointData(linkedData, getSelection<Points>()->indices, nullptr);
+                resolveLinkedPointData(linkedData, selectionIndices, nullptr, delta);
 
         }
         else
             break;
     }
+}
+
+void Points::resolveLinkedData(bool force /*= false*/)
+{
+    if (isLocked())
+        return;
 
+    resolveLinkedPointDataOfSelection(Dataset<Points>(this));
 }
 
 void Points::setSelectionIndices(const std::vector<std::uint32_t>& indices)
@@ -1067,11 +1774,37 @@ void Points::setSelectionIndices(const std::vector<std::uint32_t>& indices)
 
     selection->indices = indices;
 
+    markSelectionChanged();
+
     resolveLinkedData();
 
     //events().notifyDatasetDataSelectionChanged(this);
 }
 
+void Points::applySelectionDelta(const SelectionDelta& delta)
+{
+    if (isLocked() || delta.isReplaced() || delta.isEmpty())
+        return;
+
+    auto selection = getSelection<Points>();
+
+    delta.applyTo(selection->indices);
+
+    markSelectionChanged();
+
+    resolveLinkedPointDataOfSelection(Dataset<Points>(this), delta);
+}
+
+IndexSet Points::getSelectionIndexSet() const
+{
+    return IndexSet(getSelection<Points>()->indices);
+}
+
+void Points::setSelectionIndexSet(const IndexSet& indexSet)
+{
+    setSelectionIndices(indexSet.toIndices());
+}
+
 bool Points::canSelect() const
 {
     return getNumPoints() > 0;
@@ -1122,24 +1855,18 @@ void Points::selectInvert()
     getLocalSelectionIndices(localSelectionIndices);
 
     // Compute the inverse of this
-    const auto numberOfPoints = getNumPoints();
-    std::set<std::uint32_t> selectionSet(localSelectionIndices.begin(), localSelectionIndices.end());
-
-    std::vector<std::uint32_t> selectionIndices;
-    selectionIndices.reserve(numberOfPoints - selectionSet.size());
-
-    for (std::uint64_t i = 0; i < numberOfPoints; i++)
-        if (selectionSet.find(i) == selectionSet.end())
-            selectionIndices.push_back(i);
+    const auto invertedSelection = IndexSet(localSelectionIndices).complement(getNumPoints());
 
     // Convert the inverted indices back to global indices
-    std::vector<std::uint32_t> globalIndices;
-    getGlobalIndices(globalIndices);
+    const auto globalIndexMap   = getGlobalIndexMap();
+    const auto& globalIndices   = globalIndexMap->getGlobalIndices();
 
-    for (std::uint32_t& index : selectionIndices)
-    {
-        index = globalIndices[index];
-    }
+    std::vector<std::uint32_t> selectionIndices;
+    selectionIndices.reserve(invertedSelection.size());
+
+    invertedSelection.forEach([&selectionIndices, &globalIndices](std::uint32_t index) -> void {
+        selectionIndices.push_back(globalIndices[index]);
+    });
 
     setSelectionIndices(selectionIndices);
 
@@ -1193,10 +1920,33 @@ UniqueWorkflowPlan Points::fromVariantMapWorkflow(QVariantMap variantMap)
 
         const auto& indicesMap = variantMap["Indices"].toMap();
 
-        indices.resize(indicesMap["Count"].value<std::uint64_t>());
+        if (indicesMap.contains("Runs")) {
+            IndexRuns indexRuns(indicesMap["NumberOfRuns"].value<std::uint64_t>());
+
+            if (!indexRuns.empty())
+                populateBytesFromBlobMap(indicesMap["Runs"].toMap(), (char*)indexRuns.data(), indexRuns.size() * sizeof(IndexRun));
+
+            setIndexRuns(indexRuns);
+
+            if (indices.size() != indicesMap["Count"].value<std::uint64_t>())
+                throw ManiVaultException(
+                    SeverityLevel::Error,
+                    "Point indices do not match their declared count",
+                    QString("Dataset '%1' declares %2 indices, but its index runs contain %3 indices")
+                    .arg(getGuiName())
+                    .arg(indicesMap["Count"].value<std::uint64_t>())
+                    .arg(indices.size()),
+                    __FUNCTION__
+                );
+        }
+        else {
+            indices.resize(indicesMap["Count"].value<std::uint64_t>());
+
+            if (!indices.empty())
+			    populateBytesFromBlobMap(indicesMap["Raw"].toMap(), (char*)indices.data(), indices.size() * sizeof(uint32_t));
 
-        if (!indices.empty())
-			populateBytesFromBlobMap(indicesMap["Raw"].toMap(), (char*)indices.data(), indices.size() * sizeof(uint32_t));
+            indicesChanged();
+        }
     }, WorkflowPlan::JobThreadAffinity::GuiThread);
 
     const auto serializeDimensionsStage = plan->addNestedWorkflowStage("Load dimensions", [this, variantMap](const WorkflowPlan::Job&, const SharedWorkflowExecutionContext&) -> UniqueWorkflowPlan {
@@ -1239,7 +1989,21 @@ UniqueWorkflowPlan Points::toVariantMapWorkflow() const
         QVariantMap indicesMap;
 
         indicesMap["Count"] = QVariant::fromValue<std::uint64_t>(this->indices.size());
-        indicesMap["Raw"]   = bytesToBlobVariantMap((char*)this->indices.data(), this->indices.size() * sizeof(std::uint32_t));
+
+        // Store subsets with compact runs (of on average at least eight consecutive indices) as runs
+        if (const auto indexRuns = getCompactIndexRuns(); indexRuns && !indexRuns->empty()) {
+            static_assert(sizeof(IndexRun) == 2 * sizeof(std::uint32_t));
+
+            indicesMap["NumberOfRuns"]  = QVariant::fromValue<std::uint64_t>(indexRuns->size());
+            indicesMap["Runs"]          = indicesToBlobVariantMap(reinterpret_cast<const std::uint32_t*>(indexRuns->data()), indexRuns->size() * 2);
+
+            // Versions which predate index runs only read the raw indices, so store those as well, encoded with the project
+            // codec as those versions did (the runs spare this version from decoding and scanning the raw indices on load)
+            indicesMap["Raw"] = bytesToBlobVariantMap(reinterpret_cast<const char*>(this->indices.data()), this->indices.size() * sizeof(std::uint32_t), sizeof(std::uint32_t));
+        }
+        else {
+            indicesMap["Raw"] = indicesToBlobVariantMap(this->indices.data(), this->indices.size());
+        }
 
         datasetMap["Indices"] = indicesMap;
 
@@ -1255,7 +2019,7 @@ UniqueWorkflowPlan Points::toVariantMapWorkflow() const
             auto selectionSet = getSelection<Points>();
 
             selection["Count"]  = QVariant::fromValue<std::uint64_t>(selectionSet->indices.size());
-            selection["Raw"]    = bytesToBlobVariantMap((char*)selectionSet->indices.data(), selectionSet->indices.size() * sizeof(std::uint32_t));
+            selection["Raw"]    = indicesToBlobVariantMap(selectionSet->indices.data(), selectionSet->indices.size());
         }
 
         datasetMap["Selection"] = selection;
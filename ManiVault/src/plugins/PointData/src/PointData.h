@@ -9,22 +9,36 @@
 #include "RawData.h"
 
 #include "LinkedData.h"
+#include "PointDataKernels.h"
 #include "PointDataRange.h"
+#include "RecursiveSharedMutex.h"
 #include "Set.h"
 #include "SparseMatrix.h"
 
+#include "event/DataChangedRegion.h"
 #include "event/EventListener.h"
 
+#include "util/IndexSet.h"
+
 #include <biovault_bfloat16/biovault_bfloat16.h>
 
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QMap>
 #include <QString>
 #include <QVariantMap>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <functional>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -62,7 +76,8 @@ class ClusterAction;
 class POINTDATA_EXPORT PointData : public mv::plugin::RawData
 {
 public:
-    using DataLock = std::unique_lock<std::recursive_mutex>;
+    using DataLock          = std::unique_lock<RecursiveSharedMutex>;   /** Exclusive (writer) lock on the data */
+    using SharedDataLock    = std::shared_lock<RecursiveSharedMutex>;   /** Shared (reader) lock on the data */
 
     enum class ElementTypeSpecifier
     {
@@ -134,8 +149,8 @@ private:
     const std::vector<T>& getConstVector() const
     {
         // This function should only be used to access the currently selected vector.
-        assert(std::holds_alternative<std::vector<T>>(_variantOfVectors));
-        return std::get<std::vector<T>>(_variantOfVectors);
+        assert(std::holds_alternative<std::vector<T>>(*_variantOfVectors));
+        return std::get<std::vector<T>>(*_variantOfVectors);
     }
 
     template <typename T>
@@ -147,29 +162,32 @@ private:
     template <typename T>
     std::vector<T>& getVector()
     {
+        detachStorage();
         return const_cast<std::vector<T>&>(getConstVector<T>());
     }
 
     /// Returns the size of the std::vector currently held by _variantOfVectors.
     std::size_t getSizeOfVector() const
     {
-        return std::visit([](const auto& vec) { return vec.size(); }, _variantOfVectors);
+        return std::visit([](const auto& vec) { return vec.size(); }, *_variantOfVectors);
     }
 
     /// Resizes the std::vector currently held by _variantOfVectors.
     void resizeVector(const std::size_t newSize)
     {
-        std::visit([newSize](auto& vec) { vec.resize(newSize); }, _variantOfVectors);
+        detachStorage();
+        std::visit([newSize](auto& vec) { vec.resize(newSize); }, *_variantOfVectors);
     }
 
     void setElementTypeSpecifier(const ElementTypeSpecifier elementTypeSpecifier)
     {
-        setIndexOfVariant(_variantOfVectors, static_cast<std::size_t>(elementTypeSpecifier));
+        detachStorage();
+        setIndexOfVariant(*_variantOfVectors, static_cast<std::size_t>(elementTypeSpecifier));
     }
 
     ElementTypeSpecifier getElementTypeSpecifier() const
     {
-        return static_cast<ElementTypeSpecifier>(_variantOfVectors.index());
+        return static_cast<ElementTypeSpecifier>(_variantOfVectors->index());
     }
 
     /// Resizes the currently held data vector to the specified
@@ -178,6 +196,8 @@ private:
     template <typename T>
     void convertData(const T* const data, const std::size_t numberOfElements)
     {
+        detachStorage();
+
         std::visit([data, numberOfElements](auto& vec)
         {
             vec.resize(numberOfElements);
@@ -189,9 +209,114 @@ private:
                 ++i;
             }
         },
-        _variantOfVectors);
+        *_variantOfVectors);
+    }
+
+
+    /// Prepares the storage for modification: copies it first if a snapshot still shares it (copy-on-write), and
+    /// increments the storage version, which also releases the column-major copy. Assumes the data lock is held exclusively.
+    void detachStorage()
+    {
+        if (_variantOfVectors.use_count() > 1)
+            _variantOfVectors = std::make_shared<VariantOfVectors>(*_variantOfVectors);
+
+        ++_storageVersion;
+
+        if (_columnMajorData)
+            releaseColumnMajorData();
+
+        _storageWritable = true;
+    }
+
+    /// Replaces the storage by \p variantOfVectors (snapshots keep the previous storage) and increments the storage version.
+    void replaceStorage(VariantOfVectors&& variantOfVectors)
+    {
+        _variantOfVectors = std::make_shared<VariantOfVectors>(std::move(variantOfVectors));
+
+        ++_storageVersion;
+
+        if (_columnMajorData)
+            releaseColumnMajorData();
+
+        _storageWritable = true;
+    }
+
+    /// Returns whether extracting \p numberOfRequestedDimensions dimensions is faster from the column-major copy: a
+    /// row-major scan reads whole rows, which pays off when a large part (here a quarter or more) of the dimensions is requested.
+    bool shouldUseColumnMajorData(const std::size_t numberOfRequestedDimensions) const
+    {
+        return _columnMajorDataEnabled && 4 * static_cast<std::uint64_t>(numberOfRequestedDimensions) < _numDimensions;
+    }
+
+    /// Populates \p resultContainer with the dimensions \p dimensionIndices of \p numPoints points (the i-th being the point
+    /// at pointIndexAt(i)), point after point. The points are split into grains which are populated concurrently.
+    template <typename ResultContainer, typename DimensionIndices, typename PointIndexAt>
+    void populateDimensions(ResultContainer& resultContainer, const DimensionIndices& dimensionIndices, const std::uint64_t numPoints, const PointIndexAt& pointIndexAt) const
+    {
+        if (numPoints == 0)
+            return;
+
+        // Detach an implicitly shared result container (e.g. a QVector) before the grains write to it concurrently
+        static_cast<void>(resultContainer[0]);
+
+        const std::uint64_t numResultDimensions{ static_cast<std::uint64_t>(dimensionIndices.size()) };
+
+        // When a small part of the dimensions is requested, each dimension is a sequential scan of the column-major copy
+        if (shouldUseColumnMajorData(dimensionIndices.size()) && constVisitColumnMajorFromBeginToEnd([&resultContainer, this, &dimensionIndices, numPoints, &pointIndexAt, numResultDimensions](const auto begin, const auto)
+            {
+                const std::uint64_t numColumnPoints{ getNumPoints() };
+
+                forEachGrain(numPoints, [&resultContainer, &dimensionIndices, &pointIndexAt, numResultDimensions, numColumnPoints, begin](const std::uint64_t pointBegin, const std::uint64_t pointEnd)
+                    {
+                        std::uint64_t resultDimensionIndex{};
+
+                        for (const std::uint64_t dimensionIndex : dimensionIndices)
+                        {
+                            const auto column = begin + dimensionIndex * numColumnPoints;
+
+                            for (std::uint64_t pointIndex{ pointBegin }; pointIndex < pointEnd; ++pointIndex)
+                                resultContainer[pointIndex * numResultDimensions + resultDimensionIndex] = column[pointIndexAt(pointIndex)];
+
+                            ++resultDimensionIndex;
+                        }
+                    });
+            }))
+            return;
+
+        std::visit([&resultContainer, this, &dimensionIndices, numPoints, &pointIndexAt, numResultDimensions](const auto& vec)
+            {
+                forEachGrain(numPoints, [&resultContainer, this, &dimensionIndices, &pointIndexAt, numResultDimensions, &vec](const std::uint64_t pointBegin, const std::uint64_t pointEnd)
+                    {
+                        std::uint64_t resultIndex{ pointBegin * numResultDimensions };
+
+                        for (std::uint64_t pointIndex{ pointBegin }; pointIndex < pointEnd; ++pointIndex)
+                        {
+                            const std::uint64_t n{ pointIndexAt(pointIndex) * _numDimensions };
+
+                            for (const std::uint64_t dimensionIndex : dimensionIndices)
+                            {
+                                resultContainer[resultIndex] = vec[n + dimensionIndex];
+                                ++resultIndex;
+                            }
+                        }
+                    });
+            },
+            *_variantOfVectors);
     }
 
+    /// Whether the elements of \p ResultContainer are contiguous floats, so that the gather kernels can write to it directly.
+    template <typename ResultContainer, typename = void>
+    struct IsFloatBuffer : std::false_type {};
+
+    template <typename ResultContainer>
+    struct IsFloatBuffer<ResultContainer, std::enable_if_t<std::is_same_v<decltype(std::declval<ResultContainer&>().data()), float*>>> : std::true_type {};
+
+    /// Builds the column-major copy of the data if it is enabled, out of date, requested often enough and fits in the
+    /// memory budget (assumes the data lock is held). Returns the up-to-date column-major copy, or nullptr if it is not available.
+    std::shared_ptr<const VariantOfVectors> updateColumnMajorData() const;
+
+    /// Releases the column-major copy and returns its size to the memory budget (readers which are still visiting it keep it alive).
+    void releaseColumnMajorData() const;
 
     template <typename DimensionIndex>
     void CheckDimensionIndex(const DimensionIndex& dimensionIndex) const
@@ -216,19 +341,41 @@ public:
     using ElementTypeAt = typename std::variant_alternative_t<N, VariantOfVectors>::value_type;
 
     PointData(mv::plugin::PluginFactory* factory) : RawData(factory, PointType) { }
-    ~PointData() override = default;
+    ~PointData() override;
 
     /**
      * Acquires exclusive access to the point-data storage and its metadata.
      *
      * Keep the returned lock alive for the complete lifetime of any pointer,
      * iterator or reference obtained from this PointData instance.
+     *
+     * Exclusive access may be nested. A thread which holds shared access (see
+     * lockDataShared(), e.g. inside constVisitFromBeginToEnd()) upgrades it: the
+     * shared access is released while waiting for exclusive access and restored
+     * afterwards (see RecursiveSharedMutex). Another writer may modify the data
+     * meanwhile, so pointers and iterators obtained under the shared lock may be
+     * stale (or, after the storage is replaced, refer to a snapshot) once the
+     * exclusive lock is acquired.
      */
     [[nodiscard]] DataLock lockData() const
     {
         return DataLock(_dataMutex);
     }
 
+    /**
+     * Acquires shared (read-only) access to the point-data storage and its metadata.
+     *
+     * Readers never block each other, only writers (see lockData()) exclude them. A
+     * thread which holds shared access may still acquire exclusive access, which
+     * upgrades its lock (see lockData()). Keep the returned lock alive for the
+     * complete lifetime of any const pointer, iterator or reference obtained from
+     * this PointData instance, or use getSnapshot().
+     */
+    [[nodiscard]] SharedDataLock lockDataShared() const
+    {
+        return SharedDataLock(_dataMutex);
+    }
+
     void init() override;
 
     mv::Dataset<mv::DatasetImpl> createDataSet(const QString& guid = "") const override;
@@ -270,26 +417,29 @@ public:
     template <typename ReturnType = void, typename FunctionObject>
     ReturnType constVisitFromBeginToEnd(FunctionObject functionObject) const
     {
-        const auto dataLock = lockData();
+        const auto dataLock = lockDataShared();
 
         return std::visit([functionObject](const auto& vec) -> ReturnType
             {
                 return functionObject(std::cbegin(vec), std::cend(vec));
             },
-            _variantOfVectors);
+            *_variantOfVectors);
     }
 
     // Similar to C++17 std::visit.
+    // Snapshots taken earlier keep the unmodified data (the storage is copied first when shared).
     template <typename ReturnType = void, typename FunctionObject>
     ReturnType visitFromBeginToEnd(FunctionObject functionObject)
     {
         const auto dataLock = lockData();
 
+        detachStorage();
+
         return std::visit([functionObject](auto& vec) -> ReturnType
             {
                 return functionObject(std::begin(vec), std::end(vec));
             },
-            _variantOfVectors);
+            *_variantOfVectors);
     }
 
     void extractFullDataForDimension(std::vector<float>& result, const int dimensionIndex) const;
@@ -297,55 +447,208 @@ public:
     void extractDataForDimension(std::vector<float> &result, const int dimensionIndex, const std::vector<std::uint32_t> &indices) const;
     void extractDataForDimensions(std::vector<mv::Vector2f>& result, const int dimensionIndex1, const int dimensionIndex2, const std::vector<std::uint32_t>& indices) const;
     
+    /// Gathers dimension \p dimensionIndex1 of the points with \p indices (all points if nullptr) as floats into \p destination,
+    /// or pairs of dimensions \p dimensionIndex1 and \p dimensionIndex2 (e.g. a vector of mv::Vector2f) if \p dimensionIndex2 is not negative.
+    /// Large ranges are split into grains which are gathered concurrently.
+    void gatherDimensionsToFloat(float* destination, const std::uint64_t numberOfValues, const std::uint32_t* indices, const int dimensionIndex1, const int dimensionIndex2 = -1) const;
+
+    /// Number of points per grain when extracting data concurrently.
+    static constexpr std::uint64_t extractionGrainSize = 1 << 16;
+
+    /// Splits [0, \p count) into grains of extractionGrainSize and invokes \p function(begin, end) for each grain. The grains
+    /// run concurrently on the workers of the shared workflow plan executor (and the call blocks until all have finished)
+    /// if there are at least two of them, otherwise inline.
+    static void forEachGrain(const std::uint64_t count, const std::function<void(std::uint64_t, std::uint64_t)>& function);
+
     template <typename ResultContainer, typename DimensionIndices>
     void populateFullDataForDimensions(ResultContainer& resultContainer, const DimensionIndices& dimensionIndices) const
     {
-        const auto dataLock = lockData();
+        const auto dataLock = lockDataShared();
 
         CheckDimensionIndices(dimensionIndices);
-        std::visit([&resultContainer, this, &dimensionIndices](const auto& vec)
+
+        // One or two dimensions into a float buffer are extracted with the vectorized gather kernels
+        if constexpr (IsFloatBuffer<ResultContainer>::value)
+        {
+            if (_isDense && (dimensionIndices.size() == 1 || dimensionIndices.size() == 2))
             {
-                const std::uint64_t numPoints{ getNumPoints() };
-                std::uint64_t resultIndex{};
+                const auto dimensionIndicesBegin = std::cbegin(dimensionIndices);
 
-                for (std::uint64_t pointIndex{}; pointIndex < numPoints; ++pointIndex)
-                {
-                    const std::uint64_t n{ pointIndex * _numDimensions };
+                gatherDimensionsToFloat(resultContainer.data(), getNumPoints(), nullptr, dimensionIndicesBegin[0], dimensionIndices.size() == 2 ? dimensionIndicesBegin[1] : -1);
+                return;
+            }
+        }
 
-                    for (const std::uint64_t dimensionIndex : dimensionIndices)
-                    {
-                        resultContainer[resultIndex] = vec[n + dimensionIndex];
-                        ++resultIndex;
-                    }
-                }
-            },
-            _variantOfVectors);
+        populateDimensions(resultContainer, dimensionIndices, getNumPoints(), [](const std::uint64_t pointIndex) { return pointIndex; });
     }
 
     template <typename ResultContainer, typename DimensionIndices, typename Indices>
     void populateDataForDimensions(ResultContainer& resultContainer, const DimensionIndices& dimensionIndices, const Indices& indices) const
     {
-        const auto dataLock = lockData();
+        const auto dataLock = lockDataShared();
 
         CheckDimensionIndices(dimensionIndices);
 
-        std::visit([&resultContainer, this, &dimensionIndices, &indices](const auto& vec)
+        // One or two dimensions into a float buffer are extracted with the vectorized gather kernels
+        if constexpr (IsFloatBuffer<ResultContainer>::value && std::is_same_v<std::decay_t<decltype(*std::data(indices))>, std::uint32_t>)
+        {
+            if (_isDense && (dimensionIndices.size() == 1 || dimensionIndices.size() == 2))
             {
-                const std::uint64_t numPoints{ static_cast<std::uint64_t>(indices.size()) };
-                std::uint64_t resultIndex{};
+                const auto dimensionIndicesBegin = std::cbegin(dimensionIndices);
 
-                for (std::uint64_t pointIndex{}; pointIndex < numPoints; ++pointIndex)
-                {
-                    const std::uint64_t n{ indices[pointIndex] * _numDimensions };
+                gatherDimensionsToFloat(resultContainer.data(), static_cast<std::uint64_t>(indices.size()), std::data(indices), dimensionIndicesBegin[0], dimensionIndices.size() == 2 ? dimensionIndicesBegin[1] : -1);
+                return;
+            }
+        }
 
-                    for (const std::uint64_t dimensionIndex : dimensionIndices)
-                    {
-                        resultContainer[resultIndex] = vec[n + dimensionIndex];
-                        ++resultIndex;
-                    }
-                }
+        populateDimensions(resultContainer, dimensionIndices, static_cast<std::uint64_t>(indices.size()), [&indices](const std::uint64_t pointIndex) { return static_cast<std::uint64_t>(indices[pointIndex]); });
+    }
+
+    /// Number of per-dimension accesses of the same data after which the column-major copy is built, so that a
+    /// single extraction never pays for transposing the whole matrix.
+    static constexpr std::uint32_t columnMajorDataAccessThreshold = 3;
+
+    /// Enables or disables the column-major (dimension-contiguous) copy of the data (disabled by default). The
+    /// copy is built once the data was accessed per dimension columnMajorDataAccessThreshold times, and cached
+    /// until the data changes (or a data changed event is notified), so that per-dimension access becomes a
+    /// sequential scan. It doubles the memory footprint of the data, so the copies of all point data share a
+    /// memory budget (see setMaximumTotalColumnMajorDataSize()) and a copy which does not fit is not built.
+    void setColumnMajorDataEnabled(bool enabled);
+
+    bool isColumnMajorDataEnabled() const;
+
+    /// Returns the size (in bytes) of the current column-major copy, zero if there is none.
+    std::uint64_t getColumnMajorDataSize() const;
+
+    /// Sets the memory budget (in bytes) of the column-major copies of all point data (4 GB by default).
+    static void setMaximumTotalColumnMajorDataSize(std::uint64_t maximumTotalColumnMajorDataSize);
+
+    static std::uint64_t getMaximumTotalColumnMajorDataSize();
+
+    /// Returns the size (in bytes) of the column-major copies of all point data.
+    static std::uint64_t getTotalColumnMajorDataSize();
+
+    /// Allows read-only access to the column-major copy of the data, from its begin to its end: the
+    /// values of dimension d are at [d * numPoints, (d + 1) * numPoints). Builds the copy if needed.
+    /// Returns false without invoking the function object if no column-major copy is available
+    /// (disabled, sparse or too large), in which case the row-major data should be used instead.
+    template <typename FunctionObject>
+    bool constVisitColumnMajorFromBeginToEnd(FunctionObject functionObject) const
+    {
+        const auto dataLock = lockDataShared();
+
+        const auto columnMajorData = updateColumnMajorData();
+
+        if (!columnMajorData)
+            return false;
+
+        std::visit([&functionObject](const auto& vec)
+            {
+                functionObject(std::cbegin(vec), std::cend(vec));
             },
-            _variantOfVectors);
+            *columnMajorData);
+
+        return true;
+    }
+
+    /// Immutable view of the dense point data at the time it was taken (see getSnapshot()). Taking a
+    /// snapshot does not copy the data: the storage is shared and only copied when the point data is
+    /// modified while the snapshot is alive (copy-on-write). A snapshot may therefore be read from any
+    /// thread without holding the data lock, for as long as it exists.
+    class POINTDATA_EXPORT Snapshot
+    {
+    public:
+        Snapshot() = default;
+
+        /// Returns whether the snapshot holds data (sparse data can not be snapshotted).
+        bool isValid() const
+        {
+            return _storage != nullptr;
+        }
+
+        /// Returns the storage version of the point data at the time the snapshot was taken (see PointData::getStorageVersion()).
+        std::uint64_t getVersion() const
+        {
+            return _version;
+        }
+
+        std::uint64_t getNumPoints() const
+        {
+            return _numDimensions == 0 ? 0 : getNumberOfElements() / _numDimensions;
+        }
+
+        std::uint64_t getNumDimensions() const
+        {
+            return _numDimensions;
+        }
+
+        std::uint64_t getNumberOfElements() const
+        {
+            return _storage ? std::visit([](const auto& vec) { return static_cast<std::uint64_t>(vec.size()); }, *_storage) : 0;
+        }
+
+        /// Returns the size of the data in bytes.
+        std::uint64_t getRawDataSize() const
+        {
+            return _storage ? std::visit([](const auto& vec) { return static_cast<std::uint64_t>(vec.size() * sizeof(vec[0])); }, *_storage) : 0;
+        }
+
+        /// Returns the size of a single element in bytes.
+        std::uint32_t getElementSize() const
+        {
+            return _storage ? std::visit([](const auto& vec) { return static_cast<std::uint32_t>(sizeof(vec[0])); }, *_storage) : 1;
+        }
+
+        ElementTypeSpecifier getElementTypeSpecifier() const
+        {
+            return _storage ? static_cast<ElementTypeSpecifier>(_storage->index()) : ElementTypeSpecifier::float32;
+        }
+
+        const void* getDataConstVoidPtr() const
+        {
+            return _storage ? std::visit([](const auto& vec) { return static_cast<const void*>(vec.data()); }, *_storage) : nullptr;
+        }
+
+        /// Allows read-only access to the data from its begin to its end (like PointData::constVisitFromBeginToEnd()).
+        template <typename ReturnType = void, typename FunctionObject>
+        ReturnType constVisitFromBeginToEnd(FunctionObject functionObject) const
+        {
+            assert(isValid());
+
+            return std::visit([&functionObject](const auto& vec)
+                {
+                    return functionObject(std::cbegin(vec), std::cend(vec));
+                },
+                *_storage);
+        }
+
+    private:
+        Snapshot(std::shared_ptr<const VariantOfVectors> storage, std::uint64_t numDimensions, std::uint64_t version) :
+            _storage(std::move(storage)),
+            _numDimensions(numDimensions),
+            _version(version)
+        {
+        }
+
+    private:
+        std::shared_ptr<const VariantOfVectors>     _storage;               /**< Shared storage of the point data */
+        std::uint64_t                               _numDimensions = 0;     /**< Number of dimensions at the time the snapshot was taken */
+        std::uint64_t                               _version = 0;           /**< Storage version at the time the snapshot was taken */
+
+        friend class PointData;
+    };
+
+    /// Takes an immutable snapshot of the (dense) data, without copying it. Returns an invalid snapshot for sparse data.
+    Snapshot getSnapshot() const;
+
+    /// Returns the storage version, which is incremented whenever the data is (or may be) modified, also by
+    /// modifications without a change notification (e.g. through getDataVoidPtr() or setData()).
+    std::uint64_t getStorageVersion() const override
+    {
+        // Whoever reads the version (a snapshot, the column-major copy or a save) has to see the next write as a modification
+        _storageWritable = false;
+
+        return _storageVersion;
     }
 
     const std::vector<QString>& getDimensionNames() const;
@@ -358,7 +661,7 @@ public:
 
     ElementTypeSpecifier getElementType() const
     {
-        const auto dataLock = lockData();
+        const auto dataLock = lockDataShared();
         return getElementTypeSpecifier();
     }
 
@@ -410,7 +713,7 @@ public:
     {
          const auto dataLock = lockData();
 
-         _variantOfVectors = VariantOfVectors( std::vector<T>(data, data + numPoints * numDimensions) );
+         replaceStorage(VariantOfVectors( std::vector<T>(data, data + numPoints * numDimensions) ));
          _numDimensions = static_cast<std::uint64_t>(numDimensions);
     }
 
@@ -427,7 +730,7 @@ public:
     {
         const auto dataLock = lockData();
 
-        _variantOfVectors = VariantOfVectors(data);
+        replaceStorage(VariantOfVectors(data));
         _numDimensions = static_cast<std::uint64_t>(numDimensions);
     }
 
@@ -439,10 +742,115 @@ public:
     {
         const auto dataLock = lockData();
 
-        _variantOfVectors = VariantOfVectors(std::move(data));
+        replaceStorage(VariantOfVectors(std::move(data)));
         _numDimensions = static_cast<std::uint64_t>(numDimensions);
     }
 
+    /// Maximum number of previously published buffers which are kept for recycling (one of which is
+    /// typically still read through a snapshot, so that producers are effectively triple-buffered).
+    static constexpr std::size_t maximumNumberOfRecycledBuffers = 2;
+
+    /// Returns the back buffer for data of element type T, sized for the specified number of points and
+    /// dimensions, to which a (single) producer may write without holding the data lock. The back buffer
+    /// is recycled from previously published data, so its contents are unspecified: the producer is expected
+    /// to overwrite all of it. The reference is valid until the next call to publishBackBuffer().
+    template <typename T>
+    std::vector<T>& getBackBuffer(const std::size_t numPoints, const std::size_t numDimensions)
+    {
+        const std::lock_guard backBufferLock(_backBufferMutex);
+
+        if (!_backBuffer)
+            _backBuffer = takeRecycledBuffer();
+
+        setIndexOfVariant(*_backBuffer, getIndexOfVariantAlternative<VariantOfVectors, std::vector<T>>());
+
+        auto& backBuffer = std::get<std::vector<T>>(*_backBuffer);
+
+        backBuffer.resize(numPoints * numDimensions);
+
+        _backBufferNumDimensions = static_cast<std::uint64_t>(numDimensions);
+
+        return backBuffer;
+    }
+
+    /// Publishes the back buffer (see getBackBuffer()) as the data by swapping it with the current storage,
+    /// which is kept for recycling. Constant time: the data is neither copied nor reallocated. Returns false
+    /// if there is no back buffer to publish.
+    bool publishBackBuffer();
+
+    /// Returns the number of previously published buffers which are kept for recycling (at most
+    /// maximumNumberOfRecycledBuffers).
+    std::size_t getNumberOfRecycledBuffers() const;
+
+    /// Sets the values of the dimensions with the specified indices (all dimensions if empty) of the points
+    /// [pointBegin, pointBegin + numberOfPoints), converted to the internal element type. The data holds a
+    /// row of values for each point, with a value for each of the dimensions, in the order of their indices.
+    /// Throws std::out_of_range (without modifying the data) if a point or dimension index is out of range.
+    template <typename T>
+    void setValues(const std::uint64_t pointBegin, const std::uint64_t numberOfPoints, const std::vector<std::uint32_t>& dimensionIndices, const T* const data)
+    {
+        // One past the last point, saturated so that an overflowing range is rejected
+        const auto pointEnd = numberOfPoints > std::numeric_limits<std::uint64_t>::max() - pointBegin ? std::numeric_limits<std::uint64_t>::max() : pointBegin + numberOfPoints;
+
+        assignValues(numberOfPoints, numberOfPoints == 0 ? 0 : pointEnd, dimensionIndices, data, [pointBegin](const std::uint64_t pointIndex) { return pointBegin + pointIndex; });
+    }
+
+    /// Sets the values of the dimensions with the specified indices (all dimensions if empty) of the points with the
+    /// specified indices, converted to the internal element type (see the point range overload for the data layout).
+    template <typename T>
+    void setValues(const std::vector<std::uint32_t>& pointIndices, const std::vector<std::uint32_t>& dimensionIndices, const T* const data)
+    {
+        const auto pointEnd = pointIndices.empty() ? std::uint64_t{ 0 } : static_cast<std::uint64_t>(*std::max_element(pointIndices.begin(), pointIndices.end())) + 1;
+
+        assignValues(static_cast<std::uint64_t>(pointIndices.size()), pointEnd, dimensionIndices, data, [&pointIndices](const std::uint64_t pointIndex) { return static_cast<std::uint64_t>(pointIndices[pointIndex]); });
+    }
+
+private:
+
+    /// Assigns the values of setValues(), where pointIndexAt maps the index of a row of the data to the index of its point,
+    /// and pointEnd is one past the highest of these point indices.
+    template <typename T, typename PointIndexAt>
+    void assignValues(const std::uint64_t numberOfPoints, const std::uint64_t pointEnd, const std::vector<std::uint32_t>& dimensionIndices, const T* const data, PointIndexAt pointIndexAt)
+    {
+        const auto dataLock = lockData();
+
+        assert(_isDense);
+
+        if (pointEnd > getNumPoints())
+            throw std::out_of_range("Point index out of range");
+
+        if (std::any_of(dimensionIndices.begin(), dimensionIndices.end(), [this](const std::uint32_t dimensionIndex) { return dimensionIndex >= _numDimensions; }))
+            throw std::out_of_range("Dimension index out of range");
+
+        detachStorage();
+
+        std::visit([this, numberOfPoints, &dimensionIndices, data, &pointIndexAt](auto& vec)
+            {
+                using value_type = typename std::remove_reference_t<decltype(vec)>::value_type;
+
+                const auto numberOfDimensions   = _numDimensions;
+                const auto numberOfValues       = dimensionIndices.empty() ? numberOfDimensions : static_cast<std::uint64_t>(dimensionIndices.size());
+
+                forEachGrain(numberOfPoints, [&vec, &dimensionIndices, data, &pointIndexAt, numberOfDimensions, numberOfValues](const std::uint64_t begin, const std::uint64_t end)
+                    {
+                        for (std::uint64_t pointIndex = begin; pointIndex < end; ++pointIndex)
+                        {
+                            const auto offset   = pointIndexAt(pointIndex) * numberOfDimensions;
+                            const auto* row     = data + pointIndex * numberOfValues;
+
+                            if (dimensionIndices.empty())
+                                std::transform(row, row + numberOfValues, vec.begin() + offset, [](const T value) { return static_cast<value_type>(value); });
+                            else
+                                for (std::uint64_t valueIndex = 0; valueIndex < numberOfValues; ++valueIndex)
+                                    vec[offset + dimensionIndices[valueIndex]] = static_cast<value_type>(row[valueIndex]);
+                        }
+                    });
+            },
+            *_variantOfVectors);
+    }
+
+public:
+
     void setDimensionNames(const std::vector<QString>& dimNames);
 
     // Returns the value of the element at the specified position in the current
@@ -455,8 +863,18 @@ public:
     // data vector, converted to the internal data element type. 
     // Will work fine, even when the internal data element type is not float.
     // However, may not perform well when setting a large number of values.
+    // Copies on write like the other writers: the first write after a snapshot
+    // (or save) detaches the storage under the exclusive lock, later writes do
+    // not lock.
     void setValueAt(std::size_t index, float newValue);
 
+    /// Prepares the storage for writes through setValueAt(): copies it first if a snapshot still shares it, so that
+    /// the snapshot keeps the unmodified data, and increments the storage version, so that the column-major copy and
+    /// the encoded blocks of the previous save are not reused. setValueAt() does so itself when needed, but call it
+    /// once before a parallel loop of setValueAt() calls, so that the workers do not wait for the exclusive lock
+    /// (which deadlocks if the calling thread holds it while it waits for the workers).
+    void prepareForWrite();
+
 public: // Sparse data, test implementation
     class Experimental {
         friend class PointData;
@@ -489,7 +907,7 @@ public: // Sparse data, test implementation
 
         static bool isDense(const PointData* points)
         {
-            const auto dataLock = points->lockData();
+            const auto dataLock = points->lockDataShared();
             return points->_isDense;
         }
 
@@ -501,13 +919,13 @@ public: // Sparse data, test implementation
 
         static size_t getNumNonZeroElements(const PointData* points)
         {
-            const auto dataLock = points->lockData();
+            const auto dataLock = points->lockDataShared();
             return points->_sparseData.getNumNonZeros();
         }
 
         static std::vector<float> row(const PointData* points, size_t rowIndex)
         {
-            const auto dataLock = points->lockData();
+            const auto dataLock = points->lockDataShared();
 
             if (points->_isDense)
             {
@@ -543,15 +961,41 @@ public: // Serialization
     mv::workflow::UniqueWorkflowPlan toVariantMapWorkflow() const final;
 
 private:
-    mutable std::recursive_mutex _dataMutex;
+    mutable RecursiveSharedMutex _dataMutex;
+
+    /** Reference-counted storage, shared with snapshots and copied on write (see detachStorage()) */
+    std::shared_ptr<VariantOfVectors> _variantOfVectors = std::make_shared<VariantOfVectors>();
+
+    /** Incremented whenever the storage is (or may be) modified */
+    std::atomic<std::uint64_t> _storageVersion = 0;
 
-    VariantOfVectors _variantOfVectors;
+    /** Whether the storage is not shared and its version was not read since it was incremented, so that setValueAt() may write without detaching */
+    mutable std::atomic_bool _storageWritable = false;
 
     /** Number of features of each data point */
     std::uint64_t _numDimensions = 1;
 
     std::vector<QString> _dimNames;
 
+private: // Buffered publishing
+
+    /// Returns a previously published buffer which is no longer shared (by a snapshot), or a new buffer (assumes the back buffer mutex is held).
+    std::shared_ptr<VariantOfVectors> takeRecycledBuffer();
+
+    mutable std::mutex                                  _backBufferMutex;               /**< Guards the back buffer and the recycled buffers */
+    std::shared_ptr<VariantOfVectors>                   _backBuffer;                    /**< Buffer to which the producer writes the data that is published next */
+    std::uint64_t                                       _backBufferNumDimensions = 0;   /**< Number of dimensions of the data in the back buffer */
+    std::vector<std::shared_ptr<VariantOfVectors>>      _recycledBuffers;               /**< Previously published buffers, oldest first */
+
+private: // Column-major copy of the data
+    mutable std::shared_ptr<const VariantOfVectors> _columnMajorData;                   /**< Column-major (dimension-contiguous) copy of the data */
+    mutable std::mutex                              _columnMajorDataMutex;              /**< Guards building the column-major copy by concurrent readers */
+    mutable std::uint64_t                           _columnMajorDataStorageVersion = 0; /**< Storage version of the column-major copy */
+    mutable std::uint64_t                           _columnMajorDataRevision = 0;       /**< Raw data revision of the column-major copy (see RawData::getRevision()) */
+    mutable std::uint64_t                           _columnMajorDataSize = 0;           /**< Size of the column-major copy in bytes (reserved from the memory budget) */
+    mutable std::uint32_t                           _columnMajorDataNumberOfAccesses = 0;   /**< Number of per-dimension accesses of the data with the storage version and revision above */
+    bool                                            _columnMajorDataEnabled = false;    /**< Whether a column-major copy may be built */
+
 private: // Sparse data, experimental
     std::uint64_t _numRows = 0;
     SparseMatrix<size_t, size_t, float> _sparseData = {};
@@ -568,6 +1012,46 @@ private: // Sparse data, experimental
 class POINTDATA_EXPORT Points : public mv::DatasetImpl
 {
 private:
+    /// Raw data and point indices of a proxy member, and the index of its first point in the concatenated proxy points.
+    struct ProxyMemberRange
+    {
+        const PointData*                    rawPointData;   /**< Raw point data of the member */
+        const std::vector<std::uint32_t>*   indices;        /**< Point indices of the member, nullptr if it is full */
+        std::uint64_t                       numPoints;      /**< Number of points of the member */
+        std::uint64_t                       offset;         /**< Index of the first point of the member in the proxy */
+    };
+
+    /// Result container view which starts at \p offset, so that a proxy member writes directly into the proxy result.
+    template <typename ResultContainer>
+    class OffsetResultContainer
+    {
+    public:
+        OffsetResultContainer(ResultContainer& resultContainer, const std::uint64_t offset) :
+            _resultContainer(resultContainer),
+            _offset(offset)
+        {
+        }
+
+        decltype(auto) operator[](const std::uint64_t index) const
+        {
+            return _resultContainer[_offset + index];
+        }
+
+        template <typename Container = ResultContainer>
+        auto data() const -> decltype(std::declval<Container&>().data())
+        {
+            return _resultContainer.data() + _offset;
+        }
+
+    private:
+        ResultContainer&    _resultContainer;
+        std::uint64_t       _offset;
+    };
+
+    /// Collects the (nested) proxy members and their offsets on the calling thread, and then invokes \p function for all
+    /// of them concurrently, blocking until all have finished. The function may only access the passed member range.
+    void forEachProxyMember(const std::function<void(const ProxyMemberRange&)>& function) const;
+
     /* Private helper function for visitData. Helps to reduces duplicate
     * code between const and non-const overloads of visitData.
     */
@@ -593,6 +1077,20 @@ private:
                     else
                     {
                         // In this case, this Points object represents a subset.
+                        const auto indexRuns = points.getCompactIndexRuns();
+
+                        if (indexRuns && indexRuns->size() == 1)
+                        {
+                            // The subset is a single run of consecutive points, so there is no need to go through its indices.
+                            const auto indexFunction = [](const auto index)
+                            {
+                                return index;
+                            };
+
+                            return functionObject(mv::makePointDataRangeOfIndexRange(
+                                begin, indexRuns->front().begin, indexRuns->front().end, numberOfDimensions, indexFunction));
+                        }
+
                         const auto indexFunction = [](const auto indexIterator)
                         {
                             // Get the index by dereferencing the iterator.
@@ -630,6 +1128,18 @@ private:
                 return sourceData->template visitFromBeginToEnd<ReturnType>(
                     [&points, functionObject](const auto begin, const auto end) -> ReturnType
                     {
+                        if (const auto indexRuns = points.getCompactIndexRuns(); indexRuns && indexRuns->size() == 1)
+                        {
+                            const auto indexFunction = [](const auto index)
+                            {
+                                return index;
+                            };
+
+                            // Its own indices are a single run of consecutive points of the full source data.
+                            return functionObject(mv::makePointDataRangeOfIndexRange(
+                                begin, indexRuns->front().begin, indexRuns->front().end, points.getNumDimensions(), indexFunction));
+                        }
+
                         const auto indexFunction = [](const auto indexIterator)
                         {
                             // Get the index by dereferencing the iterator.
@@ -692,6 +1202,27 @@ public:
         return getRawData<PointData>()->visitFromBeginToEnd<ReturnType>(functionObject);
     }
 
+    /// Allows read-only access to the column-major copy of the internal point data (see PointData::constVisitColumnMajorFromBeginToEnd).
+    /// Returns false if no column-major copy is available, in which case the row-major data should be visited instead.
+    template <typename FunctionObject>
+    bool constVisitColumnMajorFromBeginToEnd(FunctionObject functionObject) const
+    {
+        return getRawData<PointData>()->constVisitColumnMajorFromBeginToEnd(functionObject);
+    }
+
+    /// Opts in to (or out of) the column-major copy of the internal point data (see PointData::setColumnMajorDataEnabled).
+    void setColumnMajorDataEnabled(bool enabled)
+    {
+        getRawData<PointData>()->setColumnMajorDataEnabled(enabled);
+    }
+
+    /// Takes an immutable snapshot of the internal (dense) point data, which may be read without locking (see PointData::getSnapshot).
+    /// Note that the snapshot holds all points of the raw data, also when this data set is a subset.
+    PointData::Snapshot getSnapshot() const
+    {
+        return getRawData<PointData>()->getSnapshot();
+    }
+
 
     /* Allows visiting the point data, which is either _all_ data (if this data
      * set is full), or (otherwise) the subset specified by its indices.
@@ -790,6 +1321,82 @@ public:
             handleNumberDimensionsChanged(numDimensions);
     }
 
+public: // Buffered publishing
+
+    /// Just calls the corresponding member function of its PointData: the producer writes the next data into the
+    /// returned back buffer and publishes it with publishBackBuffer() (e.g. once per iteration of an embedding).
+    template <typename T>
+    std::vector<T>& getBackBuffer(const std::size_t numPoints, const std::size_t numDimensions)
+    {
+        return getRawData<PointData>()->getBackBuffer<T>(numPoints, numDimensions);
+    }
+
+    /**
+     * Publish the back buffer as the data in constant time (see PointData::publishBackBuffer()) and notify that the
+     * data changed, at most once per frame budget; publishing faster than that coalesces the notifications.
+     * May be invoked from any thread, the notification is always made on the thread of this dataset.
+     */
+    void publishBackBuffer();
+
+    /**
+     * Set the minimum interval between two data changed notifications of publishBackBuffer()
+     * @param publishFrameBudget Frame budget in milliseconds
+     */
+    void setPublishFrameBudget(std::int32_t publishFrameBudget);
+
+    /**
+     * Get the minimum interval between two data changed notifications of publishBackBuffer()
+     * @return Frame budget in milliseconds
+     */
+    std::int32_t getPublishFrameBudget() const;
+
+private:
+
+    /** Notify that the data changed on behalf of publishBackBuffer(), invoked on the thread of this dataset */
+    void notifyPublishedData();
+
+public: // Partial updates
+
+    /**
+     * Set the values of some dimensions of a range of points and notify which region of the data changed (see PointData::setValues())
+     * Listeners can then update only that region instead of the complete dataset (see mv::DatasetDataChangedEvent::getRegion())
+     * @param pointBegin Index of the first point in the raw data
+     * @param numberOfPoints Number of points
+     * @param dimensionIndices Indices of the dimensions (all dimensions if empty)
+     * @param data Values, a row of values per point
+     */
+    template <typename T>
+    void setValues(const std::uint64_t pointBegin, const std::uint64_t numberOfPoints, const std::vector<std::uint32_t>& dimensionIndices, const T* const data)
+    {
+        getRawData<PointData>()->setValues(pointBegin, numberOfPoints, dimensionIndices, data);
+
+        notifyDataRegionChanged(mv::DataChangedRegion(pointBegin, pointBegin + numberOfPoints, dimensionIndices));
+    }
+
+    /**
+     * Set the values of some dimensions of the points with \p pointIndices and notify which region of the data changed (see PointData::setValues())
+     * @param pointIndices Indices of the points in the raw data
+     * @param dimensionIndices Indices of the dimensions (all dimensions if empty)
+     * @param data Values, a row of values per point
+     */
+    template <typename T>
+    void setValues(const std::vector<std::uint32_t>& pointIndices, const std::vector<std::uint32_t>& dimensionIndices, const T* const data)
+    {
+        getRawData<PointData>()->setValues(pointIndices, dimensionIndices, data);
+
+        notifyDataRegionChanged(mv::DataChangedRegion(pointIndices, dimensionIndices));
+    }
+
+private:
+
+    /**
+     * Notify listeners that \p region of the data changed
+     * @param region Region of the data that changed
+     */
+    void notifyDataRegionChanged(const mv::DataChangedRegion& region);
+
+public:
+
     void extractDataForDimension(std::vector<float>& result, const int dimensionIndex) const;
 
     void extractDataForDimensions(std::vector<mv::Vector2f>& result, const int dimensionIndex1, const int dimensionIndex2) const;
@@ -802,28 +1409,21 @@ public:
     void populateDataForDimensions(ResultContainer& resultContainer, const DimensionIndices& dimensionIndices) const
     {
         if (isProxy()) {
-            std::size_t offset = 0;
+            if (getNumPoints() == 0)
+                return;
 
-            for (auto& proxyMember : getProxyMembers()) {
-                auto points = mv::Dataset<Points>(proxyMember);
+            // Detach an implicitly shared result container (e.g. a QVector) before the members write to it concurrently
+            static_cast<void>(resultContainer[0]);
 
-                ResultContainer proxyPointsData = {};
+            // Each member writes directly into its part of the result container
+            forEachProxyMember([&resultContainer, &dimensionIndices](const ProxyMemberRange& proxyMember) {
+                OffsetResultContainer<ResultContainer> proxyMemberResultContainer(resultContainer, proxyMember.offset * static_cast<std::uint64_t>(dimensionIndices.size()));
 
-                const auto numberOfElements = points->getNumPoints() * dimensionIndices.size();
-
-                proxyPointsData.resize(numberOfElements);
-
-                const auto rawPointData = points->getRawData<PointData>();
-
-                if (points->isFull())
-                    rawPointData->populateFullDataForDimensions(proxyPointsData, dimensionIndices);
+                if (proxyMember.indices == nullptr)
+                    proxyMember.rawPointData->populateFullDataForDimensions(proxyMemberResultContainer, dimensionIndices);
                 else
-                    rawPointData->populateDataForDimensions(proxyPointsData, dimensionIndices, points->indices);
-
-                std::copy(proxyPointsData.begin(), proxyPointsData.end(), resultContainer.begin() + offset);
-
-                offset += numberOfElements;
-            }
+                    proxyMember.rawPointData->populateDataForDimensions(proxyMemberResultContainer, dimensionIndices, *proxyMember.indices);
+            });
         }
         else {
             const auto rawPointData = getRawData<PointData>();
@@ -914,8 +1514,12 @@ public:
     // data vector, converted to the internal data element type. 
     // Will work fine, even when the internal data element type is not float.
     // However, may not perform well when setting a large number of values.
+    // Copies on write (see PointData::setValueAt), call prepareForWrite() once before a parallel loop of setValueAt calls.
     void setValueAt(std::size_t index, float newValue);
 
+    /// Prepares the internal point data for writes through setValueAt() (see PointData::prepareForWrite).
+    void prepareForWrite();
+
     public: // Dense, test implementation
     class Experimental {
         friend class Points;
@@ -989,6 +1593,119 @@ public:
     void setProxyMembers(const mv::Datasets& proxyMembers) override;
 
 public: // Index transformation
+
+    /** Run [begin, end) of consecutive (point) indices */
+    struct IndexRun
+    {
+        std::uint32_t   begin;  /** First index */
+        std::uint32_t   end;    /** One past the last index */
+
+        /** Get the number of indices in the run */
+        std::uint32_t size() const {
+            return end - begin;
+        }
+
+        bool operator==(const IndexRun& other) const {
+            return begin == other.begin && end == other.end;
+        }
+    };
+
+    using IndexRuns = std::vector<IndexRun>;
+
+    /**
+     * Get the indices of this subset as runs of consecutive indices, in the order of the indices. Many subsets (proxy
+     * members, concatenated batches, the first N points) consist of one or a few runs; a subset with a single run is
+     * visited as a dense range of its source data without going through its indices, and subsets with few runs are
+     * saved as runs. Compact runs (see getCompactIndexRuns()) are cached until the indices change; the runs of
+     * fragmented indices are computed on each call, since they take up to twice the memory of the indices.
+     * @return Shared pointer to the index runs (empty if the dataset has no indices, e.g. a full set)
+     */
+    std::shared_ptr<const IndexRuns> getIndexRuns() const;
+
+    /**
+     * Get the index runs (see getIndexRuns()) if they are compact: a single run, or at most one run per eight indices.
+     * The result is cached until the indices change: indicesChanged() invalidates it, and a content hash of the indices
+     * is verified on each call, so direct writes to indices without notice are detected as well. Fragmented indices
+     * are detected as soon as they exceed the number of runs, without computing all of their runs.
+     * @return Shared pointer to the compact index runs, or nullptr if the indices are fragmented
+     */
+    std::shared_ptr<const IndexRuns> getCompactIndexRuns() const;
+
+    /**
+     * Set the indices of this subset to the consecutive indices of \p indexRuns
+     * @param indexRuns Index runs, in the order of the indices
+     */
+    void setIndexRuns(const IndexRuns& indexRuns);
+
+    /**
+     * Composed map from the local indices of a dataset to the global indices of the original raw data, and its inverse
+     * The inverse is a dense array if the dataset covers a substantial part of the raw data, and a hash map otherwise.
+     */
+    class GlobalIndexMap
+    {
+    public:
+        static constexpr std::uint32_t invalidIndex = std::numeric_limits<std::uint32_t>::max();    /** Local index of global indices which are not in the dataset */
+
+        /** Get the global index of each local point */
+        const std::vector<std::uint32_t>& getGlobalIndices() const {
+            return _globalIndices;
+        }
+
+        /**
+         * Get the local index of \p globalIndex
+         * @param globalIndex Global index into the original raw data
+         * @return Local index, or invalidIndex if the point is not in the dataset
+         */
+        std::uint32_t getLocalIndex(std::uint32_t globalIndex) const {
+            if (_isContiguous)
+                return globalIndex >= _firstGlobalIndex && globalIndex - _firstGlobalIndex < _globalIndices.size() ? globalIndex - _firstGlobalIndex : invalidIndex;
+
+            if (!_denseLocalIndices.empty())
+                return globalIndex < _denseLocalIndices.size() ? _denseLocalIndices[globalIndex] : invalidIndex;
+
+            const auto localIndex = _sparseLocalIndices.find(globalIndex);
+
+            return localIndex == _sparseLocalIndices.end() ? invalidIndex : localIndex->second;
+        }
+
+        /** Get whether each global index occurs at most once, otherwise getLocalIndex() only yields one of the local indices */
+        bool isInjective() const {
+            return _isInjective;
+        }
+
+        /** Get whether the global indices are consecutive, starting at getFirstGlobalIndex() (no inverse is stored in that case) */
+        bool isContiguous() const {
+            return _isContiguous;
+        }
+
+        /** Get the global index of the first local point if the global indices are consecutive */
+        std::uint32_t getFirstGlobalIndex() const {
+            return _firstGlobalIndex;
+        }
+
+    private:
+        std::vector<std::uint32_t>                          _globalIndices;         /** Global index of each local point */
+        std::vector<std::uint32_t>                          _denseLocalIndices;     /** Local index of each global point (dense inverse) */
+        std::unordered_map<std::uint32_t, std::uint32_t>    _sparseLocalIndices;    /** Local index of global points in the dataset (sparse inverse) */
+        bool                                                _isContiguous = false;  /** Whether the global indices are consecutive (no inverse is stored) */
+        std::uint32_t                                       _firstGlobalIndex = 0;  /** Global index of the first local point if the global indices are consecutive */
+        bool                                                _isInjective = true;    /** Whether each global index occurs at most once */
+
+        friend class Points;
+    };
+
+    /**
+     * Get the cached composed map between the local indices of this dataset and the global indices of the original
+     * raw data. It is only rebuilt when the indices of this dataset or of one of the subsets it derives from change
+     * (see indicesChanged(), direct writes to indices are detected through a content hash which is verified on each
+     * call), so that selection handling does not depend on the size of the raw data.
+     * @return Shared pointer to the global index map
+     */
+    std::shared_ptr<const GlobalIndexMap> getGlobalIndexMap() const;
+
+    /** Invoke after modifying the indices directly, so that the global index maps of this dataset and the subsets derived from it are rebuilt */
+    void indicesChanged();
+
     /**
      * Get the indices over the original source data that this dataset
      * indexes into through being a subset or derived data or a combination.
@@ -1007,6 +1724,17 @@ public: // Index transformation
 
     void getLocalSelectionIndices(std::vector<std::uint32_t>& localSelectionIndices) const;
 
+protected:
+
+    /**
+     * Get the cached global index map of this dataset, composed of the indices of \p subsets (getGlobalIndexMap()
+     * collects the chain by walking back to the source data, which requires the data manager)
+     * @param subsets Subsets from this dataset back to the source data, each indexing into the next one
+     * @param numberOfPoints Number of points of this dataset
+     * @param numberOfRawPoints Number of points of the raw data of the source dataset
+     * @return Shared pointer to the global index map
+     */
+    std::shared_ptr<const GlobalIndexMap> getGlobalIndexMap(const std::vector<const Points*>& subsets, std::size_t numberOfPoints, std::size_t numberOfRawPoints) const;
 
 public: // Action getters
 
@@ -1028,6 +1756,25 @@ public: // Selection
      */
     void setSelectionIndices(const std::vector<std::uint32_t>& indices) override;
 
+    /**
+     * Change the selection incrementally by \p delta, the linked datasets are updated with the mapped delta where the mapping allows it
+     * @param delta Selection delta
+     */
+    void applySelectionDelta(const mv::SelectionDelta& delta) override;
+
+    /**
+     * Get the selection as a compressed index set, for set operations on large selections
+     * The selection itself is stored as plain indices, so the index set is built on each call
+     * @return Selection index set (global indices)
+     */
+    mv::util::IndexSet getSelectionIndexSet() const;
+
+    /**
+     * Select by compressed index set
+     * @param indexSet Selection index set (global indices)
+     */
+    void setSelectionIndexSet(const mv::util::IndexSet& indexSet);
+
     /** Determines whether items can be selected */
     bool canSelect() const override;
 
@@ -1084,11 +1831,50 @@ public:
 
     std::vector<std::uint32_t> indices;
 
+private:
+
+    /** Identifies the state of the indices of a subset in the chain of a global index map */
+    struct IndicesState
+    {
+        const Points*               points;             /** Subset */
+        std::uint64_t               indicesRevision;    /** Revision of its indices (see indicesChanged()) */
+        const std::uint32_t*        indicesData;        /** Storage of its indices, in case they were replaced without notice */
+        std::size_t                 numberOfIndices;    /** Number of indices */
+        std::uint64_t               indicesHash;        /** Content hash of its indices, in case they were rewritten in place without notice */
+
+        bool operator==(const IndicesState& other) const {
+            return points == other.points && indicesRevision == other.indicesRevision && indicesData == other.indicesData && numberOfIndices == other.numberOfIndices && indicesHash == other.indicesHash;
+        }
+    };
+
+    /** Get the current state of the indices of this subset */
+    IndicesState getIndicesState() const;
+
+    /** Get the maximum number of runs of \p numberOfIndices indices for which the runs are compact (see getCompactIndexRuns()) */
+    static std::size_t getMaximumNumberOfCompactIndexRuns(std::size_t numberOfIndices) {
+        return std::max<std::size_t>(1, numberOfIndices / 8);
+    }
+
+    mutable std::mutex                              _globalIndexMapMutex;           /** Guards the cached global index map */
+    mutable std::shared_ptr<const GlobalIndexMap>   _globalIndexMap;                /** Cached global index map */
+    mutable std::vector<IndicesState>               _globalIndexMapChain;           /** States of the indices of the subsets the cached map was composed of */
+    std::atomic<std::uint64_t>                      _indicesRevision = 0;           /** Incremented by indicesChanged() */
+    mutable std::mutex                              _indexRunsMutex;                /** Guards the cached index runs */
+    mutable std::shared_ptr<const IndexRuns>        _indexRuns;                     /** Cached index runs (nullptr if the indices are fragmented) */
+    mutable IndicesState                            _indexRunsState = {};           /** State of the indices the cached index runs were computed from */
+
+public:
+
     InfoAction*                 _infoAction;                    /** Non-owning pointer to info action */
     mv::gui::GroupAction*       _dimensionsPickerGroupAction;   /** Group action for dimensions picker action */
     DimensionsPickerAction*     _dimensionsPickerAction;        /** Non-owning pointer to dimensions picker action */
     mv::EventListener           _eventListener;                 /** Listen to HDPS events */
 
+private:
+    std::atomic<std::int32_t>   _publishFrameBudget = 16;               /** Minimum interval in milliseconds between two notifications of published data */
+    std::atomic<bool>           _publishNotificationPending = false;    /** Whether a notification of published data is scheduled */
+    QElapsedTimer               _publishNotificationTimer;              /** Time since the last notification of published data */
+
     friend class mv::legacy::PointsLegacySerializer;
 };
 
@@ -0,0 +1,544 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#pragma once
+
+#include <biovault_bfloat16/biovault_bfloat16.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// The instruction set is selected at run time: on x86 the SSE2, AVX2 and AVX-512 kernels are all compiled (each
+// function with its own target, independent of the flags of the translation unit, e.g. of mv_check_and_set_AVX())
+// and the best one the processor supports is used. NEON is the AArch64 baseline. Other targets use scalar code.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define MV_POINT_DATA_KERNELS_X86
+    #include <immintrin.h>
+
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define MV_POINT_DATA_KERNELS_TARGET(instructionSet)
+    #else
+        #define MV_POINT_DATA_KERNELS_TARGET(instructionSet) __attribute__((target(instructionSet)))
+    #endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #define MV_POINT_DATA_KERNELS_NEON
+    #include <arm_neon.h>
+#endif
+
+/**
+ * Vectorized kernels to convert and gather point data elements to float
+ *
+ * The point data is stored as one of the PointData::ElementTypeSpecifier types, whereas
+ * most consumers (e.g. a scatter plot) want floats. These kernels convert contiguous
+ * ranges in bulk with SIMD instructions and gather scattered elements via a small tile
+ * on the stack, so that the conversion of the gathered elements is vectorized as well.
+ *
+ * Each kernel has an overload which takes the instruction set to use, so that the
+ * kernels of all instruction sets the processor supports can be compared with the
+ * scalar ones. The other overloads use getInstructionSet().
+ */
+namespace mv::kernels
+{
+    static_assert(sizeof(biovault::bfloat16_t) == sizeof(std::uint16_t) && std::is_trivially_copyable_v<biovault::bfloat16_t>, "bfloat16 must be stored as its raw 16 bits");
+
+    /// Number of elements that are gathered on the stack before they are converted in bulk
+    constexpr std::size_t gatherTileSize = 256;
+
+    /// Instruction sets for which kernels exist
+    enum class InstructionSet
+    {
+        Scalar,     /** Plain C++, available everywhere */
+        SSE2,       /** 4 floats per instruction (x86) */
+        AVX2,       /** 8 floats per instruction (x86) */
+        AVX512,     /** 16 floats per instruction (x86, AVX-512F) */
+        NEON        /** 4 floats per instruction (AArch64) */
+    };
+
+    /**
+     * Establish whether the processor (and operating system) support \p instructionSet
+     * @param instructionSet Instruction set
+     * @return Boolean determining whether the kernels of \p instructionSet may be used
+     */
+    inline bool isSupported(InstructionSet instructionSet)
+    {
+        switch (instructionSet) {
+            case InstructionSet::Scalar:
+                return true;
+
+#if defined(MV_POINT_DATA_KERNELS_X86)
+    #if defined(_MSC_VER) && !defined(__clang__)
+            case InstructionSet::SSE2:
+            case InstructionSet::AVX2:
+            case InstructionSet::AVX512:
+            {
+                int registers[4];
+
+                __cpuid(registers, 1);
+
+                const auto hasSse2 = (registers[3] & (1 << 26)) != 0;
+
+                if (instructionSet == InstructionSet::SSE2)
+                    return hasSse2;
+
+                // The operating system has to save the (upper halves of the) vector registers on a context switch
+                const auto hasAvx           = (registers[2] & (1 << 28)) != 0;
+                const auto hasOsxsave       = (registers[2] & (1 << 27)) != 0;
+                const auto extendedState    = hasOsxsave ? _xgetbv(0) : 0;
+
+                __cpuidex(registers, 7, 0);
+
+                if (instructionSet == InstructionSet::AVX2)
+                    return hasAvx && (extendedState & 0x6) == 0x6 && (registers[1] & (1 << 5)) != 0;
+
+                return hasAvx && (extendedState & 0xe6) == 0xe6 && (registers[1] & (1 << 16)) != 0;
+            }
+    #else
+            case InstructionSet::SSE2:
+                return __builtin_cpu_supports("sse2");
+
+            case InstructionSet::AVX2:
+                return __builtin_cpu_supports("avx2");
+
+            case InstructionSet::AVX512:
+                return __builtin_cpu_supports("avx512f");
+    #endif
+#elif defined(MV_POINT_DATA_KERNELS_NEON)
+            case InstructionSet::NEON:
+                return true;
+#endif
+
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Get the widest instruction set the processor supports, which the kernels use by default
+     * @return Instruction set (detected once)
+     */
+    inline InstructionSet getInstructionSet()
+    {
+        static const auto instructionSet = []() -> InstructionSet {
+            for (const auto instructionSet : { InstructionSet::AVX512, InstructionSet::AVX2, InstructionSet::SSE2, InstructionSet::NEON })
+                if (isSupported(instructionSet))
+                    return instructionSet;
+
+            return InstructionSet::Scalar;
+        }();
+
+        return instructionSet;
+    }
+
+    namespace detail
+    {
+        namespace scalar
+        {
+            template <typename T>
+            void convertToFloat(const T* source, float* destination, std::size_t count)
+            {
+                for (std::size_t index = 0; index < count; ++index)
+                    destination[index] = static_cast<float>(source[index]);
+            }
+
+            inline void interleave(const float* x, const float* y, float* destination, std::size_t count)
+            {
+                for (std::size_t index = 0; index < count; ++index) {
+                    destination[2 * index]      = x[index];
+                    destination[2 * index + 1]  = y[index];
+                }
+            }
+        }
+
+#if defined(MV_POINT_DATA_KERNELS_X86)
+        namespace sse2
+        {
+            constexpr std::size_t width = 4;
+
+            /// There is no unsigned 32-bit integer conversion before AVX-512
+            template <typename T>
+            constexpr bool hasVectorLoad = !std::is_same_v<T, std::uint32_t>;
+
+            MV_POINT_DATA_KERNELS_TARGET("sse2") inline __m128 load(const float* source) { return _mm_loadu_ps(source); }
+
+            MV_POINT_DATA_KERNELS_TARGET("sse2") inline __m128 load(const biovault::bfloat16_t* source)
+            {
+                // Interleaving with zeros moves each bfloat16 into the upper half of a float
+                const auto words = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source));
+                return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), words));
+            }
+
+            MV_POINT_DATA_KERNELS_TARGET("sse2") inline __m128 load(const std::int32_t* source) { return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source))); }
+
+            MV_POINT_DATA_KERNELS_TARGET("sse2") inline __m128 load(const std::int16_t* source)
+            {
+                const auto words = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source));
+                return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16));
+            }
+
+            MV_POINT_DATA_KERNELS_TARGET("sse2") inline __m128 load(const std::uint16_t* source)
+            {
+                const auto words = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source));
+                return _mm_cvtepi32_ps(_mm_unpacklo_epi16(words, _mm_setzero_si128()));
+            }
+
+            MV_POINT_DATA_KERNELS_TARGET("sse2") inline __m128 load(const std::int8_t* source)
+            {
+                std::int32_t packed;
+                std::memcpy(&packed, source, sizeof(packed));
+
+                const auto bytes = _mm_cvtsi32_si128(packed);
+                const auto words = _mm_unpacklo_epi8(bytes, bytes);
+
+                return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(words, words), 24));
+            }
+
+            MV_POINT_DATA_KERNELS_TARGET("sse2") inline __m128 load(const std::uint8_t* source)
+            {
+                std::int32_t packed;
+                std::memcpy(&packed, source, sizeof(packed));
+
+                const auto zero = _mm_setzero_si128();
+                return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero));
+            }
+
+            template <typename T>
+            MV_POINT_DATA_KERNELS_TARGET("sse2") void convertToFloat(const T* source, float* destination, std::size_t count)
+            {
+                std::size_t index = 0;
+
+                if constexpr (hasVectorLoad<T>) {
+                    for (; index + width <= count; index += width)
+                        _mm_storeu_ps(destination + index, load(source + index));
+                }
+
+                for (; index < count; ++index)
+                    destination[index] = static_cast<float>(source[index]);
+            }
+
+            MV_POINT_DATA_KERNELS_TARGET("sse2") inline void interleave(const float* x, const float* y, float* destination, std::size_t count)
+            {
+                std::size_t index = 0;
+
+                for (; index + width <= count; index += width) {
+                    const auto xs = _mm_loadu_ps(x + index);
+                    const auto ys = _mm_loadu_ps(y + index);
+
+                    _mm_storeu_ps(destination + 2 * index, _mm_unpacklo_ps(xs, ys));
+                    _mm_storeu_ps(destination + 2 * index + 4, _mm_unpackhi_ps(xs, ys));
+                }
+
+                scalar::interleave(x + index, y + index, destination + 2 * index, count - index);
+            }
+        }
+
+        namespace avx2
+        {
+            constexpr std::size_t width = 8;
+
+            template <typename T>
+            constexpr bool hasVectorLoad = !std::is_same_v<T, std::uint32_t>;
+
+            MV_POINT_DATA_KERNELS_TARGET("avx2") inline __m256 load(const float* source) { return _mm256_loadu_ps(source); }
+
+            MV_POINT_DATA_KERNELS_TARGET("avx2") inline __m256 load(const biovault::bfloat16_t* source)
+            {
+                // A bfloat16 holds the upper 16 bits of a float
+                const auto words = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+                return _mm256_castsi256_ps(_mm256_slli_epi32(words, 16));
+            }
+
+            MV_POINT_DATA_KERNELS_TARGET("avx2") inline __m256 load(const std::int32_t* source) { return _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source))); }
+            MV_POINT_DATA_KERNELS_TARGET("avx2") inline __m256 load(const std::int16_t* source) { return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)))); }
+            MV_POINT_DATA_KERNELS_TARGET("avx2") inline __m256 load(const std::uint16_t* source) { return _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)))); }
+            MV_POINT_DATA_KERNELS_TARGET("avx2") inline __m256 load(const std::int8_t* source) { return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source)))); }
+            MV_POINT_DATA_KERNELS_TARGET("avx2") inline __m256 load(const std::uint8_t* source) { return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source)))); }
+
+            template <typename T>
+            MV_POINT_DATA_KERNELS_TARGET("avx2") void convertToFloat(const T* source, float* destination, std::size_t count)
+            {
+                std::size_t index = 0;
+
+                if constexpr (hasVectorLoad<T>) {
+                    for (; index + width <= count; index += width)
+                        _mm256_storeu_ps(destination + index, load(source + index));
+                }
+
+                for (; index < count; ++index)
+                    destination[index] = static_cast<float>(source[index]);
+            }
+        }
+
+// The AVX-512 intrinsics of GCC 12 start from undefined registers, which -Wmaybe-uninitialized reports
+#if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+        namespace avx512
+        {
+            constexpr std::size_t width = 16;
+
+            template <typename T>
+            constexpr bool hasVectorLoad = true;
+
+            MV_POINT_DATA_KERNELS_TARGET("avx512f") inline __m512 load(const float* source) { return _mm512_loadu_ps(source); }
+
+            MV_POINT_DATA_KERNELS_TARGET("avx512f") inline __m512 load(const biovault::bfloat16_t* source)
+            {
+                // A bfloat16 holds the upper 16 bits of a float
+                const auto words = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)));
+                return _mm512_castsi512_ps(_mm512_slli_epi32(words, 16));
+            }
+
+            MV_POINT_DATA_KERNELS_TARGET("avx512f") inline __m512 load(const std::int32_t* source) { return _mm512_cvtepi32_ps(_mm512_loadu_si512(source)); }
+            MV_POINT_DATA_KERNELS_TARGET("avx512f") inline __m512 load(const std::uint32_t* source) { return _mm512_cvtepu32_ps(_mm512_loadu_si512(source)); }
+            MV_POINT_DATA_KERNELS_TARGET("avx512f") inline __m512 load(const std::int16_t* source) { return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)))); }
+            MV_POINT_DATA_KERNELS_TARGET("avx512f") inline __m512 load(const std::uint16_t* source) { return _mm512_cvtepi32_ps(_mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)))); }
+            MV_POINT_DATA_KERNELS_TARGET("avx512f") inline __m512 load(const std::int8_t* source) { return _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)))); }
+            MV_POINT_DATA_KERNELS_TARGET("avx512f") inline __m512 load(const std::uint8_t* source) { return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)))); }
+
+            template <typename T>
+            MV_POINT_DATA_KERNELS_TARGET("avx512f") void convertToFloat(const T* source, float* destination, std::size_t count)
+            {
+                std::size_t index = 0;
+
+                if constexpr (hasVectorLoad<T>) {
+                    for (; index + width <= count; index += width)
+                        _mm512_storeu_ps(destination + index, load(source + index));
+                }
+
+                // The tail is converted by the narrower kernels
+                avx2::convertToFloat(source + index, destination + index, count - index);
+            }
+        }
+#if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic pop
+#endif
+#elif defined(MV_POINT_DATA_KERNELS_NEON)
+        namespace neon
+        {
+            constexpr std::size_t width = 4;
+
+            inline float32x4_t load(const float* source) { return vld1q_f32(source); }
+
+            inline float32x4_t load(const biovault::bfloat16_t* source)
+            {
+                // A bfloat16 holds the upper 16 bits of a float
+                return vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(reinterpret_cast<const std::uint16_t*>(source)), 16));
+            }
+
+            inline float32x4_t load(const std::int32_t* source) { return vcvtq_f32_s32(vld1q_s32(source)); }
+            inline float32x4_t load(const std::uint32_t* source) { return vcvtq_f32_u32(vld1q_u32(source)); }
+            inline float32x4_t load(const std::int16_t* source) { return vcvtq_f32_s32(vmovl_s16(vld1_s16(source))); }
+            inline float32x4_t load(const std::uint16_t* source) { return vcvtq_f32_u32(vmovl_u16(vld1_u16(source))); }
+
+            inline float32x4_t load(const std::int8_t* source)
+            {
+                std::int32_t packed;
+                std::memcpy(&packed, source, sizeof(packed));
+
+                return vcvtq_f32_s32(vmovl_s16(vget_low_s16(vmovl_s8(vreinterpret_s8_s32(vdup_n_s32(packed))))));
+            }
+
+            inline float32x4_t load(const std::uint8_t* source)
+            {
+                std::uint32_t packed;
+                std::memcpy(&packed, source, sizeof(packed));
+
+                return vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(packed))))));
+            }
+
+            template <typename T>
+            void convertToFloat(const T* source, float* destination, std::size_t count)
+            {
+                std::size_t index = 0;
+
+                for (; index + width <= count; index += width)
+                    vst1q_f32(destination + index, load(source + index));
+
+                for (; index < count; ++index)
+                    destination[index] = static_cast<float>(source[index]);
+            }
+
+            inline void interleave(const float* x, const float* y, float* destination, std::size_t count)
+            {
+                std::size_t index = 0;
+
+                for (; index + width <= count; index += width)
+                    vst2q_f32(destination + 2 * index, float32x4x2_t{ { vld1q_f32(x + index), vld1q_f32(y + index) } });
+
+                scalar::interleave(x + index, y + index, destination + 2 * index, count - index);
+            }
+        }
+#endif
+    }
+
+    /**
+     * Convert \p count contiguous elements of \p source to float
+     * @param instructionSet Instruction set of the kernel (must be supported, see isSupported())
+     * @param source Pointer to the first element
+     * @param destination Output buffer of at least \p count floats
+     * @param count Number of elements
+     */
+    template <typename T>
+    void convertToFloat(InstructionSet instructionSet, const T* source, float* destination, std::size_t count)
+    {
+        if constexpr (std::is_same_v<T, float>) {
+            std::memcpy(destination, source, count * sizeof(float));
+            return;
+        }
+
+        switch (instructionSet) {
+#if defined(MV_POINT_DATA_KERNELS_X86)
+            case InstructionSet::SSE2:
+                return detail::sse2::convertToFloat(source, destination, count);
+
+            case InstructionSet::AVX2:
+                return detail::avx2::convertToFloat(source, destination, count);
+
+            case InstructionSet::AVX512:
+                return detail::avx512::convertToFloat(source, destination, count);
+#elif defined(MV_POINT_DATA_KERNELS_NEON)
+            case InstructionSet::NEON:
+                return detail::neon::convertToFloat(source, destination, count);
+#endif
+
+            default:
+                return detail::scalar::convertToFloat(source, destination, count);
+        }
+    }
+
+    /**
+     * Convert \p count contiguous elements of \p source to float, with the kernel of getInstructionSet()
+     * @param source Pointer to the first element
+     * @param destination Output buffer of at least \p count floats
+     * @param count Number of elements
+     */
+    template <typename T>
+    void convertToFloat(const T* source, float* destination, std::size_t count)
+    {
+        convertToFloat(getInstructionSet(), source, destination, count);
+    }
+
+    /**
+     * Gather \p count elements from \p source and convert them to float: destination[i] = source[indices[i] * stride + offset]
+     * The elements are gathered into a tile on the stack, which is then converted in bulk
+     * @param instructionSet Instruction set of the conversion kernel (must be supported, see isSupported())
+     * @param source Pointer to the first element of the data
+     * @param stride Distance (in elements) between consecutive points, e.g. the number of dimensions for row-major data
+     * @param offset Offset (in elements) of the requested value within a point, e.g. the dimension index for row-major data
+     * @param indices Point indices, or nullptr to gather points [0, count)
+     * @param destination Output buffer of at least \p count floats
+     * @param count Number of elements
+     */
+    template <typename T>
+    void gatherToFloat(InstructionSet instructionSet, const T* source, std::uint64_t stride, std::uint64_t offset, const std::uint32_t* indices, float* destination, std::size_t count)
+    {
+        if (stride == 1 && indices == nullptr) {
+            convertToFloat(instructionSet, source + offset, destination, count);
+            return;
+        }
+
+        if constexpr (std::is_same_v<T, float>) {
+            for (std::size_t index = 0; index < count; ++index)
+                destination[index] = source[(indices ? std::uint64_t{ indices[index] } : index) * stride + offset];
+        }
+        else {
+            T tile[gatherTileSize];
+
+            for (std::size_t tileBegin = 0; tileBegin < count; tileBegin += gatherTileSize) {
+                const auto tileCount = std::min(gatherTileSize, count - tileBegin);
+
+                if (indices) {
+                    for (std::size_t index = 0; index < tileCount; ++index)
+                        tile[index] = source[std::uint64_t{ indices[tileBegin + index] } * stride + offset];
+                }
+                else {
+                    for (std::size_t index = 0; index < tileCount; ++index)
+                        tile[index] = source[(tileBegin + index) * stride + offset];
+                }
+
+                convertToFloat(instructionSet, tile, destination + tileBegin, tileCount);
+            }
+        }
+    }
+
+    /** Gather \p count elements from \p source and convert them to float with the kernel of getInstructionSet() (see above) */
+    template <typename T>
+    void gatherToFloat(const T* source, std::uint64_t stride, std::uint64_t offset, const std::uint32_t* indices, float* destination, std::size_t count)
+    {
+        gatherToFloat(getInstructionSet(), source, stride, offset, indices, destination, count);
+    }
+
+    /**
+     * Interleave \p count values of \p x and \p y into \p destination (x0, y0, x1, y1, ...), e.g. to fill a vector of mv::Vector2f
+     * @param instructionSet Instruction set of the kernel (must be supported, see isSupported())
+     * @param x First components
+     * @param y Second components
+     * @param destination Output buffer of at least 2 * \p count floats
+     * @param count Number of pairs
+     */
+    inline void interleave(InstructionSet instructionSet, const float* x, const float* y, float* destination, std::size_t count)
+    {
+        switch (instructionSet) {
+#if defined(MV_POINT_DATA_KERNELS_X86)
+            // Interleaving is bound by memory bandwidth, wider vectors do not pay off
+            case InstructionSet::SSE2:
+            case InstructionSet::AVX2:
+            case InstructionSet::AVX512:
+                return detail::sse2::interleave(x, y, destination, count);
+#elif defined(MV_POINT_DATA_KERNELS_NEON)
+            case InstructionSet::NEON:
+                return detail::neon::interleave(x, y, destination, count);
+#endif
+
+            default:
+                return detail::scalar::interleave(x, y, destination, count);
+        }
+    }
+
+    /** Interleave \p count values of \p x and \p y into \p destination with the kernel of getInstructionSet() (see above) */
+    inline void interleave(const float* x, const float* y, float* destination, std::size_t count)
+    {
+        interleave(getInstructionSet(), x, y, destination, count);
+    }
+
+    /**
+     * Gather two values per point and interleave them as pairs of floats (see gatherToFloat() for the parameters)
+     * @param instructionSet Instruction set of the kernels (must be supported, see isSupported())
+     * @param source Pointer to the first element of the data
+     * @param stride Distance (in elements) between consecutive points
+     * @param offsetX Offset (in elements) of the first value within a point
+     * @param offsetY Offset (in elements) of the second value within a point
+     * @param indices Point indices, or nullptr to gather points [0, count)
+     * @param destination Output buffer of at least 2 * \p count floats
+     * @param count Number of points
+     */
+    template <typename T>
+    void gatherPairsToFloat(InstructionSet instructionSet, const T* source, std::uint64_t stride, std::uint64_t offsetX, std::uint64_t offsetY, const std::uint32_t* indices, float* destination, std::size_t count)
+    {
+        float x[gatherTileSize], y[gatherTileSize];
+
+        for (std::size_t tileBegin = 0; tileBegin < count; tileBegin += gatherTileSize) {
+            const auto tileCount    = std::min(gatherTileSize, count - tileBegin);
+            const auto tileIndices  = indices ? indices + tileBegin : nullptr;
+            const auto tileSource   = indices ? source : source + tileBegin * stride;
+
+            gatherToFloat(instructionSet, tileSource, stride, offsetX, tileIndices, x, tileCount);
+            gatherToFloat(instructionSet, tileSource, stride, offsetY, tileIndices, y, tileCount);
+
+            interleave(instructionSet, x, y, destination + 2 * tileBegin, tileCount);
+        }
+    }
+
+    /** Gather two values per point and interleave them as pairs of floats with the kernels of getInstructionSet() (see above) */
+    template <typename T>
+    void gatherPairsToFloat(const T* source, std::uint64_t stride, std::uint64_t offsetX, std::uint64_t offsetY, const std::uint32_t* indices, float* destination, std::size_t count)
+    {
+        gatherPairsToFloat(getInstructionSet(), source, stride, offsetX, offsetY, indices, destination, count);
+    }
+}
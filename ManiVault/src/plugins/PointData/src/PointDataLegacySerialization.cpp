@@ -106,6 +106,8 @@ void PointsLegacySerializer::fromVariantMapPre150(Points& points, const QVariant
         points.indices.resize(indicesMap["Count"].toUInt());
 
         populateBytesFromBlobMap(indicesMap["Raw"].toMap(), (char*)points.indices.data(), points.indices.size() * sizeof(decltype(points.indices)::value_type));
+
+        points.indicesChanged();
     }
 
     // Load dimension names
@@ -39,6 +39,30 @@ namespace mv
     }
 
 
+    /* Makes a PointDataRange object for a subset of the values specified by the
+    * first parameter, consisting of the consecutive points [beginIndex, endIndex).
+    * It is equivalent to makePointDataRangeOfSubset for the indices beginIndex,
+    * ..., endIndex - 1, but does not need those indices to be stored. The index
+    * function receives the point index itself.
+    */
+    template <typename ValueIteratorType, typename IndexFunctionType>
+    auto makePointDataRangeOfIndexRange(
+        const ValueIteratorType beginOfValueContainer,
+        const std::uint64_t beginIndex,
+        const std::uint64_t endIndex,
+        const std::uint64_t numberOfDimensions,
+        const IndexFunctionType indexFunction)
+    {
+        using PointDataIteratorType = PointDataIterator<ValueIteratorType, std::uint64_t, IndexFunctionType>;
+
+        return PointDataRange<ValueIteratorType, uint64_t, IndexFunctionType>
+        {
+            PointDataIteratorType(beginOfValueContainer, beginIndex, numberOfDimensions, indexFunction),
+                PointDataIteratorType(beginOfValueContainer, endIndex, numberOfDimensions, indexFunction)
+        };
+    }
+
+
     /* Makes a PointDataRange object for a full set of values.
     */
     template <typename ValueIteratorType, typename IndexFunctionType>
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "RecursiveSharedMutex.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace
+{
+
+/** Shared ownership of a mutex by the current thread */
+struct SharedOwnership
+{
+    const RecursiveSharedMutex*     mutex;      /**< Mutex which is held */
+    std::uint32_t                   depth;      /**< Number of nested shared locks */
+    bool                            acquired;   /**< Whether the underlying mutex was locked (false if nested in an exclusive lock) */
+    bool                            upgraded;   /**< Whether the shared lock was released for an exclusive lock, and is restored after it */
+};
+
+/** Mutexes which the current thread holds shared ownership of (usually very few, so a linear search is fastest) */
+thread_local std::vector<SharedOwnership> sharedOwnerships;
+
+/**
+ * Find the shared ownership of \p mutex by the current thread
+ * @param mutex Mutex
+ * @return Iterator to the shared ownership, or the end iterator if the current thread does not hold \p mutex shared
+ */
+auto findSharedOwnership(const RecursiveSharedMutex* mutex)
+{
+    return std::find_if(sharedOwnerships.begin(), sharedOwnerships.end(), [mutex](const SharedOwnership& sharedOwnership) {
+        return sharedOwnership.mutex == mutex;
+    });
+}
+
+}
+
+void RecursiveSharedMutex::lock()
+{
+    const auto currentThread = std::this_thread::get_id();
+
+    if (_exclusiveOwner.load(std::memory_order_relaxed) == currentThread) {
+        ++_exclusiveDepth;
+        return;
+    }
+
+    // Upgrade: release the shared lock first, as two readers which both wait for exclusive ownership would deadlock
+    if (const auto sharedOwnership = findSharedOwnership(this); sharedOwnership != sharedOwnerships.end() && sharedOwnership->acquired) {
+        _mutex.unlock_shared();
+
+        sharedOwnership->acquired = false;
+        sharedOwnership->upgraded = true;
+    }
+
+    _mutex.lock();
+
+    _exclusiveOwner.store(currentThread, std::memory_order_relaxed);
+    _exclusiveDepth = 1;
+}
+
+void RecursiveSharedMutex::unlock()
+{
+    assert(_exclusiveOwner.load(std::memory_order_relaxed) == std::this_thread::get_id());
+
+    if (--_exclusiveDepth > 0)
+        return;
+
+    const auto sharedOwnership = findSharedOwnership(this);
+
+    // Shared locks which are nested in the exclusive lock must be released first
+    assert(sharedOwnership == sharedOwnerships.end() || sharedOwnership->upgraded);
+
+    _exclusiveOwner.store(std::thread::id(), std::memory_order_relaxed);
+    _mutex.unlock();
+
+    // Restore the shared lock from before the upgrade
+    if (sharedOwnership != sharedOwnerships.end()) {
+        _mutex.lock_shared();
+
+        sharedOwnership->acquired = true;
+        sharedOwnership->upgraded = false;
+    }
+}
+
+void RecursiveSharedMutex::lock_shared()
+{
+    if (const auto sharedOwnership = findSharedOwnership(this); sharedOwnership != sharedOwnerships.end()) {
+        ++sharedOwnership->depth;
+        return;
+    }
+
+    // The exclusive lock of the current thread already covers reading
+    const auto ownsExclusively = _exclusiveOwner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+
+    if (!ownsExclusively)
+        _mutex.lock_shared();
+
+    sharedOwnerships.push_back({ this, 1, !ownsExclusively, false });
+}
+
+void RecursiveSharedMutex::unlock_shared()
+{
+    const auto sharedOwnership = findSharedOwnership(this);
+
+    assert(sharedOwnership != sharedOwnerships.end());
+
+    if (--sharedOwnership->depth > 0)
+        return;
+
+    const auto acquired = sharedOwnership->acquired;
+
+    sharedOwnerships.erase(sharedOwnership);
+
+    if (acquired)
+        _mutex.unlock_shared();
+}
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#pragma once
+
+#include "pointdata_export.h"
+
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+#include <thread>
+
+/**
+ * Reader/writer mutex which may be re-locked by the thread that holds it
+ *
+ * Any number of threads may hold shared (reader) ownership at the same time, whereas
+ * exclusive (writer) ownership excludes all other threads. A thread may nest:
+ *  - exclusive locks (like a std::recursive_mutex)
+ *  - shared locks, without ever blocking on a waiting writer
+ *  - shared locks inside an exclusive lock (which it already covers)
+ *
+ * A thread that holds shared ownership may upgrade to exclusive ownership by locking
+ * the mutex exclusively. The shared ownership is released while the thread waits for
+ * the exclusive ownership (so two upgrading readers do not wait on each other), and
+ * it is restored when the outermost exclusive lock is released. Other writers may thus
+ * modify the guarded data while the thread upgrades: what it read before is stale.
+ *
+ * Meets the Lockable and SharedLockable requirements, so it can be used with
+ * std::unique_lock and std::shared_lock.
+ */
+class POINTDATA_EXPORT RecursiveSharedMutex
+{
+public:
+
+    RecursiveSharedMutex() = default;
+
+    RecursiveSharedMutex(const RecursiveSharedMutex&) = delete;
+    RecursiveSharedMutex& operator=(const RecursiveSharedMutex&) = delete;
+
+    /**
+     * Acquire exclusive ownership, blocks until no other thread holds the mutex
+     * Upgrades the shared ownership of the calling thread, if it holds it (see above)
+     */
+    void lock();
+
+    /** Release (one level of) exclusive ownership, and restore the shared ownership from before an upgrade */
+    void unlock();
+
+    /** Acquire shared ownership, blocks only while another thread holds exclusive ownership */
+    void lock_shared();
+
+    /** Release (one level of) shared ownership */
+    void unlock_shared();
+
+private:
+    std::shared_mutex               _mutex;                 /**< Underlying (non-recursive) reader/writer mutex */
+    std::atomic<std::thread::id>    _exclusiveOwner;        /**< Thread which holds exclusive ownership (if any) */
+    std::uint32_t                   _exclusiveDepth = 0;    /**< Number of nested exclusive locks of the owner */
+};
@@ -125,6 +125,8 @@ std::vector<std::uint32_t>& Text::getSelectionIndices()
 void Text::setSelectionIndices(const std::vector<std::uint32_t>& indices)
 {
     getSelection<Text>()->indices = indices;
+
+    markSelectionChanged();
 }
 
 bool Text::canSelect() const
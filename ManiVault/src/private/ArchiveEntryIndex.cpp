@@ -0,0 +1,317 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "ArchiveEntryIndex.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtEndian>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _DEBUG
+    //#define ARCHIVE_ENTRY_INDEX_VERBOSE
+#endif
+
+namespace mv::util {
+
+namespace
+{
+
+constexpr quint32 localFileHeaderSignature      = 0x04034b50;
+constexpr quint32 centralFileHeaderSignature    = 0x02014b50;
+constexpr quint32 endOfCentralDirSignature      = 0x06054b50;
+constexpr quint32 zip64EndOfCentralDirSignature = 0x06064b50;
+constexpr quint32 zip64LocatorSignature         = 0x07064b50;
+
+constexpr qint64 localFileHeaderSize            = 30;
+constexpr qint64 centralFileHeaderSize          = 46;
+constexpr qint64 endOfCentralDirSize            = 22;
+constexpr qint64 zip64LocatorSize               = 20;
+constexpr qint64 zip64EndOfCentralDirSize       = 56;
+constexpr qint64 maximumCommentSize             = 0xFFFF;
+
+template<typename T>
+T readLittleEndian(const char* data)
+{
+    return qFromLittleEndian<T>(reinterpret_cast<const uchar*>(data));
+}
+
+QByteArray readAt(QFile& file, qint64 offset, qint64 size)
+{
+    if (!file.seek(offset))
+        throw std::runtime_error(QString("Unable to seek to offset %1 in %2").arg(offset).arg(file.fileName()).toStdString());
+
+    auto data = file.read(size);
+
+    if (data.size() != size)
+        throw std::runtime_error(QString("Unable to read %1 bytes at offset %2 from %3").arg(size).arg(offset).arg(file.fileName()).toStdString());
+
+    return data;
+}
+
+/**
+ * Get the absolute offset of the data of \p entry in the archive by reading its local file header
+ * @param file Opened archive file
+ * @param entry Archive entry
+ * @return Offset of the entry data in the archive
+ */
+std::uint64_t getDataOffset(QFile& file, const ArchiveEntryIndex::Entry& entry)
+{
+    const auto localHeader = readAt(file, static_cast<qint64>(entry._localHeaderOffset), localFileHeaderSize);
+
+    if (readLittleEndian<quint32>(localHeader.constData()) != localFileHeaderSignature)
+        throw std::runtime_error(QString("Invalid ZIP local file header: %1").arg(entry._name).toStdString());
+
+    const auto nameLength   = readLittleEndian<quint16>(localHeader.constData() + 26);
+    const auto extraLength  = readLittleEndian<quint16>(localHeader.constData() + 28);
+
+    return entry._localHeaderOffset + localFileHeaderSize + nameLength + extraLength;
+}
+
+QMutex indexCacheMutex;
+QHash<QString, std::shared_ptr<const ArchiveEntryIndex>> indexCache;
+
+}
+
+ArchiveEntryIndex::ArchiveEntryIndex(const QString& filePath) :
+    _filePath(filePath),
+    _fileSize(0)
+{
+    const QFileInfo fileInfo(filePath);
+
+    _fileSize       = fileInfo.size();
+    _lastModified   = fileInfo.lastModified();
+
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+        throw std::runtime_error(QString("Unable to open ZIP archive: %1").arg(filePath).toStdString());
+
+    if (_fileSize < endOfCentralDirSize)
+        throw std::runtime_error(QString("File is too small to be a ZIP archive: %1").arg(filePath).toStdString());
+
+    // Locate the end of central directory record by scanning backwards (it is followed by an optional comment)
+    const auto tailSize = std::min<qint64>(_fileSize, endOfCentralDirSize + maximumCommentSize);
+    const auto tailOffset = _fileSize - tailSize;
+    const auto tail = readAt(file, tailOffset, tailSize);
+
+    qint64 endOfCentralDirOffset = -1;
+
+    for (auto position = tailSize - endOfCentralDirSize; position >= 0; --position) {
+        if (readLittleEndian<quint32>(tail.constData() + position) == endOfCentralDirSignature) {
+            endOfCentralDirOffset = position;
+            break;
+        }
+    }
+
+    if (endOfCentralDirOffset < 0)
+        throw std::runtime_error(QString("Unable to locate ZIP central directory: %1").arg(filePath).toStdString());
+
+    const auto* endOfCentralDir = tail.constData() + endOfCentralDirOffset;
+
+    std::uint64_t numberOfEntries       = readLittleEndian<quint16>(endOfCentralDir + 10);
+    std::uint64_t centralDirSize        = readLittleEndian<quint32>(endOfCentralDir + 12);
+    std::uint64_t centralDirOffset      = readLittleEndian<quint32>(endOfCentralDir + 16);
+
+    // ZIP64 archives store the actual values in the ZIP64 end of central directory record
+    const auto absoluteEndOfCentralDirOffset = tailOffset + endOfCentralDirOffset;
+
+    if (absoluteEndOfCentralDirOffset >= zip64LocatorSize) {
+        const auto locator = readAt(file, absoluteEndOfCentralDirOffset - zip64LocatorSize, zip64LocatorSize);
+
+        if (readLittleEndian<quint32>(locator.constData()) == zip64LocatorSignature) {
+            const auto zip64EndOfCentralDirOffset = static_cast<qint64>(readLittleEndian<quint64>(locator.constData() + 8));
+            const auto zip64EndOfCentralDir = readAt(file, zip64EndOfCentralDirOffset, zip64EndOfCentralDirSize);
+
+            if (readLittleEndian<quint32>(zip64EndOfCentralDir.constData()) != zip64EndOfCentralDirSignature)
+                throw std::runtime_error(QString("Invalid ZIP64 end of central directory record: %1").arg(filePath).toStdString());
+
+            numberOfEntries     = readLittleEndian<quint64>(zip64EndOfCentralDir.constData() + 32);
+            centralDirSize      = readLittleEndian<quint64>(zip64EndOfCentralDir.constData() + 40);
+            centralDirOffset    = readLittleEndian<quint64>(zip64EndOfCentralDir.constData() + 48);
+        }
+    }
+
+    if (centralDirOffset + centralDirSize > static_cast<std::uint64_t>(_fileSize))
+        throw std::runtime_error(QString("ZIP central directory exceeds the archive size: %1").arg(filePath).toStdString());
+
+    const auto centralDir = readAt(file, static_cast<qint64>(centralDirOffset), static_cast<qint64>(centralDirSize));
+
+    _entries.reserve(static_cast<qsizetype>(numberOfEntries));
+
+    qint64 position = 0;
+
+    for (std::uint64_t entryIndex = 0; entryIndex < numberOfEntries; ++entryIndex) {
+        if (position + centralFileHeaderSize > centralDir.size())
+            throw std::runtime_error(QString("Truncated ZIP central directory: %1").arg(filePath).toStdString());
+
+        const auto* header = centralDir.constData() + position;
+
+        if (readLittleEndian<quint32>(header) != centralFileHeaderSignature)
+            throw std::runtime_error(QString("Invalid ZIP central directory file header: %1").arg(filePath).toStdString());
+
+        Entry entry;
+
+        entry._flags                = readLittleEndian<quint16>(header + 8);
+        entry._method               = readLittleEndian<quint16>(header + 10);
+        entry._compressedSize       = readLittleEndian<quint32>(header + 20);
+        entry._uncompressedSize     = readLittleEndian<quint32>(header + 24);
+        entry._localHeaderOffset    = readLittleEndian<quint32>(header + 42);
+
+        const auto nameLength       = readLittleEndian<quint16>(header + 28);
+        const auto extraLength      = readLittleEndian<quint16>(header + 30);
+        const auto commentLength    = readLittleEndian<quint16>(header + 32);
+
+        if (position + centralFileHeaderSize + nameLength + extraLength + commentLength > centralDir.size())
+            throw std::runtime_error(QString("Truncated ZIP central directory: %1").arg(filePath).toStdString());
+
+        const auto* name = header + centralFileHeaderSize;
+
+        // Bit 11 flags UTF-8 encoded names
+        entry._name = (entry._flags & (1 << 11)) ? QString::fromUtf8(name, nameLength) : QString::fromLatin1(name, nameLength);
+
+        // The ZIP64 extended information extra field only contains the values that overflowed
+        const auto* extra = name + nameLength;
+
+        for (qint64 extraPosition = 0; extraPosition + 4 <= extraLength;) {
+            const auto headerId     = readLittleEndian<quint16>(extra + extraPosition);
+            const auto dataSize     = readLittleEndian<quint16>(extra + extraPosition + 2);
+            const auto* data        = extra + extraPosition + 4;
+            const auto* dataEnd     = data + std::min<qint64>(dataSize, extraLength - extraPosition - 4);
+
+            if (headerId == 0x0001) {
+                const auto readZip64Value = [&data, dataEnd](std::uint64_t& value) -> void {
+                    if (value != 0xFFFFFFFFu || data + 8 > dataEnd)
+                        return;
+
+                    value = readLittleEndian<quint64>(data);
+                    data += 8;
+                };
+
+                readZip64Value(entry._uncompressedSize);
+                readZip64Value(entry._compressedSize);
+                readZip64Value(entry._localHeaderOffset);
+            }
+
+            extraPosition += 4 + dataSize;
+        }
+
+        _entries.insert(entry._name, entry);
+
+        position += centralFileHeaderSize + nameLength + extraLength + commentLength;
+    }
+
+#ifdef ARCHIVE_ENTRY_INDEX_VERBOSE
+    qDebug() << __FUNCTION__ << filePath << _entries.size() << "entries";
+#endif
+}
+
+QString ArchiveEntryIndex::getFilePath() const
+{
+    return _filePath;
+}
+
+bool ArchiveEntryIndex::isUpToDate() const
+{
+    const QFileInfo fileInfo(_filePath);
+
+    return fileInfo.exists() && fileInfo.size() == _fileSize && fileInfo.lastModified() == _lastModified;
+}
+
+const ArchiveEntryIndex::Entry* ArchiveEntryIndex::findEntry(const QString& entryName) const
+{
+    const auto it = _entries.constFind(entryName);
+
+    return it == _entries.constEnd() ? nullptr : &it.value();
+}
+
+QByteArray ArchiveEntryIndex::readStoredEntry(const QString& entryName) const
+{
+    const auto entry = findEntry(entryName);
+
+    if (!entry)
+        throw std::runtime_error(QString("Unable to locate ZIP entry: %1").arg(entryName).toStdString());
+
+    if (entry->_compressedSize > static_cast<std::uint64_t>(std::numeric_limits<qsizetype>::max()))
+        throw std::runtime_error(QString("ZIP entry is too large to read into memory: %1").arg(entryName).toStdString());
+
+    QByteArray data;
+
+    data.resize(static_cast<qsizetype>(entry->_compressedSize));
+
+    readStoredEntryTo(entryName, data.data(), static_cast<std::uint64_t>(data.size()));
+
+    return data;
+}
+
+void ArchiveEntryIndex::readStoredEntryTo(const QString& entryName, char* destination, std::uint64_t destinationSize) const
+{
+    const auto entry = findEntry(entryName);
+
+    if (!entry)
+        throw std::runtime_error(QString("Unable to locate ZIP entry: %1").arg(entryName).toStdString());
+
+    if (!entry->isStored())
+        throw std::runtime_error(QString("ZIP entry is not stored uncompressed: %1").arg(entryName).toStdString());
+
+    if (entry->_compressedSize != destinationSize)
+        throw std::runtime_error(QString("ZIP entry size (%1) does not match the destination size (%2): %3").arg(entry->_compressedSize).arg(destinationSize).arg(entryName).toStdString());
+
+    if (destinationSize == 0)
+        return;
+
+    if (!destination)
+        throw std::runtime_error("Destination buffer is null");
+
+    // Each read uses its own file handle so that entries can be read concurrently (and the
+    // archive is not held open in between, so it can be replaced when the project is saved)
+    QFile file(_filePath);
+
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+        throw std::runtime_error(QString("Unable to open ZIP archive: %1").arg(_filePath).toStdString());
+
+    if (!file.seek(static_cast<qint64>(getDataOffset(file, *entry))))
+        throw std::runtime_error(QString("Unable to seek to ZIP entry: %1").arg(entryName).toStdString());
+
+    std::uint64_t numberOfBytesRead = 0;
+
+    while (numberOfBytesRead < destinationSize) {
+        const auto chunkSize    = static_cast<qint64>(std::min<std::uint64_t>(destinationSize - numberOfBytesRead, std::numeric_limits<qint32>::max()));
+        const auto chunkRead    = file.read(destination + numberOfBytesRead, chunkSize);
+
+        if (chunkRead <= 0)
+            throw std::runtime_error(QString("Failed while reading ZIP entry: %1").arg(entryName).toStdString());
+
+        numberOfBytesRead += static_cast<std::uint64_t>(chunkRead);
+    }
+}
+
+std::shared_ptr<const ArchiveEntryIndex> ArchiveEntryIndex::get(const QString& filePath)
+{
+    QMutexLocker lock(&indexCacheMutex);
+
+    if (const auto cachedIndex = indexCache.value(filePath); cachedIndex && cachedIndex->isUpToDate())
+        return cachedIndex;
+
+    auto index = std::make_shared<const ArchiveEntryIndex>(filePath);
+
+    indexCache.insert(filePath, index);
+
+    return index;
+}
+
+void ArchiveEntryIndex::release(const QString& filePath)
+{
+    QMutexLocker lock(&indexCacheMutex);
+
+    indexCache.remove(filePath);
+}
+
+}
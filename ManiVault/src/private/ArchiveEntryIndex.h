@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+
+#include <cstdint>
+#include <memory>
+
+namespace mv::util {
+
+/**
+ * Archive entry index class
+ *
+ * Index of the entries in a zip archive, built once from the archive central
+ * directory (including ZIP64 records). Stored (uncompressed) entries can be
+ * read directly from their offset in the archive without re-opening the zip
+ * and walking its directory, which makes concurrent random-access reads of
+ * encoded data blocks possible.
+ *
+ * Each read opens its own (unbuffered) file handle and reads the entry data
+ * straight into the destination. The index does not keep the archive open or
+ * mapped, so a cached index never locks the project file.
+ *
+ * @author Thomas Kroes
+ */
+class ArchiveEntryIndex
+{
+public:
+
+    /** Zip compression method of stored (uncompressed) entries */
+    static constexpr std::uint16_t storedMethod = 0;
+
+    /** Alignment (in bytes) of the data of stored entries written by the archive stream writer */
+    static constexpr std::uint16_t storedDataAlignment = 64;
+
+    /** Archive entry as described by the central directory */
+    struct Entry
+    {
+        QString         _name;                  /** Entry name */
+        std::uint16_t   _method;                /** Compression method */
+        std::uint16_t   _flags;                 /** General purpose bit flags */
+        std::uint64_t   _compressedSize;        /** Size of the entry data in the archive */
+        std::uint64_t   _uncompressedSize;      /** Size of the entry data once decompressed */
+        std::uint64_t   _localHeaderOffset;     /** Offset of the local file header in the archive */
+
+        /** @return Whether the entry data can be read directly from the archive */
+        bool isStored() const {
+            return _method == storedMethod && (_flags & 0x1) == 0;
+        }
+    };
+
+    /**
+     * Build the index from the central directory of the archive at \p filePath
+     * Might throw a std::runtime_error exception if the archive is invalid
+     * @param filePath File path of the zip archive
+     */
+    explicit ArchiveEntryIndex(const QString& filePath);
+
+    /**
+     * Get archive file path
+     * @return File path of the zip archive
+     */
+    QString getFilePath() const;
+
+    /**
+     * Establish whether the index is still valid for the archive on disk (same size and modification time)
+     * @return Boolean determining whether the index is up-to-date
+     */
+    bool isUpToDate() const;
+
+    /**
+     * Get entry with \p entryName
+     * @param entryName Name of the entry
+     * @return Pointer to the entry, nullptr if not found
+     */
+    const Entry* findEntry(const QString& entryName) const;
+
+    /**
+     * Read the data of stored entry \p entryName
+     * Might throw a std::runtime_error exception if the entry is not found, not stored or cannot be read
+     * @param entryName Name of the entry
+     * @return Entry data
+     */
+    QByteArray readStoredEntry(const QString& entryName) const;
+
+    /**
+     * Read the data of stored entry \p entryName directly into \p destination
+     * Might throw a std::runtime_error exception if the entry is not found, not stored, does not match \p destinationSize or cannot be read
+     * @param entryName Name of the entry
+     * @param destination Destination buffer
+     * @param destinationSize Size of the destination buffer, must equal the entry size
+     */
+    void readStoredEntryTo(const QString& entryName, char* destination, std::uint64_t destinationSize) const;
+
+    /**
+     * Get an up-to-date index for the archive at \p filePath, building it only when no valid cached index exists
+     * Might throw a std::runtime_error exception if the archive is invalid
+     * @param filePath File path of the zip archive
+     * @return Shared pointer to the index
+     */
+    static std::shared_ptr<const ArchiveEntryIndex> get(const QString& filePath);
+
+    /**
+     * Remove the cached index for the archive at \p filePath
+     * @param filePath File path of the zip archive
+     */
+    static void release(const QString& filePath);
+
+private:
+    QString                         _filePath;          /** File path of the zip archive */
+    qint64                          _fileSize;          /** Archive size at the time the index was built */
+    QDateTime                       _lastModified;      /** Archive modification time at the time the index was built */
+    QHash<QString, Entry>           _entries;           /** Entries by name */
+};
+
+}
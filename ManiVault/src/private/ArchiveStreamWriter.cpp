@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "ArchiveStreamWriter.h"
+#include "ArchiveEntryIndex.h"
+#include "Archiver.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QtEndian>
+
+#include <quazip/JlCompress.h>
+
+#include <stdexcept>
+
+#ifdef _DEBUG
+    #define ARCHIVE_STREAM_WRITER_VERBOSE
+#endif
+
+namespace mv::util {
+
+ArchiveStreamWriter::ArchiveStreamWriter(const QString& filePath) :
+    _filePath(filePath)
+{
+}
+
+ArchiveStreamWriter::~ArchiveStreamWriter()
+{
+    abort();
+}
+
+void ArchiveStreamWriter::open()
+{
+    QMutexLocker lock(&_mutex);
+
+    if (_zip)
+        throw std::runtime_error("Archive is already open");
+
+    QDir().mkpath(QFileInfo(_filePath).absolutePath());
+
+    QFile::remove(getPartialFilePath());
+
+    auto zip = std::make_unique<QuaZip>(getPartialFilePath());
+
+    zip->setZip64Enabled(true);
+
+    if (!zip->open(QuaZip::mdCreate))
+        throw std::runtime_error(QString("Unable to create archive: %1").arg(_filePath).toStdString());
+
+    if (zip->getZipError() != 0)
+        throw std::runtime_error(QString("Zip error(s) occurred while creating archive: %1").arg(_filePath).toStdString());
+
+    _zip = std::move(zip);
+    _entryNames.clear();
+
+#ifdef ARCHIVE_STREAM_WRITER_VERBOSE
+    qDebug() << __FUNCTION__ << _filePath;
+#endif
+}
+
+void ArchiveStreamWriter::writeEntry(const QString& entryName, const QByteArray& data)
+{
+    QMutexLocker lock(&_mutex);
+
+    writeEntryLocked(entryName, data, 0);
+}
+
+bool ArchiveStreamWriter::copyEntry(const QString& sourceArchiveFilePath, const QString& entryName)
+{
+    // Blocks may be shared by several blob maps (and thus be copied more than once)
+    {
+        QMutexLocker lock(&_mutex);
+
+        if (_entryNames.contains(entryName))
+            return true;
+    }
+
+    if (!QFileInfo::exists(sourceArchiveFilePath))
+        return false;
+
+    const auto sourceEntryIndex = ArchiveEntryIndex::get(sourceArchiveFilePath);
+    const auto sourceEntry      = sourceEntryIndex->findEntry(entryName);
+
+    if (!sourceEntry)
+        return false;
+
+    // Stored entries are read at their offset in the source archive, compressed ones are decompressed
+    const auto data = Archiver::readZipEntryToMemory(sourceArchiveFilePath, entryName);
+
+    QMutexLocker lock(&_mutex);
+
+    // Another worker may have copied the same entry in the meantime
+    if (_entryNames.contains(entryName))
+        return true;
+
+    writeEntryLocked(entryName, data, 0);
+
+#ifdef ARCHIVE_STREAM_WRITER_VERBOSE
+    qDebug() << __FUNCTION__ << entryName << "from" << sourceArchiveFilePath;
+#endif
+
+    return true;
+}
+
+bool ArchiveStreamWriter::copyEntries(const QString& sourceArchiveFilePath, const QStringList& entryNames)
+{
+    if (entryNames.isEmpty())
+        return true;
+
+    if (!QFileInfo::exists(sourceArchiveFilePath))
+        return false;
+
+    const auto sourceEntryIndex = ArchiveEntryIndex::get(sourceArchiveFilePath);
+
+    // Stage: make sure every entry can be copied before writing the first one
+    {
+        QMutexLocker lock(&_mutex);
+
+        for (const auto& entryName : entryNames)
+            if (!_entryNames.contains(entryName) && !sourceEntryIndex->findEntry(entryName))
+                return false;
+    }
+
+    // Commit: copying can now only fail with an exception, which fails the save as a whole
+    for (const auto& entryName : entryNames)
+        if (!copyEntry(sourceArchiveFilePath, entryName))
+            throw std::runtime_error(QString("Unable to copy entry %1 from %2").arg(entryName, sourceArchiveFilePath).toStdString());
+
+    return true;
+}
+
+void ArchiveStreamWriter::writeDirectory(const QString& directory, std::int32_t compressionLevel /*= 0*/)
+{
+    if (!QDir(directory).exists())
+        throw std::runtime_error("Directory does not exist");
+
+    const QDir rootDirectory(directory);
+
+    QDirIterator directoryIterator(directory, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+
+    while (directoryIterator.hasNext()) {
+        const auto filePath = directoryIterator.next();
+
+        QFile file(filePath);
+
+        if (!file.open(QIODevice::ReadOnly))
+            throw std::runtime_error(QString("Unable to open input file: %1").arg(filePath).toStdString());
+
+        const auto data = file.readAll();
+
+        QMutexLocker lock(&_mutex);
+
+        writeEntryLocked(rootDirectory.relativeFilePath(filePath), data, compressionLevel);
+    }
+}
+
+void ArchiveStreamWriter::close()
+{
+    QMutexLocker lock(&_mutex);
+
+    if (!_zip)
+        return;
+
+    _zip->close();
+
+    const auto zipError = _zip->getZipError();
+
+    _zip.reset();
+
+    if (zipError != 0) {
+        QFile::remove(getPartialFilePath());
+        throw std::runtime_error(QString("Zip error(s) occurred while closing archive: %1").arg(_filePath).toStdString());
+    }
+
+    // Only replace an existing archive once the new one is complete (and drop the
+    // cached index of the existing archive, it no longer describes the file)
+    ArchiveEntryIndex::release(_filePath);
+
+    if (QFileInfo::exists(_filePath) && !QFile::remove(_filePath))
+        throw std::runtime_error(QString("Unable to replace existing archive: %1").arg(_filePath).toStdString());
+
+    if (!QFile::rename(getPartialFilePath(), _filePath))
+        throw std::runtime_error(QString("Unable to move archive into place: %1").arg(_filePath).toStdString());
+
+#ifdef ARCHIVE_STREAM_WRITER_VERBOSE
+    qDebug() << __FUNCTION__ << _filePath << _entryNames.size() << "entries";
+#endif
+}
+
+void ArchiveStreamWriter::abort()
+{
+    QMutexLocker lock(&_mutex);
+
+    if (!_zip)
+        return;
+
+    _zip->close();
+    _zip.reset();
+
+    QFile::remove(getPartialFilePath());
+}
+
+QString ArchiveStreamWriter::getFilePath() const
+{
+    QMutexLocker lock(&_mutex);
+
+    return _filePath;
+}
+
+QStringList ArchiveStreamWriter::getEntryNames() const
+{
+    QMutexLocker lock(&_mutex);
+
+    return _entryNames.values();
+}
+
+QByteArray ArchiveStreamWriter::getAlignmentExtraField(const QString& entryName) const
+{
+    constexpr quint16 alignmentHeaderId     = 0xD935;   // Same extra field id as used by zipalign
+    constexpr qint64 localFileHeaderSize    = 30;
+    constexpr qint64 zip64ExtraFieldSize    = 20;
+    constexpr qint64 alignmentFieldSize     = 6;        // Header id, data size and alignment
+
+    const auto ioDevice = _zip->getIoDevice();
+
+    if (!ioDevice)
+        return {};
+
+    // The data of the entry starts after the local file header, the entry name, our
+    // extra field and the ZIP64 extra field which is added when ZIP64 is enabled
+    const auto dataOffsetWithoutPadding = ioDevice->pos() + localFileHeaderSize + entryName.toUtf8().size() + alignmentFieldSize + (_zip->isZip64Enabled() ? zip64ExtraFieldSize : 0);
+
+    const auto alignment    = static_cast<qint64>(ArchiveEntryIndex::storedDataAlignment);
+    const auto padding      = (alignment - dataOffsetWithoutPadding % alignment) % alignment;
+
+    QByteArray extraField(alignmentFieldSize + padding, '\0');
+
+    qToLittleEndian<quint16>(alignmentHeaderId, extraField.data());
+    qToLittleEndian<quint16>(static_cast<quint16>(2 + padding), extraField.data() + 2);
+    qToLittleEndian<quint16>(ArchiveEntryIndex::storedDataAlignment, extraField.data() + 4);
+
+    return extraField;
+}
+
+QString ArchiveStreamWriter::getPartialFilePath() const
+{
+    return _filePath + ".partial";
+}
+
+void ArchiveStreamWriter::writeEntryLocked(const QString& entryName, const QByteArray& data, std::int32_t compressionLevel)
+{
+    if (!_zip)
+        throw std::runtime_error("Archive is not open");
+
+    QuaZipFile zipFile(_zip.get());
+
+    const auto method = compressionLevel == 0 ? 0 : Z_DEFLATED;
+
+    QuaZipNewInfo newInfo(entryName);
+
+    if (method == 0)
+        newInfo.extraLocal = getAlignmentExtraField(entryName);
+
+    if (!zipFile.open(QIODevice::WriteOnly, newInfo, nullptr, 0U, method, compressionLevel))
+        throw std::runtime_error(QString("Unable to open archive entry: %1").arg(entryName).toStdString());
+
+    if (zipFile.write(data) != data.size() || zipFile.getZipError() != UNZ_OK)
+        throw std::runtime_error(QString("Unable to write archive entry: %1").arg(entryName).toStdString());
+
+    zipFile.close();
+
+    if (zipFile.getZipError() != UNZ_OK)
+        throw std::runtime_error(QString("Zip error(s) occurred while writing archive entry: %1").arg(entryName).toStdString());
+
+    _entryNames.insert(entryName);
+}
+
+}
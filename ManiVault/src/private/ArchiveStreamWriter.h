@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#pragma once
+
+#include <util/ArchiveEntryWriter.h>
+
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+class QuaZip;
+
+namespace mv::util {
+
+/**
+ * Archive stream writer class
+ *
+ * Writes entries into a zip archive while the archive is being created, so that
+ * encoded data blocks can be appended as soon as they become available. Entries
+ * are stored without (re-)compression since blocks are already encoded by their
+ * codec. Entry writes are serialized with a mutex, which allows the encoding
+ * itself to run in parallel. The data of stored entries is aligned (by means
+ * of padding in a local extra field) so that it can be read into aligned buffers.
+ *
+ * The archive is written to a partial file next to the destination and only
+ * replaces the destination when it is closed successfully, so an existing
+ * archive remains intact (and readable) while a new one is being written.
+ *
+ * @author Thomas Kroes
+ */
+class ArchiveStreamWriter : public ArchiveEntryWriter
+{
+public:
+
+    /**
+     * Construct with \p filePath
+     * @param filePath File path of the archive to create
+     */
+    explicit ArchiveStreamWriter(const QString& filePath);
+
+    /** Discards the archive if it was not closed */
+    ~ArchiveStreamWriter() override;
+
+    /**
+     * Create the archive on disk
+     * Might throw a std::runtime_error exception if the archive cannot be created
+     */
+    void open();
+
+    /**
+     * Write \p data to the archive as a stored entry named \p entryName
+     * Might throw a std::runtime_error exception if the entry cannot be written
+     * @param entryName Name of the entry in the archive
+     * @param data Entry data
+     */
+    void writeEntry(const QString& entryName, const QByteArray& data) override;
+
+    /**
+     * Copy the entry named \p entryName from the archive at \p sourceArchiveFilePath into the archive as a stored entry
+     * Stored source entries are read at their offset in the source archive, compressed ones are decompressed
+     * Might throw a std::runtime_error exception if the entry cannot be written
+     * @param sourceArchiveFilePath File path of the archive to copy from (may be the file path of this archive, it is not replaced until closed)
+     * @param entryName Name of the entry in both archives
+     * @return Boolean determining whether the entry was copied or is already in the archive (false if the source archive or entry does not exist)
+     */
+    bool copyEntry(const QString& sourceArchiveFilePath, const QString& entryName) override;
+
+    /**
+     * Copy the entries named \p entryNames from the archive at \p sourceArchiveFilePath into the archive as stored entries
+     * The source archive is checked for all entries before the first one is written, so nothing is copied when one is missing
+     * Might throw a std::runtime_error exception if an entry cannot be written
+     * @param sourceArchiveFilePath File path of the archive to copy from (may be the file path of this archive, it is not replaced until closed)
+     * @param entryNames Names of the entries in both archives
+     * @return Boolean determining whether all entries were copied or are already in the archive (false if the source archive or one of the entries does not exist)
+     */
+    bool copyEntries(const QString& sourceArchiveFilePath, const QStringList& entryNames) override;
+
+    /**
+     * Add all files in \p directory (recursively) to the archive, with entry names relative to \p directory
+     * Might throw a std::runtime_error exception if a file cannot be added
+     * @param directory Path of the directory
+     * @param compressionLevel Compression level (zero means no compression)
+     */
+    void writeDirectory(const QString& directory, std::int32_t compressionLevel = 0);
+
+    /**
+     * Finish the archive by writing the central directory, closing the file and moving it to its destination
+     * Might throw a std::runtime_error exception if the archive cannot be closed
+     */
+    void close();
+
+    /** Close the archive (if open) and remove the partial file from disk */
+    void abort();
+
+    /**
+     * Get archive file path
+     * @return File path of the archive
+     */
+    QString getFilePath() const override;
+
+    /**
+     * Get names of the entries that were written so far
+     * @return Entry names
+     */
+    QStringList getEntryNames() const;
+
+private:
+
+    /**
+     * Get a local extra field which pads the local file header of \p entryName such that its data is aligned to ArchiveEntryIndex::storedDataAlignment (assumes the mutex is locked)
+     * @param entryName Name of the entry that is about to be written
+     * @return Alignment extra field, empty if the write position is unknown
+     */
+    QByteArray getAlignmentExtraField(const QString& entryName) const;
+
+    /**
+     * Get the file path of the archive while it is being written
+     * @return Partial archive file path
+     */
+    QString getPartialFilePath() const;
+
+    /**
+     * Write \p data to the archive (assumes the mutex is locked)
+     * @param entryName Name of the entry in the archive
+     * @param data Entry data
+     * @param compressionLevel Compression level (zero means no compression)
+     */
+    void writeEntryLocked(const QString& entryName, const QByteArray& data, std::int32_t compressionLevel);
+
+private:
+    mutable QMutex              _mutex;         /** Serializes access to the zip archive */
+    QString                     _filePath;      /** File path of the archive */
+    std::unique_ptr<QuaZip>     _zip;           /** QuaZip archive (valid while open) */
+    QSet<QString>               _entryNames;    /** Names of the entries that were written so far */
+};
+
+using SharedArchiveStreamWriter = std::shared_ptr<ArchiveStreamWriter>;
+
+}
@@ -3,9 +3,11 @@
 // Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
 
 #include "Archiver.h"
+#include "ArchiveEntryIndex.h"
 
 #include <util/Exception.h>
 
+#include <cstring>
 #include <stdexcept>
 
 #include <QDebug>
@@ -184,6 +186,13 @@ void Archiver::extractSingleFile(const QString& compressedFilePath, const QStrin
 
 QByteArray Archiver::readZipEntryToMemory(const QString& zipPath, const QString& entryName)
 {
+    // Stored entries (such as encoded data blocks) are read directly at their offset, using
+    // the central directory index of the archive, which is built once and then cached
+    const auto entryIndex = ArchiveEntryIndex::get(zipPath);
+
+    if (const auto entry = entryIndex->findEntry(entryName); entry && entry->isStored())
+        return entryIndex->readStoredEntry(entryName);
+
     static QMutex zipReadMutex;
 
     QByteArray data;
@@ -220,6 +229,24 @@ QByteArray Archiver::readZipEntryToMemory(const QString& zipPath, const QString&
 	return data;
 }
 
+void Archiver::readZipEntryTo(const QString& zipPath, const QString& entryName, char* destination, std::uint64_t destinationSize)
+{
+    const auto entryIndex = ArchiveEntryIndex::get(zipPath);
+
+    if (const auto entry = entryIndex->findEntry(entryName); entry && entry->isStored()) {
+        entryIndex->readStoredEntryTo(entryName, destination, destinationSize);
+        return;
+    }
+
+    const auto data = readZipEntryToMemory(zipPath, entryName);
+
+    if (static_cast<std::uint64_t>(data.size()) != destinationSize)
+        throw std::runtime_error(QString("ZIP entry size (%1) does not match the destination size (%2): %3").arg(data.size()).arg(destinationSize).arg(entryName).toStdString());
+
+    if (destinationSize > 0)
+        std::memcpy(destination, data.constData(), data.size());
+}
+
 void Archiver::compressSubDirectory(QuaZip* parentZip, const QString& directory, const QString& parentDirectory, bool recursive /*= true*/, std::int32_t compressionLevel /*= 0*/, const QString& password /*= ""*/, QDir::Filters filters /*= QDir::Filter::Files*/)
 {
     // Except if the parent zip is invalid
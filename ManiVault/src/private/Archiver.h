@@ -88,6 +88,17 @@ public:
      */
     static QByteArray readZipEntryToMemory(const QString& zipPath, const QString& entryName);
 
+    /**
+     * Reads a file from a zip archive directly into \p destination
+     * Stored (uncompressed) entries are read straight from their offset in the archive, other entries are read via QuaZip
+     * Might throw a std::runtime_error exception if an error occurs during extraction or if the entry size does not match \p destinationSize
+     * @param zipPath File path of the compressed input file
+     * @param entryName File name of the compressed source file
+     * @param destination Destination buffer
+     * @param destinationSize Size of the destination buffer in bytes
+     */
+    static void readZipEntryTo(const QString& zipPath, const QString& entryName, char* destination, std::uint64_t destinationSize);
+
 protected:
 
     /**
@@ -327,6 +327,16 @@ UniqueWorkflowPlan DataHierarchyManager::fromVariantMapWorkflow(QVariantMap vari
         for (const auto& item : _items) {
             events().notifyDatasetDataChanged(item->getDataset());
         }
+
+        // The raw data is as it was saved, so the notifications above do not
+        // count as modifications (clean raw data can be copied on the next save)
+        for (const auto& item : _items) {
+            auto dataset = item->getDataset();
+
+            if (dataset->getStorageType() == DatasetImpl::StorageType::Owner && !dataset->getRawDataName().isEmpty())
+                if (auto rawData = mv::data().getRawData(dataset->getRawDataName()))
+                    rawData->clearModified();
+        }
 	});
 
     return plan;
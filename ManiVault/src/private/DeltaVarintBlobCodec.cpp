@@ -0,0 +1,318 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "DeltaVarintBlobCodec.h"
+
+#include "Archiver.h"
+
+#include <CoreInterface.h>
+
+#include <exception/ManiVaultException.h>
+
+#include <QtEndian>
+
+#include <array>
+#include <cstring>
+#include <limits>
+
+#ifdef _DEBUG
+	#define DELTA_VARINT_CODEC_VERBOSE
+#endif
+
+using namespace mv::util;
+
+namespace {
+
+constexpr qsizetype headerSize = 8;     /** Size of the header with the decoded size */
+
+/** Masks which keep the lowest one to four bytes of a 32-bit value, indexed by two-bit length code */
+constexpr std::array<std::uint32_t, 4> byteMasks = { 0x000000FFu, 0x0000FFFFu, 0x00FFFFFFu, 0xFFFFFFFFu };
+
+/** Number of data bytes of a group of four values, indexed by control byte */
+constexpr auto groupLengths = []() {
+    std::array<std::uint8_t, 256> lengths{};
+
+    for (std::size_t control = 0; control < lengths.size(); ++control)
+        lengths[control] = static_cast<std::uint8_t>(4 + (control & 3) + ((control >> 2) & 3) + ((control >> 4) & 3) + ((control >> 6) & 3));
+
+    return lengths;
+}();
+
+/**
+ * Map a signed difference (in two's complement) to an unsigned value such that small magnitudes map to small values
+ * @param delta Difference
+ * @return Zigzag-encoded difference
+ */
+std::uint32_t zigzagEncode(std::uint32_t delta)
+{
+    return (delta << 1) ^ (0u - (delta >> 31));
+}
+
+/**
+ * Undo zigzagEncode()
+ * @param value Zigzag-encoded difference
+ * @return Difference
+ */
+std::uint32_t zigzagDecode(std::uint32_t value)
+{
+    return (value >> 1) ^ (0u - (value & 1u));
+}
+
+/**
+ * Get the two-bit length code (number of bytes minus one) of \p value
+ * @param value Value
+ * @return Length code
+ */
+std::uint8_t getLengthCode(std::uint32_t value)
+{
+    return value < (1u << 8) ? 0 : value < (1u << 16) ? 1 : value < (1u << 24) ? 2 : 3;
+}
+
+/**
+ * Read the decoded size from the header of \p encodedData
+ * Might throw a ManiVaultException if the encoded data is too small
+ * @param encodedData Pointer to the encoded data
+ * @param encodedSize Size of the encoded data in bytes
+ * @return Decoded size in bytes
+ */
+std::uint64_t readDecodedSize(const char* encodedData, std::uint64_t encodedSize)
+{
+    if (encodedData == nullptr || encodedSize < static_cast<std::uint64_t>(headerSize))
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            "Encoded data is smaller than the delta-varint header",
+            __FUNCTION__,
+            {
+                { "EncodedDataSize", QString::number(encodedSize) }
+            }
+        );
+
+    return qFromLittleEndian<quint64>(encodedData);
+}
+
+/**
+ * Decode \p encodedSize bytes of \p encodedData directly into \p destination
+ * Might throw a ManiVaultException if the encoded data is corrupt or does not decode to \p destinationSize bytes
+ * @param encodedData Pointer to the encoded data
+ * @param encodedSize Size of the encoded data in bytes
+ * @param destination Output buffer
+ * @param destinationSize Size of the output buffer in bytes
+ */
+void decodeBlockTo(const char* encodedData, std::uint64_t encodedSize, char* destination, std::uint64_t destinationSize)
+{
+    if (destination == nullptr)
+        throw mv::ManiVaultException(SeverityLevel::Error, "Failed to decode input data", "Destination buffer is null", __FUNCTION__);
+
+    const auto decodedSize = readDecodedSize(encodedData, encodedSize);
+
+    if (decodedSize != destinationSize || decodedSize % sizeof(std::uint32_t) != 0)
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            QString("Decoded size mismatch: expected %1 bytes, header reports %2 bytes").arg(destinationSize).arg(decodedSize),
+            __FUNCTION__
+        );
+
+    const auto numberOfValues   = decodedSize / sizeof(std::uint32_t);
+    const auto controlSize      = (numberOfValues + 3) / 4;
+
+    if (encodedSize - headerSize < controlSize)
+        throw mv::ManiVaultException(SeverityLevel::Error, "Failed to decode input data", "Delta-varint control stream is truncated", __FUNCTION__);
+
+    const auto* control = reinterpret_cast<const std::uint8_t*>(encodedData + headerSize);
+    const auto* data    = control + controlSize;
+    const auto* dataEnd = reinterpret_cast<const std::uint8_t*>(encodedData) + encodedSize;
+
+    std::uint32_t previous      = 0;
+    std::uint64_t valueIndex    = 0;
+
+    // Full groups of four values for which a 32-bit load per value stays within the data stream
+    for (; valueIndex + 4 <= numberOfValues; valueIndex += 4) {
+        const auto controlByte = control[valueIndex / 4];
+
+        if (data + groupLengths[controlByte] + 3 > dataEnd)
+            break;
+
+        std::uint32_t values[4];
+
+        for (std::size_t groupIndex = 0; groupIndex < 4; ++groupIndex) {
+            const auto code = (controlByte >> (2 * groupIndex)) & 3;
+
+            previous += zigzagDecode(qFromLittleEndian<quint32>(data) & byteMasks[code]);
+
+            values[groupIndex] = previous;
+
+            data += code + 1;
+        }
+
+        std::memcpy(destination + valueIndex * sizeof(std::uint32_t), values, sizeof(values));
+    }
+
+    // Remaining values are read byte by byte
+    for (; valueIndex < numberOfValues; ++valueIndex) {
+        const auto code = (control[valueIndex / 4] >> (2 * (valueIndex % 4))) & 3;
+
+        if (data + code + 1 > dataEnd)
+            throw mv::ManiVaultException(SeverityLevel::Error, "Failed to decode input data", "Delta-varint data stream is truncated", __FUNCTION__);
+
+        std::uint32_t value = 0;
+
+        for (std::size_t byteIndex = 0; byteIndex <= code; ++byteIndex)
+            value |= static_cast<std::uint32_t>(data[byteIndex]) << (8 * byteIndex);
+
+        previous += zigzagDecode(value);
+
+        std::memcpy(destination + valueIndex * sizeof(std::uint32_t), &previous, sizeof(previous));
+
+        data += code + 1;
+    }
+
+    if (data != dataEnd)
+        throw mv::ManiVaultException(SeverityLevel::Error, "Failed to decode input data", "Delta-varint data stream has trailing bytes", __FUNCTION__);
+}
+
+}
+
+DeltaVarintBlobCodec::DeltaVarintBlobCodec(QObject* parent, mv::gui::CodecSettingsAction* codecSettingsAction) :
+	BlobCodec(parent, codecSettingsAction)
+{
+#ifdef DELTA_VARINT_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+}
+
+mv::util::BlobCodec::Type DeltaVarintBlobCodec::getType() const
+{
+    return Type::DeltaVarint;
+}
+
+QString DeltaVarintBlobCodec::getName() const
+{
+    return QStringLiteral("deltavarint");
+}
+
+QByteArray DeltaVarintBlobCodec::encode(const QByteArray& input) const
+{
+#ifdef DELTA_VARINT_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    return encode(input.constData(), input.size());
+}
+
+QByteArray DeltaVarintBlobCodec::encode(const char* data, qsizetype size) const
+{
+#ifdef DELTA_VARINT_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    if (data == nullptr || size <= 0 || size % static_cast<qsizetype>(sizeof(std::uint32_t)) != 0)
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to encode input data",
+            data == nullptr ? "Input data pointer is null" : "Input size is not a (non-zero) multiple of four bytes",
+            __FUNCTION__,
+            {
+                { "InputPointer", QString::number(reinterpret_cast<std::uintptr_t>(data), 16) },
+                { "InputSize", QString::number(size) }
+            }
+        );
+
+    const auto numberOfValues   = static_cast<std::size_t>(size) / sizeof(std::uint32_t);
+    const auto controlSize      = (numberOfValues + 3) / 4;
+
+    QByteArray output(headerSize + static_cast<qsizetype>(controlSize) + size, Qt::Uninitialized);
+
+    qToLittleEndian<quint64>(static_cast<quint64>(size), output.data());
+
+    auto* control   = reinterpret_cast<std::uint8_t*>(output.data() + headerSize);
+    auto* output8   = control + controlSize;
+
+    std::memset(control, 0, controlSize);
+
+    std::uint32_t previous = 0;
+
+    for (std::size_t valueIndex = 0; valueIndex < numberOfValues; ++valueIndex) {
+        std::uint32_t value;
+
+        std::memcpy(&value, data + valueIndex * sizeof(std::uint32_t), sizeof(value));
+
+        const auto encoded  = zigzagEncode(value - previous);
+        const auto code     = getLengthCode(encoded);
+
+        control[valueIndex / 4] |= static_cast<std::uint8_t>(code << (2 * (valueIndex % 4)));
+
+        for (std::size_t byteIndex = 0; byteIndex <= code; ++byteIndex)
+            *output8++ = static_cast<std::uint8_t>(encoded >> (8 * byteIndex));
+
+        previous = value;
+    }
+
+    output.resize(static_cast<qsizetype>(reinterpret_cast<char*>(output8) - output.data()));
+
+    return output;
+}
+
+QByteArray DeltaVarintBlobCodec::decode(const QByteArray& input, qsizetype expectedSize) const
+{
+#ifdef DELTA_VARINT_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    const auto decodedSize = readDecodedSize(input.constData(), static_cast<std::uint64_t>(input.size()));
+
+    if (expectedSize >= 0 && decodedSize != static_cast<std::uint64_t>(expectedSize))
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            QStringLiteral("Decoded size mismatch. Header reports %1 bytes, expected %2 bytes").arg(decodedSize).arg(expectedSize),
+            __FUNCTION__,
+            {
+                { "HeaderSize", QString::number(decodedSize) },
+                { "ExpectedSize", QString::number(expectedSize) }
+            }
+        );
+
+    if (decodedSize > static_cast<std::uint64_t>(std::numeric_limits<qsizetype>::max()))
+        throw mv::ManiVaultException(SeverityLevel::Error, "Failed to decode input data", "Decoded size exceeds maximum QByteArray size", __FUNCTION__);
+
+    QByteArray output(static_cast<qsizetype>(decodedSize), Qt::Uninitialized);
+
+    decodeBlockTo(input.constData(), static_cast<std::uint64_t>(input.size()), output.data(), decodedSize);
+
+    return output;
+}
+
+void DeltaVarintBlobCodec::decodeTo(const QByteArray& encodedData, char* destination, std::uint64_t destinationSize) const
+{
+#ifdef DELTA_VARINT_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    decodeBlockTo(encodedData.constData(), static_cast<std::uint64_t>(encodedData.size()), destination, destinationSize);
+}
+
+QByteArray DeltaVarintBlobCodec::decodeFromFile(const QString& filePath, qsizetype expectedSize) const
+{
+#ifdef DELTA_VARINT_CODEC_VERBOSE
+    qDebug() << __FUNCTION__ << filePath;
+#endif
+
+    return decode(Archiver::readZipEntryToMemory(mv::projects().getCurrentProject()->getFilePath(), filePath), expectedSize);
+}
+
+void DeltaVarintBlobCodec::decodeFromFileTo(const QString& filePath, char* destination, std::uint64_t destinationSize) const
+{
+#ifdef DELTA_VARINT_CODEC_VERBOSE
+    qDebug() << __FUNCTION__ << filePath;
+#endif
+
+    decodeTo(Archiver::readZipEntryToMemory(mv::projects().getCurrentProject()->getFilePath(), filePath), destination, destinationSize);
+}
+
+QString DeltaVarintBlobCodec::getFileExtension() const
+{
+    return QStringLiteral(".bin.dvi");
+}
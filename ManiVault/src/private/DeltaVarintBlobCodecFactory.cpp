@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "DeltaVarintBlobCodecFactory.h"
+#include "DeltaVarintBlobCodec.h"
+#include "DeltaVarintCodecSettingsAction.h"
+
+#ifdef _DEBUG
+	#define DELTA_VARINT_CODEC_FACTORY_VERBOSE
+#endif
+
+DeltaVarintBlobCodecFactory::DeltaVarintBlobCodecFactory(QObject* parent /*= nullptr*/) :
+    BlobCodecFactory(parent),
+    _defaultSettingsAction(nullptr, "Default delta-varint settings")
+{
+#ifdef 	DELTA_VARINT_CODEC_FACTORY_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+}
+
+DeltaVarintBlobCodecFactory::~DeltaVarintBlobCodecFactory()
+{
+#ifdef 	DELTA_VARINT_CODEC_FACTORY_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+}
+
+mv::util::BlobCodec::Type DeltaVarintBlobCodecFactory::type() const
+{
+    return mv::util::BlobCodec::Type::DeltaVarint;
+}
+
+QString DeltaVarintBlobCodecFactory::key() const
+{
+    return "deltavarint";
+}
+
+QString DeltaVarintBlobCodecFactory::displayName() const
+{
+    return "Delta + varint (indices)";
+}
+
+std::shared_ptr<mv::util::BlobCodec> DeltaVarintBlobCodecFactory::createCodec(QObject* parent, mv::gui::CodecSettingsAction* codecSettingsAction /*= nullptr*/) const
+{
+#ifdef 	DELTA_VARINT_CODEC_FACTORY_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    return std::make_shared<DeltaVarintBlobCodec>(parent, codecSettingsAction);
+}
+
+const mv::gui::CodecSettingsAction* DeltaVarintBlobCodecFactory::getDefaultCodecSettingsAction() const
+{
+#ifdef 	DELTA_VARINT_CODEC_FACTORY_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    return &_defaultSettingsAction;
+}
+
+mv::gui::CodecSettingsAction* DeltaVarintBlobCodecFactory::createCodecSettingsAction(QObject* parent) const
+{
+    return new DeltaVarintCodecSettingsAction(parent, "Delta-varint codec settings action");
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#pragma once
+
+#include "DeltaVarintCodecSettingsAction.h"
+
+#include <util/BlobCodec.h>
+#include <util/BlobCodecFactory.h>
+
+/**
+ * @brief Creates delta-varint index codec instances.
+ *
+ * This factory owns the default settings action and creates codec instances
+ * for (mostly sorted) unsigned 32-bit index payloads.
+ *
+ * @maintainer Thomas Kroes (BioVault - Biomedical Visual Analytics Unit LUMC - TU Delft)
+ */
+class DeltaVarintBlobCodecFactory final : public mv::util::BlobCodecFactory
+{
+public:
+
+    /**
+     * @brief Constructs a delta-varint codec factory.
+     * @param parent Optional parent object.
+     */
+    DeltaVarintBlobCodecFactory(QObject* parent = nullptr);
+
+    /**
+     * @brief Destroys the codec factory.
+     */
+    ~DeltaVarintBlobCodecFactory();
+
+    /**
+     * @brief Returns the codec type.
+     * @return Blob codec type.
+     */
+    [[nodiscard]] mv::util::BlobCodec::Type type() const override;
+
+    /**
+     * @brief Returns the codec registry key.
+     * @return Unique codec key.
+     */
+    [[nodiscard]] QString key() const override;
+
+    /**
+     * @brief Returns the user-facing codec name.
+     * @return Display name.
+     */
+    [[nodiscard]] QString displayName() const override;
+
+    /**
+     * @brief Returns the default codec settings action.
+     * @return Default settings action for this codec.
+     */
+    [[nodiscard]] const mv::gui::CodecSettingsAction* getDefaultCodecSettingsAction() const override;
+
+    /**
+     * @brief Creates a codec settings action.
+     * @param parent Optional parent object.
+     * @return Newly created settings action.
+     */
+    [[nodiscard]] mv::gui::CodecSettingsAction* createCodecSettingsAction(QObject* parent) const override;
+
+protected:
+
+    /**
+     * @brief Creates a delta-varint blob codec.
+     * @param parent Optional parent object.
+     * @param codecSettingsAction Codec settings action to use.
+     * @return Shared codec instance.
+     */
+    [[nodiscard]] std::shared_ptr<mv::util::BlobCodec> createCodec(QObject* parent, mv::gui::CodecSettingsAction* codecSettingsAction = nullptr) const override;
+
+private:
+    DeltaVarintCodecSettingsAction _defaultSettingsAction;  /**< Default codec settings action for this codec. */
+
+    friend class mv::util::CodecRegistry;
+};
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "DeltaVarintCodecSettingsAction.h"
+
+#include "util/BlobCodec.h"
+
+#ifdef _DEBUG
+	#define DELTA_VARINT_CODEC_SETTINGS_VERBOSE
+#endif
+
+using namespace mv;
+using namespace mv::gui;
+using namespace mv::util;
+
+DeltaVarintCodecSettingsAction::DeltaVarintCodecSettingsAction(QObject* parent, const QString& title) :
+    CodecSettingsAction(parent, title)
+{
+#ifdef DELTA_VARINT_CODEC_SETTINGS_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    getTypeAction().setString(BlobCodec::typeToString(BlobCodec::Type::DeltaVarint));
+}
+
+DeltaVarintCodecSettingsAction::~DeltaVarintCodecSettingsAction()
+{
+#ifdef DELTA_VARINT_CODEC_SETTINGS_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+}
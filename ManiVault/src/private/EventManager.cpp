@@ -68,15 +68,15 @@ void EventManager::initialize()
                 if (candidateDataset == dataset)
                     continue;
 
-                // If the dataset derives from the current dataset, notify it
+                // If the dataset derives from the current dataset, notify it (it shares the selection, and thus the delta)
                 if (candidateDataset->isDerivedData() && candidateDataset->getSourceDataset<DatasetImpl>()->getRawDataName() == dataset->getSourceDataset<DatasetImpl>()->getRawDataName())
-                    candidateDataset->markSelectionDirty(true);
+                    candidateDataset->markSelectionDirty(true, dataset->getPendingSelectionDelta());
 
-                // If the dataset has the same raw data, notify it
+                // If the dataset has the same raw data, notify it (it shares the selection, and thus the delta)
                 if (candidateDataset->getRawDataName() == dataset->getRawDataName())
-                    candidateDataset->markSelectionDirty(true);
+                    candidateDataset->markSelectionDirty(true, dataset->getPendingSelectionDelta());
 
-                // If the dataset is a proxy and the current dataset is one of its members, notify the proxy
+                // If the dataset is a proxy and the current dataset is one of its members, notify the proxy (its selection is in other indices)
                 if (candidateDataset->isProxy() && candidateDataset->getProxyMembers().contains(dataset))
                     candidateDataset->markSelectionDirty(true);
             }
@@ -88,7 +88,7 @@ void EventManager::initialize()
             if (!dataset->needsSelectionUpdate())
                 continue;
             
-            DatasetDataSelectionChangedEvent dataSelectionChangedEvent(dataset);
+            DatasetDataSelectionChangedEvent dataSelectionChangedEvent(dataset, dataset->getPendingSelectionDelta());
             
             // For every listener, find it in the original list and call its DataSelectionChangedEvent
             for (auto listener : eventListeners)
@@ -247,12 +247,20 @@ void EventManager::notifyDatasetRemoved(const QString& datasetId, const DataType
 }
 
 void EventManager::notifyDatasetDataChanged(const Dataset<DatasetImpl>& dataset)
+{
+    notifyDatasetDataChanged(dataset, DataChangedRegion());
+}
+
+void EventManager::notifyDatasetDataChanged(const Dataset<DatasetImpl>& dataset, const DataChangedRegion& region)
 {
     try {
         if (core()->isAboutToBeDestroyed())
             return;
 
-        DatasetDataChangedEvent dataEvent(dataset);
+        if (dataset.isValid())
+            dataset->setDataModified();
+
+        DatasetDataChangedEvent dataEvent(dataset, region);
 
         const auto eventListeners = _eventListeners;
 
@@ -275,6 +283,9 @@ void EventManager::notifyDatasetDataDimensionsChanged(const Dataset<DatasetImpl>
         if (core()->isAboutToBeDestroyed())
             return;
 
+        if (dataset.isValid())
+            dataset->setDataModified();
+
         DatasetDataDimensionsChangedEvent dataEvent(dataset);
 
         const auto eventListeners = _eventListeners;
@@ -293,6 +304,11 @@ void EventManager::notifyDatasetDataDimensionsChanged(const Dataset<DatasetImpl>
 }
 
 void EventManager::notifyDatasetDataSelectionChanged(const Dataset<DatasetImpl>& dataset, Datasets* ignoreDatasets /*= nullptr*/)
+{
+    notifyDatasetDataSelectionChanged(dataset, SelectionDelta(), ignoreDatasets);
+}
+
+void EventManager::notifyDatasetDataSelectionChanged(const Dataset<DatasetImpl>& dataset, const SelectionDelta& delta, Datasets* ignoreDatasets /*= nullptr*/)
 {
     try {
         if (core()->isAboutToBeDestroyed())
@@ -311,6 +327,10 @@ void EventManager::notifyDatasetDataSelectionChanged(const Dataset<DatasetImpl>&
         if (ignoreDatasets != nullptr && ignoreDatasets->contains(dataset))
             return;
 
+        // The notifier may have written the selection indices directly, so selections propagated to them are no longer built upon
+        if (ignoreDatasets == nullptr && delta.isReplaced())
+            dataset->markSelectionChanged();
+
         Datasets notified{ dataset };
 
         if (ignoreDatasets == nullptr)
@@ -318,18 +338,24 @@ void EventManager::notifyDatasetDataSelectionChanged(const Dataset<DatasetImpl>&
         else
             *ignoreDatasets << dataset;
 
-        dataset->markSelectionDirty(true);
+        dataset->markSelectionDirty(true, delta);
 
         // For all selection groups, set the current dataset as having a changed selection
         for (const KeyBasedSelectionGroup& selectionGroup : _selectionGroups)
         {
-            selectionGroup.selectionChanged(dataset, dataset->getSelection()->getSelectionIndices());
+            if (delta.isReplaced())
+                selectionGroup.selectionChanged(dataset, dataset->getSelection()->getSelectionIndices());
+            else
+                selectionGroup.selectionChanged(dataset, delta);
         }
 
-        // If the dataset has any linked dataset, then dirty them as well
+        // If the dataset has any linked dataset, then dirty them as well (with the delta mapped to the target)
         for (const LinkedData& ld : dataset->getLinkedData()) {
-            ld.getTargetDataset()->markSelectionDirty(true);
-            notifyDatasetDataSelectionChanged(ld.getTargetDataset(), ignoreDatasets);
+            // Usually mapped already when the target selection was updated, in which case the remembered delta is used
+            const auto targetDelta = ld.mapSelectionDelta(delta);
+
+            ld.getTargetDataset()->markSelectionDirty(true, targetDelta);
+            notifyDatasetDataSelectionChanged(ld.getTargetDataset(), targetDelta, ignoreDatasets);
         }
     }
     catch (std::exception& e)
@@ -63,6 +63,13 @@ public:
      */
     void notifyDatasetDataChanged(const Dataset<DatasetImpl>& dataset) override;
 
+    /**
+     * Notify listeners that a region of the data of a dataset has changed, so that they can update only that region
+     * @param dataset Smart pointer to the dataset of which the data changed
+     * @param region Region of the data that changed
+     */
+    void notifyDatasetDataChanged(const Dataset<DatasetImpl>& dataset, const DataChangedRegion& region) override;
+
     /**
      * Notify listeners that a dataset has changed data dimensions
      * @param dataset Smart pointer to the dataset of which the data dimensions changed
@@ -76,6 +83,14 @@ public:
      */
     void notifyDatasetDataSelectionChanged(const Dataset<DatasetImpl>& dataset, Datasets* ignoreDatasets = nullptr) override;
 
+    /**
+     * Notify listeners that dataset data selection has changed by \p delta, the delta is propagated (mapped) to linked datasets and selection groups
+     * @param dataset Smart pointer to the dataset of which the data selection changed
+     * @param delta How the data selection changed
+     * @param ignoreDatasets Pointer to datasets that should be ignored during notification
+     */
+    void notifyDatasetDataSelectionChanged(const Dataset<DatasetImpl>& dataset, const SelectionDelta& delta, Datasets* ignoreDatasets = nullptr) override;
+
     /**
      * Notify all listeners that a dataset is locked
      * @param dataset Smart pointer to the dataset
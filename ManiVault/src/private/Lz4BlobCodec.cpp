@@ -0,0 +1,365 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "Lz4BlobCodec.h"
+#include "Lz4CodecSettingsAction.h"
+
+#include "Archiver.h"
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+#include <CoreInterface.h>
+
+#include <exception/ManiVaultException.h>
+
+#include <QFile>
+#include <QtEndian>
+
+#include <limits>
+#include <vector>
+
+#ifdef _DEBUG
+	#define LZ4_CODEC_VERBOSE
+#endif
+
+using namespace mv::util;
+
+namespace {
+
+constexpr qsizetype headerSize = 8;     /** Size of the header with the decoded size */
+
+/**
+ * Get the (fast) compression state of the calling thread, which is reused across blocks
+ * @return Pointer to the thread-local compression state
+ */
+void* getThreadLocalState()
+{
+    thread_local std::vector<std::uint64_t> state((static_cast<std::size_t>(LZ4_sizeofState()) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+
+    return state.data();
+}
+
+/**
+ * Get the high compression state of the calling thread, which is reused across blocks
+ * @return Pointer to the thread-local high compression state
+ */
+void* getThreadLocalStateHC()
+{
+    thread_local std::vector<std::uint64_t> state((static_cast<std::size_t>(LZ4_sizeofStateHC()) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+
+    return state.data();
+}
+
+/**
+ * Get the maximum encoded size of \p size bytes (header included)
+ * Might throw a ManiVaultException if \p size exceeds the maximum LZ4 block size
+ * @param size Size of the raw data in bytes
+ * @return Maximum encoded size in bytes
+ */
+qsizetype getEncodedSizeBound(qsizetype size)
+{
+    if (size <= 0 || size > LZ4_MAX_INPUT_SIZE)
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to encode input data",
+            size <= 0 ? "Input data is empty" : "Input exceeds the maximum LZ4 block size, reduce the block size",
+            __FUNCTION__,
+            {
+                { "InputSize", QString::number(size) },
+                { "MaximumInputSize", QString::number(LZ4_MAX_INPUT_SIZE) }
+            }
+        );
+
+    return headerSize + LZ4_compressBound(static_cast<int>(size));
+}
+
+/**
+ * Encode \p size bytes of \p data into \p destination (header included)
+ * Might throw a ManiVaultException if compression fails
+ * @param settings LZ4 codec settings
+ * @param data Pointer to raw input bytes
+ * @param size Size of the raw input in bytes
+ * @param destination Destination buffer of at least getEncodedSizeBound(size) bytes
+ * @param capacity Size of the destination buffer in bytes
+ * @return Encoded size in bytes (header included)
+ */
+qsizetype encodeTo(Lz4CodecSettingsAction& settings, const char* data, qsizetype size, char* destination, qsizetype capacity)
+{
+    qToLittleEndian<quint64>(static_cast<quint64>(size), destination);
+
+    auto* block             = destination + headerSize;
+    const auto blockBound   = static_cast<int>(capacity - headerSize);
+
+    const auto compressedSize = settings.getHighCompressionAction().isChecked()
+        ? LZ4_compress_HC_extStateHC(getThreadLocalStateHC(), data, block, static_cast<int>(size), blockBound, settings.getHighCompressionLevelAction().getValue())
+        : LZ4_compress_fast_extState(getThreadLocalState(), data, block, static_cast<int>(size), blockBound, settings.getAccelerationAction().getValue());
+
+    if (compressedSize <= 0)
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to encode input data",
+            "LZ4 compression failed",
+            __FUNCTION__,
+            {
+                { "InputSize", QString::number(size) },
+                { "Capacity", QString::number(capacity) }
+            }
+        );
+
+    return headerSize + compressedSize;
+}
+
+/**
+ * Read the decoded size from the header of \p encodedData
+ * Might throw a ManiVaultException if the encoded data is too small
+ * @param encodedData Pointer to the encoded data
+ * @param encodedSize Size of the encoded data in bytes
+ * @return Decoded size in bytes
+ */
+std::uint64_t readDecodedSize(const char* encodedData, std::uint64_t encodedSize)
+{
+    if (encodedData == nullptr || encodedSize < static_cast<std::uint64_t>(headerSize))
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            "Encoded data is smaller than the LZ4 header",
+            __FUNCTION__,
+            {
+                { "EncodedDataSize", QString::number(encodedSize) }
+            }
+        );
+
+    return qFromLittleEndian<quint64>(encodedData);
+}
+
+/**
+ * Decode \p encodedSize bytes of \p encodedData directly into \p destination
+ * Might throw a ManiVaultException if decoding fails or the decoded size does not match \p destinationSize
+ * @param encodedData Pointer to the encoded data
+ * @param encodedSize Size of the encoded data in bytes
+ * @param destination Output buffer
+ * @param destinationSize Size of the output buffer in bytes
+ */
+void decodeBlockTo(const char* encodedData, std::uint64_t encodedSize, char* destination, std::uint64_t destinationSize)
+{
+    if (destination == nullptr)
+        throw mv::ManiVaultException(SeverityLevel::Error, "Failed to decode input data", "Destination buffer is null", __FUNCTION__);
+
+    const auto decodedSize = readDecodedSize(encodedData, encodedSize);
+
+    if (decodedSize != destinationSize || decodedSize > static_cast<std::uint64_t>(LZ4_MAX_INPUT_SIZE))
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            QString("Decoded size mismatch: expected %1 bytes, header reports %2 bytes").arg(destinationSize).arg(decodedSize),
+            __FUNCTION__
+        );
+
+    const auto blockSize = encodedSize - headerSize;
+
+    if (blockSize > static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+        throw mv::ManiVaultException(SeverityLevel::Error, "Failed to decode input data", "Encoded block exceeds the maximum LZ4 block size", __FUNCTION__);
+
+    const auto result = LZ4_decompress_safe(encodedData + headerSize, destination, static_cast<int>(blockSize), static_cast<int>(destinationSize));
+
+    if (result < 0 || static_cast<std::uint64_t>(result) != destinationSize)
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            result < 0 ? QString("LZ4 decompression failed (corrupt block)") : QString("Decoded size mismatch: expected %1 bytes, got %2 bytes").arg(destinationSize).arg(result),
+            __FUNCTION__
+        );
+}
+
+}
+
+Lz4BlobCodec::Lz4BlobCodec(QObject* parent, mv::gui::CodecSettingsAction* codecSettingsAction) :
+	BlobCodec(parent, codecSettingsAction)
+{
+#ifdef LZ4_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+}
+
+mv::util::BlobCodec::Type Lz4BlobCodec::getType() const
+{
+    return Type::Lz4;
+}
+
+QString Lz4BlobCodec::getName() const
+{
+    return QStringLiteral("lz4");
+}
+
+QByteArray Lz4BlobCodec::encode(const QByteArray& input) const
+{
+#ifdef LZ4_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    return encode(input.constData(), input.size());
+}
+
+QByteArray Lz4BlobCodec::encode(const char* data, qsizetype size) const
+{
+#ifdef LZ4_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    auto settings = dynamic_cast<Lz4CodecSettingsAction*>(getSettingsAction());
+
+    if (data == nullptr || !settings)
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to encode input data",
+            data == nullptr ? "Input data pointer is null" : "Invalid codec settings action",
+            __FUNCTION__,
+            {
+                { "InputPointer", QString::number(reinterpret_cast<std::uintptr_t>(data), 16) },
+                { "InputSize", QString::number(size) }
+            }
+        );
+
+    QByteArray output(getEncodedSizeBound(size), Qt::Uninitialized);
+
+    output.resize(encodeTo(*settings, data, size, output.data(), output.size()));
+
+    return output;
+}
+
+void Lz4BlobCodec::encodeToFile(const char* data, qsizetype size, const QString& filePath, std::uint64_t* numberOfEncodedBytes) const
+{
+#ifdef LZ4_CODEC_VERBOSE
+    qDebug() << __FUNCTION__ << filePath;
+#endif
+
+    auto settings = dynamic_cast<Lz4CodecSettingsAction*>(getSettingsAction());
+
+    if (data == nullptr || !settings)
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to encode input data",
+            data == nullptr ? "Input data pointer is null" : "Invalid codec settings action",
+            __FUNCTION__,
+            {
+                { "FilePath", filePath },
+                { "InputSize", QString::number(size) }
+            }
+        );
+
+    const auto bound = getEncodedSizeBound(size);
+
+    QFile file(filePath);
+
+    // Compress straight into the memory-mapped file, so no intermediate encoded buffer is needed
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate) || !file.resize(bound))
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to open file for writing",
+            QString("Unable to open file for writing: %1 (%2)").arg(filePath, file.errorString()),
+            __FUNCTION__,
+            {
+                { "FilePath", filePath },
+                { "InputSize", QString::number(size) }
+            }
+        );
+
+    auto* mapped = file.map(0, bound);
+
+    qsizetype encodedSize = 0;
+
+    if (mapped) {
+        encodedSize = encodeTo(*settings, data, size, reinterpret_cast<char*>(mapped), bound);
+
+        file.unmap(mapped);
+    }
+    else {
+        const auto encodedData = encode(data, size);
+
+        encodedSize = encodedData.size();
+
+        file.seek(0);
+
+        if (file.write(encodedData) != encodedSize)
+            encodedSize = -1;
+    }
+
+    if (encodedSize < 0 || !file.resize(encodedSize))
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to write file",
+            QString("Unable to write encoded data to: %1 (%2)").arg(filePath, file.errorString()),
+            __FUNCTION__,
+            {
+                { "FilePath", filePath },
+                { "QFileError", file.errorString() }
+            }
+        );
+
+    if (numberOfEncodedBytes != nullptr)
+        *numberOfEncodedBytes = static_cast<std::uint64_t>(encodedSize);
+}
+
+QByteArray Lz4BlobCodec::decode(const QByteArray& input, qsizetype expectedSize) const
+{
+#ifdef LZ4_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    const auto decodedSize = readDecodedSize(input.constData(), static_cast<std::uint64_t>(input.size()));
+
+    if (expectedSize >= 0 && decodedSize != static_cast<std::uint64_t>(expectedSize))
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            QStringLiteral("Decoded size mismatch. Header reports %1 bytes, expected %2 bytes").arg(decodedSize).arg(expectedSize),
+            __FUNCTION__,
+            {
+                { "HeaderSize", QString::number(decodedSize) },
+                { "ExpectedSize", QString::number(expectedSize) }
+            }
+        );
+
+    if (decodedSize > static_cast<std::uint64_t>(LZ4_MAX_INPUT_SIZE))
+        throw mv::ManiVaultException(SeverityLevel::Error, "Failed to decode input data", "Decoded size exceeds the maximum LZ4 block size", __FUNCTION__);
+
+    QByteArray output(static_cast<qsizetype>(decodedSize), Qt::Uninitialized);
+
+    decodeBlockTo(input.constData(), static_cast<std::uint64_t>(input.size()), output.data(), decodedSize);
+
+    return output;
+}
+
+void Lz4BlobCodec::decodeTo(const QByteArray& encodedData, char* destination, std::uint64_t destinationSize) const
+{
+#ifdef LZ4_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    decodeBlockTo(encodedData.constData(), static_cast<std::uint64_t>(encodedData.size()), destination, destinationSize);
+}
+
+QByteArray Lz4BlobCodec::decodeFromFile(const QString& filePath, qsizetype expectedSize) const
+{
+#ifdef LZ4_CODEC_VERBOSE
+    qDebug() << __FUNCTION__ << filePath;
+#endif
+
+    return decode(Archiver::readZipEntryToMemory(mv::projects().getCurrentProject()->getFilePath(), filePath), expectedSize);
+}
+
+void Lz4BlobCodec::decodeFromFileTo(const QString& filePath, char* destination, std::uint64_t destinationSize) const
+{
+#ifdef LZ4_CODEC_VERBOSE
+    qDebug() << __FUNCTION__ << filePath;
+#endif
+
+    decodeTo(Archiver::readZipEntryToMemory(mv::projects().getCurrentProject()->getFilePath(), filePath), destination, destinationSize);
+}
+
+QString Lz4BlobCodec::getFileExtension() const
+{
+    return QStringLiteral(".bin.lz4");
+}
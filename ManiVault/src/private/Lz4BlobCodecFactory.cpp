@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "Lz4BlobCodecFactory.h"
+#include "Lz4BlobCodec.h"
+#include "Lz4CodecSettingsAction.h"
+
+#ifdef _DEBUG
+	#define LZ4_CODEC_FACTORY_VERBOSE
+#endif
+
+Lz4BlobCodecFactory::Lz4BlobCodecFactory(QObject* parent /*= nullptr*/) :
+    BlobCodecFactory(parent),
+    _defaultSettingsAction(nullptr, "Default LZ4 settings")
+{
+#ifdef LZ4_CODEC_FACTORY_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+}
+
+Lz4BlobCodecFactory::~Lz4BlobCodecFactory()
+{
+#ifdef LZ4_CODEC_FACTORY_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+}
+
+mv::util::BlobCodec::Type Lz4BlobCodecFactory::type() const
+{
+	return mv::util::BlobCodec::Type::Lz4;
+}
+
+QString Lz4BlobCodecFactory::key() const
+{
+	return "lz4";
+}
+
+QString Lz4BlobCodecFactory::displayName() const
+{
+	return "LZ4";
+}
+
+std::shared_ptr<mv::util::BlobCodec> Lz4BlobCodecFactory::createCodec(QObject* parent, mv::gui::CodecSettingsAction* codecSettingsAction /*= nullptr*/) const
+{
+#ifdef LZ4_CODEC_FACTORY_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    return std::make_shared<Lz4BlobCodec>(parent, codecSettingsAction);
+}
+
+const mv::gui::CodecSettingsAction* Lz4BlobCodecFactory::getDefaultCodecSettingsAction() const
+{
+#ifdef LZ4_CODEC_FACTORY_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+	return &_defaultSettingsAction;
+}
+
+mv::gui::CodecSettingsAction* Lz4BlobCodecFactory::createCodecSettingsAction(QObject* parent) const
+{
+    return new Lz4CodecSettingsAction(parent, "LZ4 codec settings action");
+}
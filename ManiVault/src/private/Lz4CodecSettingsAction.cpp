@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "Lz4CodecSettingsAction.h"
+
+#include "util/BlobCodec.h"
+
+#ifdef _DEBUG
+	#define LZ4_CODEC_SETTINGS_ACTION_VERBOSE
+#endif
+
+using namespace mv;
+using namespace mv::gui;
+using namespace mv::util;
+
+Lz4CodecSettingsAction::Lz4CodecSettingsAction(QObject* parent, const QString& title) :
+    CodecSettingsAction(parent, title),
+    _accelerationAction(this, "Acceleration", 1, 65, 1),
+    _highCompressionAction(this, "High compression", false),
+    _highCompressionLevelAction(this, "HC level", 1, 12, 9)
+{
+#ifdef LZ4_CODEC_SETTINGS_ACTION_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    getTypeAction().setString(BlobCodec::typeToString(BlobCodec::Type::Lz4));
+
+    _accelerationAction.setToolTip("Acceleration of the fast compressor (higher is faster, but compresses less)");
+    _highCompressionAction.setToolTip("Use the LZ4-HC compressor: compresses better and decompresses just as fast, but compresses considerably slower");
+    _highCompressionLevelAction.setToolTip("LZ4-HC compression level");
+
+    addAction(&_accelerationAction);
+    addAction(&_highCompressionAction);
+    addAction(&_highCompressionLevelAction);
+
+    const auto updateReadOnly = [this]() -> void {
+        _accelerationAction.setEnabled(!_highCompressionAction.isChecked());
+        _highCompressionLevelAction.setEnabled(_highCompressionAction.isChecked());
+    };
+
+    updateReadOnly();
+
+    connect(&_highCompressionAction, &ToggleAction::toggled, this, updateReadOnly);
+}
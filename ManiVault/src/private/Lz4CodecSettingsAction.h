@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#pragma once
+
+#include <actions/CodecSettingsAction.h>
+#include <actions/IntegralAction.h>
+#include <actions/ToggleAction.h>
+
+/**
+ * @brief Settings action for the LZ4 blob codec.
+ *
+ * The action exposes the acceleration of the (default) fast LZ4 compressor and
+ * whether, and at which level, the high compression (LZ4-HC) compressor is used.
+ *
+ * @maintainer Thomas Kroes (BioVault - Biomedical Visual Analytics Unit LUMC - TU Delft)
+ */
+class Lz4CodecSettingsAction : public mv::gui::CodecSettingsAction
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief Constructs an LZ4 codec settings action.
+     * @param parent Optional parent object.
+     * @param title Action title.
+     */
+    Lz4CodecSettingsAction(QObject* parent, const QString& title);
+
+public:
+
+    /**
+     * @brief Returns the acceleration action.
+     * @return Acceleration action.
+     */
+    [[nodiscard]] mv::gui::IntegralAction& getAccelerationAction() { return _accelerationAction; }
+
+    /**
+     * @brief Returns the high compression action.
+     * @return High compression action.
+     */
+    [[nodiscard]] mv::gui::ToggleAction& getHighCompressionAction() { return _highCompressionAction; }
+
+    /**
+     * @brief Returns the high compression level action.
+     * @return High compression level action.
+     */
+    [[nodiscard]] mv::gui::IntegralAction& getHighCompressionLevelAction() { return _highCompressionLevelAction; }
+
+private:
+
+    mv::gui::IntegralAction  _accelerationAction;            /**< Acceleration of the fast compressor in the range [1, 65] (higher is faster, but compresses less). */
+    mv::gui::ToggleAction    _highCompressionAction;         /**< Uses the LZ4-HC compressor instead of the fast compressor. */
+    mv::gui::IntegralAction  _highCompressionLevelAction;    /**< LZ4-HC compression level in the range [1, 12]. */
+};
@@ -152,45 +152,20 @@ void PassthroughBlobCodec::decodeFromFileTo(const QString& filePath, char* desti
                                      }
         );
 
-    const auto encodedData = mv::util::Archiver::readZipEntryToMemory(mv::projects().getCurrentProject()->getFilePath(), filePath);
-
-    if (encodedData.isEmpty())
-        throw mv::ManiVaultException(
-            SeverityLevel::Error,
-            "Failed to decode from file to buffer",
-            "Encoded data is empty",
-            __FUNCTION__,
-            {
-                { "FilePath", filePath }
-            }
-        );
-
-    if (encodedData.size() != static_cast<qsizetype>(destinationSize))
-        throw mv::ManiVaultException(
-            SeverityLevel::Error,
-            QString("Encoded data size does not match destination buffer size. Encoded data size: %1 bytes, destination buffer size: %2 bytes").arg(encodedData.size()).arg(destinationSize),
-            "Encoded data size != destinationSize",
-            __FUNCTION__,
-            {
-                { "DestinationPointer", QString::number(reinterpret_cast<std::uintptr_t>(destination), 16) },
-                { "DestinationSize", QString::number(destinationSize) },
-                { "EncodedDataSize", QString::number(encodedData.size()) }
-            }
-        );
-
+    // Passthrough blocks are stored uncompressed in the archive, so they are read straight into the destination buffer
     try {
-    	memcpy(destination, encodedData.constData(), encodedData.size());
+        mv::util::Archiver::readZipEntryTo(mv::projects().getCurrentProject()->getFilePath(), filePath, destination, destinationSize);
     }
     catch (const std::exception& exception) {
 	    throw mv::ManiVaultException(
             SeverityLevel::Error,
-            "Failed to copy decoded data to destination buffer",
+            "Failed to read encoded data into destination buffer",
             exception.what(),
             __FUNCTION__,
             {
+                { "FilePath", filePath },
                 { "DestinationPointer", QString::number(reinterpret_cast<std::uintptr_t>(destination), 16) },
-                { "DestinationSize", QString::number(destinationSize) },
-                { "EncodedDataSize", QString::number(encodedData.size()) }
+                { "DestinationSize", QString::number(destinationSize) }
             }
         );
     }
@@ -198,13 +173,13 @@ void PassthroughBlobCodec::decodeFromFileTo(const QString& filePath, char* desti
     {
         throw mv::ManiVaultException(
             SeverityLevel::Error,
-            "Failed to copy decoded data to destination buffer: unknown error",
+            "Failed to read encoded data into destination buffer: unknown error",
             "Unknown error",
             __FUNCTION__,
             {
+                { "FilePath", filePath },
                 { "DestinationPointer", QString::number(reinterpret_cast<std::uintptr_t>(destination), 16) },
-                { "DestinationSize", QString::number(destinationSize) },
-                { "EncodedDataSize", QString::number(encodedData.size()) }
+                { "DestinationSize", QString::number(destinationSize) }
             }
         );
     }
@@ -18,6 +18,7 @@
 #include <models/HardwareSpecTreeModel.h>
 
 #include <util/Exception.h>
+#include <util/Serialization.h>
 #include <util/StandardPaths.h>
 
 #include <widgets/FileDialog.h>
@@ -272,6 +273,8 @@ void ProjectManager::reset()
             data().reset();
             plugins().reset();
         }
+
+        util::releaseEncodedBlocks();
     }
     endReset();
 }
@@ -749,7 +752,10 @@ void ProjectManager::saveProject(QString filePath)
 
         auto workflowPlan = createProjectSaveWorkflowPlan(filePath);
 
-        setTemporaryDirPath(TemporaryDirType::Save, workflowPlan->getWorkflowContextAs<ProjectSaveContext>()->getTemporaryDirectoryPath());
+        const auto saveContext = workflowPlan->getWorkflowContextAs<ProjectSaveContext>();
+
+        setTemporaryDirPath(TemporaryDirType::Save, saveContext->getTemporaryDirectoryPath());
+        setArchiveEntryWriter(saveContext->getArchiveStreamWriter());
 
         auto future = Application::getWorkflowPlanExecutor().execute(std::move(workflowPlan), nullptr, WorkflowOptions({
             .execution = {
@@ -767,7 +773,12 @@ void ProjectManager::saveProject(QString filePath)
             }
         }));
 
-        future.onFinished(this, [this](SharedWorkflowResult result) {
+        future.onFinished(this, [this, filePath](SharedWorkflowResult result) {
+            setArchiveEntryWriter(nullptr);
+
+            // Only blocks in the saved archive can be copied into the next one
+            util::releaseEncodedBlocks(filePath);
+
             setState(State::Idle);
             emit projectSaved(*_project);
         });
@@ -825,6 +836,7 @@ void ProjectManager::publishProject(QString filePath /*= ""*/)
             workspaceLockingAction->setLocked(workspaceWasLocked);
             unsetTemporaryDirPath(TemporaryDirType::Save);
             unsetTemporaryDirPath(TemporaryDirType::Publish);
+            setArchiveEntryWriter(nullptr);
             setState(State::Idle);
         };
 
@@ -840,12 +852,14 @@ void ProjectManager::publishProject(QString filePath /*= ""*/)
         }
         workspaceLockingAction->setLocked(true);
         auto workflowPlan = createProjectSaveWorkflowPlan(filePath);
-        const auto temporaryDirectoryPath = workflowPlan->getWorkflowContextAs<ProjectSaveContext>()->getTemporaryDirectoryPath();
+        const auto saveContext = workflowPlan->getWorkflowContextAs<ProjectSaveContext>();
+        const auto temporaryDirectoryPath = saveContext->getTemporaryDirectoryPath();
 
         // The serialization layer still resolves blobs through the save directory.
         // Also expose the directory as the publish directory for publish-specific clients.
         setTemporaryDirPath(TemporaryDirType::Save, temporaryDirectoryPath);
         setTemporaryDirPath(TemporaryDirType::Publish, temporaryDirectoryPath);
+        setArchiveEntryWriter(saveContext->getArchiveStreamWriter());
 
         auto future = Application::getWorkflowPlanExecutor().execute(std::move(workflowPlan), nullptr, WorkflowOptions({
             .execution = {
@@ -6,6 +6,7 @@
 #include "ProjectOpenContext.h"
 #include "ProjectManager.h"
 #include "Archiver.h"
+#include "ArchiveEntryIndex.h"
 
 #include <CoreInterface.h>
 
@@ -83,6 +84,8 @@ UniqueWorkflowPlan createProjectOpenWorkflowPlan(const QString& filePath)
 		archiver.extractSingleFile(context->getFilePath(), "project.json", context->getProjectJsonPath());
 		archiver.extractSingleFile(context->getFilePath(), "workspace.json", context->getWorkspaceJsonPath());
 
+        // Build the archive central directory index once, data blocks are read directly from their entry offsets later on
+        ArchiveEntryIndex::get(context->getFilePath());
     }, WorkflowPlan::JobThreadAffinity::GuiThread, 1.0);
 
     plan->addSequentialStage("Open meta JSON", [context](const WorkflowPlan::Job& job, const SharedWorkflowExecutionContext&) -> void {
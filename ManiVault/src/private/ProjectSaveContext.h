@@ -8,6 +8,7 @@
 
 #include "Application.h"
 #include "Archiver.h"
+#include "ArchiveStreamWriter.h"
 
 using UniqueTemporaryDir = std::unique_ptr<QTemporaryDir>;
 
@@ -30,7 +31,8 @@ public:
      */
     explicit ProjectSaveContext(const QString& filePath) :
 		_filePath(filePath),
-		_temporaryDirectory(new QTemporaryDir(QDir::cleanPath(mv::Application::current()->getTemporaryDir().path() + QDir::separator() + "SaveProject")))
+		_temporaryDirectory(new QTemporaryDir(QDir::cleanPath(mv::Application::current()->getTemporaryDir().path() + QDir::separator() + "SaveProject"))),
+		_archiveStreamWriter(std::make_shared<mv::util::ArchiveStreamWriter>(filePath))
     {
     }
 
@@ -124,6 +126,15 @@ public:
 		return _archiver;
 	}
 
+    /**
+     * @brief Get archive stream writer for writing entries directly into the project archive
+     * @return Shared pointer to the archive stream writer
+     */
+    mv::util::SharedArchiveStreamWriter getArchiveStreamWriter() const {
+        QMutexLocker locker(&_mutex);
+        return _archiveStreamWriter;
+    }
+
     /**
      * @brief Get error message
      * @return Error message string
@@ -134,12 +145,13 @@ public:
     }
 
 private:
-    mutable QMutex      _mutex;                 /** Mutex for synchronizing access to the context */
-    QString             _filePath;              /** Path to the project file */
-    QString             _workspaceJsonPath;     /** Path to the workspace JSON file */
-    QString             _projectJsonPath;       /** Path to the project JSON file */
-    QString             _metaJsonPath;          /** Path to the project meta JSON file */
-    UniqueTemporaryDir  _temporaryDirectory;    /** Temporary directory for saving the project */
-    mv::util::Archiver  _archiver;              /** Archiver for handling the project archive */
-    QString             _errorMessage;          /** Error message string for storing any error that occurs during the project saving process */
+    mutable QMutex                        _mutex;                 /** Mutex for synchronizing access to the context */
+    QString                               _filePath;              /** Path to the project file */
+    QString                               _workspaceJsonPath;     /** Path to the workspace JSON file */
+    QString                               _projectJsonPath;       /** Path to the project JSON file */
+    QString                               _metaJsonPath;          /** Path to the project meta JSON file */
+    UniqueTemporaryDir                    _temporaryDirectory;    /** Temporary directory for saving the project */
+    mv::util::Archiver                    _archiver;              /** Archiver for handling the project archive */
+    mv::util::SharedArchiveStreamWriter   _archiveStreamWriter;   /** Writer which streams encoded blocks into the project archive */
+    QString                               _errorMessage;          /** Error message string for storing any error that occurs during the project saving process */
 };
@@ -46,6 +46,9 @@ UniqueWorkflowPlan createProjectSaveWorkflowPlan(const QString& filePath)
 		context->setProjectJsonPath(QFileInfo(temporaryDirPath, "project.json").absoluteFilePath());
 		context->setMetaJsonPath(QFileInfo(temporaryDirPath, "meta.json").absoluteFilePath());
 
+        // Encoded data blocks are streamed into the project archive while the datasets are saved
+        context->getArchiveStreamWriter()->open();
+
 #ifdef PROJECT_SAVE_WORKFLOW_PLAN_VERBOSE
 		qDebug() << "Workspace JSON" << context->getWorkspaceJsonPath();
 		qDebug() << "Project JSON" << context->getProjectJsonPath();
@@ -90,12 +93,13 @@ UniqueWorkflowPlan createProjectSaveWorkflowPlan(const QString& filePath)
         qDebug() << "Archive";
 #endif
 
-        QDir tempDir(context->getTemporaryDirectoryPath());
-
-    	QStringList files = tempDir.entryList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+        // Data blocks are already in the archive, only the JSON files (and any other
+        // files that ended up in the temporary directory) remain to be added
+        const auto archiveStreamWriter = context->getArchiveStreamWriter();
 
-        context->getArchiver().compressDirectory(context->getTemporaryDirectoryPath(), context->getFilePath(), true, 0);
-    }, WorkflowPlan::JobThreadAffinity::CurrentWorkerThread, 10.0);
+        archiveStreamWriter->writeDirectory(context->getTemporaryDirectoryPath(), 0);
+        archiveStreamWriter->close();
+    }, WorkflowPlan::JobThreadAffinity::CurrentWorkerThread, 1.0);
 
     plan->addSequentialStage("Finalize", [context](const WorkflowPlan::Job& job, const SharedWorkflowExecutionContext& jobExecutionContext) -> void {
 #ifdef PROJECT_SAVE_WORKFLOW_PLAN_VERBOSE
@@ -117,6 +121,14 @@ UniqueWorkflowPlan createProjectSaveWorkflowPlan(const QString& filePath)
 
         Application::requestRemoveOverrideCursor(Qt::WaitCursor, true);
     }, WorkflowPlan::JobThreadAffinity::GuiThread, 1.0);
+
+    plan->addOnFailureStage("Discard archive", [context](const WorkflowPlan::Job& job, const SharedWorkflowExecutionContext& jobExecutionContext) -> void {
+#ifdef PROJECT_SAVE_WORKFLOW_PLAN_VERBOSE
+        qDebug() << "Discard archive";
+#endif
+
+        context->getArchiveStreamWriter()->abort();
+    });
     
     return plan;
 }
@@ -0,0 +1,627 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "ShuffleBlobCodec.h"
+#include "ShuffleCodecSettingsAction.h"
+
+#include "Archiver.h"
+
+#include <CoreInterface.h>
+
+#include <exception/ManiVaultException.h>
+
+#include <util/CodecRegistry.h>
+
+#include <QtEndian>
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define MV_SHUFFLE_CODEC_SSE2
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define MV_SHUFFLE_CODEC_NEON
+    #include <arm_neon.h>
+#endif
+
+#ifdef _DEBUG
+	#define SHUFFLE_CODEC_VERBOSE
+#endif
+
+using namespace mv::util;
+
+namespace {
+
+using Mode = ShuffleCodecSettingsAction::Mode;
+
+constexpr std::uint8_t  headerVersion   = 1;    /** Version of the encoded data header */
+constexpr qsizetype     headerSize      = 12;   /** Size of the encoded data header in bytes */
+
+/** Header which precedes the compressed shuffled data (the element size is stored in the blob map) */
+struct Header
+{
+    Mode                _mode;              /** Shuffle granularity */
+    BlobCodec::Type     _compressorType;    /** Type of the codec which compressed the shuffled data */
+    std::uint64_t       _size;              /** Decoded size in bytes */
+};
+
+/**
+ * Write \p header to the first headerSize bytes of \p destination
+ * Layout (little-endian): version (1), mode (1), compressor type (1), reserved (1), decoded size (8)
+ * @param header Header to write
+ * @param destination Destination buffer
+ */
+void writeHeader(const Header& header, char* destination)
+{
+    destination[0] = static_cast<char>(headerVersion);
+    destination[1] = static_cast<char>(header._mode);
+    destination[2] = static_cast<char>(header._compressorType);
+    destination[3] = 0;
+
+    qToLittleEndian<quint64>(header._size, destination + 4);
+}
+
+/**
+ * Read and validate the header of \p encodedData
+ * Might throw a ManiVaultException if the header is invalid
+ * @param encodedData Encoded data
+ * @return Header
+ */
+Header readHeader(const QByteArray& encodedData)
+{
+    if (encodedData.size() < headerSize)
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            "Encoded data is smaller than the shuffle header",
+            __FUNCTION__,
+            {
+                { "EncodedDataSize", QString::number(encodedData.size()) }
+            }
+        );
+
+    const auto* bytes = encodedData.constData();
+
+    const auto version          = static_cast<std::uint8_t>(bytes[0]);
+    const auto mode             = static_cast<std::uint8_t>(bytes[1]);
+    const auto compressorType   = static_cast<std::uint8_t>(bytes[2]);
+
+    if (version != headerVersion || mode > static_cast<std::uint8_t>(Mode::Bit))
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            "Unsupported shuffle header",
+            __FUNCTION__,
+            {
+                { "Version", QString::number(version) },
+                { "Mode", QString::number(mode) }
+            }
+        );
+
+    if (compressorType >= static_cast<std::uint8_t>(BlobCodec::Type::Count) || compressorType == static_cast<std::uint8_t>(BlobCodec::Type::Shuffle) || !codecRegistry().isRegistered(static_cast<BlobCodec::Type>(compressorType)))
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            "Shuffled data was compressed with an unknown codec",
+            __FUNCTION__,
+            {
+                { "CompressorType", QString::number(compressorType) }
+            }
+        );
+
+    Header header;
+
+    header._mode            = static_cast<Mode>(mode);
+    header._compressorType  = static_cast<BlobCodec::Type>(compressorType);
+    header._size            = qFromLittleEndian<quint64>(bytes + 4);
+
+    return header;
+}
+
+#if defined(MV_SHUFFLE_CODEC_SSE2) || defined(MV_SHUFFLE_CODEC_NEON)
+
+/** Number of elements which are transposed at once, one byte of each in a vector */
+constexpr std::size_t numberOfVectorElements = 16;
+
+#if defined(MV_SHUFFLE_CODEC_SSE2)
+
+using Vector = __m128i;
+
+inline Vector loadVector(const unsigned char* source) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)); }
+inline void storeVector(unsigned char* destination, Vector vector) { _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), vector); }
+inline Vector interleaveLow(Vector first, Vector second) { return _mm_unpacklo_epi8(first, second); }
+inline Vector interleaveHigh(Vector first, Vector second) { return _mm_unpackhi_epi8(first, second); }
+
+#else
+
+using Vector = uint8x16_t;
+
+inline Vector loadVector(const unsigned char* source) { return vld1q_u8(source); }
+inline void storeVector(unsigned char* destination, Vector vector) { vst1q_u8(destination, vector); }
+inline Vector interleaveLow(Vector first, Vector second) { return vzip1q_u8(first, second); }
+inline Vector interleaveHigh(Vector first, Vector second) { return vzip2q_u8(first, second); }
+
+#endif
+
+/**
+ * Interleave the bytes of the vectors in the first half of \p vectors with those in the second half, \p numberOfRounds times
+ *
+ * Sixteen elements of \p ElementSize bytes (loaded into \p ElementSize vectors) become \p ElementSize byte
+ * planes of sixteen bytes after four rounds, and byte planes become elements again after log2(\p ElementSize) rounds.
+ *
+ * @param vectors Vectors to transpose in place
+ * @param numberOfRounds Number of interleave rounds
+ */
+template<std::size_t ElementSize>
+void interleave(Vector (&vectors)[ElementSize], std::size_t numberOfRounds)
+{
+    constexpr auto half = ElementSize / 2;
+
+    for (std::size_t roundIndex = 0; roundIndex < numberOfRounds; ++roundIndex) {
+        Vector interleaved[ElementSize];
+
+        for (std::size_t vectorIndex = 0; vectorIndex < half; ++vectorIndex) {
+            interleaved[2 * vectorIndex]        = interleaveLow(vectors[vectorIndex], vectors[vectorIndex + half]);
+            interleaved[2 * vectorIndex + 1]    = interleaveHigh(vectors[vectorIndex], vectors[vectorIndex + half]);
+        }
+
+        for (std::size_t vectorIndex = 0; vectorIndex < ElementSize; ++vectorIndex)
+            vectors[vectorIndex] = interleaved[vectorIndex];
+    }
+}
+
+#endif
+
+/**
+ * Transpose \p numberOfElements elements of \p ElementSize bytes from \p source to byte planes in \p destination
+ * Groups of sixteen elements are transposed with byte interleaves in vector registers, the remainder element by element
+ * @param source Source elements
+ * @param destination Destination byte planes
+ * @param numberOfElements Number of elements
+ */
+template<std::size_t ElementSize>
+void byteShuffle(const unsigned char* source, unsigned char* destination, std::size_t numberOfElements)
+{
+    std::size_t elementIndex = 0;
+
+#if defined(MV_SHUFFLE_CODEC_SSE2) || defined(MV_SHUFFLE_CODEC_NEON)
+    for (; elementIndex + numberOfVectorElements <= numberOfElements; elementIndex += numberOfVectorElements) {
+        Vector vectors[ElementSize];
+
+        for (std::size_t vectorIndex = 0; vectorIndex < ElementSize; ++vectorIndex)
+            vectors[vectorIndex] = loadVector(source + elementIndex * ElementSize + vectorIndex * sizeof(Vector));
+
+        interleave(vectors, 4);
+
+        for (std::size_t byteIndex = 0; byteIndex < ElementSize; ++byteIndex)
+            storeVector(destination + byteIndex * numberOfElements + elementIndex, vectors[byteIndex]);
+    }
+#endif
+
+    for (; elementIndex < numberOfElements; ++elementIndex)
+        for (std::size_t byteIndex = 0; byteIndex < ElementSize; ++byteIndex)
+            destination[byteIndex * numberOfElements + elementIndex] = source[elementIndex * ElementSize + byteIndex];
+}
+
+/**
+ * Transpose \p numberOfElements elements of \p ElementSize bytes from byte planes in \p source back to elements in \p destination
+ * @param source Source byte planes
+ * @param destination Destination elements
+ * @param numberOfElements Number of elements
+ */
+template<std::size_t ElementSize>
+void byteUnshuffle(const unsigned char* source, unsigned char* destination, std::size_t numberOfElements)
+{
+    std::size_t elementIndex = 0;
+
+#if defined(MV_SHUFFLE_CODEC_SSE2) || defined(MV_SHUFFLE_CODEC_NEON)
+    constexpr std::size_t numberOfRounds = ElementSize == 2 ? 1 : (ElementSize == 4 ? 2 : 3);
+
+    for (; elementIndex + numberOfVectorElements <= numberOfElements; elementIndex += numberOfVectorElements) {
+        Vector vectors[ElementSize];
+
+        for (std::size_t byteIndex = 0; byteIndex < ElementSize; ++byteIndex)
+            vectors[byteIndex] = loadVector(source + byteIndex * numberOfElements + elementIndex);
+
+        interleave(vectors, numberOfRounds);
+
+        for (std::size_t vectorIndex = 0; vectorIndex < ElementSize; ++vectorIndex)
+            storeVector(destination + elementIndex * ElementSize + vectorIndex * sizeof(Vector), vectors[vectorIndex]);
+    }
+#endif
+
+    for (; elementIndex < numberOfElements; ++elementIndex)
+        for (std::size_t byteIndex = 0; byteIndex < ElementSize; ++byteIndex)
+            destination[elementIndex * ElementSize + byteIndex] = source[byteIndex * numberOfElements + elementIndex];
+}
+
+/**
+ * Byte shuffle (or unshuffle when \p inverse is true) \p size bytes of \p elementSize byte elements from \p source to \p destination
+ * Trailing bytes which do not form a complete element are copied as is
+ * @param source Source buffer
+ * @param destination Destination buffer (may not overlap with the source)
+ * @param size Size of the buffers in bytes
+ * @param elementSize Element size in bytes
+ * @param inverse Whether to undo the shuffle
+ */
+void byteShuffle(const char* source, char* destination, std::size_t size, std::size_t elementSize, bool inverse)
+{
+    const auto numberOfElements = size / elementSize;
+    const auto shuffledSize     = numberOfElements * elementSize;
+
+    const auto* sourceBytes = reinterpret_cast<const unsigned char*>(source);
+    auto* destinationBytes  = reinterpret_cast<unsigned char*>(destination);
+
+    switch (elementSize) {
+        case 1:
+            std::memcpy(destination, source, shuffledSize);
+            break;
+
+        case 2:
+            inverse ? byteUnshuffle<2>(sourceBytes, destinationBytes, numberOfElements) : byteShuffle<2>(sourceBytes, destinationBytes, numberOfElements);
+            break;
+
+        case 4:
+            inverse ? byteUnshuffle<4>(sourceBytes, destinationBytes, numberOfElements) : byteShuffle<4>(sourceBytes, destinationBytes, numberOfElements);
+            break;
+
+        case 8:
+            inverse ? byteUnshuffle<8>(sourceBytes, destinationBytes, numberOfElements) : byteShuffle<8>(sourceBytes, destinationBytes, numberOfElements);
+            break;
+
+        default:
+        {
+            for (std::size_t elementIndex = 0; elementIndex < numberOfElements; ++elementIndex) {
+                for (std::size_t byteIndex = 0; byteIndex < elementSize; ++byteIndex) {
+                    const auto elementByteIndex = elementIndex * elementSize + byteIndex;
+                    const auto planeByteIndex   = byteIndex * numberOfElements + elementIndex;
+
+                    destinationBytes[inverse ? elementByteIndex : planeByteIndex] = sourceBytes[inverse ? planeByteIndex : elementByteIndex];
+                }
+            }
+
+            break;
+        }
+    }
+
+    std::memcpy(destination + shuffledSize, source + shuffledSize, size - shuffledSize);
+}
+
+/**
+ * Transpose the 8x8 bit matrix in \p x (byte i is row i); the transpose is its own inverse
+ * @param x Bit matrix
+ * @return Transposed bit matrix
+ */
+std::uint64_t transposeBits8x8(std::uint64_t x)
+{
+    std::uint64_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+
+    return x;
+}
+
+/**
+ * Bit shuffle (or unshuffle when \p inverse is true) a byte plane of \p size bytes
+ *
+ * Groups of eight bytes are bit-transposed and bit k of each group is stored
+ * in bit row k, so the plane becomes eight rows of size / 8 bytes in which
+ * bits of equal significance are adjacent. Trailing bytes are copied as is.
+ *
+ * @param source Source plane
+ * @param destination Destination plane (may not overlap with the source)
+ * @param size Size of the plane in bytes
+ * @param inverse Whether to undo the shuffle
+ */
+void bitShufflePlane(const unsigned char* source, unsigned char* destination, std::size_t size, bool inverse)
+{
+    const auto numberOfGroups = size / 8;
+
+    std::size_t groupIndex = 0;
+
+#if defined(MV_SHUFFLE_CODEC_SSE2)
+    // Bit k of each byte of a vector is gathered with a byte mask after shifting it to the top bit (shifting 16-bit
+    // lanes is fine, only bits from within the same byte reach the top bit), two groups of eight bytes at a time
+    const auto gatherBits = [](Vector bytes, unsigned char* destination, std::size_t stride) -> void {
+        for (std::size_t bitIndex = 0; bitIndex < 8; ++bitIndex) {
+            const auto mask = _mm_movemask_epi8(_mm_slli_epi16(bytes, static_cast<int>(7 - bitIndex)));
+
+            destination[bitIndex * stride]      = static_cast<unsigned char>(mask);
+            destination[bitIndex * stride + 1]  = static_cast<unsigned char>(mask >> 8);
+        }
+    };
+
+    if (inverse) {
+        // Sixteen groups at a time: the eight rows of each group are gathered with byte interleaves first
+        for (; groupIndex + numberOfVectorElements <= numberOfGroups; groupIndex += numberOfVectorElements) {
+            Vector vectors[8];
+
+            for (std::size_t rowIndex = 0; rowIndex < 8; ++rowIndex)
+                vectors[rowIndex] = loadVector(source + rowIndex * numberOfGroups + groupIndex);
+
+            interleave(vectors, 3);
+
+            for (std::size_t vectorIndex = 0; vectorIndex < 8; ++vectorIndex) {
+                unsigned char bytes[16];
+
+                gatherBits(vectors[vectorIndex], bytes, 2);
+
+                // Byte i of the two groups is bit i of their rows
+                for (std::size_t byteIndex = 0; byteIndex < 8; ++byteIndex) {
+                    destination[(groupIndex + 2 * vectorIndex) * 8 + byteIndex]     = bytes[2 * byteIndex];
+                    destination[(groupIndex + 2 * vectorIndex + 1) * 8 + byteIndex] = bytes[2 * byteIndex + 1];
+                }
+            }
+        }
+    }
+    else {
+        for (; groupIndex + 2 <= numberOfGroups; groupIndex += 2)
+            gatherBits(loadVector(source + groupIndex * 8), destination + groupIndex, numberOfGroups);
+    }
+#endif
+
+    std::uint8_t rows[8];
+
+    for (; groupIndex < numberOfGroups; ++groupIndex) {
+        std::uint64_t matrix;
+
+        if (inverse) {
+            for (std::size_t rowIndex = 0; rowIndex < 8; ++rowIndex)
+                rows[rowIndex] = source[rowIndex * numberOfGroups + groupIndex];
+
+            std::memcpy(&matrix, rows, 8);
+
+            matrix = transposeBits8x8(matrix);
+
+            std::memcpy(destination + groupIndex * 8, &matrix, 8);
+        }
+        else {
+            std::memcpy(&matrix, source + groupIndex * 8, 8);
+
+            matrix = transposeBits8x8(matrix);
+
+            std::memcpy(rows, &matrix, 8);
+
+            for (std::size_t rowIndex = 0; rowIndex < 8; ++rowIndex)
+                destination[rowIndex * numberOfGroups + groupIndex] = rows[rowIndex];
+        }
+    }
+
+    std::memcpy(destination + numberOfGroups * 8, source + numberOfGroups * 8, size - numberOfGroups * 8);
+}
+
+/**
+ * Shuffle (or unshuffle when \p inverse is true) \p size bytes of \p elementSize byte elements from \p source to \p destination
+ * @param mode Shuffle granularity
+ * @param source Source buffer
+ * @param destination Destination buffer (may not overlap with the source)
+ * @param size Size of the buffers in bytes
+ * @param elementSize Element size in bytes
+ * @param inverse Whether to undo the shuffle
+ */
+void shuffle(Mode mode, const char* source, char* destination, std::size_t size, std::size_t elementSize, bool inverse)
+{
+    if (mode == Mode::Byte) {
+        byteShuffle(source, destination, size, elementSize, inverse);
+        return;
+    }
+
+    // Bit shuffle: byte planes first, then a bit transpose within each plane
+    const auto numberOfElements = size / elementSize;
+    const auto shuffledSize     = numberOfElements * elementSize;
+
+    std::vector<char> planes(shuffledSize);
+
+    const auto bitShufflePlanes = [&](const char* planesSource, char* planesDestination) -> void {
+        for (std::size_t planeIndex = 0; planeIndex < elementSize; ++planeIndex) {
+            const auto planeOffset = planeIndex * numberOfElements;
+
+            bitShufflePlane(reinterpret_cast<const unsigned char*>(planesSource + planeOffset), reinterpret_cast<unsigned char*>(planesDestination + planeOffset), numberOfElements, inverse);
+        }
+    };
+
+    if (inverse) {
+        bitShufflePlanes(source, planes.data());
+        byteShuffle(planes.data(), destination, shuffledSize, elementSize, true);
+    }
+    else {
+        byteShuffle(source, planes.data(), shuffledSize, elementSize, false);
+        bitShufflePlanes(planes.data(), destination);
+    }
+
+    std::memcpy(destination + shuffledSize, source + shuffledSize, size - shuffledSize);
+}
+
+}
+
+ShuffleBlobCodec::ShuffleBlobCodec(QObject* parent, mv::gui::CodecSettingsAction* codecSettingsAction) :
+	BlobCodec(parent, codecSettingsAction)
+{
+#ifdef SHUFFLE_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+}
+
+mv::util::BlobCodec::Type ShuffleBlobCodec::getType() const
+{
+    return Type::Shuffle;
+}
+
+QString ShuffleBlobCodec::getName() const
+{
+    return QStringLiteral("shuffle");
+}
+
+QByteArray ShuffleBlobCodec::encode(const QByteArray& input) const
+{
+#ifdef SHUFFLE_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    return encode(input.constData(), input.size());
+}
+
+QByteArray ShuffleBlobCodec::encode(const char* data, qsizetype size) const
+{
+#ifdef SHUFFLE_CODEC_VERBOSE
+    qDebug() << __FUNCTION__ << "element size" << getElementSize();
+#endif
+
+    if (data == nullptr || size <= 0)
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to encode input data",
+            data == nullptr ? "Input data pointer is null" : "Input data is empty",
+            __FUNCTION__,
+            {
+                { "InputPointer", QString::number(reinterpret_cast<std::uintptr_t>(data), 16) },
+                { "InputSize", QString::number(size) }
+            }
+        );
+
+    auto settings = dynamic_cast<ShuffleCodecSettingsAction*>(getSettingsAction());
+
+    if (!settings)
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to encode input data",
+            "Invalid codec settings action",
+            __FUNCTION__,
+            {
+                { "InputPointer", QString::number(reinterpret_cast<std::uintptr_t>(data), 16) },
+                { "InputSize", QString::number(size) }
+            }
+        );
+
+    const auto compressor = codecRegistry().createCodec(nullptr, &settings->getCompressorSettingsAction());
+
+    compressor->setNumberOfConcurrentBlocks(getNumberOfConcurrentBlocks());
+
+    Header header;
+
+    header._mode            = settings->getMode();
+    header._compressorType  = compressor->getType();
+    header._size            = static_cast<std::uint64_t>(size);
+
+    QByteArray shuffled(size, Qt::Uninitialized);
+
+    shuffle(header._mode, data, shuffled.data(), static_cast<std::size_t>(size), getElementSize(), false);
+
+    const auto compressed = compressor->encode(shuffled);
+
+    QByteArray output(headerSize + compressed.size(), Qt::Uninitialized);
+
+    writeHeader(header, output.data());
+
+    std::memcpy(output.data() + headerSize, compressed.constData(), static_cast<std::size_t>(compressed.size()));
+
+    return output;
+}
+
+QByteArray ShuffleBlobCodec::decode(const QByteArray& input, qsizetype expectedSize) const
+{
+#ifdef SHUFFLE_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    const auto header = readHeader(input);
+
+    if (expectedSize >= 0 && header._size != static_cast<std::uint64_t>(expectedSize))
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            QStringLiteral("Decoded size mismatch. Header reports %1 bytes, expected %2 bytes").arg(header._size).arg(expectedSize),
+            __FUNCTION__,
+            {
+                { "HeaderSize", QString::number(header._size) },
+                { "ExpectedSize", QString::number(expectedSize) }
+            }
+        );
+
+    if (header._size > static_cast<std::uint64_t>(std::numeric_limits<qsizetype>::max()))
+        throw mv::ManiVaultException(SeverityLevel::Error, "Failed to decode input data", "Decoded size exceeds maximum QByteArray size", __FUNCTION__);
+
+    QByteArray output(static_cast<qsizetype>(header._size), Qt::Uninitialized);
+
+    decodeTo(input, output.data(), header._size);
+
+    return output;
+}
+
+void ShuffleBlobCodec::decodeTo(const QByteArray& encodedData, char* destination, std::uint64_t destinationSize) const
+{
+#ifdef SHUFFLE_CODEC_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    if (destination == nullptr)
+        throw mv::ManiVaultException(SeverityLevel::Error, "Failed to decode input data", "Destination buffer is null", __FUNCTION__);
+
+    const auto header = readHeader(encodedData);
+
+    if (header._size != destinationSize)
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            QString("Decoded size mismatch: expected %1 bytes, header reports %2 bytes").arg(destinationSize).arg(header._size),
+            __FUNCTION__
+        );
+
+    const auto compressor   = codecRegistry().createCodec(nullptr, header._compressorType);
+    const auto compressed   = QByteArray::fromRawData(encodedData.constData() + headerSize, encodedData.size() - headerSize);
+
+    // Byte shuffling single-byte elements is the identity
+    if (header._mode == Mode::Byte && getElementSize() == 1) {
+        compressor->decodeTo(compressed, destination, destinationSize);
+        return;
+    }
+
+    std::vector<char> shuffled(destinationSize);
+
+    compressor->decodeTo(compressed, shuffled.data(), destinationSize);
+
+    shuffle(header._mode, shuffled.data(), destination, destinationSize, getElementSize(), true);
+}
+
+QByteArray ShuffleBlobCodec::decodeFromFile(const QString& filePath, qsizetype expectedSize) const
+{
+#ifdef SHUFFLE_CODEC_VERBOSE
+    qDebug() << __FUNCTION__ << filePath;
+#endif
+
+    const auto encodedData = Archiver::readZipEntryToMemory(mv::projects().getCurrentProject()->getFilePath(), filePath);
+
+    if (encodedData.isEmpty())
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to decode input data",
+            QString("ZIP entry '%1' is empty").arg(filePath),
+            __FUNCTION__
+        );
+
+    return decode(encodedData, expectedSize);
+}
+
+void ShuffleBlobCodec::decodeFromFileTo(const QString& filePath, char* destination, std::uint64_t destinationSize) const
+{
+#ifdef SHUFFLE_CODEC_VERBOSE
+    qDebug() << __FUNCTION__ << filePath;
+#endif
+
+    const auto encodedData = Archiver::readZipEntryToMemory(mv::projects().getCurrentProject()->getFilePath(), filePath);
+
+    decodeTo(encodedData, destination, destinationSize);
+}
+
+QString ShuffleBlobCodec::getFileExtension() const
+{
+    return QStringLiteral(".bin.shf");
+}
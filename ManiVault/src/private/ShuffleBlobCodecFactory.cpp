@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "ShuffleBlobCodecFactory.h"
+#include "ShuffleBlobCodec.h"
+#include "ShuffleCodecSettingsAction.h"
+
+#ifdef _DEBUG
+	#define SHUFFLE_CODEC_FACTORY_VERBOSE
+#endif
+
+ShuffleBlobCodecFactory::ShuffleBlobCodecFactory(QObject* parent /*= nullptr*/) :
+    BlobCodecFactory(parent),
+    _defaultSettingsAction(nullptr, "Default shuffle settings")
+{
+#ifdef SHUFFLE_CODEC_FACTORY_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+}
+
+ShuffleBlobCodecFactory::~ShuffleBlobCodecFactory()
+{
+#ifdef SHUFFLE_CODEC_FACTORY_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+}
+
+mv::util::BlobCodec::Type ShuffleBlobCodecFactory::type() const
+{
+	return mv::util::BlobCodec::Type::Shuffle;
+}
+
+QString ShuffleBlobCodecFactory::key() const
+{
+	return "shuffle";
+}
+
+QString ShuffleBlobCodecFactory::displayName() const
+{
+	return "Shuffle";
+}
+
+std::shared_ptr<mv::util::BlobCodec> ShuffleBlobCodecFactory::createCodec(QObject* parent, mv::gui::CodecSettingsAction* codecSettingsAction /*= nullptr*/) const
+{
+#ifdef SHUFFLE_CODEC_FACTORY_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    return std::make_shared<ShuffleBlobCodec>(parent, codecSettingsAction);
+}
+
+const mv::gui::CodecSettingsAction* ShuffleBlobCodecFactory::getDefaultCodecSettingsAction() const
+{
+#ifdef SHUFFLE_CODEC_FACTORY_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+	return &_defaultSettingsAction;
+}
+
+mv::gui::CodecSettingsAction* ShuffleBlobCodecFactory::createCodecSettingsAction(QObject* parent) const
+{
+    return new ShuffleCodecSettingsAction(parent, "Shuffle codec settings action");
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "ShuffleCodecSettingsAction.h"
+
+#include "util/BlobCodec.h"
+
+#ifdef _DEBUG
+	#define SHUFFLE_CODEC_SETTINGS_ACTION_VERBOSE
+#endif
+
+using namespace mv;
+using namespace mv::gui;
+using namespace mv::util;
+
+ShuffleCodecSettingsAction::ShuffleCodecSettingsAction(QObject* parent, const QString& title) :
+    CodecSettingsAction(parent, title),
+    _modeAction(this, "Shuffle", { "Byte", "Bit" }, "Byte"),
+    _compressorAction(this, "Compressor", { "Zstandard", "LZ4" }, "Zstandard"),
+    _zstdSettingsAction(this, "Zstandard"),
+    _lz4SettingsAction(this, "LZ4")
+{
+#ifdef SHUFFLE_CODEC_SETTINGS_ACTION_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    getTypeAction().setString(BlobCodec::typeToString(BlobCodec::Type::Shuffle));
+
+    _modeAction.setToolTip("Byte shuffle groups the bytes of equal significance of all elements, bit shuffle groups their bits (slower, but often better for low-precision data)");
+    _compressorAction.setToolTip("Compressor which encodes the shuffled data: Zstandard compresses better, LZ4 is faster");
+    _zstdSettingsAction.setToolTip("Settings of the Zstandard compressor");
+    _lz4SettingsAction.setToolTip("Settings of the LZ4 compressor");
+
+    // Blocks are partitioned by this action, the block size of the compressors is not used
+    _zstdSettingsAction.getBlockSizeAction().setForceHidden(true);
+    _lz4SettingsAction.getBlockSizeAction().setForceHidden(true);
+
+    addAction(&_modeAction);
+    addAction(&_compressorAction);
+    addAction(&_zstdSettingsAction);
+    addAction(&_lz4SettingsAction);
+
+    const auto compressorChanged = [this]() -> void {
+        _zstdSettingsAction.setVisible(&getCompressorSettingsAction() == &_zstdSettingsAction);
+        _lz4SettingsAction.setVisible(&getCompressorSettingsAction() == &_lz4SettingsAction);
+    };
+
+    compressorChanged();
+
+    connect(&_compressorAction, &OptionAction::currentIndexChanged, this, compressorChanged);
+}
+
+ShuffleCodecSettingsAction::Mode ShuffleCodecSettingsAction::getMode() const
+{
+    return _modeAction.getCurrentIndex() == 1 ? Mode::Bit : Mode::Byte;
+}
+
+CodecSettingsAction& ShuffleCodecSettingsAction::getCompressorSettingsAction()
+{
+    if (_compressorAction.getCurrentIndex() == 1)
+        return _lz4SettingsAction;
+
+    return _zstdSettingsAction;
+}
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#pragma once
+
+#include "Lz4CodecSettingsAction.h"
+#include "ZstdCodecSettingsAction.h"
+
+#include <actions/CodecSettingsAction.h>
+#include <actions/OptionAction.h>
+
+/**
+ * @brief Settings action for the shuffle blob codec.
+ *
+ * The action exposes the shuffle mode (byte or bit granularity), the compressor
+ * that encodes the shuffled data (Zstandard or LZ4) and its settings.
+ *
+ * @maintainer Thomas Kroes (BioVault - Biomedical Visual Analytics Unit LUMC - TU Delft)
+ */
+class ShuffleCodecSettingsAction : public mv::gui::CodecSettingsAction
+{
+    Q_OBJECT
+
+public:
+
+    /** Shuffle granularity */
+    enum class Mode
+    {
+        Byte,   /** Group bytes of equal significance */
+        Bit     /** Group bits of equal significance */
+    };
+
+public:
+
+    /**
+     * @brief Constructs a shuffle codec settings action.
+     * @param parent Optional parent object.
+     * @param title Action title.
+     */
+    ShuffleCodecSettingsAction(QObject* parent, const QString& title);
+
+    /**
+     * @brief Returns the selected shuffle mode.
+     * @return Shuffle mode.
+     */
+    [[nodiscard]] Mode getMode() const;
+
+    /**
+     * @brief Returns the settings action of the selected compressor which encodes the shuffled data.
+     * @return Compressor settings action.
+     */
+    [[nodiscard]] mv::gui::CodecSettingsAction& getCompressorSettingsAction();
+
+public:
+
+    /**
+     * @brief Returns the shuffle mode action.
+     * @return Shuffle mode action.
+     */
+    [[nodiscard]] mv::gui::OptionAction& getModeAction() { return _modeAction; }
+
+    /**
+     * @brief Returns the compressor action.
+     * @return Compressor action.
+     */
+    [[nodiscard]] mv::gui::OptionAction& getCompressorAction() { return _compressorAction; }
+
+    /**
+     * @brief Returns the Zstandard compressor settings action.
+     * @return Zstandard compressor settings action.
+     */
+    [[nodiscard]] ZstdCodecSettingsAction& getZstdSettingsAction() { return _zstdSettingsAction; }
+
+    /**
+     * @brief Returns the LZ4 compressor settings action.
+     * @return LZ4 compressor settings action.
+     */
+    [[nodiscard]] Lz4CodecSettingsAction& getLz4SettingsAction() { return _lz4SettingsAction; }
+
+private:
+
+    mv::gui::OptionAction    _modeAction;            /**< Shuffle granularity (byte or bit). */
+    mv::gui::OptionAction    _compressorAction;      /**< Compressor which encodes the shuffled data (Zstandard or LZ4). */
+    ZstdCodecSettingsAction  _zstdSettingsAction;    /**< Settings of the Zstandard compressor. */
+    Lz4CodecSettingsAction   _lz4SettingsAction;     /**< Settings of the LZ4 compressor. */
+};
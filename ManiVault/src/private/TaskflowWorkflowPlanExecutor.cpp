@@ -404,6 +404,45 @@ void TaskflowWorkflowPlanExecutor::executeJob(const WorkflowPlan::Job& job, Shar
     executeJobImpl(job, std::move(jobContext), true);
 }
 
+void TaskflowWorkflowPlanExecutor::parallelFor(std::uint64_t count, const std::function<void(std::uint64_t)>& function)
+{
+    if (count == 0)
+        return;
+
+    if (count == 1) {
+        function(0);
+        return;
+    }
+
+    tf::Taskflow taskflow;
+
+    taskflow.for_each_index(std::uint64_t{ 0 }, count, std::uint64_t{ 1 }, [&function](std::uint64_t index) -> void {
+        function(index);
+    });
+
+    tf::Executor* workerExecutor = nullptr;
+
+    auto future = [&]() -> tf::Future<void> {
+        std::scoped_lock lock(_executorMutex);
+
+        if (!_executor)
+            ensureExecutor({});
+
+        // A worker which waited for the loop could leave no worker to run it, so it runs the loop itself
+        if (_executor->this_worker_id() >= 0) {
+            workerExecutor = _executor.get();
+            return {};
+        }
+
+        return _executor->run(taskflow);
+    }();
+
+    if (workerExecutor)
+        workerExecutor->corun(taskflow);
+    else
+        future.get();
+}
+
 void TaskflowWorkflowPlanExecutor::ensureExecutor(const WorkflowOptions& options)
 {
 	const auto workerCount = resolveWorkerCount(options);
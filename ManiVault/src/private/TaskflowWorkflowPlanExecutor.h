@@ -105,6 +105,17 @@ public:
      */
     [[nodiscard]] mv::workflow::SharedWorkflowResult executeBlocking(mv::workflow::UniqueWorkflowPlan workflowPlan, mv::workflow::SharedWorkflowExecutionContext parentContext) override;
 
+    /**
+     * @brief Runs a data-parallel loop on the shared Taskflow executor.
+     *
+     * Called from a worker thread of the executor (e.g. inside a workflow job),
+     * the worker takes part in the loop instead of blocking on it.
+     *
+     * @param count Number of indices.
+     * @param function Function invoked with each index (concurrently).
+     */
+    void parallelFor(std::uint64_t count, const std::function<void(std::uint64_t)>& function) override;
+
 protected:
 
     /**
@@ -13,6 +13,15 @@
 
 #include <exception/ManiVaultException.h>
 
+#include <QScopeGuard>
+#include <QThread>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
 #ifdef _DEBUG
 	#define ZSTD_CODEC_VERBOSE
 #endif
@@ -25,16 +34,179 @@ QString getZstdErrorString(const char* prefix, size_t code) {
     return QStringLiteral("%1: %2").arg(QString::fromUtf8(prefix), QString::fromUtf8(ZSTD_getErrorName(code)));
 }
 
-static ZSTD_DCtx* getThreadLocalDCtx()
+/**
+ * Get the compression context of the calling thread
+ * The context is created on first use and freed when the thread exits, so
+ * contexts (and their internal buffers) are reused across blocks.
+ * @return Pointer to the thread-local compression context
+ */
+ZSTD_CCtx* getThreadLocalCCtx()
 {
-    thread_local ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx(ZSTD_createCCtx(), &ZSTD_freeCCtx);
+
+    if (!cctx)
+        throw std::runtime_error("ZSTD_createCCtx failed");
+
+    return cctx.get();
+}
+
+/**
+ * Get the decompression context of the calling thread
+ * The context is created on first use and freed when the thread exits.
+ * @return Pointer to the thread-local decompression context
+ */
+ZSTD_DCtx* getThreadLocalDCtx()
+{
+    thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(ZSTD_createDCtx(), &ZSTD_freeDCtx);
 
     if (!dctx)
         throw std::runtime_error("ZSTD_createDCtx failed");
 
-    return dctx;
+    return dctx.get();
+}
+
+/**
+ * Estimate the Shannon entropy (in bits per byte) of \p data from a number of evenly spaced samples
+ * @param data Pointer to the data
+ * @param size Size of the data in bytes
+ * @return Entropy estimate in the range [0, 8]
+ */
+double estimateEntropy(const char* data, std::size_t size)
+{
+    constexpr std::size_t numberOfSamples   = 16;
+    constexpr std::size_t sampleSize        = 4096;
+
+    std::array<std::uint32_t, 256> histogram{};
+
+    std::size_t numberOfProbedBytes = 0;
+
+    const auto probe = [&](std::size_t offset, std::size_t count) -> void {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(data + offset);
+
+        for (std::size_t byteIndex = 0; byteIndex < count; ++byteIndex)
+            ++histogram[bytes[byteIndex]];
+
+        numberOfProbedBytes += count;
+    };
+
+    if (size <= numberOfSamples * sampleSize) {
+        probe(0, size);
+    }
+    else {
+        const auto stride = (size - sampleSize) / (numberOfSamples - 1);
+
+        for (std::size_t sampleIndex = 0; sampleIndex < numberOfSamples; ++sampleIndex)
+            probe(sampleIndex * stride, sampleSize);
+    }
+
+    if (numberOfProbedBytes == 0)
+        return 0.0;
+
+    double entropy = 0.0;
+
+    for (const auto count : histogram) {
+        if (count == 0)
+            continue;
+
+        const auto probability = static_cast<double>(count) / static_cast<double>(numberOfProbedBytes);
+
+        entropy -= probability * std::log2(probability);
+    }
+
+    return entropy;
+}
+
+/**
+ * Choose a compression level in [\p minimumLevel, \p maximumLevel] for a block with \p entropy
+ * Low-entropy data gains most from higher levels, while (nearly) incompressible data is compressed with the lowest level
+ * @param entropy Entropy estimate in bits per byte
+ * @param minimumLevel Minimum compression level
+ * @param maximumLevel Maximum compression level
+ * @return Compression level
+ */
+std::int32_t chooseAdaptiveLevel(double entropy, std::int32_t minimumLevel, std::int32_t maximumLevel)
+{
+    if (minimumLevel > maximumLevel)
+        std::swap(minimumLevel, maximumLevel);
+
+    constexpr double incompressibleEntropy = 7.5;
+
+    if (entropy >= incompressibleEntropy)
+        return minimumLevel;
+
+    const auto compressibility = 1.0 - std::clamp(entropy / incompressibleEntropy, 0.0, 1.0);
+
+    return minimumLevel + static_cast<std::int32_t>(std::lround(compressibility * (maximumLevel - minimumLevel)));
 }
 
+/**
+ * Process-wide budget of zstd worker threads
+ *
+ * Every block which is being encoded already occupies a thread of its own (a worker of the
+ * workflow executor), so zstd worker threads are only handed out for the cores which are not
+ * busy encoding, regardless of the blob the concurrently encoded blocks belong to. This keeps
+ * the total number of compression threads at the number of cores.
+ */
+class WorkerBudget
+{
+public:
+
+    /**
+     * Start encoding a block and reserve at most \p maximumNumberOfWorkers zstd worker threads for it
+     * @param maximumNumberOfWorkers Maximum number of worker threads
+     * @param numberOfConcurrentBlocks Number of blocks of the same blob which are encoded concurrently
+     * @return Number of reserved worker threads (zero when the block is compressed by the calling thread only)
+     */
+    std::int32_t acquire(std::int32_t maximumNumberOfWorkers, std::size_t numberOfConcurrentBlocks)
+    {
+        const std::lock_guard lock(_mutex);
+
+        ++_numberOfActiveEncodes;
+
+        const auto numberOfCores            = std::max(QThread::idealThreadCount(), 1);
+        const auto numberOfIdleCores        = numberOfCores - _numberOfActiveEncodes - _numberOfReservedWorkers;
+        const auto numberOfCoresPerBlock    = static_cast<std::int32_t>(static_cast<std::size_t>(numberOfCores) / std::max<std::size_t>(numberOfConcurrentBlocks, 1));
+
+        auto numberOfWorkers = std::min({ maximumNumberOfWorkers, numberOfIdleCores, numberOfCoresPerBlock });
+
+        // A single worker thread only adds overhead
+        if (numberOfWorkers < 2)
+            numberOfWorkers = 0;
+
+        _numberOfReservedWorkers += numberOfWorkers;
+
+        return numberOfWorkers;
+    }
+
+    /**
+     * Finish encoding a block and return its \p numberOfWorkers worker threads to the budget
+     * @param numberOfWorkers Number of worker threads reserved by acquire()
+     */
+    void release(std::int32_t numberOfWorkers)
+    {
+        const std::lock_guard lock(_mutex);
+
+        --_numberOfActiveEncodes;
+
+        _numberOfReservedWorkers -= numberOfWorkers;
+    }
+
+    /** Get the number of worker threads which are currently reserved */
+    std::int32_t getNumberOfReservedWorkers() const
+    {
+        const std::lock_guard lock(_mutex);
+
+        return _numberOfReservedWorkers;
+    }
+
+private:
+    mutable std::mutex  _mutex;                         /** Protects the counts */
+    std::int32_t        _numberOfActiveEncodes = 0;     /** Number of blocks which are being encoded */
+    std::int32_t        _numberOfReservedWorkers = 0;   /** Number of zstd worker threads handed out */
+};
+
+WorkerBudget workerBudget;
+
 }
 
 ZstdBlobCodec::ZstdBlobCodec(QObject* parent, mv::gui::CodecSettingsAction* codecSettingsAction) :
@@ -136,22 +308,57 @@ QByteArray ZstdBlobCodec::encode(const char* data, qsizetype size) const
             }
         );
 
+    auto level = settings->getLevelAction().getValue();
+
+    if (settings->getAdaptiveLevelAction().isChecked())
+        level = chooseAdaptiveLevel(estimateEntropy(data, inputSize), settings->getMinimumLevelAction().getValue(), level);
+
+    // Only use zstd worker threads for the cores which are not busy encoding other blocks
+    const auto numberOfWorkers = settings->getMultithreadedAction().isChecked() ? workerBudget.acquire(settings->getMaximumNumberOfWorkersAction().getValue(), getNumberOfConcurrentBlocks()) : workerBudget.acquire(0, 1);
+
+    const auto releaseWorkers = qScopeGuard([numberOfWorkers]() -> void {
+        workerBudget.release(numberOfWorkers);
+    });
+
+    auto* cctx = getThreadLocalCCtx();
+
+    ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters);
+
+    if (const auto result = ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level); ZSTD_isError(result))
+        throw mv::ManiVaultException(
+            SeverityLevel::Error,
+            "Failed to encode input data",
+            getZstdErrorString("Unable to set the compression level", result),
+            __FUNCTION__,
+            {
+                { "Level", QString::number(level) }
+            }
+        );
+
+    // Always set explicitly, so the cached context never keeps the workers of a previous block. This
+    // fails when zstd is built without multithreading support, compression then simply runs single-threaded.
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, numberOfWorkers);
+
+#ifdef ZSTD_CODEC_VERBOSE
+    qDebug() << __FUNCTION__ << "level" << level << "workers" << numberOfWorkers;
+#endif
+
     QByteArray output;
     output.resize(static_cast<qsizetype>(bound));
 
-    const auto compressedSize = ZSTD_compress(
+    const auto compressedSize = ZSTD_compress2(
+        cctx,
         output.data(),
         bound,
         data,
-        inputSize,
-        settings->getLevelAction().getValue()
+        inputSize
     );
 
     if (ZSTD_isError(compressedSize))
         throw mv::ManiVaultException(
             SeverityLevel::Error,
             "Failed to encode input data",
-            getZstdErrorString("ZSTD_compress failed", compressedSize),
+            getZstdErrorString("ZSTD_compress2 failed", compressedSize),
             __FUNCTION__,
             {
                 { "InputPointer", QString::number(reinterpret_cast<std::uintptr_t>(data), 16) },
@@ -278,7 +485,7 @@ QByteArray ZstdBlobCodec::decode(const QByteArray& input, qsizetype expectedSize
             }
         );
 
-    const auto decompressedSize = ZSTD_decompressDCtx(ZSTD_createDCtx(), output.data(), static_cast<size_t>(output.size()), input.constData(), static_cast<size_t>(input.size()));
+    const auto decompressedSize = ZSTD_decompressDCtx(getThreadLocalDCtx(), output.data(), static_cast<size_t>(output.size()), input.constData(), static_cast<size_t>(input.size()));
 
     if (ZSTD_isError(decompressedSize))
         throw std::runtime_error(getZstdErrorString("ZSTD_decompress failed", decompressedSize).toStdString());
@@ -347,18 +554,7 @@ void ZstdBlobCodec::decodeTo(const QByteArray& encodedData, char* destination, s
     if (frameSize != destinationSize)
         throw std::runtime_error("ZSTD frame size mismatch");
 
-    auto* dctx = ZSTD_createDCtx();
-
-    if (!dctx)
-        throw std::runtime_error("ZSTD_createDCtx failed");
-
-    const auto decodedSize = ZSTD_decompressDCtx(dctx, destination, destinationSize, encodedData.constData(), static_cast<size_t>(encodedData.size()));
-
-    ZSTD_freeDCtx(dctx);
-
-    if (ZSTD_isError(decodedSize)) {
-        throw std::runtime_error(ZSTD_getErrorName(decodedSize));
-    }
+    const auto decodedSize = ZSTD_decompressDCtx(getThreadLocalDCtx(), destination, destinationSize, encodedData.constData(), static_cast<size_t>(encodedData.size()));
 
     if (ZSTD_isError(decodedSize))
         throw mv::ManiVaultException(
@@ -383,23 +579,11 @@ QByteArray ZstdBlobCodec::decodeFromFile(const QString& filePath, qsizetype expe
     qDebug() << __FUNCTION__ << filePath;
 #endif
 
-    QFile file(filePath);
-
-    if (!file.open(QIODevice::ReadOnly))
-        throw mv::ManiVaultException(
-            SeverityLevel::Error,
-            "Failed to open file for reading",
-            QString("Unable to open file for reading: %1").arg(filePath),
-            __FUNCTION__
-        );
-
     const auto zstdBytes = mv::util::Archiver::readZipEntryToMemory(mv::projects().getCurrentProject()->getFilePath(), filePath);
 
-    qDebug()
-        << "Read zstd entry"
-        << filePath
-        << "encodedData.size =" << zstdBytes.size()
-        << "expectedCompressedSize =" << expectedSize;
+#ifdef ZSTD_CODEC_VERBOSE
+    qDebug() << "Read zstd entry" << filePath << "encodedData.size =" << zstdBytes.size() << "expectedSize =" << expectedSize;
+#endif
 
     if (zstdBytes.isEmpty()) {
         throw mv::ManiVaultException(
@@ -432,6 +616,11 @@ void ZstdBlobCodec::decodeFromFileTo(const QString& filePath, char* destination,
     return decodeTo(encodedData, destination, destinationSize);
 }
 
+std::int32_t ZstdBlobCodec::getNumberOfReservedWorkers()
+{
+    return workerBudget.getNumberOfReservedWorkers();
+}
+
 QString ZstdBlobCodec::getFileExtension() const
 {
     return QStringLiteral(".bin.zst");
@@ -10,7 +10,10 @@
  * @brief Encodes blob data with Zstandard compression.
  *
  * ZstdBlobCodec compresses and decompresses raw blob data using the compression
- * level supplied by its codec settings action.
+ * level supplied by its codec settings action (or a level chosen per block from
+ * an entropy probe). Compression and decompression contexts are reused per thread.
+ * Blocks are compressed with additional zstd worker threads only as far as cores
+ * are not busy encoding other blocks (of any blob).
  *
  * @maintainer Thomas Kroes (BioVault - Biomedical Visual Analytics Unit LUMC - TU Delft)
  */
@@ -89,4 +92,10 @@ public:
      * @return File extension without a leading dot.
      */
     [[nodiscard]] QString getFileExtension() const override;
+
+    /**
+     * @brief Returns the number of zstd worker threads reserved by blocks which are being encoded.
+     * @return Number of worker threads, never more than the number of cores.
+     */
+    [[nodiscard]] static std::int32_t getNumberOfReservedWorkers();
 };
@@ -6,6 +6,8 @@
 
 #include "util/BlobCodec.h"
 
+#include <QThread>
+
 #ifdef _DEBUG
 	#define ZSTD_CODEC_SETTINGS_ACTION_VERBOSE
 #endif
@@ -16,7 +18,11 @@ using namespace mv::util;
 
 ZstdCodecSettingsAction::ZstdCodecSettingsAction(QObject* parent, const QString& title) :
     CodecSettingsAction(parent, title),
-    _levelAction(this, "Level", 1, 22, 3)
+    _levelAction(this, "Level", 1, 22, 3),
+    _adaptiveLevelAction(this, "Adaptive level", false),
+    _minimumLevelAction(this, "Min. level", 1, 22, 1),
+    _multithreadedAction(this, "Multithreaded", true),
+    _maximumNumberOfWorkersAction(this, "Max. workers", 1, 256, std::max(QThread::idealThreadCount(), 1))
 {
 #ifdef ZSTD_CODEC_SETTINGS_ACTION_VERBOSE
     qDebug() << __FUNCTION__;
@@ -24,5 +30,25 @@ ZstdCodecSettingsAction::ZstdCodecSettingsAction(QObject* parent, const QString&
 
     getTypeAction().setString(BlobCodec::typeToString(BlobCodec::Type::Zstd));
 
+    _levelAction.setToolTip("Compression level (the maximum level when the level is chosen adaptively)");
+    _adaptiveLevelAction.setToolTip("Choose the compression level per block from a quick entropy probe: data that compresses well gets a higher level, (nearly) incompressible data a lower one");
+    _minimumLevelAction.setToolTip("Lowest compression level used when the level is chosen adaptively");
+    _multithreadedAction.setToolTip("Compress a block with multiple Zstandard worker threads when cores are not busy encoding other blocks");
+    _maximumNumberOfWorkersAction.setToolTip("Maximum number of Zstandard worker threads used to compress a single block");
+
     addAction(&_levelAction);
+    addAction(&_adaptiveLevelAction);
+    addAction(&_minimumLevelAction);
+    addAction(&_multithreadedAction);
+    addAction(&_maximumNumberOfWorkersAction);
+
+    const auto updateReadOnly = [this]() -> void {
+        _minimumLevelAction.setEnabled(_adaptiveLevelAction.isChecked());
+        _maximumNumberOfWorkersAction.setEnabled(_multithreadedAction.isChecked());
+    };
+
+    updateReadOnly();
+
+    connect(&_adaptiveLevelAction, &ToggleAction::toggled, this, updateReadOnly);
+    connect(&_multithreadedAction, &ToggleAction::toggled, this, updateReadOnly);
 }
@@ -6,12 +6,14 @@
 
 #include <actions/CodecSettingsAction.h>
 #include <actions/IntegralAction.h>
+#include <actions/ToggleAction.h>
 
 /**
  * @brief Settings action for the Zstandard blob codec.
  *
  * The action exposes the compression level used when creating Zstandard codec
- * instances.
+ * instances, whether the level is chosen adaptively per block and whether
+ * Zstandard may use its internal worker threads.
  *
  * @maintainer Thomas Kroes (BioVault - Biomedical Visual Analytics Unit LUMC - TU Delft)
  */
@@ -36,7 +38,35 @@ public:
      */
     [[nodiscard]] mv::gui::IntegralAction& getLevelAction() { return _levelAction; }
 
+    /**
+     * @brief Returns the adaptive level action.
+     * @return Adaptive level action.
+     */
+    [[nodiscard]] mv::gui::ToggleAction& getAdaptiveLevelAction() { return _adaptiveLevelAction; }
+
+    /**
+     * @brief Returns the minimum (adaptive) compression level action.
+     * @return Minimum compression level action.
+     */
+    [[nodiscard]] mv::gui::IntegralAction& getMinimumLevelAction() { return _minimumLevelAction; }
+
+    /**
+     * @brief Returns the multithreaded compression action.
+     * @return Multithreaded compression action.
+     */
+    [[nodiscard]] mv::gui::ToggleAction& getMultithreadedAction() { return _multithreadedAction; }
+
+    /**
+     * @brief Returns the maximum number of workers action.
+     * @return Maximum number of workers action.
+     */
+    [[nodiscard]] mv::gui::IntegralAction& getMaximumNumberOfWorkersAction() { return _maximumNumberOfWorkersAction; }
+
 private:
 
-    mv::gui::IntegralAction  _levelAction;   /**< Compression level action in the range [1, 22]. */
+    mv::gui::IntegralAction  _levelAction;                   /**< Compression level action in the range [1, 22] (maximum level in adaptive mode). */
+    mv::gui::ToggleAction    _adaptiveLevelAction;           /**< Picks the compression level per block from an entropy probe. */
+    mv::gui::IntegralAction  _minimumLevelAction;            /**< Lowest compression level used in adaptive mode. */
+    mv::gui::ToggleAction    _multithreadedAction;           /**< Allows Zstandard to use worker threads when fewer blocks than cores are encoded. */
+    mv::gui::IntegralAction  _maximumNumberOfWorkersAction;  /**< Maximum number of Zstandard worker threads per block. */
 };
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <stdexcept>
 
 namespace mv
 {
@@ -118,6 +119,27 @@ namespace mv
             _dirtyPositions = true;
         }
 
+        void PointArrayObject::updatePositions(std::size_t offset, const std::vector<Vector2f>& positions)
+        {
+            if (positions.empty())
+                return;
+
+            if (offset > _positions.size() || positions.size() > _positions.size() - offset)
+                throw std::out_of_range("Updated positions exceed the point positions");
+
+            std::copy(positions.begin(), positions.end(), _positions.begin() + offset);
+
+            // Grow the dirty range to cover the updated positions
+            if (_dirtyPositionsBegin == _dirtyPositionsEnd) {
+                _dirtyPositionsBegin    = offset;
+                _dirtyPositionsEnd      = offset + positions.size();
+            }
+            else {
+                _dirtyPositionsBegin    = std::min(_dirtyPositionsBegin, offset);
+                _dirtyPositionsEnd      = std::max(_dirtyPositionsEnd, offset + positions.size());
+            }
+        }
+
         void PointArrayObject::setHighlights(const std::vector<char>& highlights)
         {
             _highlights = highlights;
@@ -277,6 +299,14 @@ namespace mv
 
                 _dirtyPositions = false;
             }
+            else if (_dirtyPositionsBegin < _dirtyPositionsEnd)
+            {
+                _positionBuffer.bind();
+                _positionBuffer.setSubData(_dirtyPositionsBegin, _positions.data() + _dirtyPositionsBegin, _dirtyPositionsEnd - _dirtyPositionsBegin);
+            }
+
+            _dirtyPositionsBegin    = 0;
+            _dirtyPositionsEnd      = 0;
 
             if (_dirtyHighlights)
             {
@@ -434,6 +464,11 @@ namespace mv
             _gpuPoints.setPositions(positions);
         }
 
+        void PointRenderer::updateData(std::size_t offset, const std::vector<Vector2f>& positions)
+        {
+            _gpuPoints.updatePositions(offset, positions);
+        }
+
         void PointRenderer::setHighlights(const std::vector<char>& highlights, const std::int32_t& numSelectedPoints)
         {
             _gpuPoints.setHighlights(highlights);
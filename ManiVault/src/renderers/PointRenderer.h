@@ -55,6 +55,7 @@ namespace mv
             PointArrayObject() : QOpenGLFunctions_3_3_Core(), _handle(0), _colorScalarsRange(0, 1, 1), _colorScalarsRange2(0, 1, 1), _colorScalarsRange3(0, 1, 1), _zOrderScalarsRange(0, 1, 1) {}
             void init();
             void setPositions(const std::vector<Vector2f>& positions);
+            void updatePositions(std::size_t offset, const std::vector<Vector2f>& positions);
             void setHighlights(const std::vector<char>& highlights);
             void setFocusHighlights(const std::vector<char>& focusHighlights);
             void setScalars(const std::vector<float>& scalars, bool adjustColorMapRange);
@@ -148,6 +149,8 @@ namespace mv
             Vector3f    _zOrderScalarsRange;    /** Scalar range of the point z-order scalars */
 
             bool _dirtyPositions        = false;
+            std::size_t _dirtyPositionsBegin    = 0;    /** Begin of the range of positions to upload (if not all are dirty) */
+            std::size_t _dirtyPositionsEnd      = 0;    /** End of the range of positions to upload (if not all are dirty) */
             bool _dirtyHighlights       = false;
             bool _dirtyFocusHighlights  = false;
             bool _dirtyColorScalars     = false;
@@ -191,6 +194,15 @@ namespace mv
             QRectF computeWorldBounds() const override;
 
             void setData(const std::vector<Vector2f>& points);
+
+            /**
+             * Update the positions of a contiguous range of points, only this range is uploaded to the GPU
+             * (e.g. in response to a mv::DataChangedRegion). The range must lie within the current positions.
+             * @param offset Index of the first point
+             * @param points Positions of the points
+             * @throws std::out_of_range if the range exceeds the current positions
+             */
+            void updateData(std::size_t offset, const std::vector<Vector2f>& points);
             void setHighlights(const std::vector<char>& highlights, const std::int32_t& numSelectedPoints);
             void setFocusHighlights(const std::vector<char>& focusHighlights, const std::int32_t& numberOfFocusHighlights);
             void setColorChannelScalars(const std::vector<float>& scalars, bool adjustColorMapRange = true);
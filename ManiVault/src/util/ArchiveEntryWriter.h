@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#pragma once
+
+#include "ManiVaultGlobals.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+namespace mv::util {
+
+/**
+ * Interface for writing entries directly into a project archive
+ *
+ * During project save, the project manager may expose an archive entry writer
+ * so that encoded data blocks are appended to the project archive as soon as
+ * they are encoded, instead of being written to the temporary save directory
+ * first and archived afterwards.
+ *
+ * Entries of a previously saved archive may be copied as they are, which
+ * allows data that did not change since the last save to skip encoding.
+ *
+ * Implementations must be thread-safe: entries may be written concurrently
+ * from multiple encoding workers.
+ *
+ * @author Thomas Kroes
+ */
+class CORE_EXPORT ArchiveEntryWriter
+{
+public:
+
+    /** Virtual destructor for proper cleanup in derived classes */
+    virtual ~ArchiveEntryWriter() = default;
+
+    /**
+     * Write \p data to the archive as a stored (uncompressed) entry named \p entryName
+     * Might throw a std::runtime_error exception if the entry cannot be written
+     * @param entryName Name of the entry in the archive
+     * @param data Entry data
+     */
+    virtual void writeEntry(const QString& entryName, const QByteArray& data) = 0;
+
+    /**
+     * Copy the entry named \p entryName from the archive at \p sourceArchiveFilePath into the archive as it is (without decoding and re-encoding it)
+     * Copying an entry that is already in the archive does nothing, so entries may be shared by several blob maps
+     * Might throw a std::runtime_error exception if the entry cannot be written
+     * @param sourceArchiveFilePath File path of the archive to copy from
+     * @param entryName Name of the entry in both archives
+     * @return Boolean determining whether the entry was copied or is already in the archive (false if the source archive or entry does not exist)
+     */
+    virtual bool copyEntry(const QString& sourceArchiveFilePath, const QString& entryName) = 0;
+
+    /**
+     * Copy the entries named \p entryNames from the archive at \p sourceArchiveFilePath into the archive as they are
+     * Nothing is copied unless the source archive contains all entries, so a failed copy does not leave orphaned entries in the archive
+     * Might throw a std::runtime_error exception if an entry cannot be written (the save fails and the partial archive is discarded)
+     * @param sourceArchiveFilePath File path of the archive to copy from
+     * @param entryNames Names of the entries in both archives
+     * @return Boolean determining whether all entries were copied or are already in the archive (false if the source archive or one of the entries does not exist)
+     */
+    virtual bool copyEntries(const QString& sourceArchiveFilePath, const QStringList& entryNames) = 0;
+
+    /**
+     * Get the file path of the archive once it is complete
+     * @return Archive file path
+     */
+    virtual QString getFilePath() const = 0;
+};
+
+using SharedArchiveEntryWriter = std::shared_ptr<ArchiveEntryWriter>;
+
+}
@@ -10,6 +10,7 @@
 
 #include <QFile>
 
+#include <algorithm>
 #include <stdexcept>
 
 #ifdef _DEBUG
@@ -228,6 +229,9 @@ QString BlobCodec::typeToString(Type type)
 	    case Type::None:        return QStringLiteral("none");
 	    case Type::QtCompress:  return QStringLiteral("qcompress");
 	    case Type::Zstd:        return QStringLiteral("zstd");
+	    case Type::Shuffle:     return QStringLiteral("shuffle");
+	    case Type::Lz4:         return QStringLiteral("lz4");
+	    case Type::DeltaVarint: return QStringLiteral("deltavarint");
 
         case Type::Count:
             break; // not a valid type, just a count of the number of types
@@ -247,6 +251,15 @@ BlobCodec::Type BlobCodec::typeFromString(const QString& typeString)
     if (typeString.compare(QStringLiteral("zstd"), Qt::CaseInsensitive) == 0)
         return Type::Zstd;
 
+    if (typeString.compare(QStringLiteral("shuffle"), Qt::CaseInsensitive) == 0)
+        return Type::Shuffle;
+
+    if (typeString.compare(QStringLiteral("lz4"), Qt::CaseInsensitive) == 0)
+        return Type::Lz4;
+
+    if (typeString.compare(QStringLiteral("deltavarint"), Qt::CaseInsensitive) == 0)
+        return Type::DeltaVarint;
+
     throw mv::ManiVaultException(
         SeverityLevel::Error,
         "Unknown blob codec type",
@@ -263,4 +276,24 @@ gui::CodecSettingsAction* BlobCodec::getSettingsAction() const
 	return _codecSettingsAction;
 }
 
+void BlobCodec::setNumberOfConcurrentBlocks(std::size_t numberOfConcurrentBlocks)
+{
+    _numberOfConcurrentBlocks = std::max<std::size_t>(numberOfConcurrentBlocks, 1);
+}
+
+std::size_t BlobCodec::getNumberOfConcurrentBlocks() const
+{
+    return _numberOfConcurrentBlocks;
+}
+
+void BlobCodec::setElementSize(std::uint32_t elementSize)
+{
+    _elementSize = std::max<std::uint32_t>(elementSize, 1);
+}
+
+std::uint32_t BlobCodec::getElementSize() const
+{
+    return _elementSize;
+}
+
 }
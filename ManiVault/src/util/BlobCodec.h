@@ -37,6 +37,9 @@ public:
         None,           /** No compression */
         QtCompress,     /** Qt compression */
         Zstd,           /** Zstandard compression */
+        Shuffle,        /** Byte/bit shuffle prefilter followed by compression */
+        Lz4,            /** LZ4 (and LZ4-HC) compression */
+        DeltaVarint,    /** Delta and variable-byte encoding of unsigned 32-bit indices */
 
         Count
     };
@@ -159,8 +162,36 @@ public:
      */
     gui::CodecSettingsAction* getSettingsAction() const;
 
+    /**
+     * Set the number of blocks that are encoded concurrently (including the block encoded by this codec)
+     * Codecs with internal multithreading may use this hint to decide how many worker threads to use per block
+     * @param numberOfConcurrentBlocks Number of blocks that are encoded concurrently
+     */
+    void setNumberOfConcurrentBlocks(std::size_t numberOfConcurrentBlocks);
+
+    /**
+     * Get the number of blocks that are encoded concurrently (including the block encoded by this codec)
+     * @return Number of blocks that are encoded concurrently
+     */
+    std::size_t getNumberOfConcurrentBlocks() const;
+
+    /**
+     * Set the size (in bytes) of the elements in the blob (e.g. four for float data)
+     * Codecs that exploit the structure of numeric data (such as shuffle prefilters) use this to group bytes of equal significance
+     * @param elementSize Element size in bytes
+     */
+    void setElementSize(std::uint32_t elementSize);
+
+    /**
+     * Get the size (in bytes) of the elements in the blob
+     * @return Element size in bytes (one when the data has no element structure)
+     */
+    std::uint32_t getElementSize() const;
+
 private:
-    gui::CodecSettingsActionPtr  _codecSettingsAction;    /* Cached settings action instance (if any) for this codec */
+    gui::CodecSettingsActionPtr  _codecSettingsAction;              /* Cached settings action instance (if any) for this codec */
+    std::size_t                  _numberOfConcurrentBlocks = 1;     /* Hint of the number of blocks that are encoded concurrently */
+    std::uint32_t                _elementSize = 1;                  /* Size (in bytes) of the elements in the blob */
 };
 
 using SharedCodec = std::shared_ptr<BlobCodec>;
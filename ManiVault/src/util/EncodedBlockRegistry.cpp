@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "EncodedBlockRegistry.h"
+
+#include <QMutexLocker>
+
+namespace mv::util
+{
+
+std::optional<EncodedBlockRegistry::EncodedBlock> EncodedBlockRegistry::find(const QString& key) const
+{
+    QMutexLocker lock(&_mutex);
+
+    if (const auto it = _encodedBlocks.constFind(key); it != _encodedBlocks.constEnd())
+        return *it;
+
+    return std::nullopt;
+}
+
+void EncodedBlockRegistry::add(const QString& key, const EncodedBlock& encodedBlock)
+{
+    QMutexLocker lock(&_mutex);
+
+    _encodedBlocks.insert(key, encodedBlock);
+}
+
+void EncodedBlockRegistry::release(const QString& archiveFilePath /*= ""*/)
+{
+    QMutexLocker lock(&_mutex);
+
+    if (archiveFilePath.isEmpty()) {
+        _encodedBlocks.clear();
+        _encodedBlocks.squeeze();
+
+        return;
+    }
+
+    for (auto it = _encodedBlocks.begin(); it != _encodedBlocks.end();) {
+        if (it->_archiveFilePath != archiveFilePath)
+            it = _encodedBlocks.erase(it);
+        else
+            ++it;
+    }
+}
+
+qsizetype EncodedBlockRegistry::getNumberOfBlocks() const
+{
+    QMutexLocker lock(&_mutex);
+
+    return _encodedBlocks.size();
+}
+
+}
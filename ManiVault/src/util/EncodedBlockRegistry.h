@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#pragma once
+
+#include "ManiVaultGlobals.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <cstdint>
+#include <optional>
+
+namespace mv::util
+{
+
+/**
+ * Encoded block registry class
+ *
+ * Remembers where encoded data blocks are stored, by their content key (the codec
+ * signature followed by the hash of the decoded block), so that identical blocks are
+ * copied from an archive instead of encoded again. Blocks are registered when they are
+ * saved or loaded, and are scoped to a project: only blocks in the archive which was
+ * saved last can be copied into the next one, blocks of other archives are released.
+ *
+ * The registry may be used from multiple (encoding) threads concurrently.
+ */
+class CORE_EXPORT EncodedBlockRegistry
+{
+public:
+
+    /** Encoded block in a project archive, shared by all blob maps with an identical block */
+    struct EncodedBlock
+    {
+        QString         _uri;                   /** Name of the entry in the archive */
+        std::uint64_t   _compressedSize = 0;    /** Size of the encoded block */
+        QString         _archiveFilePath;       /** File path of the archive that contains the entry */
+
+        bool operator==(const EncodedBlock& other) const = default;
+    };
+
+    /**
+     * Get the encoded block with content \p key
+     * @param key Content key (codec signature followed by the block hash)
+     * @return Encoded block, empty if no block with \p key was saved (or loaded)
+     */
+    std::optional<EncodedBlock> find(const QString& key) const;
+
+    /**
+     * Remember that the block with content \p key is stored as \p encodedBlock (replaces an earlier one)
+     * @param key Content key (codec signature followed by the block hash)
+     * @param encodedBlock Encoded block
+     */
+    void add(const QString& key, const EncodedBlock& encodedBlock);
+
+    /**
+     * Forget the encoded blocks which are not in the archive at \p archiveFilePath
+     * @param archiveFilePath File path of the archive whose blocks are kept (all blocks are forgotten when empty)
+     */
+    void release(const QString& archiveFilePath = "");
+
+    /**
+     * Get the number of registered blocks
+     * @return Number of blocks
+     */
+    qsizetype getNumberOfBlocks() const;
+
+private:
+    mutable QMutex                  _mutex;             /** Guards the encoded blocks */
+    QHash<QString, EncodedBlock>    _encodedBlocks;     /** Encoded blocks by content key */
+};
+
+}
@@ -0,0 +1,472 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "IndexSet.h"
+
+#include <algorithm>
+#include <bitset>
+#include <iterator>
+#include <limits>
+
+namespace mv::util
+{
+
+namespace
+{
+
+/**
+ * Get the number of set bits of \p bitmap
+ * @param bitmap Bitmap words
+ * @return Number of set bits
+ */
+std::uint32_t countBits(const std::vector<std::uint64_t>& bitmap)
+{
+    std::uint32_t count = 0;
+
+    for (const auto word : bitmap)
+        count += static_cast<std::uint32_t>(std::bitset<64>(word).count());
+
+    return count;
+}
+
+/**
+ * Create a bitmap container with bits [\p begin, \p end) set (\p end at most 65536)
+ * @param begin First bit
+ * @param end One past the last bit
+ * @param bitmapWords Number of words of the bitmap
+ * @return Bitmap words
+ */
+std::vector<std::uint64_t> createRangeBitmap(std::uint32_t begin, std::uint32_t end, std::uint32_t bitmapWords)
+{
+    std::vector<std::uint64_t> bitmap(bitmapWords, 0);
+
+    for (auto bit = begin; bit < end;) {
+        const auto wordIndex    = bit >> 6;
+        const auto wordEnd      = std::min(end, (wordIndex + 1) << 6);
+        const auto numberOfBits = wordEnd - bit;
+        const auto mask         = numberOfBits == 64 ? ~std::uint64_t{ 0 } : ((std::uint64_t{ 1 } << numberOfBits) - 1) << (bit & 63);
+
+        bitmap[wordIndex] |= mask;
+
+        bit = wordEnd;
+    }
+
+    return bitmap;
+}
+
+}
+
+IndexSet::IndexSet(const std::vector<std::uint32_t>& indices)
+{
+    const auto* sortedIndices = &indices;
+
+    std::vector<std::uint32_t> sortedCopy;
+
+    if (!std::is_sorted(indices.begin(), indices.end())) {
+        sortedCopy = indices;
+
+        std::sort(sortedCopy.begin(), sortedCopy.end());
+
+        sortedIndices = &sortedCopy;
+    }
+
+    // Chunks are built in one pass over the sorted indices
+    for (auto chunkBegin = sortedIndices->begin(); chunkBegin != sortedIndices->end();) {
+        const auto key      = static_cast<std::uint16_t>(*chunkBegin >> 16);
+        const auto chunkEnd = std::upper_bound(chunkBegin, sortedIndices->end(), (static_cast<std::uint32_t>(key) << 16) | 0xFFFFu);
+
+        Container container;
+
+        container.array.reserve(std::min<std::size_t>(std::distance(chunkBegin, chunkEnd), maximumArraySize + 1));
+
+        for (auto index = chunkBegin; index != chunkEnd; ++index) {
+            const auto low = static_cast<std::uint16_t>(*index & 0xFFFFu);
+
+            if (!container.array.empty() && container.array.back() == low)
+                continue;
+
+            container.array.push_back(low);
+
+            if (container.array.size() > maximumArraySize) {
+                container.cardinality = static_cast<std::uint32_t>(container.array.size());
+                container.toBitmap();
+
+                for (auto remaining = std::next(index); remaining != chunkEnd; ++remaining) {
+                    const auto remainingLow = *remaining & 0xFFFFu;
+
+                    container.bitmap[remainingLow >> 6] |= std::uint64_t{ 1 } << (remainingLow & 63);
+                }
+
+                container.cardinality = countBits(container.bitmap);
+
+                break;
+            }
+        }
+
+        if (!container.isBitmap())
+            container.cardinality = static_cast<std::uint32_t>(container.array.size());
+
+        append(key, std::move(container));
+
+        chunkBegin = chunkEnd;
+    }
+}
+
+IndexSet IndexSet::fromRange(std::uint64_t begin, std::uint64_t end)
+{
+    IndexSet indexSet;
+
+    end = std::min<std::uint64_t>(end, std::uint64_t{ 1 } << 32);
+
+    while (begin < end) {
+        const auto key      = static_cast<std::uint16_t>(begin >> 16);
+        const auto chunkEnd = std::min<std::uint64_t>(end, (static_cast<std::uint64_t>(key) + 1) << 16);
+        const auto lowBegin = static_cast<std::uint32_t>(begin & 0xFFFFu);
+        const auto lowEnd   = static_cast<std::uint32_t>(chunkEnd - (static_cast<std::uint64_t>(key) << 16));
+
+        Container container;
+
+        container.cardinality = lowEnd - lowBegin;
+
+        if (container.cardinality > maximumArraySize) {
+            container.bitmap = createRangeBitmap(lowBegin, lowEnd, bitmapWords);
+        }
+        else {
+            container.array.resize(container.cardinality);
+
+            for (std::uint32_t low = lowBegin; low < lowEnd; ++low)
+                container.array[low - lowBegin] = static_cast<std::uint16_t>(low);
+        }
+
+        indexSet.append(key, std::move(container));
+
+        begin = chunkEnd;
+    }
+
+    return indexSet;
+}
+
+std::vector<std::uint32_t> IndexSet::toIndices() const
+{
+    std::vector<std::uint32_t> indices;
+
+    indices.reserve(size());
+
+    forEach([&indices](std::uint32_t index) -> void {
+        indices.push_back(index);
+    });
+
+    return indices;
+}
+
+void IndexSet::add(std::uint32_t index)
+{
+    const auto key  = static_cast<std::uint16_t>(index >> 16);
+    const auto low  = static_cast<std::uint16_t>(index & 0xFFFFu);
+    const auto it   = std::lower_bound(_keys.begin(), _keys.end(), key);
+    const auto pos  = static_cast<std::size_t>(std::distance(_keys.begin(), it));
+
+    if (it == _keys.end() || *it != key) {
+        Container container;
+
+        container.array         = { low };
+        container.cardinality   = 1;
+
+        _keys.insert(it, key);
+        _containers.insert(_containers.begin() + pos, std::move(container));
+
+        return;
+    }
+
+    auto& container = _containers[pos];
+
+    if (container.isBitmap()) {
+        auto& word      = container.bitmap[low >> 6];
+        const auto mask = std::uint64_t{ 1 } << (low & 63);
+
+        if ((word & mask) == 0) {
+            word |= mask;
+            ++container.cardinality;
+        }
+
+        return;
+    }
+
+    const auto lowIt = std::lower_bound(container.array.begin(), container.array.end(), low);
+
+    if (lowIt != container.array.end() && *lowIt == low)
+        return;
+
+    container.array.insert(lowIt, low);
+
+    ++container.cardinality;
+
+    if (container.cardinality > maximumArraySize)
+        container.toBitmap();
+}
+
+bool IndexSet::contains(std::uint32_t index) const
+{
+    const auto key  = static_cast<std::uint16_t>(index >> 16);
+    const auto it   = std::lower_bound(_keys.begin(), _keys.end(), key);
+
+    if (it == _keys.end() || *it != key)
+        return false;
+
+    return _containers[std::distance(_keys.begin(), it)].contains(static_cast<std::uint16_t>(index & 0xFFFFu));
+}
+
+std::uint64_t IndexSet::size() const
+{
+    std::uint64_t size = 0;
+
+    for (const auto& container : _containers)
+        size += container.cardinality;
+
+    return size;
+}
+
+bool IndexSet::isEmpty() const
+{
+    return _keys.empty();
+}
+
+void IndexSet::clear()
+{
+    _keys.clear();
+    _containers.clear();
+}
+
+std::uint64_t IndexSet::getMemoryUsage() const
+{
+    std::uint64_t memoryUsage = sizeof(IndexSet) + _keys.capacity() * sizeof(std::uint16_t) + _containers.capacity() * sizeof(Container);
+
+    for (const auto& container : _containers)
+        memoryUsage += container.array.capacity() * sizeof(std::uint16_t) + container.bitmap.capacity() * sizeof(std::uint64_t);
+
+    return memoryUsage;
+}
+
+IndexSet IndexSet::unite(const IndexSet& other) const
+{
+    return combine(other, Operation::Union);
+}
+
+IndexSet IndexSet::intersect(const IndexSet& other) const
+{
+    return combine(other, Operation::Intersection);
+}
+
+IndexSet IndexSet::subtract(const IndexSet& other) const
+{
+    return combine(other, Operation::Difference);
+}
+
+IndexSet IndexSet::complement(std::uint64_t universeSize) const
+{
+    // The complement is the difference between the universe and this set
+    return fromRange(0, universeSize).subtract(*this);
+}
+
+bool IndexSet::operator==(const IndexSet& other) const
+{
+    if (_keys != other._keys)
+        return false;
+
+    for (std::size_t chunkIndex = 0; chunkIndex < _keys.size(); ++chunkIndex) {
+        const auto& lhs = _containers[chunkIndex];
+        const auto& rhs = other._containers[chunkIndex];
+
+        if (lhs.cardinality != rhs.cardinality)
+            return false;
+
+        // Containers are normalized (see Container::optimize()), so equal sets have equal representations
+        if (lhs.isBitmap() != rhs.isBitmap() || lhs.array != rhs.array || lhs.bitmap != rhs.bitmap)
+            return false;
+    }
+
+    return true;
+}
+
+void IndexSet::append(std::uint16_t key, Container&& container)
+{
+    if (container.cardinality == 0)
+        return;
+
+    _keys.push_back(key);
+    _containers.push_back(std::move(container));
+}
+
+IndexSet IndexSet::combine(const IndexSet& other, Operation operation) const
+{
+    IndexSet result;
+
+    std::size_t lhsIndex = 0, rhsIndex = 0;
+
+    // Merge the chunks by key; chunks which only occur on one side are copied or skipped depending on the operation
+    while (lhsIndex < _keys.size() || rhsIndex < other._keys.size()) {
+        const auto lhsKey = lhsIndex < _keys.size() ? static_cast<std::int32_t>(_keys[lhsIndex]) : std::numeric_limits<std::int32_t>::max();
+        const auto rhsKey = rhsIndex < other._keys.size() ? static_cast<std::int32_t>(other._keys[rhsIndex]) : std::numeric_limits<std::int32_t>::max();
+
+        if (lhsKey < rhsKey) {
+            if (operation != Operation::Intersection)
+                result.append(_keys[lhsIndex], Container(_containers[lhsIndex]));
+
+            ++lhsIndex;
+        }
+        else if (rhsKey < lhsKey) {
+            if (operation == Operation::Union)
+                result.append(other._keys[rhsIndex], Container(other._containers[rhsIndex]));
+
+            ++rhsIndex;
+        }
+        else {
+            result.append(_keys[lhsIndex], combine(_containers[lhsIndex], other._containers[rhsIndex], operation));
+
+            ++lhsIndex;
+            ++rhsIndex;
+        }
+    }
+
+    return result;
+}
+
+IndexSet::Container IndexSet::combine(const Container& lhs, const Container& rhs, Operation operation)
+{
+    Container result;
+
+    // Two arrays are merged
+    if (!lhs.isBitmap() && !rhs.isBitmap()) {
+        const auto lhsBegin = lhs.array.begin(), lhsEnd = lhs.array.end();
+        const auto rhsBegin = rhs.array.begin(), rhsEnd = rhs.array.end();
+
+        auto output = std::back_inserter(result.array);
+
+        switch (operation) {
+            case Operation::Union:
+                result.array.reserve(lhs.array.size() + rhs.array.size());
+                std::set_union(lhsBegin, lhsEnd, rhsBegin, rhsEnd, output);
+                break;
+
+            case Operation::Intersection:
+                result.array.reserve(std::min(lhs.array.size(), rhs.array.size()));
+                std::set_intersection(lhsBegin, lhsEnd, rhsBegin, rhsEnd, output);
+                break;
+
+            case Operation::Difference:
+                result.array.reserve(lhs.array.size());
+                std::set_difference(lhsBegin, lhsEnd, rhsBegin, rhsEnd, output);
+                break;
+        }
+
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+
+        if (result.cardinality > maximumArraySize)
+            result.toBitmap();
+
+        return result;
+    }
+
+    // An array is probed against a bitmap, when the result is a subset of the array
+    if (!lhs.isBitmap() && operation != Operation::Union) {
+        for (const auto low : lhs.array)
+            if (rhs.contains(low) == (operation == Operation::Intersection))
+                result.array.push_back(low);
+
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+
+        return result;
+    }
+
+    if (!rhs.isBitmap() && operation == Operation::Intersection) {
+        for (const auto low : rhs.array)
+            if (lhs.contains(low))
+                result.array.push_back(low);
+
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+
+        return result;
+    }
+
+    // Otherwise both sides are combined as bitmaps, word by word (these loops are vectorized by the compiler)
+    const auto getWords = [](const Container& container, Container& converted) -> const std::vector<std::uint64_t>& {
+        if (container.isBitmap())
+            return container.bitmap;
+
+        converted = container;
+        converted.toBitmap();
+
+        return converted.bitmap;
+    };
+
+    Container lhsConverted, rhsConverted;
+
+    const auto& lhsWords = getWords(lhs, lhsConverted);
+    const auto& rhsWords = getWords(rhs, rhsConverted);
+
+    result.bitmap.resize(bitmapWords);
+
+    auto* resultWords = result.bitmap.data();
+
+    switch (operation) {
+        case Operation::Union:
+            for (std::uint32_t wordIndex = 0; wordIndex < bitmapWords; ++wordIndex)
+                resultWords[wordIndex] = lhsWords[wordIndex] | rhsWords[wordIndex];
+            break;
+
+        case Operation::Intersection:
+            for (std::uint32_t wordIndex = 0; wordIndex < bitmapWords; ++wordIndex)
+                resultWords[wordIndex] = lhsWords[wordIndex] & rhsWords[wordIndex];
+            break;
+
+        case Operation::Difference:
+            for (std::uint32_t wordIndex = 0; wordIndex < bitmapWords; ++wordIndex)
+                resultWords[wordIndex] = lhsWords[wordIndex] & ~rhsWords[wordIndex];
+            break;
+    }
+
+    result.cardinality = countBits(result.bitmap);
+
+    result.optimize();
+
+    return result;
+}
+
+void IndexSet::Container::toBitmap()
+{
+    if (isBitmap())
+        return;
+
+    bitmap.assign(bitmapWords, 0);
+
+    for (const auto low : array)
+        bitmap[low >> 6] |= std::uint64_t{ 1 } << (low & 63);
+
+    std::vector<std::uint16_t>().swap(array);
+}
+
+void IndexSet::Container::optimize()
+{
+    if (!isBitmap() || cardinality > maximumArraySize)
+        return;
+
+    array.clear();
+    array.reserve(cardinality);
+
+    for (std::uint32_t wordIndex = 0; wordIndex < bitmapWords; ++wordIndex)
+        for (auto word = bitmap[wordIndex]; word != 0; word &= word - 1)
+            array.push_back(static_cast<std::uint16_t>((wordIndex << 6) | countTrailingZeros(word)));
+
+    std::vector<std::uint64_t>().swap(bitmap);
+}
+
+bool IndexSet::Container::contains(std::uint16_t low) const
+{
+    if (isBitmap())
+        return (bitmap[low >> 6] >> (low & 63)) & 1;
+
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+}
@@ -3,6 +3,7 @@
 // Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
 
 #include "PixelSelectionTool.h"
+#include "SelectionUpdateScheduler.h"
 
 #include <QDebug>
 
@@ -31,7 +32,8 @@ PixelSelectionTool::PixelSelectionTool(QWidget* targetWidget, const bool& enable
     _fixedLineAngleModifier(Qt::NoModifier),
     _mouseButtons(),
     _preventContextMenu(false),
-    _aborted(false)
+    _aborted(false),
+    _selectionUpdateScheduler(nullptr)
 {
     setMainColor(QColor(Qt::black));
 
@@ -220,6 +222,16 @@ void PixelSelectionTool::update()
     paint();
 }
 
+SelectionUpdateScheduler* PixelSelectionTool::getSelectionUpdateScheduler() const
+{
+    return _selectionUpdateScheduler;
+}
+
+void PixelSelectionTool::setSelectionUpdateScheduler(SelectionUpdateScheduler* selectionUpdateScheduler)
+{
+    _selectionUpdateScheduler = selectionUpdateScheduler;
+}
+
 void PixelSelectionTool::setAreaPixmap(const QPixmap& areaPixmap)
 {
     _areaPixmap = areaPixmap;
@@ -1000,6 +1012,14 @@ void PixelSelectionTool::endSelection()
 {
     emit ended();
 
+    // Apply the latest selection of the process right away (listeners of ended() may still schedule the final one)
+    if (_selectionUpdateScheduler) {
+        if (_aborted)
+            _selectionUpdateScheduler->cancel();
+        else
+            _selectionUpdateScheduler->flush();
+    }
+
     _mousePositions.clear();
 
     _active     = false;
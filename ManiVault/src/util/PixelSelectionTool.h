@@ -12,11 +12,14 @@
 #include <QMap>
 #include <QPen>
 #include <QBrush>
+#include <QPointer>
 
 class QPainter;
 
 namespace mv::util {
 
+class SelectionUpdateScheduler;
+
 /**
  * Pixel selection tool class
  *
@@ -163,6 +166,16 @@ public: // Getters/setters
     /** Updates the pixel selection tool (wraps internal paint method) */
     void update();
 
+    /** Get the selection update scheduler (nullptr if selections are not scheduled) */
+    SelectionUpdateScheduler* getSelectionUpdateScheduler() const;
+
+    /**
+     * Set the selection update scheduler to \p selectionUpdateScheduler, selections which are scheduled with it while
+     * the selection process is active (e.g. on areaChanged()) are applied when it ends, or discarded when it is aborted
+     * @param selectionUpdateScheduler Pointer to selection update scheduler (nullptr to stop scheduling)
+     */
+    void setSelectionUpdateScheduler(SelectionUpdateScheduler* selectionUpdateScheduler);
+
 private:
 
     void setAreaPixmap(const QPixmap& areaPixmap);
@@ -240,6 +253,7 @@ protected:
     QPixmap                     _areaPixmap;                /** Pixmap for the selection area */
     bool                        _preventContextMenu;        /** Whether to prevent a context menu */
     bool                        _aborted;                   /** Whether the selection process was aborted */
+    QPointer<SelectionUpdateScheduler>  _selectionUpdateScheduler;  /** Applies the scheduled selections (if any) */
 
     static const std::int32_t LAZY_UPDATE_INTERVAL = 10;
 
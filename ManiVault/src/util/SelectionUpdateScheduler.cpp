@@ -0,0 +1,331 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#include "SelectionUpdateScheduler.h"
+
+#include "CoreInterface.h"
+#include "Set.h"
+
+#include "util/Exception.h"
+
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace mv::util
+{
+
+SelectionUpdateScheduler::SelectionUpdateScheduler(const Dataset<DatasetImpl>& dataset, QObject* parent /*= nullptr*/) :
+    SelectionUpdateScheduler([this](const SelectionIndices& selectionIndices, const SelectionDelta& delta) -> void {
+        if (!_dataset.isValid())
+            return;
+
+        // The delta is relative to the previously applied selection, which is only the current one if it was not changed elsewhere since
+        if (delta.isIncremental() && _appliedSelectionRevision == _dataset->getSelectionRevision()) {
+            if (delta.isEmpty())
+                return;
+
+            _dataset->applySelectionDelta(delta);
+
+            events().notifyDatasetDataSelectionChanged(_dataset->getSourceDataset<DatasetImpl>(), delta);
+        }
+        else {
+            _dataset->setSelectionIndices(selectionIndices);
+
+            events().notifyDatasetDataSelectionChanged(_dataset->getSourceDataset<DatasetImpl>());
+        }
+
+        _appliedSelectionRevision = _dataset->getSelectionRevision();
+    }, parent)
+{
+    _dataset = dataset;
+}
+
+SelectionUpdateScheduler::SelectionUpdateScheduler(ApplySelectionFunction applySelection, QObject* parent /*= nullptr*/) :
+    QObject(parent),
+    _applySelection(std::move(applySelection)),
+    _frameInterval(defaultFrameInterval),
+    _generation(0),
+    _resolutionWatcher(nullptr)
+{
+    _applyTimer.setSingleShot(true);
+
+    connect(&_applyTimer, &QTimer::timeout, this, [this]() -> void {
+        apply();
+    });
+}
+
+SelectionUpdateScheduler::SelectionUpdateScheduler(ApplySelectionDeltaFunction applySelectionDelta, QObject* parent /*= nullptr*/) :
+    SelectionUpdateScheduler(ApplySelectionFunction(), parent)
+{
+    _applySelectionDelta = std::move(applySelectionDelta);
+}
+
+SelectionUpdateScheduler::~SelectionUpdateScheduler()
+{
+    cancel();
+}
+
+void SelectionUpdateScheduler::schedule(SelectionIndices selectionIndices)
+{
+    ++_generation;
+
+    if (_cancellationToken.has_value()) {
+        _cancellationToken->cancel();
+        _cancellationToken.reset();
+    }
+
+    _pendingSelectionIndices = std::move(selectionIndices);
+
+    scheduleApply();
+}
+
+void SelectionUpdateScheduler::schedule(ComputeSelectionFunction computeSelection)
+{
+    const auto generation = ++_generation;
+
+    // The computation supersedes the pending selection and the computation in flight
+    _pendingSelectionIndices.reset();
+
+    if (_cancellationToken.has_value())
+        _cancellationToken->cancel();
+
+    const CancellationToken cancellationToken;
+
+    _cancellationToken = cancellationToken;
+
+    auto futureWatcher = new QFutureWatcher<SelectionIndices>(this);
+
+    connect(futureWatcher, &QFutureWatcher<SelectionIndices>::finished, this, [this, futureWatcher, generation]() -> void {
+        futureWatcher->deleteLater();
+
+        // Discard the result of a superseded computation
+        if (generation != _generation)
+            return;
+
+        _cancellationToken.reset();
+
+        try {
+            _pendingSelectionIndices = futureWatcher->result();
+
+            scheduleApply();
+        }
+        catch (std::exception& e)
+        {
+            exceptionMessageBox("Unable to compute selection", e);
+        }
+        catch (...) {
+            exceptionMessageBox("Unable to compute selection");
+        }
+    });
+
+    // The computation only captures the function and its cancellation token, so it may outlive the scheduler
+    futureWatcher->setFuture(QtConcurrent::run([computeSelection = std::move(computeSelection), cancellationToken]() -> SelectionIndices {
+        if (cancellationToken.isCancelled())
+            return {};
+
+        return computeSelection(cancellationToken);
+    }));
+}
+
+void SelectionUpdateScheduler::flush()
+{
+    _applyTimer.stop();
+
+    // The resolution in flight is superseded by the pending selection, otherwise it is the latest selection and it is applied now
+    if (_resolutionWatcher && !_pendingSelectionIndices.has_value()) {
+        auto resolutionWatcher  = _resolutionWatcher;
+        auto cancellationToken  = *_resolutionCancellationToken;
+
+        resolutionWatcher->waitForFinished();
+
+        // Let the finished handler discard the resolution, it is applied here
+        cancellationToken.cancel();
+
+        _resolutionWatcher = nullptr;
+        _resolutionCancellationToken.reset();
+
+        try {
+            applyResolution(resolutionWatcher->result());
+        }
+        catch (std::exception& e)
+        {
+            exceptionMessageBox("Unable to resolve selection", e);
+        }
+        catch (...) {
+            exceptionMessageBox("Unable to resolve selection");
+        }
+
+        return;
+    }
+
+    apply(true);
+}
+
+void SelectionUpdateScheduler::cancel()
+{
+    ++_generation;
+
+    _applyTimer.stop();
+    _pendingSelectionIndices.reset();
+
+    if (_cancellationToken.has_value()) {
+        _cancellationToken->cancel();
+        _cancellationToken.reset();
+    }
+
+    if (_resolutionCancellationToken.has_value()) {
+        _resolutionCancellationToken->cancel();
+        _resolutionCancellationToken.reset();
+    }
+
+    _resolutionWatcher = nullptr;
+}
+
+bool SelectionUpdateScheduler::isPending() const
+{
+    return _pendingSelectionIndices.has_value() || _cancellationToken.has_value() || _resolutionCancellationToken.has_value();
+}
+
+SelectionUpdateScheduler::Resolution SelectionUpdateScheduler::resolve(SelectionIndices selectionIndices, const std::shared_ptr<const IndexSet>& previousIndexSet, const CancellationToken& cancellationToken)
+{
+    if (cancellationToken.isCancelled())
+        return {};
+
+    auto indexSet = std::make_shared<const IndexSet>(selectionIndices);
+
+    if (cancellationToken.isCancelled())
+        return {};
+
+    if (!previousIndexSet)
+        return { std::move(selectionIndices), std::move(indexSet), SelectionDelta() };
+
+    auto added = *indexSet - *previousIndexSet;
+
+    if (cancellationToken.isCancelled())
+        return {};
+
+    auto removed = *previousIndexSet - *indexSet;
+
+    return { std::move(selectionIndices), std::move(indexSet), SelectionDelta(std::move(added), std::move(removed)) };
+}
+
+Dataset<DatasetImpl> SelectionUpdateScheduler::getDataset() const
+{
+    return _dataset;
+}
+
+std::int32_t SelectionUpdateScheduler::getFrameInterval() const
+{
+    return _frameInterval;
+}
+
+void SelectionUpdateScheduler::setFrameInterval(std::int32_t frameInterval)
+{
+    _frameInterval = std::max(frameInterval, 0);
+}
+
+void SelectionUpdateScheduler::scheduleApply()
+{
+    // A selection which is scheduled while another one is resolved is applied after it
+    if (!_pendingSelectionIndices.has_value() || _applyTimer.isActive() || _resolutionWatcher)
+        return;
+
+    // Apply right away if the previous selection was applied at least a frame ago, otherwise at the end of the frame
+    const auto sinceApply = _sinceApplyTimer.isValid() ? _sinceApplyTimer.elapsed() : static_cast<qint64>(_frameInterval);
+
+    _applyTimer.start(static_cast<int>(std::max<qint64>(0, _frameInterval - sinceApply)));
+}
+
+void SelectionUpdateScheduler::apply(bool synchronous /*= false*/)
+{
+    if (!_pendingSelectionIndices.has_value())
+        return;
+
+    auto selectionIndices = std::move(*_pendingSelectionIndices);
+
+    _pendingSelectionIndices.reset();
+
+    if (_applySelectionDelta) {
+        if (_resolutionCancellationToken.has_value()) {
+            _resolutionCancellationToken->cancel();
+            _resolutionCancellationToken.reset();
+        }
+
+        _resolutionWatcher = nullptr;
+
+        if (synchronous)
+            applyResolution(resolve(std::move(selectionIndices), _appliedIndexSet, CancellationToken()));
+        else
+            resolveAsynchronously(std::move(selectionIndices));
+
+        return;
+    }
+
+    _sinceApplyTimer.restart();
+
+    if (!_applySelection)
+        return;
+
+    _applySelection(selectionIndices);
+
+    emit selectionApplied();
+}
+
+void SelectionUpdateScheduler::resolveAsynchronously(SelectionIndices selectionIndices)
+{
+    const CancellationToken cancellationToken;
+
+    _resolutionCancellationToken = cancellationToken;
+
+    auto resolutionWatcher = new QFutureWatcher<Resolution>(this);
+
+    _resolutionWatcher = resolutionWatcher;
+
+    connect(resolutionWatcher, &QFutureWatcher<Resolution>::finished, this, [this, resolutionWatcher, cancellationToken]() -> void {
+        resolutionWatcher->deleteLater();
+
+        // Discard a resolution which is cancelled, superseded or already applied by flush()
+        if (cancellationToken.isCancelled())
+            return;
+
+        _resolutionWatcher = nullptr;
+        _resolutionCancellationToken.reset();
+
+        try {
+            applyResolution(resolutionWatcher->result());
+        }
+        catch (std::exception& e)
+        {
+            exceptionMessageBox("Unable to resolve selection", e);
+        }
+        catch (...) {
+            exceptionMessageBox("Unable to resolve selection");
+        }
+
+        scheduleApply();
+    });
+
+    // The resolution only captures its inputs and its cancellation token, so it may outlive the scheduler
+    resolutionWatcher->setFuture(QtConcurrent::run([selectionIndices = std::move(selectionIndices), previousIndexSet = _appliedIndexSet, cancellationToken]() mutable -> Resolution {
+        return resolve(std::move(selectionIndices), previousIndexSet, cancellationToken);
+    }));
+}
+
+void SelectionUpdateScheduler::applyResolution(Resolution resolution)
+{
+    if (!resolution.indexSet)
+        return;
+
+    _sinceApplyTimer.restart();
+
+    _appliedIndexSet = std::move(resolution.indexSet);
+
+    _applySelectionDelta(resolution.selectionIndices, resolution.delta);
+
+    emit selectionApplied();
+}
+
+}
@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// A corresponding LICENSE file is located in the root directory of this source tree
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft)
+
+#pragma once
+
+#include "Dataset.h"
+
+#include "event/SelectionDelta.h"
+#include "util/IndexSet.h"
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace mv
+{
+    class DatasetImpl;
+}
+
+namespace mv::util
+{
+
+/**
+ * Selection update scheduler class
+ *
+ * Coalesces the selections of a dataset which are produced in rapid succession (e.g. while brushing with the pixel
+ * selection tool with notify during selection enabled) and only applies the latest one, at most once per frame.
+ * Applying a selection sets the selection indices of the dataset (which resolves its linked data) and notifies that
+ * the selection of its source dataset changed (with which it shares its selection), so intermediate selections never
+ * reach the linked datasets and selection groups.
+ *
+ * A selection may also be computed on a worker thread. When a newer selection is scheduled, the cancellation token of
+ * a computation in flight is cancelled and its result is discarded.
+ *
+ * Schedulers of a dataset resolve each selection on a worker thread into the delta with respect to the previously
+ * applied one (see resolve()), so that the GUI thread only applies the changed indices and propagates them to the
+ * linked datasets. The selection is replaced instead when it was changed elsewhere since. Resolutions run one at a
+ * time: selections which are scheduled in the meantime are coalesced and resolved after it, cancel() cancels it and
+ * flush() cancels it when a newer selection is pending.
+ */
+class CORE_EXPORT SelectionUpdateScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    using SelectionIndices = std::vector<std::uint32_t>;
+
+    /** Cancellation token of a selection computation, it is cancelled when a newer selection is scheduled */
+    class CancellationToken
+    {
+    public:
+
+        /** Get whether the computation is superseded by a newer selection (in which case it should return early) */
+        bool isCancelled() const {
+            return _cancelled->load(std::memory_order_relaxed);
+        }
+
+    private:
+
+        /** Cancel the computation */
+        void cancel() const {
+            _cancelled->store(true, std::memory_order_relaxed);
+        }
+
+    private:
+        std::shared_ptr<std::atomic_bool>   _cancelled = std::make_shared<std::atomic_bool>(false);     /** Shared with the computation on the worker thread */
+
+        friend class SelectionUpdateScheduler;
+    };
+
+    /** Computes selection indices on a worker thread, it should regularly check the cancellation token */
+    using ComputeSelectionFunction = std::function<SelectionIndices(const CancellationToken&)>;
+
+    /** Applies selection indices (on the thread of the scheduler) */
+    using ApplySelectionFunction = std::function<void(const SelectionIndices&)>;
+
+    /** Applies selection indices and their delta with respect to the previously applied selection indices (on the thread of the scheduler) */
+    using ApplySelectionDeltaFunction = std::function<void(const SelectionIndices&, const SelectionDelta&)>;
+
+    /** Selection which is resolved on a worker thread */
+    struct Resolution
+    {
+        SelectionIndices                        selectionIndices;   /** Scheduled selection indices */
+        std::shared_ptr<const IndexSet>         indexSet;           /** Index set of the selection indices (nullptr if the resolution was cancelled) */
+        SelectionDelta                          delta;              /** Delta with respect to the previously applied selection (replaced if none) */
+    };
+
+    static constexpr std::int32_t defaultFrameInterval = 16;    /** Default minimum interval between applied selections (in milliseconds) */
+
+public: // Construction/destruction
+
+    /**
+     * Construct with \p dataset and \p parent object
+     * @param dataset Dataset of which to schedule selection updates
+     * @param parent Pointer to parent object
+     */
+    SelectionUpdateScheduler(const Dataset<DatasetImpl>& dataset, QObject* parent = nullptr);
+
+    /**
+     * Construct with \p applySelection and \p parent object, for selections which are not applied by setting the selection indices of a dataset and notifying its source dataset
+     * @param applySelection Function which applies the selection indices
+     * @param parent Pointer to parent object
+     */
+    SelectionUpdateScheduler(ApplySelectionFunction applySelection, QObject* parent = nullptr);
+
+    /**
+     * Construct with \p applySelectionDelta and \p parent object, scheduled selections are resolved into deltas on a worker thread before they are applied
+     * @param applySelectionDelta Function which applies the selection indices and their delta
+     * @param parent Pointer to parent object
+     */
+    SelectionUpdateScheduler(ApplySelectionDeltaFunction applySelectionDelta, QObject* parent = nullptr);
+
+    /** Cancels a computation or resolution in flight */
+    ~SelectionUpdateScheduler() override;
+
+public: // Scheduling
+
+    /**
+     * Schedule \p selectionIndices, it replaces the selection which is pending (if any)
+     * @param selectionIndices Selection indices of the dataset
+     */
+    void schedule(SelectionIndices selectionIndices);
+
+    /**
+     * Schedule the selection indices computed by \p computeSelection on a worker thread, it replaces the selection
+     * which is pending (if any) and cancels a computation in flight
+     * @param computeSelection Function which computes the selection indices of the dataset
+     */
+    void schedule(ComputeSelectionFunction computeSelection);
+
+    /**
+     * Apply the pending selection immediately (e.g. at the end of the selection process), a selection which is still
+     * being computed is scheduled as usual once it is available. A resolution in flight is cancelled when a newer
+     * selection is pending, otherwise it is waited for.
+     */
+    void flush();
+
+    /** Discard the pending selection and cancel a computation or resolution in flight */
+    void cancel();
+
+    /** Get whether a selection is pending, being computed or being resolved */
+    bool isPending() const;
+
+    /**
+     * Resolve \p selectionIndices into the delta with respect to \p previousIndexSet (thread-safe)
+     * @param selectionIndices Selection indices to resolve
+     * @param previousIndexSet Index set of the previously applied selection (nullptr if none, in which case the delta replaces the selection)
+     * @param cancellationToken Cancellation token of the resolution
+     * @return Resolution (with a null index set if it was cancelled)
+     */
+    static Resolution resolve(SelectionIndices selectionIndices, const std::shared_ptr<const IndexSet>& previousIndexSet, const CancellationToken& cancellationToken);
+
+public: // Getters/setters
+
+    /** Get the dataset of which selection updates are scheduled (invalid when constructed with an apply function) */
+    Dataset<DatasetImpl> getDataset() const;
+
+    /** Get the minimum interval between applied selections (in milliseconds) */
+    std::int32_t getFrameInterval() const;
+
+    /**
+     * Set the minimum interval between applied selections to \p frameInterval
+     * @param frameInterval Frame interval in milliseconds
+     */
+    void setFrameInterval(std::int32_t frameInterval);
+
+private:
+
+    /** Apply the pending selection when the frame interval since the previously applied selection has elapsed */
+    void scheduleApply();
+
+    /**
+     * Apply the pending selection (if any), it is resolved on a worker thread first unless \p synchronous
+     * @param synchronous Whether to resolve the pending selection on the calling thread
+     */
+    void apply(bool synchronous = false);
+
+    /**
+     * Resolve \p selectionIndices on a worker thread and apply the resolution when done
+     * @param selectionIndices Selection indices to resolve
+     */
+    void resolveAsynchronously(SelectionIndices selectionIndices);
+
+    /**
+     * Apply \p resolution with the apply delta function
+     * @param resolution Resolved selection
+     */
+    void applyResolution(Resolution resolution);
+
+signals:
+
+    /** Signals that a scheduled selection has been applied to the dataset */
+    void selectionApplied();
+
+private:
+    Dataset<DatasetImpl>                                    _dataset;                       /** Dataset of which selection updates are scheduled */
+    ApplySelectionFunction                                  _applySelection;                /** Applies the selection indices */
+    ApplySelectionDeltaFunction                             _applySelectionDelta;           /** Applies the selection indices and their delta (selections are resolved if set) */
+    std::int32_t                                            _frameInterval;                 /** Minimum interval between applied selections (in milliseconds) */
+    QTimer                                                  _applyTimer;                    /** Single-shot timer which applies the pending selection */
+    QElapsedTimer                                           _sinceApplyTimer;               /** Measures the time since the previously applied selection */
+    std::optional<SelectionIndices>                         _pendingSelectionIndices;       /** Latest selection which is not applied yet */
+    std::uint64_t                                           _generation;                    /** Incremented for each scheduled selection, results of superseded computations are discarded */
+    std::optional<CancellationToken>                        _cancellationToken;             /** Cancellation token of the computation in flight */
+    std::shared_ptr<const IndexSet>                         _appliedIndexSet;               /** Index set of the previously applied selection */
+    QFutureWatcher<Resolution>*                             _resolutionWatcher;             /** Watches the resolution in flight (nullptr if none) */
+    std::optional<CancellationToken>                        _resolutionCancellationToken;   /** Cancellation token of the resolution in flight */
+    std::optional<std::uint64_t>                            _appliedSelectionRevision;      /** Selection revision of the dataset after the previously applied selection */
+};
+
+}
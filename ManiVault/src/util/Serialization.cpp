@@ -5,11 +5,14 @@
 #include "Serialization.h"
 #include "CoreInterface.h"
 #include "CodecRegistry.h"
+#include "EncodedBlockRegistry.h"
 
 #include "workflow/WorkflowRuntimeScoped.h"
 
 #include "exception/ManiVaultException.h"
 
+#include "actions/GroupAction.h"
+
 #include <QUuid>
 #include <QFileInfo>
 #include <QFile>
@@ -20,6 +23,9 @@
 #include <math.h>
 #include <limits>
 
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
 using namespace mv::workflow;
 
 namespace mv::util {
@@ -27,13 +33,70 @@ namespace mv::util {
 namespace
 {
 
+EncodedBlockRegistry encodedBlockRegistry;      /** Encoded blocks of the current project, see releaseEncodedBlocks() */
+
+/**
+ * Get the 128-bit XXH3 hash of \p size bytes at \p data
+ * @param data Pointer to the data
+ * @param size Number of bytes
+ * @return Hexadecimal hash string
+ */
+QString hashBlock(const char* data, std::uint64_t size)
+{
+    const auto hash = XXH3_128bits(data, static_cast<std::size_t>(size));
+
+    return QString("%1%2").arg(static_cast<qulonglong>(hash.high64), 16, 16, QChar('0')).arg(static_cast<qulonglong>(hash.low64), 16, 16, QChar('0'));
+}
+
+/**
+ * Append the values of the settings in \p action (recursively) to \p signature
+ * @param action Settings action
+ * @param signature Signature to append to
+ */
+void appendSettingsSignature(gui::WidgetAction* action, QByteArray& signature)
+{
+    if (action == nullptr)
+        return;
+
+    if (auto groupAction = dynamic_cast<gui::GroupAction*>(action)) {
+        for (auto childAction : groupAction->getActions())
+            appendSettingsSignature(childAction, signature);
+
+        return;
+    }
+
+    signature += action->text().toUtf8() + '=' + action->toVariantMap().value("Value").toString().toUtf8() + ';';
+}
+
+/**
+ * Get the signature of \p codec, which covers its name, element size and settings
+ * Identical blocks only yield identical encoded blocks when encoded with identical signatures
+ * @param codec Codec
+ * @return Hexadecimal signature string
+ */
+QString getCodecSignature(const BlobCodec& codec)
+{
+    QByteArray signature = codec.getName().toUtf8() + ':' + QByteArray::number(codec.getElementSize()) + ':';
+
+    appendSettingsSignature(codec.getSettingsAction(), signature);
+
+    return QString("%1").arg(static_cast<qulonglong>(XXH3_64bits(signature.constData(), static_cast<std::size_t>(signature.size()))), 16, 16, QChar('0'));
+}
+
 /**
  * Encode a single raw data block and store the encoded payload on disk.
  *
  * The function encodes the byte range described by `job._offset` and
- * `job._size` from the source buffer `job._data`. The encoded payload is
- * written to a uniquely named file inside `saveDir`, using the file extension
- * provided by the block codec.
+ * `job._size` from the source buffer `job._data`. When the project manager
+ * exposes an archive entry writer (during project save), the encoded payload
+ * is appended to the project archive directly as a stored entry. Otherwise it
+ * is written to a uniquely named file inside `saveDir`. In both cases the name
+ * is a UUID with the file extension provided by the block codec.
+ *
+ * Blocks written to the archive are content-addressed by their XXH3 hash and
+ * codec signature: a block that is identical to one that was saved (or loaded)
+ * before is not encoded again, its entry is shared (or copied from the archive
+ * it was saved to) instead.
  *
  * The returned result contains a block variant map with the metadata required
  * to decode the block later, including offset, decoded size, compressed size,
@@ -66,7 +129,36 @@ EncodeBlockResult encodeBlock(const EncodeBlockJob& job, const QString& saveDir)
 
         std::uint64_t numberOfEncodedBytes = 0;
 
-        job._codec->encodeToFile(job._data + job._offset, static_cast<qsizetype>(job._size), filePath, &numberOfEncodedBytes);
+        if (const auto archiveEntryWriter = projects().getArchiveEntryWriter()) {
+            const auto hash = hashBlock(job._data + job._offset, job._size);
+            const auto key  = job._codecSignature + hash;
+
+            blockVariantMap["Hash"] = hash;
+
+            // Identical blocks are stored once: the block is either already in the archive
+            // (saved by another blob) or can be copied from the archive it was saved to before
+            if (const auto encodedBlock = encodedBlockRegistry.find(key); encodedBlock && archiveEntryWriter->copyEntry(encodedBlock->_archiveFilePath, encodedBlock->_uri)) {
+                blockVariantMap["CompressedSize"]   = QVariant::fromValue<std::uint64_t>(encodedBlock->_compressedSize);
+                blockVariantMap["URI"]              = encodedBlock->_uri;
+
+                encodedBlockRegistry.add(key, { encodedBlock->_uri, encodedBlock->_compressedSize, archiveEntryWriter->getFilePath() });
+
+                result._block = std::move(blockVariantMap);
+
+                return result;
+            }
+
+            const auto encodedData = job._codec->encode(job._data + job._offset, static_cast<qsizetype>(job._size));
+
+            archiveEntryWriter->writeEntry(fileName, encodedData);
+
+            numberOfEncodedBytes = static_cast<std::uint64_t>(encodedData.size());
+
+            encodedBlockRegistry.add(key, { fileName, numberOfEncodedBytes, archiveEntryWriter->getFilePath() });
+        }
+        else {
+            job._codec->encodeToFile(job._data + job._offset, static_cast<qsizetype>(job._size), filePath, &numberOfEncodedBytes);
+        }
 
         blockVariantMap["CompressedSize"]   = QVariant::fromValue<std::uint64_t>(numberOfEncodedBytes);
         blockVariantMap["URI"]              = fileName;
@@ -96,18 +188,21 @@ EncodeBlockResult encodeBlock(const EncodeBlockJob& job, const QString& saveDir)
  *
  * Each returned job references the original input buffer, stores the byte offset
  * and block size for one block, and owns a fresh codec instance created with
- * createCodec(). The final block may be smaller than blockSizeInBytes.
+ * createCodec(). The final block may be smaller than blockSizeInBytes. The block
+ * size is rounded down to a multiple of elementSize so that blocks never split
+ * an element, and each codec is told the element size.
  *
  * @param bytes Pointer to the source byte buffer. May be null only when numberOfBytes is zero.
  * @param numberOfBytes Total number of bytes available in the source buffer.
  * @param createCodec Factory function used to create one codec instance per encode job.
  * @param blockSizeInBytes Maximum size of each encoded block.
+ * @param elementSize Size (in bytes) of the elements in the source buffer.
  * @return Encode jobs covering the full input buffer.
  *
  * @throws std::invalid_argument If bytes is null while numberOfBytes is non-zero.
  * @throws std::invalid_argument If blockSizeInBytes is zero.
  */
-EncodeBlockJobs makeEncodeBlockJobs(const char* bytes, std::uint64_t numberOfBytes, const std::function<SharedCodec()>& createCodec, std::uint64_t blockSizeInBytes)
+EncodeBlockJobs makeEncodeBlockJobs(const char* bytes, std::uint64_t numberOfBytes, const std::function<SharedCodec()>& createCodec, std::uint64_t blockSizeInBytes, std::uint32_t elementSize)
 {
     if (!bytes && numberOfBytes > 0)
         throw std::invalid_argument("bytes is null");
@@ -115,12 +210,20 @@ EncodeBlockJobs makeEncodeBlockJobs(const char* bytes, std::uint64_t numberOfByt
     if (blockSizeInBytes == 0)
         throw std::invalid_argument("blockSizeInBytes is zero");
 
+    if (elementSize == 0)
+        throw std::invalid_argument("elementSize is zero");
+
+    if (blockSizeInBytes >= elementSize)
+        blockSizeInBytes -= blockSizeInBytes % elementSize;
+
     EncodeBlockJobs jobs;
 
     const auto numberOfBlocks = (numberOfBytes + blockSizeInBytes - 1) / blockSizeInBytes;
 
     jobs.reserve(static_cast<int>(numberOfBlocks));
 
+    QString codecSignature;
+
     for (std::uint64_t offset = 0; offset < numberOfBytes;) {
         const auto blockSize = std::min(blockSizeInBytes, numberOfBytes - offset);
 
@@ -131,6 +234,15 @@ EncodeBlockJobs makeEncodeBlockJobs(const char* bytes, std::uint64_t numberOfByt
         job._size       = blockSize;
         job._codec      = createCodec();
 
+        job._codec->setNumberOfConcurrentBlocks(static_cast<std::size_t>(numberOfBlocks));
+        job._codec->setElementSize(elementSize);
+
+        // All codecs are created with the same settings, so the signature is computed once
+        if (codecSignature.isEmpty())
+            codecSignature = getCodecSignature(*job._codec);
+
+        job._codecSignature = codecSignature;
+
         jobs.push_back(std::move(job));
 
         offset += blockSize;
@@ -143,19 +255,20 @@ EncodeBlockJobs makeEncodeBlockJobs(const char* bytes, std::uint64_t numberOfByt
  * Create a blob metadata variant map from completed block encoding jobs.
  *
  * The returned variant map contains the original uncompressed size, codec name,
- * block size, number of blocks, and the serialized metadata for each encoded
- * block. All encode jobs must have completed successfully before calling this
+ * block size, element size (when larger than one byte), codec signature, number
+ * of blocks, and the serialized metadata for each encoded block. All encode jobs must have completed successfully before calling this
  * function.
  *
  * @param numberOfBytes Original size of the uncompressed data.
  * @param blockSizeInBytes Block size used during encoding.
  * @param codecName Name of the codec used to encode the blocks.
+ * @param elementSize Size (in bytes) of the elements in the uncompressed data.
  * @param jobs Completed encode jobs containing encoded block results.
  * @return Variant map describing the encoded blob and its blocks.
  *
  * @throws ManiVaultException If any block encoding operation failed.
  */
-QVariantMap makeBlobVariantMap(std::uint64_t numberOfBytes, std::uint64_t blockSizeInBytes, const QString& codecName, const EncodeBlockJobs& jobs)
+QVariantMap makeBlobVariantMap(std::uint64_t numberOfBytes, std::uint64_t blockSizeInBytes, const QString& codecName, std::uint32_t elementSize, const EncodeBlockJobs& jobs)
 {
     QVariantMap rawData;
 
@@ -178,6 +291,12 @@ QVariantMap makeBlobVariantMap(std::uint64_t numberOfBytes, std::uint64_t blockS
     rawData["BlockSize"]    = QVariant::fromValue(blockSizeInBytes);
     rawData["Blocks"]       = blocks;
 
+    if (!jobs.isEmpty())
+        rawData["CodecSignature"] = jobs.first()._codecSignature;
+
+    if (elementSize > 1)
+        rawData["ElementSize"] = QVariant::fromValue(elementSize);
+
     return rawData;
 }
 
@@ -214,6 +333,10 @@ DecodeBlockJobs makeDecodeBlockJobs(const QVariantMap& variantMap)
     const bool hasCodec     = variantMap.contains("Codec");
     const auto codecName    = hasCodec ? variantMap.value("Codec").toString() : QStringLiteral("none");
     const auto totalSize    = variantMap.value("Size").toULongLong(&totalSizeOk);
+    const auto elementSize  = std::max(variantMap.value("ElementSize", 1u).toUInt(), 1u);
+
+    const auto codecSignature   = variantMap.value("CodecSignature").toString();
+    const auto archiveFilePath  = projects().hasProject() ? projects().getCurrentProject()->getFilePath() : QString();
 
     if (blocks.isEmpty()) {
         return {};  // No blocks to decode, return empty job list
@@ -272,9 +395,16 @@ DecodeBlockJobs makeDecodeBlockJobs(const QVariantMap& variantMap)
         job._size               = size;
         job._compressedSize     = compressedSize;
         job._codec              = createCodec();
+
+        job._codec->setElementSize(elementSize);
+
         job._uri                = blockMap.value("URI").toString();
         job._encodedData        = blockMap.value("Data").toString();
 
+        // Loaded blocks can be copied (instead of encoded) when identical blocks are saved
+        if (!codecSignature.isEmpty() && !archiveFilePath.isEmpty() && !job._uri.isEmpty() && blockMap.contains("Hash"))
+            encodedBlockRegistry.add(codecSignature + blockMap.value("Hash").toString(), { job._uri, compressedSize, archiveFilePath });
+
         jobs.push_back(std::move(job));
     }
 
@@ -604,28 +734,48 @@ std::uint64_t getRawBlockObjectSize(const QVariantMap& map)
     return ok ? size : 0;
 }
 
+/**
+ * Encode a contiguous byte buffer block by block (sequentially) and describe it with a blob variant map.
+ *
+ * @param bytes Pointer to the source byte buffer.
+ * @param numberOfBytes Number of bytes in the source buffer.
+ * @param createCodec Factory function used to create one codec instance per block.
+ * @param elementSize Size (in bytes) of the elements in the source buffer.
+ * @return Variant map describing the encoded blob and its blocks.
+ */
+QVariantMap encodeBlobVariantMap(const char* bytes, std::uint64_t numberOfBytes, const std::function<SharedCodec()>& createCodec, std::uint32_t elementSize)
+{
+    const auto blockSizeInBytes = static_cast<std::uint64_t>(mv::projects().getCurrentProject()->getCompressionAction().getCodecSettingsAction()->getBlockSizeAction().getValue()) << 20;
+
+    auto jobs = makeEncodeBlockJobs(bytes, numberOfBytes, createCodec, blockSizeInBytes, elementSize);
+
+    const auto saveDir = QDir::cleanPath(projects().getTemporaryDirPath(AbstractProjectManager::TemporaryDirType::Save));
+
+    // Blocks are encoded one after the other here, so each codec may use all cores
+    for (auto& job : jobs) {
+        job._codec->setNumberOfConcurrentBlocks(1);
+        job._result = encodeBlock(job, saveDir);
+    }
+
+    return makeBlobVariantMap(numberOfBytes, blockSizeInBytes, createCodec()->getName(), elementSize, jobs);
+}
+
 }
 
-QVariantMap bytesToBlobVariantMap(const char* bytes, std::uint64_t numberOfBytes)
+void releaseEncodedBlocks(const QString& archiveFilePath /*= ""*/)
+{
+    encodedBlockRegistry.release(archiveFilePath);
+}
+
+QVariantMap bytesToBlobVariantMap(const char* bytes, std::uint64_t numberOfBytes, std::uint32_t elementSize /*= 1*/)
 {
     try {
         if (!mv::projects().hasProject())
             throw mv::ManiVaultException(SeverityLevel::Error, "Unable to save raw data", "No project is currently open", __FUNCTION__, {});
 
-        auto createCodec = []() -> SharedCodec {
+        return encodeBlobVariantMap(bytes, numberOfBytes, []() -> SharedCodec {
             return mv::projects().getCurrentProject()->getCompressionAction().createCodec(nullptr);
-        };
-
-        const auto blockSizeInBytes = static_cast<std::uint64_t>(mv::projects().getCurrentProject()->getCompressionAction().getCodecSettingsAction()->getBlockSizeAction().getValue()) << 20;
-
-        auto jobs = makeEncodeBlockJobs(bytes, numberOfBytes, createCodec, blockSizeInBytes);
-
-        const auto saveDir = QDir::cleanPath(projects().getTemporaryDirPath(AbstractProjectManager::TemporaryDirType::Save));
-
-        for (auto& job : jobs)
-            job._result = encodeBlock(job, saveDir);
-
-        return makeBlobVariantMap(numberOfBytes, blockSizeInBytes, createCodec()->getName(), jobs);
+        }, elementSize);
     }
     catch (const ManiVaultException& exception) {
         throw exception.withAddedDetails({{ "NumberOfBytes", QString::number(numberOfBytes) }});
@@ -637,26 +787,55 @@ QVariantMap bytesToBlobVariantMap(const char* bytes, std::uint64_t numberOfBytes
     }
 }
 
-UniqueWorkflowPlan bytesToBlobVariantMapWorkflow(const char* bytes, std::uint64_t numberOfBytes)
+QVariantMap indicesToBlobVariantMap(const std::uint32_t* indices, std::uint64_t numberOfIndices)
 {
+    const auto numberOfBytes = numberOfIndices * sizeof(std::uint32_t);
+
     try {
-        if (!bytes && numberOfBytes > 0)
-            throw std::invalid_argument("bytes is null");
+        if (!mv::projects().hasProject())
+            throw mv::ManiVaultException(SeverityLevel::Error, "Unable to save indices", "No project is currently open", __FUNCTION__, {});
 
-        if (!mv::projects().hasProject()) {
-            throw mv::ManiVaultException(SeverityLevel::Error, "Unable to save raw data", "No project is currently open", __FUNCTION__, {});
-        }
+        return encodeBlobVariantMap(reinterpret_cast<const char*>(indices), numberOfBytes, []() -> SharedCodec {
+            return codecRegistry().createCodec(nullptr, BlobCodec::Type::DeltaVarint);
+        }, sizeof(std::uint32_t));
+    }
+    catch (const ManiVaultException& exception) {
+        throw exception.withAddedDetails({{ "NumberOfIndices", QString::number(numberOfIndices) }});
+    }
+    catch (const std::exception& exception) {
+        throw ManiVaultException(SeverityLevel::Error, "Failed to convert indices to variant map", exception.what(), __FUNCTION__, {
+            { "NumberOfIndices", QString::number(numberOfIndices) }
+        });
+    }
+}
 
-        auto createCodec = []() -> SharedCodec {
-            return mv::projects().getCurrentProject()->getCompressionAction().createCodec(nullptr);
-        };
+UniqueWorkflowPlan bytesToBlobVariantMapWorkflow(const char* bytes, std::uint64_t numberOfBytes, std::uint32_t elementSize /*= 1*/)
+{
+    if (!mv::projects().hasProject()) {
+        throw mv::ManiVaultException(SeverityLevel::Error, "Unable to save raw data", "No project is currently open", __FUNCTION__, {
+            { "NumberOfBytes", QString::number(numberOfBytes) }
+        });
+    }
 
-        const auto maxBlockSizeInBytes = static_cast<std::uint64_t>(mv::projects().getCurrentProject()->getCompressionAction().getCodecSettingsAction()->getBlockSizeAction().getValue()) << 20;
+    const auto createCodec = []() -> SharedCodec {
+        return mv::projects().getCurrentProject()->getCompressionAction().createCodec(nullptr);
+    };
 
-        auto encodeBlockJobs = std::make_shared<EncodeBlockJobs>(makeEncodeBlockJobs(bytes, numberOfBytes, createCodec, maxBlockSizeInBytes));
+    const auto maxBlockSizeInBytes  = static_cast<std::uint64_t>(mv::projects().getCurrentProject()->getCompressionAction().getCodecSettingsAction()->getBlockSizeAction().getValue()) << 20;
+    const auto saveDir              = QDir::cleanPath(projects().getTemporaryDirPath(AbstractProjectManager::TemporaryDirType::Save));
 
-        const auto codecName    = createCodec()->getName();
-        const auto saveDir      = QDir::cleanPath(projects().getTemporaryDirPath(AbstractProjectManager::TemporaryDirType::Save));
+    return encodeBlobVariantMapWorkflow(bytes, numberOfBytes, createCodec, maxBlockSizeInBytes, saveDir, elementSize);
+}
+
+UniqueWorkflowPlan encodeBlobVariantMapWorkflow(const char* bytes, std::uint64_t numberOfBytes, const std::function<SharedCodec()>& createCodec, std::uint64_t blockSizeInBytes, const QString& saveDir, std::uint32_t elementSize /*= 1*/)
+{
+    try {
+        if (!bytes && numberOfBytes > 0)
+            throw std::invalid_argument("bytes is null");
+
+        auto encodeBlockJobs = std::make_shared<EncodeBlockJobs>(makeEncodeBlockJobs(bytes, numberOfBytes, createCodec, blockSizeInBytes, elementSize));
+
+        const auto codecName = createCodec()->getName();
 
         auto plan = std::make_unique<workflow::WorkflowPlan>("Encode blob");
 
@@ -677,8 +856,8 @@ UniqueWorkflowPlan bytesToBlobVariantMapWorkflow(const char* bytes, std::uint64_
             });
         }
 
-        plan->addSequentialStage("Publish blob map", [encodeBlockJobs, numberOfBytes, maxBlockSizeInBytes, codecName](const WorkflowPlan::Job&, const workflow::SharedWorkflowExecutionContext& executionContext) {
-            executionContext->setOutput(makeBlobVariantMap(numberOfBytes, maxBlockSizeInBytes, codecName, *encodeBlockJobs));
+        plan->addSequentialStage("Publish blob map", [encodeBlockJobs, numberOfBytes, blockSizeInBytes, codecName, elementSize](const WorkflowPlan::Job&, const workflow::SharedWorkflowExecutionContext& executionContext) {
+            executionContext->setOutput(makeBlobVariantMap(numberOfBytes, blockSizeInBytes, codecName, elementSize, *encodeBlockJobs));
         }, WorkflowPlan::JobThreadAffinity::CurrentWorkerThread, 1.0);
 
         return plan;
@@ -700,6 +879,59 @@ UniqueWorkflowPlan bytesToBlobVariantMapWorkflow(const char* bytes, std::uint64_
     }
 }
 
+bool copyBlobVariantMapBlocks(const QVariantMap& variantMap, const QString& sourceArchiveFilePath)
+{
+    try {
+        const auto archiveEntryWriter = projects().getArchiveEntryWriter();
+
+        if (!archiveEntryWriter || variantMap.isEmpty() || sourceArchiveFilePath.isEmpty() || !mv::projects().hasProject())
+            return false;
+
+        const auto blocks = variantMap.value("Blocks").toList();
+
+        // Blocks encoded with other codec settings (or a different block size) than the current ones have to be encoded again
+        if (!blocks.isEmpty()) {
+            auto& compressionAction = mv::projects().getCurrentProject()->getCompressionAction();
+
+            const auto codec        = compressionAction.createCodec(nullptr);
+            const auto elementSize  = std::max(variantMap.value("ElementSize", 1u).toUInt(), 1u);
+
+            codec->setElementSize(elementSize);
+
+            if (variantMap.value("Codec").toString() != codec->getName() || variantMap.value("CodecSignature").toString() != getCodecSignature(*codec))
+                return false;
+
+            auto blockSizeInBytes = static_cast<std::uint64_t>(compressionAction.getCodecSettingsAction()->getBlockSizeAction().getValue()) << 20;
+
+            if (blockSizeInBytes >= elementSize)
+                blockSizeInBytes -= blockSizeInBytes % elementSize;
+
+            if (variantMap.value("BlockSize").toULongLong() != blockSizeInBytes)
+                return false;
+        }
+
+        QStringList uris;
+
+        uris.reserve(blocks.size());
+
+        for (const auto& block : blocks) {
+            const auto uri = block.toMap().value("URI").toString();
+
+            if (uri.isEmpty())
+                return false;
+
+            uris << uri;
+        }
+
+        return archiveEntryWriter->copyEntries(sourceArchiveFilePath, uris);
+    }
+    catch (const std::exception& exception) {
+        throw ManiVaultException(SeverityLevel::Error, "Failed to copy encoded blocks", exception.what(), __FUNCTION__, {
+            { "SourceArchive", sourceArchiveFilePath }
+        });
+    }
+}
+
 void populateBytesFromBlobMap(QVariantMap variantMap, char* destination, std::uint64_t destinationSize)
 {
     if (variantMap.isEmpty()) {
@@ -831,12 +1063,12 @@ QVariantMap storeOnDisk(const QStringList& list)
 
 QVariantMap storeOnDisk(const QVector<uint32_t>& vector)
 {
-    QByteArray byteArray;
-    QDataStream dataStream(&byteArray, QIODevice::WriteOnly);
+    auto variantMap = indicesToBlobVariantMap(vector.constData(), static_cast<std::uint64_t>(vector.size()));
 
-	dataStream << vector;
+    // Distinguishes the raw indices from the data stream format which was used before
+    variantMap["RawIndices"] = true;
 
-    return bytesToBlobVariantMap((const char*)byteArray.data(), byteArray.size());
+    return variantMap;
 }
 
 void loadFromDisk(const QVariantMap& variantMap, QStringList& list)
@@ -853,6 +1085,15 @@ void loadFromDisk(const QVariantMap& variantMap, QStringList& list)
 
 void loadFromDisk(const QVariantMap& variantMap, QVector<uint32_t>& vec)
 {
+    if (variantMap.value("RawIndices", false).toBool()) {
+        vec.resize(static_cast<qsizetype>(variantMap["Size"].value<uint64_t>() / sizeof(std::uint32_t)));
+
+        if (!vec.isEmpty())
+            populateBytesFromBlobMap(variantMap, reinterpret_cast<char*>(vec.data()), static_cast<std::uint64_t>(vec.size()) * sizeof(std::uint32_t));
+
+        return;
+    }
+
     std::vector<char> bytes(variantMap["Size"].value<uint64_t>());
 
 	populateBytesFromBlobMap(variantMap, (char*)bytes.data(), static_cast<std::uint64_t>(bytes.size()));
@@ -863,6 +1104,11 @@ void loadFromDisk(const QVariantMap& variantMap, QVector<uint32_t>& vec)
 	dataStream >> vec;
 }
 
+std::uint64_t hashBytes(const void* data, std::uint64_t numberOfBytes)
+{
+    return numberOfBytes == 0 ? 0 : XXH3_64bits(data, static_cast<std::size_t>(numberOfBytes));
+}
+
 std::uint64_t estimateRawBlockTotalSize(const QVariant& value)
 {
     std::uint64_t totalSize = 0;
@@ -18,6 +18,7 @@
 #include <QVector>
 
 #include <cstdint>
+#include <functional>
 
 namespace mv::util {
 
@@ -41,6 +42,7 @@ struct EncodeBlockJob
     std::uint64_t       _size = 0;              /** Size of the block in bytes. */
     EncodeBlockResult   _result;                /** Encoding result populated after execution. */
     SharedCodec         _codec;                 /** Codec used to encode the block. */
+    QString             _codecSignature;        /** Signature of the codec and its settings, identical blocks with the same signature are stored once. */
 };
 
 using EncodeBlockJobs = QVector<EncodeBlockJob>;
@@ -78,9 +80,24 @@ using DecodeBlockJobs = QVector<DecodeBlockJob>;
  *
  * @param bytes Source byte buffer.
  * @param numberOfBytes Number of bytes in the source buffer.
+ * @param elementSize Size (in bytes) of the elements in the source buffer, used by codecs which exploit numeric structure.
  * @return Serialized blob variant map.
  */
-CORE_EXPORT QVariantMap bytesToBlobVariantMap(const char* bytes, std::uint64_t numberOfBytes);
+CORE_EXPORT QVariantMap bytesToBlobVariantMap(const char* bytes, std::uint64_t numberOfBytes, std::uint32_t elementSize = 1);
+
+/**
+ * Serialize an array of unsigned 32-bit indices into a blob variant map.
+ *
+ * Unlike bytesToBlobVariantMap(), the blocks are always encoded with the
+ * delta-varint index codec (regardless of the project compression settings),
+ * which stores mostly sorted indices in little over a byte per index. The
+ * result can be restored with populateBytesFromBlobMap() like any other blob.
+ *
+ * @param indices Source indices.
+ * @param numberOfIndices Number of indices.
+ * @return Serialized blob variant map.
+ */
+CORE_EXPORT QVariantMap indicesToBlobVariantMap(const std::uint32_t* indices, std::uint64_t numberOfIndices);
 
 /**
  * Create a workflow that serializes a raw byte buffer into a blob variant map.
@@ -90,9 +107,62 @@ CORE_EXPORT QVariantMap bytesToBlobVariantMap(const char* bytes, std::uint64_t n
  *
  * @param bytes Source byte buffer.
  * @param numberOfBytes Number of bytes in the source buffer.
+ * @param elementSize Size (in bytes) of the elements in the source buffer, used by codecs which exploit numeric structure.
  * @return Workflow that produces a blob variant map.
  */
-CORE_EXPORT workflow::UniqueWorkflowPlan bytesToBlobVariantMapWorkflow(const char* bytes, std::uint64_t numberOfBytes);
+CORE_EXPORT workflow::UniqueWorkflowPlan bytesToBlobVariantMapWorkflow(const char* bytes, std::uint64_t numberOfBytes, std::uint32_t elementSize = 1);
+
+/**
+ * Create a workflow that serializes a raw byte buffer into a blob variant map
+ * with an explicit codec, block size and save directory.
+ *
+ * This is the project-independent part of bytesToBlobVariantMapWorkflow():
+ * the buffer is split into blocks of at most \p blockSizeInBytes (rounded down
+ * to a multiple of \p elementSize), which are encoded by the jobs of a batched
+ * parallel stage (with batches of dataBlockEncodingBatchSize blocks), after
+ * which a final stage publishes the blob variant map.
+ *
+ * @param bytes Source byte buffer (must stay alive until the workflow finished).
+ * @param numberOfBytes Number of bytes in the source buffer.
+ * @param createCodec Factory function used to create one codec instance per block.
+ * @param blockSizeInBytes Maximum size of each encoded block.
+ * @param saveDir Directory where encoded block files are written (when no archive is being written).
+ * @param elementSize Size (in bytes) of the elements in the source buffer.
+ * @return Workflow that produces a blob variant map.
+ *
+ * @throws ManiVaultException If the blocks can not be created.
+ */
+CORE_EXPORT workflow::UniqueWorkflowPlan encodeBlobVariantMapWorkflow(const char* bytes, std::uint64_t numberOfBytes, const std::function<SharedCodec()>& createCodec, std::uint64_t blockSizeInBytes, const QString& saveDir, std::uint32_t elementSize = 1);
+
+/**
+ * Copy the encoded blocks of a blob variant map into the project archive that is being saved.
+ *
+ * The blocks are copied as they are from the archive they were previously
+ * saved to (or loaded from), so unchanged data does not need to be encoded
+ * again. The blob variant map itself remains valid for the new archive.
+ *
+ * Blocks are only copied when they were encoded with the current project codec,
+ * codec settings and block size (as recorded in the blob variant map), and only
+ * when the source archive contains all of them, so a failed copy does not leave
+ * orphaned entries in the archive.
+ *
+ * @param variantMap Serialized blob variant map (as produced by bytesToBlobVariantMap() or bytesToBlobVariantMapWorkflow()).
+ * @param sourceArchiveFilePath File path of the archive which contains the encoded blocks.
+ * @return True if all blocks were copied, false if nothing was copied (no archive is being saved, the codec settings changed, or the source archive lacks a block) and the data needs to be encoded instead.
+ */
+CORE_EXPORT bool copyBlobVariantMapBlocks(const QVariantMap& variantMap, const QString& sourceArchiveFilePath);
+
+/**
+ * Forget encoded blocks which are not in the archive at \p archiveFilePath.
+ *
+ * Encoded blocks are remembered by their content when they are saved or
+ * loaded, so identical blocks are copied instead of encoded again. The project
+ * manager forgets all of them when a project is created, opened or closed, and
+ * those of other archives once a project has been saved.
+ *
+ * @param archiveFilePath File path of the archive whose blocks are kept (all blocks are forgotten when empty).
+ */
+CORE_EXPORT void releaseEncodedBlocks(const QString& archiveFilePath = "");
 
 /**
  * Populate a destination buffer from a serialized blob variant map.
@@ -184,6 +254,18 @@ CORE_EXPORT void loadFromDisk(const QVariantMap& variantMap, QVector<uint32_t>&
  */
 CORE_EXPORT std::uint64_t estimateRawBlockTotalSize(const QVariant& value);
 
+/**
+ * Get the 64-bit content hash of a byte range.
+ *
+ * Uses XXH3, which hashes at memory bandwidth, so it is cheap enough to verify
+ * whether cached derived data still matches its source.
+ *
+ * @param data Pointer to the bytes.
+ * @param numberOfBytes Number of bytes.
+ * @return Content hash.
+ */
+CORE_EXPORT std::uint64_t hashBytes(const void* data, std::uint64_t numberOfBytes);
+
 /**
  * Serialize a variant map to a binary byte array.
  *
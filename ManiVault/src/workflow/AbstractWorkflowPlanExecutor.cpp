@@ -20,6 +20,12 @@ AbstractWorkflowPlanExecutor::AbstractWorkflowPlanExecutor(QObject* parent):
 {
 }
 
+void AbstractWorkflowPlanExecutor::parallelFor(std::uint64_t count, const std::function<void(std::uint64_t)>& function)
+{
+    for (std::uint64_t index = 0; index < count; ++index)
+        function(index);
+}
+
 SharedWorkflowResult AbstractWorkflowPlanExecutor::waitForAsync(WorkflowResultFuture::State& state)
 {
     auto result = state.future.get();
@@ -13,6 +13,9 @@
 
 #include <QObject>
 
+#include <cstdint>
+#include <functional>
+
 namespace mv::workflow
 {
 
@@ -92,6 +95,23 @@ public:
      */
     [[nodiscard]] virtual SharedWorkflowResult executeBlocking(UniqueWorkflowPlan workflowPlan, SharedWorkflowExecutionContext parentContext) = 0;
 
+    /**
+     * @brief Runs a data-parallel loop on the worker threads of the executor.
+     *
+     * Invokes \p function for each index in [0, \p count) and blocks until all
+     * invocations completed. Unlike a workflow plan, the loop has no execution
+     * context, task or result, which suits fine-grained parallelism inside a
+     * job or a data access, such as converting the elements of a data set.
+     * Loops share the worker threads with the workflows, instead of each
+     * starting threads of its own.
+     *
+     * The default implementation runs the loop on the calling thread.
+     *
+     * @param count Number of indices.
+     * @param function Function invoked with each index (concurrently).
+     */
+    virtual void parallelFor(std::uint64_t count, const std::function<void(std::uint64_t)>& function);
+
     /**
      * @brief Waits for asynchronous workflow completion.
      *